@@ -0,0 +1,869 @@
+#include "animation.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <assert.h>
+#include <chrono>
+#include <algorithm>
+
+#include "imgui/imgui.h"
+#include "animation_graph.h"
+#include "job_system.h"
+#include "memory_tracker.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SKINNING_SSE 1
+#include <xmmintrin.h>
+#else
+#define SKINNING_SSE 0
+#endif
+
+Animation g_animation;
+
+const char* SKINNING_MODE_NAMES[SKINNING_MODE_COUNT] = { "cpu", "gpu" };
+
+// times time   key index
+static unsigned animation_find_key(const float* times, unsigned count, float time)
+{
+	const unsigned index = (unsigned)(std::upper_bound(times, times + count, time) - times);
+	return index > 0 ? index - 1 : 0;
+}
+
+static float animation_key_factor(const float* times, unsigned key, float time)
+{
+	const float length = times[key + 1] - times[key];
+	const float t = length > 0.f ? (time - times[key]) / length : 0.f;
+	return t < 0.f ? 0.f : (t > 1.f ? 1.f : t);
+}
+
+glm::vec3 animation_sample_vec3(const float* times, const glm::vec3* values, unsigned count, float time)
+{
+	const unsigned key = animation_find_key(times, count, time);
+	if (key + 1 >= count)
+	{
+		return values[count - 1];
+	}
+	return glm::mix(values[key], values[key + 1], animation_key_factor(times, key, time));
+}
+
+glm::quat animation_sample_quat(const float* times, const glm::quat* values, unsigned count, float time)
+{
+	const unsigned key = animation_find_key(times, count, time);
+	if (key + 1 >= count)
+	{
+		return values[count - 1];
+	}
+	return glm::slerp(values[key], values[key + 1], animation_key_factor(times, key, time));
+}
+
+int animation_find_node(const Skeleton* skeleton, const char* name)
+{
+	const int node_count = (int)skeleton->node_names.size();
+	for (int i = 0; i < node_count; ++i)
+	{
+		if (skeleton->node_names[i] == name)
+		{
+			return i;
+		}
+	}
+	return -1;
+}
+
+void animation_pose_resize(const Skeleton* skeleton, Pose* pose)
+{
+	const size_t node_count = skeleton->parents.size();
+	pose->positions = skeleton->bind_positions;
+	pose->rotations = skeleton->bind_rotations;
+	pose->scales = skeleton->bind_scales;
+	pose->world.resize(node_count);
+}
+
+void animation_build_levels(Skeleton* skeleton)
+{
+	// θ ׻ տ Ƿ ̵ տ .
+	const int node_count = (int)skeleton->parents.size();
+	std::vector<int> depths(node_count);
+	int max_depth = 0;
+	for (int i = 0; i < node_count; ++i)
+	{
+		const int parent = skeleton->parents[i];
+		depths[i] = parent >= 0 ? depths[parent] + 1 : 0;
+		max_depth = std::max(max_depth, depths[i]);
+	}
+
+	skeleton->level_begin.assign(max_depth + 2, 0);
+	for (int i = 0; i < node_count; ++i)
+	{
+		++skeleton->level_begin[depths[i] + 1];
+	}
+	for (int depth = 0; depth <= max_depth; ++depth)
+	{
+		skeleton->level_begin[depth + 1] += skeleton->level_begin[depth];
+	}
+
+	std::vector<int> next(skeleton->level_begin.begin(), skeleton->level_begin.end() - 1);
+	skeleton->level_order.resize(node_count);
+	for (int i = 0; i < node_count; ++i)
+	{
+		skeleton->level_order[next[depths[i]]++] = i;
+	}
+}
+
+void animation_sample_clip(const AnimationClip* clip, float time, const Skeleton* skeleton, Pose* pose)
+{
+	// track  node  bind  ä.
+	std::copy(skeleton->bind_positions.begin(), skeleton->bind_positions.end(), pose->positions.begin());
+	std::copy(skeleton->bind_rotations.begin(), skeleton->bind_rotations.end(), pose->rotations.begin());
+	std::copy(skeleton->bind_scales.begin(), skeleton->bind_scales.end(), pose->scales.begin());
+
+	for (const AnimationTrack& track : clip->tracks)
+	{
+		if (track.position_count > 0)
+		{
+			pose->positions[track.node_index] = animation_sample_vec3(&(clip->position_times[track.position_begin]),
+				&(clip->positions[track.position_begin]), track.position_count, time);
+		}
+		if (track.rotation_count > 0)
+		{
+			pose->rotations[track.node_index] = animation_sample_quat(&(clip->rotation_times[track.rotation_begin]),
+				&(clip->rotations[track.rotation_begin]), track.rotation_count, time);
+		}
+		if (track.scale_count > 0)
+		{
+			pose->scales[track.node_index] = animation_sample_vec3(&(clip->scale_times[track.scale_begin]),
+				&(clip->scales[track.scale_begin]), track.scale_count, time);
+		}
+	}
+}
+
+void animation_build_world(const Skeleton* skeleton, Pose* pose)
+{
+	// θ ׻ տ Ƿ տ   ȴ.
+	const int node_count = (int)skeleton->parents.size();
+	for (int i = 0; i < node_count; ++i)
+	{
+		// T * R * S
+		glm::mat4 local = glm::mat4_cast(pose->rotations[i]);
+		local[0] *= pose->scales[i].x;
+		local[1] *= pose->scales[i].y;
+		local[2] *= pose->scales[i].z;
+		local[3] = glm::vec4(pose->positions[i], 1.f);
+
+		const int parent = skeleton->parents[i];
+		pose->world[i] = parent >= 0 ? pose->world[parent] * local : local;
+	}
+}
+
+void animation_build_palette(const SkinnedMesh* skinned_mesh, const Pose* pose, SkinMatrix* palette)
+{
+	const glm::mat4 mesh_inverse = glm::inverse(pose->world[skinned_mesh->mesh_node_index]);
+	const size_t bone_count = skinned_mesh->bone_nodes.size();
+	for (size_t i = 0; i < bone_count; ++i)
+	{
+		const glm::mat4 skin = mesh_inverse * pose->world[skinned_mesh->bone_nodes[i]] * skinned_mesh->bone_offsets[i];
+		for (int row = 0; row < 3; ++row)
+		{
+			for (int column = 0; column < 4; ++column)
+			{
+				palette[i].rows[row][column] = skin[column][row];
+			}
+		}
+	}
+}
+
+void skinning_quantize_weights(const float weights[SKIN_MAX_INFLUENCES], uint8_t out_weights[SKIN_MAX_INFLUENCES])
+{
+	float sum = 0.f;
+	for (int i = 0; i < SKIN_MAX_INFLUENCES; ++i)
+	{
+		sum += weights[i];
+	}
+	if (sum <= 0.f)
+	{
+		out_weights[0] = 255;
+		out_weights[1] = out_weights[2] = out_weights[3] = 0;
+		return;
+	}
+
+	// ݿø  ̴  ū weight(0)   255 .
+	int quantized_sum = 0;
+	for (int i = 1; i < SKIN_MAX_INFLUENCES; ++i)
+	{
+		out_weights[i] = (uint8_t)(weights[i] / sum * 255.f + 0.5f);
+		quantized_sum += out_weights[i];
+	}
+	out_weights[0] = (uint8_t)(255 - quantized_sum);
+}
+
+void skinning_cpu_range_scalar(const SkinnedMesh* skinned_mesh, const SkinMatrix* palette, const SkinningOutput* output, int begin, int end)
+{
+	for (int v = begin; v < end; ++v)
+	{
+		float m[3][4] = {};
+		for (int k = 0; k < SKIN_MAX_INFLUENCES; ++k)
+		{
+			const float w = (float)skinned_mesh->weights[v * SKIN_MAX_INFLUENCES + k] * (1.f / 255.f);
+			const SkinMatrix& bone = palette[skinned_mesh->joints[v * SKIN_MAX_INFLUENCES + k]];
+			for (int row = 0; row < 3; ++row)
+			{
+				for (int column = 0; column < 4; ++column)
+				{
+					m[row][column] += w * bone.rows[row][column];
+				}
+			}
+		}
+
+		const float px = skinned_mesh->position_x[v], py = skinned_mesh->position_y[v], pz = skinned_mesh->position_z[v];
+		const float nx = skinned_mesh->normal_x[v], ny = skinned_mesh->normal_y[v], nz = skinned_mesh->normal_z[v];
+		const float tx = skinned_mesh->tangent_x[v], ty = skinned_mesh->tangent_y[v], tz = skinned_mesh->tangent_z[v];
+
+		float* out_position = output->position + v * 4;
+		float* out_normal = output->normal + v * 3;
+		float* out_tangent = output->tangent + v * 3;
+		float normal[3], tangent[3];
+		for (int row = 0; row < 3; ++row)
+		{
+			out_position[row] = m[row][0] * px + m[row][1] * py + m[row][2] * pz + m[row][3];
+			normal[row] = m[row][0] * nx + m[row][1] * ny + m[row][2] * nz;
+			tangent[row] = m[row][0] * tx + m[row][1] * ty + m[row][2] * tz;
+		}
+		out_position[3] = 1.f;
+
+		// normal/tangent scale   ٽ ȭѴ.
+		const float normal_scale = 1.f / sqrtf(std::max(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2], 1e-20f));
+		const float tangent_scale = 1.f / sqrtf(std::max(tangent[0] * tangent[0] + tangent[1] * tangent[1] + tangent[2] * tangent[2], 1e-20f));
+		for (int i = 0; i < 3; ++i)
+		{
+			out_normal[i] = normal[i] * normal_scale;
+			out_tangent[i] = tangent[i] * tangent_scale;
+		}
+	}
+}
+
+#if SKINNING_SSE
+// vec3 4(SoA)  3 float .
+//  3 16 byte  ģ 1   .   batch ǵ帮 ʵ 12 byte .
+static void skinning_store_vec3x4(float* out, __m128 x, __m128 y, __m128 z)
+{
+	__m128 w = _mm_setzero_ps();
+	_MM_TRANSPOSE4_PS(x, y, z, w);
+	_mm_storeu_ps(out, x);
+	_mm_storeu_ps(out + 3, y);
+	_mm_storeu_ps(out + 6, z);
+
+	alignas(16) float last[4];
+	_mm_store_ps(last, w);
+	memcpy(out + 9, last, sizeof(float) * 3);
+}
+
+static void skinning_normalize3(__m128* x, __m128* y, __m128* z)
+{
+	const __m128 length2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(*x, *x), _mm_mul_ps(*y, *y)), _mm_mul_ps(*z, *z));
+	const __m128 scale = _mm_div_ps(_mm_set1_ps(1.f), _mm_sqrt_ps(_mm_max_ps(length2, _mm_set1_ps(1e-20f))));
+	*x = _mm_mul_ps(*x, scale);
+	*y = _mm_mul_ps(*y, scale);
+	*z = _mm_mul_ps(*z, scale);
+}
+#endif
+
+void skinning_cpu_range(const SkinnedMesh* skinned_mesh, const SkinMatrix* palette, const SkinningOutput* output, int begin, int end)
+{
+#if SKINNING_SSE
+	const __m128 weight_scale = _mm_set1_ps(1.f / 255.f);
+	const int simd_end = begin + ((end - begin) & ~3);
+	for (int v = begin; v < simd_end; v += 4)
+	{
+		// 1.  4 bone matrix weight ´. (matrix    register)
+		__m128 rows[3][4];
+		for (int lane = 0; lane < 4; ++lane)
+		{
+			const uint8_t* joints = &(skinned_mesh->joints[(v + lane) * SKIN_MAX_INFLUENCES]);
+			const uint8_t* weights = &(skinned_mesh->weights[(v + lane) * SKIN_MAX_INFLUENCES]);
+			__m128 row0 = _mm_setzero_ps();
+			__m128 row1 = _mm_setzero_ps();
+			__m128 row2 = _mm_setzero_ps();
+			for (int k = 0; k < SKIN_MAX_INFLUENCES; ++k)
+			{
+				const __m128 w = _mm_mul_ps(_mm_set1_ps((float)weights[k]), weight_scale);
+				const SkinMatrix& bone = palette[joints[k]];
+				row0 = _mm_add_ps(row0, _mm_mul_ps(w, _mm_loadu_ps(bone.rows[0])));
+				row1 = _mm_add_ps(row1, _mm_mul_ps(w, _mm_loadu_ps(bone.rows[1])));
+				row2 = _mm_add_ps(row2, _mm_mul_ps(w, _mm_loadu_ps(bone.rows[2])));
+			}
+			rows[0][lane] = row0;
+			rows[1][lane] = row1;
+			rows[2][lane] = row2;
+		}
+
+		// 2.  matrix  ϳ 4   Ѵ. rows[r][c] = 4  m[r][c]
+		for (int r = 0; r < 3; ++r)
+		{
+			_MM_TRANSPOSE4_PS(rows[r][0], rows[r][1], rows[r][2], rows[r][3]);
+		}
+
+		// 3. SoA stream 4 ȯѴ.
+		const __m128 px = _mm_loadu_ps(&(skinned_mesh->position_x[v]));
+		const __m128 py = _mm_loadu_ps(&(skinned_mesh->position_y[v]));
+		const __m128 pz = _mm_loadu_ps(&(skinned_mesh->position_z[v]));
+		const __m128 nx = _mm_loadu_ps(&(skinned_mesh->normal_x[v]));
+		const __m128 ny = _mm_loadu_ps(&(skinned_mesh->normal_y[v]));
+		const __m128 nz = _mm_loadu_ps(&(skinned_mesh->normal_z[v]));
+		const __m128 tx = _mm_loadu_ps(&(skinned_mesh->tangent_x[v]));
+		const __m128 ty = _mm_loadu_ps(&(skinned_mesh->tangent_y[v]));
+		const __m128 tz = _mm_loadu_ps(&(skinned_mesh->tangent_z[v]));
+
+		__m128 out_p[4];
+		__m128 out_n[3];
+		__m128 out_t[3];
+		for (int r = 0; r < 3; ++r)
+		{
+			const __m128 xyz_p = _mm_add_ps(_mm_add_ps(_mm_mul_ps(rows[r][0], px), _mm_mul_ps(rows[r][1], py)), _mm_mul_ps(rows[r][2], pz));
+			out_p[r] = _mm_add_ps(xyz_p, rows[r][3]);
+			out_n[r] = _mm_add_ps(_mm_add_ps(_mm_mul_ps(rows[r][0], nx), _mm_mul_ps(rows[r][1], ny)), _mm_mul_ps(rows[r][2], nz));
+			out_t[r] = _mm_add_ps(_mm_add_ps(_mm_mul_ps(rows[r][0], tx), _mm_mul_ps(rows[r][1], ty)), _mm_mul_ps(rows[r][2], tz));
+		}
+		out_p[3] = _mm_set1_ps(1.f);
+		skinning_normalize3(&out_n[0], &out_n[1], &out_n[2]);
+		skinning_normalize3(&out_t[0], &out_t[1], &out_t[2]);
+
+		// 4. vertex attribute ġ(AoS) ǵ .
+		_MM_TRANSPOSE4_PS(out_p[0], out_p[1], out_p[2], out_p[3]);
+		float* out_position = output->position + v * 4;
+		for (int lane = 0; lane < 4; ++lane)
+		{
+			_mm_storeu_ps(out_position + lane * 4, out_p[lane]);
+		}
+		skinning_store_vec3x4(output->normal + v * 3, out_n[0], out_n[1], out_n[2]);
+		skinning_store_vec3x4(output->tangent + v * 3, out_t[0], out_t[1], out_t[2]);
+	}
+
+	// 4  Ǵ 
+	skinning_cpu_range_scalar(skinned_mesh, palette, output, simd_end, end);
+#else
+	skinning_cpu_range_scalar(skinned_mesh, palette, output, begin, end);
+#endif
+}
+
+void skinning_cpu(const SkinnedMesh* skinned_mesh, const SkinMatrix* palette, const SkinningOutput* output)
+{
+	// batch ũⰡ 4 ̹Ƿ  ó  batch .
+	parallel_for_range((int)skinned_mesh->vertex_count, SKIN_BATCH_SIZE, [skinned_mesh, palette, output](int begin, int end)
+	{
+		skinning_cpu_range(skinned_mesh, palette, output, begin, end);
+	});
+}
+
+void animation_sample(int clip_index, float time, Pose* pose)
+{
+	if (g_animation.is_use_baked_clips)
+	{
+		baked_clip_sample(&(g_animation.baked_clips[clip_index]), time, pose);
+	}
+	else
+	{
+		animation_sample_clip(&(g_animation.clips[clip_index]), time, &(g_animation.skeleton), pose);
+	}
+}
+
+void animation_evaluate()
+{
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	if (g_animation.skinning_mode == SKINNING_MODE_GPU)
+	{
+		// character  ٲ  ٽ ҴѴ.
+		if ((int)g_animation_graph.characters.size() != g_animation.instance_pose_count)
+		{
+			animation_graph_resize(g_animation.instance_pose_count);
+		}
+		animation_graph_evaluate_all();
+	}
+	else
+	{
+		if (!g_animation.clips.empty())
+		{
+			animation_sample(g_animation.clip_index, g_animation.time, &(g_animation.pose));
+		}
+		animation_build_world(&(g_animation.skeleton), &(g_animation.pose));
+
+		for (SkinnedMesh& skinned_mesh : g_animation.skinned_meshes)
+		{
+			animation_build_palette(&skinned_mesh, &(g_animation.pose), skinned_mesh.palette.data());
+		}
+	}
+
+	g_animation.pose_ms = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+	++g_animation.pose_version;
+}
+
+void animation_print_usage()
+{
+	printf("  --skinning MODE             skin on the cpu (default) or in the vertex shader (gpu)\n");
+	printf("  --skinning-poses COUNT      poses shared by the instances with gpu skinning (default 1, max %d)\n", ANIMATION_MAX_INSTANCE_POSES);
+	printf("  --raw-clips                 sample the imported animation keys instead of baking the clips\n");
+	printf("  --skinning-bench            run the CPU skinning benchmark without a window and exit\n");
+	printf("  --clip-bench                compare raw and baked clip memory/sampling without a window and exit\n");
+	animation_graph_print_usage();
+}
+
+void animation_set_defaults()
+{
+	g_animation.test_mode = ANIMATION_TEST_NONE;
+	g_animation.skinning_mode = SKINNING_MODE_CPU;
+	g_animation.instance_pose_count = 1;
+	g_animation.max_instance_pose_count = ANIMATION_MAX_INSTANCE_POSES;
+	g_animation.is_use_baked_clips = true;
+	animation_graph_set_defaults();
+}
+
+bool animation_parse_arg(int argc, char** argv, int* index)
+{
+	const char* arg = argv[*index];
+	if (strcmp(arg, "--skinning-bench") == 0)
+	{
+		g_animation.test_mode = ANIMATION_TEST_SKINNING_BENCH;
+		return true;
+	}
+	if (strcmp(arg, "--clip-bench") == 0)
+	{
+		g_animation.test_mode = ANIMATION_TEST_CLIP_BENCH;
+		return true;
+	}
+	if (strcmp(arg, "--raw-clips") == 0)
+	{
+		g_animation.is_use_baked_clips = false;
+		return true;
+	}
+	if (strcmp(arg, "--skinning") == 0 && *index + 1 < argc)
+	{
+		for (int mode = 0; mode < SKINNING_MODE_COUNT; ++mode)
+		{
+			if (strcmp(argv[*index + 1], SKINNING_MODE_NAMES[mode]) == 0)
+			{
+				g_animation.skinning_mode = mode;
+				++(*index);
+				return true;
+			}
+		}
+		return false;
+	}
+	if (strcmp(arg, "--skinning-poses") == 0 && *index + 1 < argc)
+	{
+		const int pose_count = atoi(argv[*index + 1]);
+		if (pose_count < 1 || pose_count > ANIMATION_MAX_INSTANCE_POSES)
+		{
+			return false;
+		}
+		g_animation.instance_pose_count = pose_count;
+		++(*index);
+		return true;
+	}
+	return animation_graph_parse_arg(argc, argv, index);
+}
+
+void animation_init()
+{
+	g_animation.is_play = !g_animation.clips.empty();
+	g_animation.clip_index = 0;
+	g_animation.time = 0.f;
+	g_animation.speed = 1.f;
+	g_animation.pose_version = 0;
+	g_animation.pose_ms = 0.f;
+	g_animation.skinning_ms = 0.f;
+	g_animation.skinned_vertex_count = 0;
+
+	// clip    Ƿ job .  ڿ  key .
+	if (g_animation.is_use_baked_clips)
+	{
+		const int last_tag = memory_tag_begin(MEMORY_TAG_ANIMATION);
+		g_animation.baked_clips.resize(g_animation.clips.size());
+		parallel_for((int)g_animation.clips.size(), 1, [](int clip_index)
+		{
+			const int last_tag = memory_tag_begin(MEMORY_TAG_ANIMATION);
+			baked_clip_load_or_bake(&(g_animation.clips[clip_index]), &(g_animation.skeleton), &(g_animation.baked_clips[clip_index]));
+			memory_tag_end(last_tag);
+		});
+
+		for (size_t i = 0; i < g_animation.clips.size(); ++i)
+		{
+			AnimationClip* clip = &(g_animation.clips[i]);
+			const BakedClip* baked = &(g_animation.baked_clips[i]);
+			printf("Baked clip %s%s : %.1f KB -> %.1f KB, %u animated / %u constant tracks, max error %g / %g / %g\n",
+				clip->name.c_str(), baked->is_from_cache ? " (cache)" : "",
+				(float)baked->source_bytes / 1024.f, (float)baked_clip_memory_bytes(baked) / 1024.f,
+				baked->animated_track_count, baked->constant_track_count,
+				baked->max_error[BAKED_CHANNEL_ROTATION], baked->max_error[BAKED_CHANNEL_TRANSLATION], baked->max_error[BAKED_CHANNEL_SCALE]);
+
+			AnimationClip baked_only;
+			baked_only.name = clip->name;
+			baked_only.duration = clip->duration;
+			std::swap(*clip, baked_only);
+		}
+		memory_tag_end(last_tag);
+	}
+
+	animation_build_levels(&(g_animation.skeleton));
+	animation_pose_resize(&(g_animation.skeleton), &(g_animation.pose));
+	g_animation.palette_stride = 0;
+	for (SkinnedMesh& skinned_mesh : g_animation.skinned_meshes)
+	{
+		assert(skinned_mesh.bone_nodes.size() <= SKIN_MAX_BONES);
+		skinned_mesh.palette.resize(skinned_mesh.bone_nodes.size());
+		skinned_mesh.palette_base = g_animation.palette_stride;
+		g_animation.palette_stride += (unsigned)skinned_mesh.bone_nodes.size();
+	}
+	animation_graph_build_default();
+	animation_evaluate();
+
+	printf("Animation : %d nodes, %d clips, %d skinned meshes\n", (int)g_animation.skeleton.parents.size(),
+		(int)g_animation.clips.size(), (int)g_animation.skinned_meshes.size());
+}
+
+void animation_terminate()
+{
+	g_animation.skeleton = Skeleton();
+	g_animation.clips.clear();
+	g_animation.clips.shrink_to_fit();
+	g_animation.baked_clips.clear();
+	g_animation.baked_clips.shrink_to_fit();
+	g_animation.skinned_meshes.clear();
+	g_animation.skinned_meshes.shrink_to_fit();
+	g_animation.pose = Pose();
+	animation_graph_terminate();
+	g_animation.gpu_palettes.clear();
+	g_animation.gpu_palettes.shrink_to_fit();
+}
+
+bool animation_update(float delta_time, const glm::vec3& camera_position)
+{
+	if (g_animation.clips.empty() || !g_animation.is_play)
+	{
+		return false;
+	}
+
+	// GPU skinning character  ð ̰, ʰ  character Ѵ.
+	if (g_animation.skinning_mode == SKINNING_MODE_GPU && (int)g_animation_graph.characters.size() == g_animation.instance_pose_count)
+	{
+		if (!animation_graph_update(delta_time * g_animation.speed, camera_position))
+		{
+			return false;
+		}
+		g_animation.pose_ms = g_animation_graph.update_ms;
+		++g_animation.pose_version;
+		return true;
+	}
+
+	const float duration = g_animation.clips[g_animation.clip_index].duration;
+	g_animation.time += delta_time * g_animation.speed;
+	if (duration > 0.f)
+	{
+		g_animation.time = fmodf(g_animation.time, duration);
+		if (g_animation.time < 0.f)
+		{
+			g_animation.time += duration;
+		}
+	}
+	animation_evaluate();
+	return true;
+}
+
+//  seed ׻  data .
+static float animation_bench_random(uint32_t* state)
+{
+	*state ^= *state << 13;
+	*state ^= *state >> 17;
+	*state ^= *state << 5;
+	return (float)(*state & 0xFFFFFF) / (float)0xFFFFFF;
+}
+
+static bool animation_run_skinning_bench()
+{
+	constexpr int REPEAT_COUNT = 5;
+	constexpr float MAX_ERROR = 1e-4f;
+
+	// bone  ȸ/̵,   4 bone  ռ data
+	uint32_t random_state = 0x12345678;
+	SkinnedMesh mesh;
+	mesh.vertex_count = SKIN_BENCH_VERTEX_COUNT;
+	mesh.palette.resize(SKIN_BENCH_BONE_COUNT);
+	for (SkinMatrix& bone : mesh.palette)
+	{
+		const glm::vec3 axis = glm::normalize(glm::vec3(animation_bench_random(&random_state), animation_bench_random(&random_state), animation_bench_random(&random_state)) + glm::vec3(0.1f));
+		const glm::mat4 skin = glm::mat4_cast(glm::angleAxis(animation_bench_random(&random_state) * 6.28f, axis));
+		for (int row = 0; row < 3; ++row)
+		{
+			for (int column = 0; column < 3; ++column)
+			{
+				bone.rows[row][column] = skin[column][row];
+			}
+			bone.rows[row][3] = animation_bench_random(&random_state) * 2.f - 1.f;
+		}
+	}
+
+	std::vector<float>* streams[9] = { &mesh.position_x, &mesh.position_y, &mesh.position_z, &mesh.normal_x, &mesh.normal_y, &mesh.normal_z,
+		&mesh.tangent_x, &mesh.tangent_y, &mesh.tangent_z };
+	for (std::vector<float>* stream : streams)
+	{
+		stream->resize(mesh.vertex_count);
+		for (float& value : *stream)
+		{
+			value = animation_bench_random(&random_state) * 2.f - 1.f;
+		}
+	}
+	mesh.joints.resize(mesh.vertex_count * SKIN_MAX_INFLUENCES);
+	mesh.weights.resize(mesh.vertex_count * SKIN_MAX_INFLUENCES);
+	for (unsigned v = 0; v < mesh.vertex_count; ++v)
+	{
+		float weights[SKIN_MAX_INFLUENCES];
+		for (int k = 0; k < SKIN_MAX_INFLUENCES; ++k)
+		{
+			mesh.joints[v * SKIN_MAX_INFLUENCES + k] = (uint8_t)(animation_bench_random(&random_state) * (SKIN_BENCH_BONE_COUNT - 1));
+			weights[k] = animation_bench_random(&random_state);
+		}
+		std::sort(weights, weights + SKIN_MAX_INFLUENCES, [](float a, float b) { return a > b; });
+		skinning_quantize_weights(weights, &(mesh.weights[v * SKIN_MAX_INFLUENCES]));
+	}
+
+	std::vector<float> reference_data(mesh.vertex_count * 10);
+	std::vector<float> result_data(mesh.vertex_count * 10);
+	const SkinningOutput reference = { reference_data.data(), reference_data.data() + mesh.vertex_count * 4, reference_data.data() + mesh.vertex_count * 7 };
+	const SkinningOutput result = { result_data.data(), result_data.data() + mesh.vertex_count * 4, result_data.data() + mesh.vertex_count * 7 };
+
+	job_system_init(g_job_system.requested_worker_count);
+
+	printf("Skinning bench : %u vertices, %d bones, %d influences\n", mesh.vertex_count, SKIN_BENCH_BONE_COUNT, SKIN_MAX_INFLUENCES);
+	printf("  path          threads       ms   vertices/ms\n");
+
+	//    .
+	auto measure = [&mesh](const char* name, int thread_count, const SkinningOutput* output, void (*run)(const SkinnedMesh*, const SkinningOutput*))
+	{
+		float best_ms = 0.f;
+		for (int repeat = 0; repeat < REPEAT_COUNT; ++repeat)
+		{
+			const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			run(&mesh, output);
+			const float ms = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+			best_ms = repeat == 0 || ms < best_ms ? ms : best_ms;
+		}
+		printf("  %-12s %8d %8.2f %13.0f\n", name, thread_count, best_ms, best_ms > 0.f ? (float)mesh.vertex_count / best_ms : 0.f);
+	};
+
+	measure("scalar", 1, &reference, [](const SkinnedMesh* m, const SkinningOutput* output)
+	{
+		skinning_cpu_range_scalar(m, m->palette.data(), output, 0, (int)m->vertex_count);
+	});
+	measure(SKINNING_SSE ? "sse" : "scalar", 1, &result, [](const SkinnedMesh* m, const SkinningOutput* output)
+	{
+		skinning_cpu_range(m, m->palette.data(), output, 0, (int)m->vertex_count);
+	});
+	measure(SKINNING_SSE ? "sse + jobs" : "scalar + jobs", g_job_system.worker_count + 1, &result, [](const SkinnedMesh* m, const SkinningOutput* output)
+	{
+		skinning_cpu(m, m->palette.data(), output);
+	});
+
+	job_system_terminate();
+
+	float max_error = 0.f;
+	for (size_t i = 0; i < reference_data.size(); ++i)
+	{
+		max_error = std::max(max_error, fabsf(reference_data[i] - result_data[i]));
+	}
+	const bool is_success = max_error <= MAX_ERROR;
+	printf("Skinning bench %s : max error %g\n", is_success ? "passed" : "FAILED", max_error);
+	return is_success;
+}
+
+//  ĳó rotation  ̰, translation root, scale  ʴ´.
+void animation_bench_make_clip(Skeleton* skeleton, AnimationClip* clip)
+{
+	uint32_t random_state = 0x9E3779B9;
+	for (int node = 0; node < CLIP_BENCH_NODE_COUNT; ++node)
+	{
+		skeleton->node_names.push_back("node" + std::to_string(node));
+		skeleton->parents.push_back(node - 1);
+		skeleton->bind_positions.push_back(glm::vec3(0.f, 0.1f, 0.f));
+		skeleton->bind_rotations.push_back(glm::quat(1.f, 0.f, 0.f, 0.f));
+		skeleton->bind_scales.push_back(glm::vec3(1.f));
+	}
+
+	clip->name = "bench";
+	clip->duration = CLIP_BENCH_DURATION;
+	const unsigned key_count = (unsigned)(CLIP_BENCH_DURATION * CLIP_BENCH_KEY_RATE) + 1;
+	for (int node = 0; node < CLIP_BENCH_NODE_COUNT; ++node)
+	{
+		const glm::vec3 axis = glm::normalize(glm::vec3(animation_bench_random(&random_state), animation_bench_random(&random_state), animation_bench_random(&random_state)) + glm::vec3(0.1f));
+		const float frequency = 0.2f + animation_bench_random(&random_state);
+		const float phase = animation_bench_random(&random_state) * 6.28f;
+
+		AnimationTrack track;
+		track.node_index = node;
+		track.position_begin = (unsigned)clip->positions.size();
+		track.position_count = node == 0 ? key_count : 1;
+		track.rotation_begin = (unsigned)clip->rotations.size();
+		track.rotation_count = key_count;
+		track.scale_begin = (unsigned)clip->scales.size();
+		track.scale_count = key_count;
+		for (unsigned key = 0; key < key_count; ++key)
+		{
+			const float time = (float)key / CLIP_BENCH_KEY_RATE;
+			if (key < track.position_count)
+			{
+				clip->position_times.push_back(time);
+				clip->positions.push_back(glm::vec3(sinf(time * 0.5f), 0.f, time * 0.1f));
+			}
+			clip->rotation_times.push_back(time);
+			clip->rotations.push_back(glm::angleAxis(sinf(time * frequency * 6.28f + phase) * 0.8f, axis));
+			clip->scale_times.push_back(time);
+			clip->scales.push_back(glm::vec3(1.f));
+		}
+		clip->tracks.push_back(track);
+	}
+}
+
+static bool animation_run_clip_bench()
+{
+	constexpr int SAMPLE_COUNT = 20000;
+	constexpr float MAX_ROTATION_ERROR = BAKED_CLIP_ROTATION_TOLERANCE * 2.f;
+
+	Skeleton skeleton;
+	AnimationClip clip;
+	animation_bench_make_clip(&skeleton, &clip);
+
+	const std::chrono::steady_clock::time_point bake_start = std::chrono::steady_clock::now();
+	BakedClip baked;
+	baked_clip_bake(&clip, &skeleton, &baked);
+	const float bake_ms = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - bake_start).count();
+
+	Pose raw_pose, baked_pose;
+	animation_pose_resize(&skeleton, &raw_pose);
+	animation_pose_resize(&skeleton, &baked_pose);
+
+	//    ð sampling Ѵ.
+	std::vector<float> times(SAMPLE_COUNT);
+	uint32_t random_state = 0x2545F491;
+	for (float& time : times)
+	{
+		time = animation_bench_random(&random_state) * CLIP_BENCH_DURATION;
+	}
+
+	const std::chrono::steady_clock::time_point raw_start = std::chrono::steady_clock::now();
+	for (float time : times)
+	{
+		animation_sample_clip(&clip, time, &skeleton, &raw_pose);
+	}
+	const float raw_ms = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - raw_start).count();
+
+	const std::chrono::steady_clock::time_point baked_start = std::chrono::steady_clock::now();
+	for (float time : times)
+	{
+		baked_clip_sample(&baked, time, &baked_pose);
+	}
+	const float baked_ms = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - baked_start).count();
+
+	float max_rotation_error = 0.f;
+	float max_translation_error = 0.f;
+	for (int i = 0; i < 1000; ++i)
+	{
+		animation_sample_clip(&clip, times[i], &skeleton, &raw_pose);
+		baked_clip_sample(&baked, times[i], &baked_pose);
+		for (int node = 0; node < CLIP_BENCH_NODE_COUNT; ++node)
+		{
+			const glm::quat a = raw_pose.rotations[node];
+			const glm::quat b = glm::dot(a, baked_pose.rotations[node]) < 0.f ? -baked_pose.rotations[node] : baked_pose.rotations[node];
+			for (int c = 0; c < 4; ++c)
+			{
+				max_rotation_error = std::max(max_rotation_error, fabsf(a[c] - b[c]));
+			}
+			const glm::vec3 d = glm::abs(raw_pose.positions[node] - baked_pose.positions[node]);
+			max_translation_error = std::max(max_translation_error, std::max(d.x, std::max(d.y, d.z)));
+		}
+	}
+
+	const size_t raw_bytes = animation_clip_memory_bytes(&clip);
+	const size_t baked_bytes = baked_clip_memory_bytes(&baked);
+	printf("Clip bench : %d nodes, %.0f s, %.0f keys/s, baked at %.0f Hz in %.1f ms (%u animated / %u constant tracks, %d groups)\n",
+		CLIP_BENCH_NODE_COUNT, CLIP_BENCH_DURATION, CLIP_BENCH_KEY_RATE, BAKED_CLIP_SAMPLE_RATE, bake_ms,
+		baked.animated_track_count, baked.constant_track_count, (int)baked.groups.size());
+	printf("  format       memory KB   us/pose\n");
+	printf("  raw         %10.1f %9.3f\n", (float)raw_bytes / 1024.f, raw_ms * 1000.f / SAMPLE_COUNT);
+	printf("  baked       %10.1f %9.3f\n", (float)baked_bytes / 1024.f, baked_ms * 1000.f / SAMPLE_COUNT);
+	printf("  ratio       %10.1fx %8.1fx\n", baked_bytes > 0 ? (float)raw_bytes / baked_bytes : 0.f, baked_ms > 0.f ? raw_ms / baked_ms : 0.f);
+
+	const bool is_success = max_rotation_error <= MAX_ROTATION_ERROR && max_translation_error <= BAKED_CLIP_TRANSLATION_TOLERANCE * 2.f;
+	printf("Clip bench %s : max rotation error %g, max translation error %g\n", is_success ? "passed" : "FAILED", max_rotation_error, max_translation_error);
+	return is_success;
+}
+
+bool animation_run_test()
+{
+	switch (g_animation.test_mode)
+	{
+	case ANIMATION_TEST_SKINNING_BENCH:	return animation_run_skinning_bench();
+	case ANIMATION_TEST_CLIP_BENCH:		return animation_run_clip_bench();
+	case ANIMATION_TEST_GRAPH_BENCH:	return animation_graph_run_bench();
+	}
+	return true;
+}
+
+void animation_draw_gui()
+{
+	if (g_animation.skinned_meshes.empty())
+	{
+		ImGui::Text("Animation : None");
+		return;
+	}
+
+	bool is_changed = false;
+
+	ImGui::Text("Skinning"); ImGui::SameLine();
+	is_changed |= ImGui::Combo("##Skinning", &g_animation.skinning_mode, "CPU\0GPU\0");
+	if (g_animation.skinning_mode == SKINNING_MODE_GPU)
+	{
+		ImGui::Text("Characters"); ImGui::SameLine();
+		is_changed |= ImGui::SliderInt("##Characters", &g_animation.instance_pose_count, 1, std::min(ANIMATION_MAX_INSTANCE_POSES, g_animation.max_instance_pose_count));
+		animation_graph_draw_gui();
+	}
+
+	if (!g_animation.clips.empty())
+	{
+		ImGui::Text("Animation Play"); ImGui::SameLine();
+		ImGui::Checkbox("##AnimationPlay", &g_animation.is_play);
+
+		ImGui::Text("Animation Clip"); ImGui::SameLine();
+		const bool is_clip_changed = ImGui::Combo("##AnimationClip", &g_animation.clip_index, [](void* data, int index, const char** out_text) -> bool
+		{
+			*out_text = g_animation.clips[index].name.c_str();
+			return true;
+		}, nullptr, (int)g_animation.clips.size());
+
+		ImGui::Text("Animation Speed"); ImGui::SameLine();
+		ImGui::DragFloat("##AnimationSpeed", &g_animation.speed, 0.01f, -4.f, 4.f, "%.2f");
+
+		ImGui::Text("Animation Time"); ImGui::SameLine();
+		const bool is_time_changed = ImGui::SliderFloat("##AnimationTime", &g_animation.time, 0.f, g_animation.clips[g_animation.clip_index].duration, "%.2f s");
+		is_changed |= is_clip_changed || is_time_changed;
+	}
+
+	if (is_changed)
+	{
+		animation_evaluate();
+	}
+
+	if (g_animation.is_use_baked_clips && !g_animation.baked_clips.empty())
+	{
+		const BakedClip* baked = &(g_animation.baked_clips[g_animation.clip_index]);
+		ImGui::Text("Baked Clip %.1f KB (raw %.1f KB)", (float)baked_clip_memory_bytes(baked) / 1024.f, (float)baked->source_bytes / 1024.f);
+	}
+	ImGui::Text("Pose + Palette %.3f ms", g_animation.pose_ms);
+	if (g_animation.skinning_mode == SKINNING_MODE_CPU)
+	{
+		const float vertices_per_ms = g_animation.skinning_ms > 0.f ? (float)g_animation.skinned_vertex_count / g_animation.skinning_ms : 0.f;
+		ImGui::Text("CPU Skinning %.3f ms / %u vertices (%.0f vertices/ms)", g_animation.skinning_ms, g_animation.skinned_vertex_count, vertices_per_ms);
+	}
+	else
+	{
+		ImGui::Text("GPU Palette %u bones x %d characters", g_animation.palette_stride, g_animation.instance_pose_count);
+	}
+}
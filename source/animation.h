@@ -0,0 +1,252 @@
+#ifndef __ANIMATION_H__
+#define __ANIMATION_H__
+
+#include <stdint.h>
+#include <vector>
+#include <string>
+
+#include "glm/glm.hpp"
+#include "glm/gtc/quaternion.hpp"
+
+#include "baked_clip.h"
+
+// skeletal animation CPU skinning.
+// Skeleton : model node hierarchy. θ ׻ ڽĺ տ Ƿ տ   world .
+// AnimationClip : node position/rotation/scale key. key clip ϳ Ƶΰ track  Ų.
+// SkinnedMesh :   ū 4 joint index/weight(8bit) bind pose SoA stream.
+//               palette index mesh ̹Ƿ 8bit ϴ.
+// CPU skinning SSE 4  óϰ, job system  streaming VBO ٷ .
+// GPU skinning vertex shader joint/weight attribute texture buffer palette д´.
+//   instance instance_pose_count pose  ϳ Ƿ CPU  ۾   ٸ δ.
+//   pose ϳ animation graph(animation_graph.h) character ϳ.
+//   CPU skinning VBO ϳ̹Ƿ  instance pose 0 .
+// clip ҷ  BakedClip (baked_clip.h)  key   clip sampling Ѵ.
+//  :
+//   animation_update(delta_time, camera_position);		// clip , pose/palette 
+//   skinning_cpu(&skinned_mesh, skinned_mesh.palette.data(), &output);
+//
+// command line : [--skinning cpu|gpu] [--skinning-poses COUNT] [--raw-clips] [--skinning-bench] [--clip-bench]
+
+constexpr int SKIN_MAX_INFLUENCES = 4;
+constexpr int SKIN_MAX_BONES = 256;
+
+// skinning job ϳ ó   (4 )
+constexpr int SKIN_BATCH_SIZE = 2048;
+
+// GPU skinning instance   pose(character) ִ 
+constexpr int ANIMATION_MAX_INSTANCE_POSES = 8192;
+
+// --skinning-bench ռ  ũ
+constexpr int SKIN_BENCH_VERTEX_COUNT = 1 << 20;
+constexpr int SKIN_BENCH_BONE_COUNT = 64;
+
+// --clip-bench ռ clip ũ
+constexpr int CLIP_BENCH_NODE_COUNT = 64;
+constexpr float CLIP_BENCH_DURATION = 30.f;
+constexpr float CLIP_BENCH_KEY_RATE = 60.f;
+
+// node  local transform ⺻ θ
+struct Skeleton
+{
+	std::vector<std::string> node_names;
+	std::vector<int> parents;	// -1̶ root
+
+	// ִϸ̼ track  node   .
+	std::vector<glm::vec3> bind_positions;
+	std::vector<glm::quat> bind_rotations;
+	std::vector<glm::vec3> bind_scales;
+
+	//   node.  d node level_order[level_begin[d] ~ level_begin[d + 1])
+	std::vector<int> level_order;
+	std::vector<int> level_begin;
+};
+
+struct AnimationTrack
+{
+	int node_index;
+	unsigned position_begin, position_count;
+	unsigned rotation_begin, rotation_count;
+	unsigned scale_begin, scale_count;
+};
+
+struct AnimationClip
+{
+	std::string name;
+	float duration;	// 
+
+	std::vector<AnimationTrack> tracks;
+
+	// ð . track key ð .
+	std::vector<float> position_times;
+	std::vector<glm::vec3> positions;
+	std::vector<float> rotation_times;
+	std::vector<glm::quat> rotations;
+	std::vector<float> scale_times;
+	std::vector<glm::vec3> scales;
+};
+
+// skeleton ϳ  ð ڼ
+struct Pose
+{
+	std::vector<glm::vec3> positions;
+	std::vector<glm::quat> rotations;
+	std::vector<glm::vec3> scales;
+
+	// node scene root  matrix
+	std::vector<glm::mat4> world;
+};
+
+// affine skin matrix  3 (row-major). SSE  ྿ д´.
+struct SkinMatrix
+{
+	float rows[3][4];
+};
+
+struct SkinnedMesh
+{
+	int mesh_index;			// g_model.mesh index
+	int mesh_node_index;	//  mesh  node. skin matrix  node  .
+
+	// palette index -> node, inverse bind matrix
+	std::vector<int> bone_nodes;
+	std::vector<glm::mat4> bone_offsets;
+
+	unsigned vertex_count;
+
+	// bind pose SoA stream
+	std::vector<float> position_x, position_y, position_z;
+	std::vector<float> normal_x, normal_y, normal_z;
+	std::vector<float> tangent_x, tangent_y, tangent_z;
+
+	// vertex_count * SKIN_MAX_INFLUENCES. weight  255.
+	std::vector<uint8_t> joints;
+	std::vector<uint8_t> weights;
+
+	// ̹ pose skin matrix. animation_update . (CPU skinning)
+	std::vector<SkinMatrix> palette;
+
+	// Animation::gpu_palettes pose ϳ    mesh  index (GPU skinning)
+	unsigned palette_base;
+};
+
+// skinning   . model shader vertex attribute  ġ. (position vec4, normal/tangent vec3)
+struct SkinningOutput
+{
+	float* position;
+	float* normal;
+	float* tangent;
+};
+
+enum SkinningMode
+{
+	SKINNING_MODE_CPU = 0,
+	SKINNING_MODE_GPU,
+	SKINNING_MODE_COUNT
+};
+extern const char* SKINNING_MODE_NAMES[SKINNING_MODE_COUNT];
+
+enum AnimationTestMode
+{
+	ANIMATION_TEST_NONE = 0,
+	ANIMATION_TEST_SKINNING_BENCH,
+	ANIMATION_TEST_CLIP_BENCH,
+	ANIMATION_TEST_GRAPH_BENCH,
+};
+
+struct Animation
+{
+	Skeleton skeleton;
+	std::vector<AnimationClip> clips;
+	std::vector<SkinnedMesh> skinned_meshes;
+
+	// clips  index. ٸ clips ̸ ̸ ´.
+	bool is_use_baked_clips;
+	std::vector<BakedClip> baked_clips;
+
+	int test_mode;
+
+	// 
+	bool is_play;
+	int clip_index;
+	float time;
+	float speed;
+
+	Pose pose;
+
+	int skinning_mode;
+
+	// GPU skinning. instance i (i % instance_pose_count)° pose , pose p graph character p .
+	// gpu_palettes pose palette_stride  skinned mesh skin matrix ̾  ̴.
+	int instance_pose_count;
+	int max_instance_pose_count;	// texture buffer ִ ũ Ѵ.
+	unsigned palette_stride;
+	std::vector<SkinMatrix> gpu_palettes;
+
+	// pose ٲ  ö󰣴. skinning  ٽ  ǴѴ.
+	unsigned pose_version;
+
+	//  (GUI)
+	float pose_ms;		// clip sampling + palette
+	float skinning_ms;
+	unsigned skinned_vertex_count;
+};
+extern Animation g_animation;
+
+void animation_set_defaults();
+void animation_print_usage();
+
+// argv[*index] animation ɼ̶  а index ű  true ش.
+bool animation_parse_arg(int argc, char** argv, int* index);
+
+// skeleton/clip/skinned mesh ä  ȣѴ. pose palette bind pose .
+void animation_init();
+void animation_terminate();
+
+//  ̶ ð ű pose palette ٽ . pose ٲٸ true.
+// camera_position GPU skinning character LOD Ѵ.
+bool animation_update(float delta_time, const glm::vec3& camera_position);
+
+// skinning mode ´ pose palette  ð ٽ . (mode pose  ٲ )
+void animation_evaluate();
+
+// key 迭 time() . binary search   (rotation slerp)Ѵ.
+glm::vec3 animation_sample_vec3(const float* times, const glm::vec3* values, unsigned count, float time);
+glm::quat animation_sample_quat(const float* times, const glm::quat* values, unsigned count, float time);
+
+// ̸  ù node index. ٸ -1
+int animation_find_node(const Skeleton* skeleton, const char* name);
+
+void animation_pose_resize(const Skeleton* skeleton, Pose* pose);
+
+// parents level_order .
+void animation_build_levels(Skeleton* skeleton);
+
+//  clip ִٸ װ, ٸ  key clip_index time() sampling Ѵ.
+void animation_sample(int clip_index, float time, Pose* pose);
+
+// clip time() ڼ local transform ä. track  node bind .
+void animation_sample_clip(const AnimationClip* clip, float time, const Skeleton* skeleton, Pose* pose);
+void animation_build_world(const Skeleton* skeleton, Pose* pose);
+void animation_build_palette(const SkinnedMesh* skinned_mesh, const Pose* pose, SkinMatrix* palette);
+
+// [begin, end)  skinning Ѵ.
+void skinning_cpu_range(const SkinnedMesh* skinned_mesh, const SkinMatrix* palette, const SkinningOutput* output, int begin, int end);
+void skinning_cpu_range_scalar(const SkinnedMesh* skinned_mesh, const SkinMatrix* palette, const SkinningOutput* output, int begin, int end);
+
+//   job system  skinning ϰ   ٸ.
+void skinning_cpu(const SkinnedMesh* skinned_mesh, const SkinMatrix* palette, const SkinningOutput* output);
+
+// weight 4  255 8bit ٲ۴. weight ū  Ѵ.
+void skinning_quantize_weights(const float weights[SKIN_MAX_INFLUENCES], uint8_t out_weights[SKIN_MAX_INFLUENCES]);
+
+// ε巴 ̴ ռ clip  skeleton (bench)
+void animation_bench_make_clip(Skeleton* skeleton, AnimationClip* clip);
+
+// --skinning-bench. â̳ GL context  ռ ͷ ʴ skinning   ϰ .
+// --clip-bench. ռ clip  key  clip memory, sampling ð,  ϰ .
+// --anim-graph-bench. animation_graph_run_bench
+bool animation_run_test();
+
+void animation_draw_gui();
+
+#endif
@@ -0,0 +1,852 @@
+#include "animation_graph.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <assert.h>
+#include <chrono>
+#include <algorithm>
+
+#include "imgui/imgui.h"
+#include "job_system.h"
+#include "memory_tracker.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ANIMATION_GRAPH_SSE 1
+#include <xmmintrin.h>
+#else
+#define ANIMATION_GRAPH_SSE 0
+#endif
+
+AnimationGraph g_animation_graph;
+
+// thread  ϳ. node   pose ϳ .
+struct AnimGraphScratch
+{
+	std::vector<Pose> slots;
+	Pose output;
+};
+static AnimGraphScratch s_scratches[JOB_MAX_WORKER_COUNT + 1];
+
+static glm::quat animation_nlerp(const glm::quat& a, const glm::quat& b, float weight)
+{
+	const glm::quat target = glm::dot(a, b) < 0.f ? -b : b;
+	return glm::normalize(a + (target - a) * weight);
+}
+
+void animation_blend_poses_scalar(const Pose* a, const Pose* b, float weight, Pose* out)
+{
+	const size_t node_count = a->rotations.size();
+	for (size_t i = 0; i < node_count; ++i)
+	{
+		out->positions[i] = a->positions[i] + (b->positions[i] - a->positions[i]) * weight;
+		out->rotations[i] = animation_nlerp(a->rotations[i], b->rotations[i], weight);
+		out->scales[i] = a->scales[i] + (b->scales[i] - a->scales[i]) * weight;
+	}
+}
+
+// a + (b - a) * weight float 迭 ü Ѵ.
+static void animation_lerp_floats(const float* a, const float* b, float weight, float* out, size_t count)
+{
+	size_t i = 0;
+#if ANIMATION_GRAPH_SSE
+	const __m128 w = _mm_set1_ps(weight);
+	for (; i + 4 <= count; i += 4)
+	{
+		const __m128 va = _mm_loadu_ps(a + i);
+		const __m128 vb = _mm_loadu_ps(b + i);
+		_mm_storeu_ps(out + i, _mm_add_ps(va, _mm_mul_ps(_mm_sub_ps(vb, va), w)));
+	}
+#endif
+	for (; i < count; ++i)
+	{
+		out[i] = a[i] + (b[i] - a[i]) * weight;
+	}
+}
+
+#if ANIMATION_GRAPH_SSE
+// quaternion 4(x, y, z, w )   register ٲ۴.
+static void animation_load_quat4(const glm::quat* q, __m128* x, __m128* y, __m128* z, __m128* w)
+{
+	__m128 r0 = _mm_loadu_ps(&(q[0].x));
+	__m128 r1 = _mm_loadu_ps(&(q[1].x));
+	__m128 r2 = _mm_loadu_ps(&(q[2].x));
+	__m128 r3 = _mm_loadu_ps(&(q[3].x));
+	_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+	*x = r0; *y = r1; *z = r2; *w = r3;
+}
+
+static void animation_store_quat4(glm::quat* q, __m128 x, __m128 y, __m128 z, __m128 w)
+{
+	_MM_TRANSPOSE4_PS(x, y, z, w);
+	_mm_storeu_ps(&(q[0].x), x);
+	_mm_storeu_ps(&(q[1].x), y);
+	_mm_storeu_ps(&(q[2].x), z);
+	_mm_storeu_ps(&(q[3].x), w);
+}
+
+// b a  ݱ   nlerp Ѵ.
+static void animation_nlerp4(__m128 ax, __m128 ay, __m128 az, __m128 aw, __m128* bx, __m128* by, __m128* bz, __m128* bw, __m128 weight)
+{
+	const __m128 sign_mask = _mm_set1_ps(-0.f);
+	const __m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax, *bx), _mm_mul_ps(ay, *by)), _mm_add_ps(_mm_mul_ps(az, *bz), _mm_mul_ps(aw, *bw)));
+	const __m128 sign = _mm_and_ps(dot, sign_mask);
+
+	__m128 x = _mm_add_ps(ax, _mm_mul_ps(_mm_sub_ps(_mm_xor_ps(*bx, sign), ax), weight));
+	__m128 y = _mm_add_ps(ay, _mm_mul_ps(_mm_sub_ps(_mm_xor_ps(*by, sign), ay), weight));
+	__m128 z = _mm_add_ps(az, _mm_mul_ps(_mm_sub_ps(_mm_xor_ps(*bz, sign), az), weight));
+	__m128 w = _mm_add_ps(aw, _mm_mul_ps(_mm_sub_ps(_mm_xor_ps(*bw, sign), aw), weight));
+
+	const __m128 length_sq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_add_ps(_mm_mul_ps(z, z), _mm_mul_ps(w, w)));
+	const __m128 inverse_length = _mm_div_ps(_mm_set1_ps(1.f), _mm_sqrt_ps(length_sq));
+	*bx = _mm_mul_ps(x, inverse_length);
+	*by = _mm_mul_ps(y, inverse_length);
+	*bz = _mm_mul_ps(z, inverse_length);
+	*bw = _mm_mul_ps(w, inverse_length);
+}
+#endif
+
+void animation_blend_poses(const Pose* a, const Pose* b, float weight, Pose* out)
+{
+	const size_t node_count = a->rotations.size();
+	animation_lerp_floats(&(a->positions[0].x), &(b->positions[0].x), weight, &(out->positions[0].x), node_count * 3);
+	animation_lerp_floats(&(a->scales[0].x), &(b->scales[0].x), weight, &(out->scales[0].x), node_count * 3);
+
+	size_t i = 0;
+#if ANIMATION_GRAPH_SSE
+	const __m128 w = _mm_set1_ps(weight);
+	for (; i + 4 <= node_count; i += 4)
+	{
+		__m128 ax, ay, az, aw, bx, by, bz, bw;
+		animation_load_quat4(&(a->rotations[i]), &ax, &ay, &az, &aw);
+		animation_load_quat4(&(b->rotations[i]), &bx, &by, &bz, &bw);
+		animation_nlerp4(ax, ay, az, aw, &bx, &by, &bz, &bw, w);
+		animation_store_quat4(&(out->rotations[i]), bx, by, bz, bw);
+	}
+#endif
+	for (; i < node_count; ++i)
+	{
+		out->rotations[i] = animation_nlerp(a->rotations[i], b->rotations[i], weight);
+	}
+}
+
+void animation_add_pose(const Pose* base, const Pose* additive, const Pose* reference, float weight, Pose* out)
+{
+	const size_t node_count = base->rotations.size();
+	for (size_t i = 0; i < node_count; ++i)
+	{
+		out->positions[i] = base->positions[i] + (additive->positions[i] - reference->positions[i]) * weight;
+
+		// scale reference   Ѵ.
+		const glm::vec3 ratio = glm::vec3(reference->scales[i].x != 0.f ? additive->scales[i].x / reference->scales[i].x : 1.f,
+			reference->scales[i].y != 0.f ? additive->scales[i].y / reference->scales[i].y : 1.f,
+			reference->scales[i].z != 0.f ? additive->scales[i].z / reference->scales[i].z : 1.f);
+		out->scales[i] = base->scales[i] * (glm::vec3(1.f) + (ratio - glm::vec3(1.f)) * weight);
+	}
+
+	size_t i = 0;
+#if ANIMATION_GRAPH_SSE
+	const __m128 w = _mm_set1_ps(weight);
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.f);
+	for (; i + 4 <= node_count; i += 4)
+	{
+		__m128 bx, by, bz, bw, ax, ay, az, aw, rx, ry, rz, rw;
+		animation_load_quat4(&(base->rotations[i]), &bx, &by, &bz, &bw);
+		animation_load_quat4(&(additive->rotations[i]), &ax, &ay, &az, &aw);
+		animation_load_quat4(&(reference->rotations[i]), &rx, &ry, &rz, &rw);
+
+		// delta = conj(reference) * additive
+		__m128 dx = _mm_sub_ps(_mm_add_ps(_mm_sub_ps(_mm_mul_ps(rw, ax), _mm_mul_ps(rx, aw)), _mm_mul_ps(rz, ay)), _mm_mul_ps(ry, az));
+		__m128 dy = _mm_sub_ps(_mm_add_ps(_mm_sub_ps(_mm_mul_ps(rw, ay), _mm_mul_ps(ry, aw)), _mm_mul_ps(rx, az)), _mm_mul_ps(rz, ax));
+		__m128 dz = _mm_sub_ps(_mm_add_ps(_mm_sub_ps(_mm_mul_ps(rw, az), _mm_mul_ps(rz, aw)), _mm_mul_ps(ry, ax)), _mm_mul_ps(rx, ay));
+		__m128 dw = _mm_add_ps(_mm_add_ps(_mm_mul_ps(rw, aw), _mm_mul_ps(rx, ax)), _mm_add_ps(_mm_mul_ps(ry, ay), _mm_mul_ps(rz, az)));
+
+		// identity delta weight ŭ
+		animation_nlerp4(zero, zero, zero, one, &dx, &dy, &dz, &dw, w);
+
+		// base * delta
+		const __m128 x = _mm_add_ps(_mm_add_ps(_mm_mul_ps(bw, dx), _mm_mul_ps(bx, dw)), _mm_sub_ps(_mm_mul_ps(by, dz), _mm_mul_ps(bz, dy)));
+		const __m128 y = _mm_add_ps(_mm_add_ps(_mm_mul_ps(bw, dy), _mm_mul_ps(by, dw)), _mm_sub_ps(_mm_mul_ps(bz, dx), _mm_mul_ps(bx, dz)));
+		const __m128 z = _mm_add_ps(_mm_add_ps(_mm_mul_ps(bw, dz), _mm_mul_ps(bz, dw)), _mm_sub_ps(_mm_mul_ps(bx, dy), _mm_mul_ps(by, dx)));
+		const __m128 qw = _mm_sub_ps(_mm_sub_ps(_mm_mul_ps(bw, dw), _mm_mul_ps(bx, dx)), _mm_add_ps(_mm_mul_ps(by, dy), _mm_mul_ps(bz, dz)));
+		animation_store_quat4(&(out->rotations[i]), x, y, z, qw);
+	}
+#endif
+	for (; i < node_count; ++i)
+	{
+		const glm::quat delta = animation_nlerp(glm::quat(1.f, 0.f, 0.f, 0.f), glm::conjugate(reference->rotations[i]) * additive->rotations[i], weight);
+		out->rotations[i] = base->rotations[i] * delta;
+	}
+}
+
+void animation_build_world_levels(const Skeleton* skeleton, Pose* pose)
+{
+	if (skeleton->level_order.empty())
+	{
+		animation_build_world(skeleton, pose);
+		return;
+	}
+
+	// local   Ƿ   .
+	const int node_count = (int)skeleton->parents.size();
+	for (int i = 0; i < node_count; ++i)
+	{
+		glm::mat4 local = glm::mat4_cast(pose->rotations[i]);
+		local[0] *= pose->scales[i].x;
+		local[1] *= pose->scales[i].y;
+		local[2] *= pose->scales[i].z;
+		local[3] = glm::vec4(pose->positions[i], 1.f);
+		pose->world[i] = local;
+	}
+
+	//  0(root) local  world.   ̺ʹ θ ̹ world̹Ƿ ϱ⸸ Ѵ.
+	for (size_t order = skeleton->level_begin[1]; order < skeleton->level_order.size(); ++order)
+	{
+		const int node = skeleton->level_order[order];
+		pose->world[node] = pose->world[skeleton->parents[node]] * pose->world[node];
+	}
+}
+
+// root program ؼ slots[root] .
+static void animation_graph_evaluate_node(const AnimGraph* graph, int root, const AnimCharacter* character, AnimGraphScratch* scratch)
+{
+	for (int node_index : graph->programs[root])
+	{
+		const AnimGraphNode* node = &(graph->nodes[node_index]);
+		Pose* out = &(scratch->slots[node_index]);
+		switch (node->type)
+		{
+		case ANIM_GRAPH_NODE_CLIP:
+		{
+			const float duration = g_animation.clips[node->clip_index].duration;
+			float time = character->time * node->speed;
+			if (duration > 0.f)
+			{
+				time = fmodf(time, duration);
+				time = time < 0.f ? time + duration : time;
+			}
+			animation_sample(node->clip_index, time, out);
+			break;
+		}
+		case ANIM_GRAPH_NODE_BLEND_1D:
+		{
+			//  ̿ δ  Է ã´.   ̶  Է ״δ.
+			const float value = character->parameters[node->parameters[0]];
+			int upper = 0;
+			while (upper < node->input_count && node->positions[upper].x < value)
+			{
+				++upper;
+			}
+			if (upper == 0 || upper == node->input_count)
+			{
+				const Pose* input = &(scratch->slots[node->inputs[upper == 0 ? 0 : node->input_count - 1]]);
+				animation_blend_poses(input, input, 0.f, out);
+			}
+			else
+			{
+				const float lower_x = node->positions[upper - 1].x;
+				const float upper_x = node->positions[upper].x;
+				const float weight = upper_x > lower_x ? (value - lower_x) / (upper_x - lower_x) : 0.f;
+				animation_blend_poses(&(scratch->slots[node->inputs[upper - 1]]), &(scratch->slots[node->inputs[upper]]), weight, out);
+			}
+			break;
+		}
+		case ANIM_GRAPH_NODE_BLEND_2D:
+		{
+			// Ÿ   ġ ְ, ݱ տ   ϳ  .
+			const glm::vec2 point(character->parameters[node->parameters[0]], character->parameters[node->parameters[1]]);
+			float weight_sum = 0.f;
+			for (int i = 0; i < node->input_count; ++i)
+			{
+				const glm::vec2 d = point - node->positions[i];
+				const float weight = 1.f / (glm::dot(d, d) + 1e-4f);
+				weight_sum += weight;
+				const Pose* input = &(scratch->slots[node->inputs[i]]);
+				animation_blend_poses(i == 0 ? input : out, input, i == 0 ? 0.f : weight / weight_sum, out);
+			}
+			break;
+		}
+		case ANIM_GRAPH_NODE_ADDITIVE:
+		{
+			const float weight = character->parameters[node->parameters[0]];
+			animation_add_pose(&(scratch->slots[node->inputs[0]]), &(scratch->slots[node->inputs[1]]), &(graph->references[node->reference_index]), weight, out);
+			break;
+		}
+		}
+	}
+}
+
+static void animation_graph_prepare_scratch(AnimGraphScratch* scratch, const AnimGraph* graph)
+{
+	if (scratch->slots.size() == graph->nodes.size() && scratch->output.world.size() == g_animation.skeleton.parents.size())
+	{
+		return;
+	}
+	scratch->slots.resize(graph->nodes.size());
+	for (Pose& slot : scratch->slots)
+	{
+		animation_pose_resize(&(g_animation.skeleton), &slot);
+	}
+	animation_pose_resize(&(g_animation.skeleton), &(scratch->output));
+}
+
+// character pending_time ŭ ϰ pose palette .
+static void animation_graph_evaluate_character(int character_index, AnimGraphScratch* scratch)
+{
+	const AnimGraph* graph = &(g_animation_graph.graph);
+	AnimCharacter* character = &(g_animation_graph.characters[character_index]);
+
+	const float delta_time = character->pending_time;
+	character->pending_time = 0.f;
+	character->pending_frames = 0;
+	character->time = fmodf(character->time + delta_time, 3600.f);
+
+	//   parameter  ٸ ֱ õõ δ.
+	character->parameters[0] = 0.5f + 0.5f * sinf(character->time * 0.31f + character->seed);
+	character->parameters[1] = 0.5f + 0.5f * sinf(character->time * 0.17f + character->seed * 2.3f);
+	character->parameters[2] = 0.5f + 0.5f * sinf(character->time * 0.53f + character->seed * 0.7f);
+
+	Pose* output = &(scratch->output);
+	if (graph->states.empty())
+	{
+		animation_pose_resize(&(g_animation.skeleton), output);
+	}
+	else
+	{
+		character->state_time += delta_time;
+		if (character->fade_node >= 0)
+		{
+			character->fade_time += delta_time;
+			if (character->fade_time >= ANIM_GRAPH_FADE_DURATION)
+			{
+				character->fade_node = -1;
+			}
+		}
+		if (character->state_time >= character->state_duration && graph->states.size() > 1)
+		{
+			character->fade_node = graph->states[character->state_index];
+			character->fade_time = 0.f;
+			character->state_index = (character->state_index + 1) % (int)graph->states.size();
+			character->state_time = 0.f;
+		}
+
+		const int root = graph->states[character->state_index];
+		animation_graph_evaluate_node(graph, root, character, scratch);
+		if (character->fade_node >= 0)
+		{
+			//   program      Ƿ  Ű д.
+			animation_blend_poses(&(scratch->slots[root]), &(scratch->slots[root]), 0.f, output);
+			animation_graph_evaluate_node(graph, character->fade_node, character, scratch);
+			animation_blend_poses(&(scratch->slots[character->fade_node]), output, character->fade_time / ANIM_GRAPH_FADE_DURATION, output);
+		}
+		else
+		{
+			output = &(scratch->slots[root]);
+		}
+	}
+	animation_build_world_levels(&(g_animation.skeleton), output);
+
+	SkinMatrix* palettes = &(g_animation.gpu_palettes[(size_t)character_index * g_animation.palette_stride]);
+	for (const SkinnedMesh& skinned_mesh : g_animation.skinned_meshes)
+	{
+		animation_build_palette(&skinned_mesh, output, palettes + skinned_mesh.palette_base);
+	}
+}
+
+// update_indices character job  Ѵ. ɸ ð(ms) ش.
+static float animation_graph_run(int count)
+{
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	const int thread_count = g_job_system.is_init ? g_job_system.worker_count + 1 : 1;
+	for (int thread = 0; thread < thread_count; ++thread)
+	{
+		animation_graph_prepare_scratch(&(s_scratches[thread]), &(g_animation_graph.graph));
+	}
+
+	const int* indices = g_animation_graph.update_indices.data();
+	parallel_for_range(count, ANIM_GRAPH_BATCH_SIZE, [indices](int begin, int end)
+	{
+		const int thread = job_thread_index();
+		AnimGraphScratch* scratch = &(s_scratches[thread >= 0 ? thread : 0]);
+		for (int i = begin; i < end; ++i)
+		{
+			animation_graph_evaluate_character(indices[i], scratch);
+		}
+	});
+
+	return std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void animation_graph_set_defaults()
+{
+	g_animation_graph.budget_ms = 2.f;
+	g_animation_graph.lod_distance = 15.f;
+}
+
+void animation_graph_print_usage()
+{
+	printf("  --anim-budget MS            cpu time per frame for the gpu skinning characters, 0 for no limit (default %.1f)\n", g_animation_graph.budget_ms);
+	printf("  --anim-lod-distance DIST    distance between the animation update rate steps, 0 to update every frame (default %.0f)\n", g_animation_graph.lod_distance);
+	printf("  --anim-graph-bench          run the blend graph crowd benchmark without a window and exit\n");
+}
+
+bool animation_graph_parse_arg(int argc, char** argv, int* index)
+{
+	const char* arg = argv[*index];
+	if (strcmp(arg, "--anim-graph-bench") == 0)
+	{
+		g_animation.test_mode = ANIMATION_TEST_GRAPH_BENCH;
+		return true;
+	}
+	if (strcmp(arg, "--anim-budget") == 0 && *index + 1 < argc)
+	{
+		const float budget_ms = (float)atof(argv[*index + 1]);
+		if (budget_ms < 0.f)
+		{
+			return false;
+		}
+		g_animation_graph.budget_ms = budget_ms;
+		++(*index);
+		return true;
+	}
+	if (strcmp(arg, "--anim-lod-distance") == 0 && *index + 1 < argc)
+	{
+		const float lod_distance = (float)atof(argv[*index + 1]);
+		if (lod_distance < 0.f)
+		{
+			return false;
+		}
+		g_animation_graph.lod_distance = lod_distance;
+		++(*index);
+		return true;
+	}
+	return false;
+}
+
+static int animation_graph_add_clip(AnimGraph* graph, int clip_index, float speed)
+{
+	AnimGraphNode node = {};
+	node.type = ANIM_GRAPH_NODE_CLIP;
+	node.clip_index = clip_index;
+	node.speed = speed;
+	node.reference_index = -1;
+	graph->nodes.push_back(node);
+	return (int)graph->nodes.size() - 1;
+}
+
+void animation_graph_build_default()
+{
+	AnimGraph* graph = &(g_animation_graph.graph);
+	*graph = AnimGraph();
+
+	const int clip_count = (int)g_animation.clips.size();
+	if (clip_count > 0)
+	{
+		// clip ϴٸ  clip ٸ ӵ .
+		const int slow = animation_graph_add_clip(graph, 0, 0.6f);
+		const int normal = animation_graph_add_clip(graph, 0, 1.f);
+		const int fast = animation_graph_add_clip(graph, std::min(1, clip_count - 1), 1.4f);
+		const int other = animation_graph_add_clip(graph, std::min(2, clip_count - 1), 0.8f);
+
+		// parameter 0 : ӵ
+		AnimGraphNode blend_1d = {};
+		blend_1d.type = ANIM_GRAPH_NODE_BLEND_1D;
+		blend_1d.input_count = 3;
+		blend_1d.inputs[0] = slow;		blend_1d.positions[0] = glm::vec2(0.f, 0.f);
+		blend_1d.inputs[1] = normal;	blend_1d.positions[1] = glm::vec2(0.5f, 0.f);
+		blend_1d.inputs[2] = fast;		blend_1d.positions[2] = glm::vec2(1.f, 0.f);
+		blend_1d.parameters[0] = 0;
+		blend_1d.reference_index = -1;
+		graph->nodes.push_back(blend_1d);
+		const int locomotion = (int)graph->nodes.size() - 1;
+
+		// parameter 0, 1 : 
+		AnimGraphNode blend_2d = {};
+		blend_2d.type = ANIM_GRAPH_NODE_BLEND_2D;
+		blend_2d.input_count = 4;
+		blend_2d.inputs[0] = slow;		blend_2d.positions[0] = glm::vec2(0.f, 0.f);
+		blend_2d.inputs[1] = normal;	blend_2d.positions[1] = glm::vec2(1.f, 0.f);
+		blend_2d.inputs[2] = fast;		blend_2d.positions[2] = glm::vec2(0.f, 1.f);
+		blend_2d.inputs[3] = other;		blend_2d.positions[3] = glm::vec2(1.f, 1.f);
+		blend_2d.parameters[0] = 0;
+		blend_2d.parameters[1] = 1;
+		blend_2d.reference_index = -1;
+		graph->nodes.push_back(blend_2d);
+		const int strafe = (int)graph->nodes.size() - 1;
+
+		// parameter 2 : ü layer 
+		const int layer = animation_graph_add_clip(graph, clip_count - 1, 1.f);
+		AnimGraphNode additive = {};
+		additive.type = ANIM_GRAPH_NODE_ADDITIVE;
+		additive.input_count = 2;
+		additive.inputs[0] = locomotion;
+		additive.inputs[1] = layer;
+		additive.parameters[0] = 2;
+		graph->nodes.push_back(additive);
+		const int layered = (int)graph->nodes.size() - 1;
+
+		graph->states = { locomotion, strafe, layered };
+	}
+	animation_graph_finalize(graph);
+}
+
+void animation_graph_finalize(AnimGraph* graph)
+{
+	const int last_tag = memory_tag_begin(MEMORY_TAG_ANIMATION);
+
+	// Է program ڿ ڽ δ.  Է  node ٸ   ִ´.
+	const int node_count = (int)graph->nodes.size();
+	graph->programs.assign(node_count, std::vector<int>());
+	for (int i = 0; i < node_count; ++i)
+	{
+		const AnimGraphNode* node = &(graph->nodes[i]);
+		std::vector<int>* program = &(graph->programs[i]);
+		for (int input = 0; input < node->input_count; ++input)
+		{
+			assert(node->inputs[input] < i);
+			for (int input_node : graph->programs[node->inputs[input]])
+			{
+				if (std::find(program->begin(), program->end(), input_node) == program->end())
+				{
+					program->push_back(input_node);
+				}
+			}
+		}
+		program->push_back(i);
+	}
+
+	// additive Է 0 pose reference .  node Ƿ reference ٸ additive ĵ ȴ.
+	graph->references.clear();
+	AnimGraphScratch* scratch = &(s_scratches[0]);
+	scratch->slots.clear();
+	animation_graph_prepare_scratch(scratch, graph);
+	AnimCharacter character = {};
+	for (int i = 0; i < node_count; ++i)
+	{
+		AnimGraphNode* node = &(graph->nodes[i]);
+		if (node->type != ANIM_GRAPH_NODE_ADDITIVE)
+		{
+			continue;
+		}
+		animation_graph_evaluate_node(graph, node->inputs[1], &character, scratch);
+		node->reference_index = (int)graph->references.size();
+		graph->references.push_back(scratch->slots[node->inputs[1]]);
+	}
+
+	memory_tag_end(last_tag);
+}
+
+void animation_graph_terminate()
+{
+	g_animation_graph.graph = AnimGraph();
+	g_animation_graph.characters.clear();
+	g_animation_graph.characters.shrink_to_fit();
+	g_animation_graph.positions.clear();
+	g_animation_graph.positions.shrink_to_fit();
+	g_animation_graph.update_indices.clear();
+	g_animation_graph.update_indices.shrink_to_fit();
+	for (AnimGraphScratch& scratch : s_scratches)
+	{
+		scratch = AnimGraphScratch();
+	}
+}
+
+void animation_graph_resize(int character_count)
+{
+	const int last_tag = memory_tag_begin(MEMORY_TAG_ANIMATION);
+
+	const int old_count = (int)g_animation_graph.characters.size();
+	g_animation_graph.characters.resize(character_count);
+	const int state_count = std::max(1, (int)g_animation_graph.graph.states.size());
+	for (int i = old_count; i < character_count; ++i)
+	{
+		// ̿ character ٸ ̵ , ,  ʸ ش.
+		AnimCharacter* character = &(g_animation_graph.characters[i]);
+		*character = AnimCharacter();
+		character->seed = (float)((i * 2654435761u) & 0xFFFF) / 65535.f * 6.28f;
+		character->time = character->seed;
+		character->state_index = i % state_count;
+		character->state_duration = 3.f + character->seed;
+		character->fade_node = -1;
+		character->pending_frames = i % ANIM_GRAPH_STAGGER_FRAMES;
+	}
+	g_animation_graph.update_indices.resize(character_count);
+	g_animation.gpu_palettes.resize((size_t)character_count * g_animation.palette_stride);
+	g_animation_graph.cursor = 0;
+
+	memory_tag_end(last_tag);
+}
+
+void animation_graph_set_positions(const glm::vec3* positions, int count)
+{
+	const int last_tag = memory_tag_begin(MEMORY_TAG_ANIMATION);
+	g_animation_graph.positions.assign(positions, positions + count);
+	memory_tag_end(last_tag);
+}
+
+bool animation_graph_update(float delta_time, const glm::vec3& camera_position)
+{
+	const int character_count = (int)g_animation_graph.characters.size();
+	const int position_count = (int)g_animation_graph.positions.size();
+
+	// Ÿ LOD ϰ, LOD ݸŭ frame  character  ʷ .
+	memset(g_animation_graph.lod_counts, 0, sizeof(g_animation_graph.lod_counts));
+	for (int i = 0; i < character_count; ++i)
+	{
+		AnimCharacter* character = &(g_animation_graph.characters[i]);
+		character->pending_time += delta_time;
+		++character->pending_frames;
+
+		int lod = 0;
+		if (g_animation_graph.lod_distance > 0.f && i < position_count)
+		{
+			const float distance = glm::length(g_animation_graph.positions[i] - camera_position);
+			lod = std::min((int)(distance / g_animation_graph.lod_distance), ANIM_GRAPH_LOD_COUNT - 1);
+		}
+		character->lod = lod;
+		++g_animation_graph.lod_counts[lod];
+	}
+
+	//   budget ȿ   Ѵ. ó  𸣹Ƿ  Ѵ.
+	int max_update_count = character_count;
+	if (g_animation_graph.budget_ms > 0.f && g_animation_graph.character_cost_ms > 0.f)
+	{
+		const int budget_count = (int)(g_animation_graph.budget_ms / g_animation_graph.character_cost_ms);
+		max_update_count = std::min(character_count, std::max(ANIM_GRAPH_BATCH_SIZE, budget_count));
+	}
+
+	//    ư Ƿ и character  и ʴ´.
+	int update_count = 0;
+	int due_count = 0;
+	int next_cursor = g_animation_graph.cursor;
+	for (int n = 0; n < character_count; ++n)
+	{
+		const int i = (g_animation_graph.cursor + n) % character_count;
+		const AnimCharacter* character = &(g_animation_graph.characters[i]);
+		if (character->pending_frames < (1 << character->lod))
+		{
+			continue;
+		}
+		++due_count;
+		if (update_count < max_update_count)
+		{
+			g_animation_graph.update_indices[update_count++] = i;
+			next_cursor = (i + 1) % character_count;
+		}
+	}
+	g_animation_graph.cursor = next_cursor;
+	g_animation_graph.due_count = due_count;
+	g_animation_graph.update_count = update_count;
+	g_animation_graph.max_update_count = max_update_count;
+	g_animation_graph.deferred_count = due_count - update_count;
+
+	if (update_count == 0)
+	{
+		g_animation_graph.update_ms = 0.f;
+		return false;
+	}
+
+	const float update_ms = animation_graph_run(update_count);
+	const float cost_ms = update_ms / update_count;
+	g_animation_graph.character_cost_ms = g_animation_graph.character_cost_ms > 0.f ? g_animation_graph.character_cost_ms * 0.9f + cost_ms * 0.1f : cost_ms;
+	g_animation_graph.update_ms = update_ms;
+	return true;
+}
+
+void animation_graph_evaluate_all()
+{
+	const int character_count = (int)g_animation_graph.characters.size();
+	for (int i = 0; i < character_count; ++i)
+	{
+		g_animation_graph.update_indices[i] = i;
+	}
+	g_animation_graph.update_ms = animation_graph_run(character_count);
+	g_animation_graph.update_count = character_count;
+
+	//  frame  Ƿ  character Ѳ ʰ  ʵ ٽ  ´.
+	for (int i = 0; i < character_count; ++i)
+	{
+		g_animation_graph.characters[i].pending_frames = i % ANIM_GRAPH_STAGGER_FRAMES;
+	}
+}
+
+// out_min_max_update_count : warmup  budget  frame       
+static float animation_graph_bench_run(int frame_count, float* out_max_ms, float* out_average_update_count, int* out_min_max_update_count)
+{
+	constexpr int WARMUP_FRAME_COUNT = 30;
+	constexpr float DELTA_TIME = 1.f / 60.f;
+
+	float total_ms = 0.f;
+	float max_ms = 0.f;
+	float total_update_count = 0.f;
+	int min_max_update_count = (int)g_animation_graph.characters.size();
+
+	//     ʸ ٽ   Ѵ.
+	animation_graph_evaluate_all();
+	for (int frame = 0; frame < WARMUP_FRAME_COUNT + frame_count; ++frame)
+	{
+		animation_graph_update(DELTA_TIME, glm::vec3(0.f));
+		min_max_update_count = std::min(min_max_update_count, g_animation_graph.max_update_count);
+		if (frame >= WARMUP_FRAME_COUNT)
+		{
+			total_ms += g_animation_graph.update_ms;
+			max_ms = std::max(max_ms, g_animation_graph.update_ms);
+			total_update_count += (float)g_animation_graph.update_count;
+		}
+	}
+	*out_max_ms = max_ms;
+	*out_average_update_count = total_update_count / frame_count;
+	*out_min_max_update_count = min_max_update_count;
+	return total_ms / frame_count;
+}
+
+bool animation_graph_run_bench()
+{
+	constexpr float MAX_BLEND_ERROR = 1e-5f;
+
+	// ռ clip skeleton ĳó   ٲ۴.
+	g_animation = Animation();
+	g_animation.clips.resize(1);
+	animation_bench_make_clip(&(g_animation.skeleton), &(g_animation.clips[0]));
+	const int node_count = (int)g_animation.skeleton.parents.size();
+	for (int node = 1; node < node_count; ++node)
+	{
+		g_animation.skeleton.parents[node] = (node - 1) / 2;
+	}
+	animation_build_levels(&(g_animation.skeleton));
+
+	g_animation.is_use_baked_clips = true;
+	g_animation.baked_clips.resize(1);
+	baked_clip_bake(&(g_animation.clips[0]), &(g_animation.skeleton), &(g_animation.baked_clips[0]));
+
+	SkinnedMesh skinned_mesh = {};
+	skinned_mesh.mesh_node_index = 0;
+	for (int node = 0; node < node_count; ++node)
+	{
+		skinned_mesh.bone_nodes.push_back(node);
+		skinned_mesh.bone_offsets.push_back(glm::mat4(1.f));
+	}
+	skinned_mesh.palette_base = 0;
+	g_animation.skinned_meshes.push_back(skinned_mesh);
+	g_animation.palette_stride = (unsigned)node_count;
+	g_animation.skinning_mode = SKINNING_MODE_GPU;
+
+	// SSE blend scalar blend  pose Ѵ.
+	Pose a, b, simd, scalar;
+	animation_pose_resize(&(g_animation.skeleton), &a);
+	animation_pose_resize(&(g_animation.skeleton), &b);
+	animation_pose_resize(&(g_animation.skeleton), &simd);
+	animation_pose_resize(&(g_animation.skeleton), &scalar);
+	animation_sample_clip(&(g_animation.clips[0]), 1.3f, &(g_animation.skeleton), &a);
+	animation_sample_clip(&(g_animation.clips[0]), 17.9f, &(g_animation.skeleton), &b);
+	float max_blend_error = 0.f;
+	for (float weight = 0.f; weight <= 1.f; weight += 0.125f)
+	{
+		animation_blend_poses(&a, &b, weight, &simd);
+		animation_blend_poses_scalar(&a, &b, weight, &scalar);
+		for (int node = 0; node < node_count; ++node)
+		{
+			for (int c = 0; c < 4; ++c)
+			{
+				max_blend_error = std::max(max_blend_error, fabsf(simd.rotations[node][c] - scalar.rotations[node][c]));
+			}
+			for (int c = 0; c < 3; ++c)
+			{
+				max_blend_error = std::max(max_blend_error, fabsf(simd.positions[node][c] - scalar.positions[node][c]));
+			}
+		}
+
+		// additive a reference b ̸ b  Ѵ.
+		animation_add_pose(&b, &b, &a, weight, &simd);
+		for (int node = 0; node < node_count; ++node)
+		{
+			const glm::quat delta = animation_nlerp(glm::quat(1.f, 0.f, 0.f, 0.f), glm::conjugate(a.rotations[node]) * b.rotations[node], weight);
+			const glm::quat expected = b.rotations[node] * delta;
+			const float sign = glm::dot(expected, simd.rotations[node]) < 0.f ? -1.f : 1.f;
+			for (int c = 0; c < 4; ++c)
+			{
+				max_blend_error = std::max(max_blend_error, fabsf(simd.rotations[node][c] * sign - expected[c]));
+			}
+		}
+	}
+
+	job_system_init(g_job_system.requested_worker_count);
+
+	// camera   grid
+	const int character_count = ANIM_GRAPH_BENCH_CHARACTER_COUNT;
+	const int grid_side = (int)ceil(sqrt((double)character_count));
+	const float spacing = 2.f;
+	std::vector<glm::vec3> positions(character_count);
+	for (int i = 0; i < character_count; ++i)
+	{
+		positions[i] = glm::vec3(((i % grid_side) - (grid_side - 1) * 0.5f) * spacing, 0.f, ((i / grid_side) - (grid_side - 1) * 0.5f) * spacing);
+	}
+
+	animation_graph_build_default();
+	animation_graph_resize(character_count);
+	animation_graph_set_positions(positions.data(), character_count);
+
+	printf("Animation graph bench : %d characters, %d nodes, %d graph nodes, %d threads\n", character_count, node_count,
+		(int)g_animation_graph.graph.nodes.size(), g_job_system.worker_count + 1);
+	printf("  mode                   budget ms   avg ms   max ms   updates/frame\n");
+
+	//   frame   
+	const float budget_ms = g_animation_graph.budget_ms;
+	const float lod_distance = g_animation_graph.lod_distance;
+	float max_ms = 0.f;
+	float update_count = 0.f;
+	int min_max_update_count = 0;
+	g_animation_graph.budget_ms = 0.f;
+	g_animation_graph.lod_distance = 0.f;
+	float average_ms = animation_graph_bench_run(ANIM_GRAPH_BENCH_FRAME_COUNT, &max_ms, &update_count, &min_max_update_count);
+	printf("  every frame           %10s %8.3f %8.3f %15.0f\n", "-", average_ms, max_ms, update_count);
+
+	g_animation_graph.lod_distance = lod_distance;
+	average_ms = animation_graph_bench_run(ANIM_GRAPH_BENCH_FRAME_COUNT, &max_ms, &update_count, &min_max_update_count);
+	printf("  lod                   %10s %8.3f %8.3f %15.0f\n", "-", average_ms, max_ms, update_count);
+
+	g_animation_graph.budget_ms = budget_ms;
+	average_ms = animation_graph_bench_run(ANIM_GRAPH_BENCH_FRAME_COUNT, &max_ms, &update_count, &min_max_update_count);
+	printf("  lod + budget          %10.2f %8.3f %8.3f %15.0f\n", budget_ms, average_ms, max_ms, update_count);
+	printf("  lod characters : %d / %d / %d / %d\n", g_animation_graph.lod_counts[0], g_animation_graph.lod_counts[1],
+		g_animation_graph.lod_counts[2], g_animation_graph.lod_counts[3]);
+
+	job_system_terminate();
+
+	// budget  и character  Ǿ Ѵ.
+	// ư Ƿ frame  min_max_update_count  cursor ,   LOD ݸŭ  ٸ  ִ.
+	// ( machine̳ debug build  frame  batch Ƿ  ó Ѵ.)
+	const int max_pending_frames_limit = (character_count + min_max_update_count - 1) / min_max_update_count + ANIM_GRAPH_STAGGER_FRAMES;
+	int max_pending_frames = 0;
+	for (const AnimCharacter& character : g_animation_graph.characters)
+	{
+		max_pending_frames = std::max(max_pending_frames, character.pending_frames);
+	}
+
+	// budget  . ù   𸣹Ƿ    ְ,  batch budget Ѵ ׻ Ѵ.
+	const float batch_ms = ANIM_GRAPH_BATCH_SIZE * g_animation_graph.character_cost_ms;
+	const bool is_in_budget = budget_ms <= 0.f || average_ms <= std::max(budget_ms, batch_ms) * 1.25f;
+	const bool is_success = max_blend_error <= MAX_BLEND_ERROR && max_pending_frames <= max_pending_frames_limit && is_in_budget;
+	printf("Animation graph bench %s : max blend error %g, max pending frames %d (limit %d)\n", is_success ? "passed" : "FAILED",
+		max_blend_error, max_pending_frames, max_pending_frames_limit);
+
+	animation_graph_terminate();
+	return is_success;
+}
+
+void animation_graph_draw_gui()
+{
+	ImGui::Text("Animation Budget"); ImGui::SameLine();
+	ImGui::DragFloat("##AnimationBudget", &g_animation_graph.budget_ms, 0.05f, 0.f, 16.f, "%.2f ms");
+
+	ImGui::Text("Animation LOD Distance"); ImGui::SameLine();
+	ImGui::DragFloat("##AnimationLODDistance", &g_animation_graph.lod_distance, 0.5f, 0.f, 200.f, "%.1f");
+
+	ImGui::Text("Graph %.3f ms, %d / %d due characters (%d deferred), %.2f us each", g_animation_graph.update_ms,
+		g_animation_graph.update_count, g_animation_graph.due_count, g_animation_graph.deferred_count, g_animation_graph.character_cost_ms * 1000.f);
+	ImGui::Text("LOD characters %d / %d / %d / %d", g_animation_graph.lod_counts[0], g_animation_graph.lod_counts[1],
+		g_animation_graph.lod_counts[2], g_animation_graph.lod_counts[3]);
+}
@@ -0,0 +1,176 @@
+#ifndef __ANIMATION_GRAPH_H__
+#define __ANIMATION_GRAPH_H__
+
+#include <stdint.h>
+#include <vector>
+
+#include "glm/glm.hpp"
+
+#include "animation.h"
+
+// character  ٸ parameter ϴ animation blend graph.
+// AnimGraph : node 迭. Է ׻ ڽź տ ִ nodḛ, node root    node (program) ̸  д.
+//   CLIP     : clip ϳ speed  sampling
+//   BLEND_1D : parameter ϳ     Է ´. (position.x )
+//   BLEND_2D : parameter    Էµ position Ÿ  ġ ´.
+//   ADDITIVE : base (additive - reference)  weight parameter ŭ Ѵ. reference additive Է 0 pose.
+// AnimCharacter : ð, parameter,  (root node). ¸ ٲٸ  ¿ fade_duration  crossfade Ѵ.
+// pose  SSE quaternion 4 nlerp ϰ, world  (Skeleton::level_order) .
+//  character ANIM_GRAPH_BATCH_SIZE  job  pose palette(Animation::gpu_palettes) .
+// camera ּ 1, 2, 4, 8 frame   ϰ(LOD), ǳʶ ð  꿡 Ƽ Ѵ.
+//  frame  character    character   budget_ms ȿ  ϰ,
+// и character ư  frame  Ѵ.
+//  :
+//   animation_graph_build_default();		// ҷ clip graph .
+//   animation_graph_set_positions(positions, count);
+//   animation_graph_update(delta_time, camera_position);
+//
+// command line : [--anim-budget MS] [--anim-lod-distance DISTANCE] [--anim-graph-bench]
+
+constexpr int ANIM_GRAPH_MAX_INPUTS = 8;
+constexpr int ANIM_GRAPH_MAX_PARAMETERS = 4;
+constexpr int ANIM_GRAPH_LOD_COUNT = 4;
+constexpr int ANIM_GRAPH_BATCH_SIZE = 16;
+constexpr float ANIM_GRAPH_FADE_DURATION = 0.4f;
+
+//   LOD . character  ʸ  frame  ȿ  ´.
+constexpr int ANIM_GRAPH_STAGGER_FRAMES = 1 << (ANIM_GRAPH_LOD_COUNT - 1);
+
+// --anim-graph-bench character  frame 
+constexpr int ANIM_GRAPH_BENCH_CHARACTER_COUNT = 4096;
+constexpr int ANIM_GRAPH_BENCH_FRAME_COUNT = 240;
+
+enum AnimGraphNodeType
+{
+	ANIM_GRAPH_NODE_CLIP = 0,
+	ANIM_GRAPH_NODE_BLEND_1D,
+	ANIM_GRAPH_NODE_BLEND_2D,
+	ANIM_GRAPH_NODE_ADDITIVE,
+};
+
+struct AnimGraphNode
+{
+	int type;
+
+	// CLIP
+	int clip_index;
+	float speed;
+
+	// BLEND :  node, ADDITIVE : [0] base, [1] additive
+	int input_count;
+	int inputs[ANIM_GRAPH_MAX_INPUTS];
+	glm::vec2 positions[ANIM_GRAPH_MAX_INPUTS];
+
+	// BLEND_1D : [0], BLEND_2D : [0] [1], ADDITIVE : [0] weight
+	int parameters[2];
+
+	// ADDITIVE reference pose. AnimGraph::references index
+	int reference_index;
+};
+
+struct AnimGraph
+{
+	std::vector<AnimGraphNode> nodes;
+
+	// node i root    node (Է տ  )
+	std::vector<std::vector<int>> programs;
+
+	std::vector<Pose> references;
+
+	// character ư  root node
+	std::vector<int> states;
+};
+
+struct AnimCharacter
+{
+	float time;
+	float parameters[ANIM_GRAPH_MAX_PARAMETERS];
+
+	//  ¿  · ٲ ð
+	int state_index;
+	float state_time;
+	float state_duration;
+
+	// crossfade ̶   root node, ƴ϶ -1
+	int fade_node;
+	float fade_time;
+
+	//     ð frame 
+	float pending_time;
+	int pending_frames;
+	int lod;
+
+	// parameter ̴ 
+	float seed;
+};
+
+struct AnimationGraph
+{
+	AnimGraph graph;
+	std::vector<AnimCharacter> characters;
+
+	// world ġ. ٸ camera Ÿ 0 .
+	std::vector<glm::vec3> positions;
+
+	// option
+	float budget_ms;		// 0̶  
+	float lod_distance;		//  Ÿ LOD ϳ ö󰣴. 0̶ LOD 
+
+	//  frame   character
+	int cursor;
+
+	// ̹ frame  character
+	std::vector<int> update_indices;
+
+	// character ϳ  (ms) ̵ 
+	float character_cost_ms;
+
+	//  (GUI)
+	float update_ms;
+	int update_count;
+	int max_update_count;	// budget  ̹ frame ִ  
+	int due_count;
+	int deferred_count;
+	int lod_counts[ANIM_GRAPH_LOD_COUNT];
+};
+extern AnimationGraph g_animation_graph;
+
+void animation_graph_set_defaults();
+void animation_graph_print_usage();
+
+// argv[*index] animation graph ɼ̶  а index ű  true ش.
+bool animation_graph_parse_arg(int argc, char** argv, int* index);
+
+// g_animation clip 1D/2D blend space additive layer  ⺻ graph . (animation_init)
+void animation_graph_build_default();
+void animation_graph_terminate();
+
+// graph ٲ  program reference pose ٽ .
+void animation_graph_finalize(AnimGraph* graph);
+
+// character  ٲ۴.  character index   ¿ Ѵ.
+void animation_graph_resize(int character_count);
+void animation_graph_set_positions(const glm::vec3* positions, int count);
+
+//   character budget ȿ  gpu_palettes ä. ϳ ߴٸ true.
+bool animation_graph_update(float delta_time, const glm::vec3& camera_position);
+
+// LOD budget ϰ  character  ð ٽ Ѵ.
+void animation_graph_evaluate_all();
+
+// out = nlerp(a, b, weight). SSE rotation 4 Ѵ. out a b Ƶ ȴ.
+void animation_blend_poses(const Pose* a, const Pose* b, float weight, Pose* out);
+void animation_blend_poses_scalar(const Pose* a, const Pose* b, float weight, Pose* out);
+
+// out = base + (additive - reference) * weight. rotation base * nlerp(identity, conj(reference) * additive, weight)
+void animation_add_pose(const Pose* base, const Pose* additive, const Pose* reference, float weight, Pose* out);
+
+// skeleton level_order world .   node   ʴ´.
+void animation_build_world_levels(const Skeleton* skeleton, Pose* pose);
+
+// --anim-graph-bench. â̳ GL context  ռ skeleton clip budget ȿ  character ϴ ϰ .
+bool animation_graph_run_bench();
+
+void animation_graph_draw_gui();
+
+#endif
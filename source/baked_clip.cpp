@@ -0,0 +1,781 @@
+#include "baked_clip.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <assert.h>
+#include <algorithm>
+
+#include "animation.h"
+#include "utility.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define BAKED_CLIP_SSE 1
+#include <emmintrin.h>
+#else
+#define BAKED_CLIP_SSE 0
+#endif
+
+// cache  header.  ٲ version ÷   .
+struct BakedClipHeader
+{
+	uint32_t magic;
+	uint32_t version;
+	uint64_t key;
+};
+constexpr uint32_t BAKED_CLIP_MAGIC = 0x31504C43; // "CLP1"
+constexpr uint32_t BAKED_CLIP_VERSION = 1;
+
+// Ͽ  vector ũ .  Ϸ ū Ҵ  ʵ Ѵ.
+constexpr uint32_t BAKED_CLIP_MAX_VECTOR_COUNT = 1u << 26;
+
+// smallest-three  [-1/sqrt(2), 1/sqrt(2)] ȿ Ƿ   15bit .
+constexpr float QUAT_COMPONENT_MAX = 0.70710678f;
+constexpr float QUAT_QUANTIZE_SCALE = 32767.f / (2.f * QUAT_COMPONENT_MAX);
+constexpr float QUAT_DEQUANTIZE_SCALE = (2.f * QUAT_COMPONENT_MAX) / 32767.f;
+
+// FNV-1a 64bit
+constexpr uint64_t FNV_OFFSET_BASIS = 14695981039346656037ull;
+constexpr uint64_t FNV_PRIME = 1099511628211ull;
+
+static uint64_t hash_bytes(uint64_t hash, const void* data, size_t size)
+{
+	const uint8_t* bytes = (const uint8_t*)data;
+	for (size_t i = 0; i < size; ++i)
+	{
+		hash ^= bytes[i];
+		hash *= FNV_PRIME;
+	}
+	return hash;
+}
+
+template <typename T>
+static uint64_t hash_vector(uint64_t hash, const std::vector<T>& values)
+{
+	const uint64_t count = values.size();
+	hash = hash_bytes(hash, &count, sizeof(count));
+	return hash_bytes(hash, values.data(), sizeof(T) * values.size());
+}
+
+size_t animation_clip_memory_bytes(const AnimationClip* clip)
+{
+	return sizeof(AnimationTrack) * clip->tracks.size() +
+		sizeof(float) * (clip->position_times.size() + clip->rotation_times.size() + clip->scale_times.size()) +
+		sizeof(glm::vec3) * (clip->positions.size() + clip->scales.size()) +
+		sizeof(glm::quat) * clip->rotations.size();
+}
+
+size_t baked_clip_memory_bytes(const BakedClip* baked)
+{
+	size_t bytes = sizeof(glm::vec3) * (baked->base_positions.size() + baked->base_scales.size()) +
+		sizeof(glm::quat) * baked->base_rotations.size();
+	for (const BakedClipGroup& group : baked->groups)
+	{
+		bytes += sizeof(BakedClipGroup) + sizeof(uint16_t) * (group.nodes.size() + group.data.size()) +
+			sizeof(float) * (group.range_min.size() + group.range_scale.size());
+	}
+	return bytes;
+}
+
+// rotation (x, y, z, w) vec4 ٷ.
+static void quantize_rotation(const glm::vec4& q, uint16_t* a, uint16_t* b, uint16_t* c)
+{
+	int largest = 0;
+	for (int i = 1; i < 4; ++i)
+	{
+		if (fabsf(q[i]) > fabsf(q[largest]))
+		{
+			largest = i;
+		}
+	}
+
+	// q -q  ȸ̹Ƿ    ǵ ȣ .
+	const float sign = q[largest] < 0.f ? -1.f : 1.f;
+	uint16_t out[3];
+	int out_index = 0;
+	for (int i = 0; i < 4; ++i)
+	{
+		if (i == largest)
+		{
+			continue;
+		}
+		const float value = std::min(std::max(q[i] * sign, -QUAT_COMPONENT_MAX), QUAT_COMPONENT_MAX);
+		out[out_index++] = (uint16_t)lroundf((value + QUAT_COMPONENT_MAX) * QUAT_QUANTIZE_SCALE);
+	}
+
+	*a = (uint16_t)(out[0] | ((largest & 1) << 15));
+	*b = (uint16_t)(out[1] | ((largest >> 1) << 15));
+	*c = out[2];
+}
+
+static glm::vec4 dequantize_rotation(uint16_t a, uint16_t b, uint16_t c)
+{
+	const int largest = (a >> 15) | ((b >> 15) << 1);
+	const float small[3] =
+	{
+		(float)(a & 0x7FFF) * QUAT_DEQUANTIZE_SCALE - QUAT_COMPONENT_MAX,
+		(float)(b & 0x7FFF) * QUAT_DEQUANTIZE_SCALE - QUAT_COMPONENT_MAX,
+		(float)(c & 0x7FFF) * QUAT_DEQUANTIZE_SCALE - QUAT_COMPONENT_MAX,
+	};
+	const float d = sqrtf(std::max(1.f - small[0] * small[0] - small[1] * small[1] - small[2] * small[2], 0.f));
+
+	glm::vec4 q;
+	int in_index = 0;
+	for (int i = 0; i < 4; ++i)
+	{
+		q[i] = i == largest ? d : small[in_index++];
+	}
+	return q;
+}
+
+static glm::vec4 baked_nlerp(const glm::vec4& a, glm::vec4 b, float t)
+{
+	if (glm::dot(a, b) < 0.f)
+	{
+		b = -b;
+	}
+	return glm::normalize(a + (b - a) * t);
+}
+
+static float baked_max_difference(const glm::vec4& a, const glm::vec4& b)
+{
+	const glm::vec4 d = glm::abs(a - b);
+	return std::max(std::max(d.x, d.y), std::max(d.z, d.w));
+}
+
+//   track ϳ key
+struct BakedTrackKeys
+{
+	int node;
+	std::vector<uint16_t> keys;	// key_count * 3
+	float range_min[3];
+	float range_scale[3];
+};
+
+static unsigned baked_key_count(unsigned frame_count, unsigned stride)
+{
+	return (frame_count - 1 + stride - 1) / stride + 1;
+}
+
+static glm::vec4 baked_decode_key(int channel, const BakedTrackKeys& track, unsigned key)
+{
+	const uint16_t* q = &(track.keys[key * 3]);
+	if (channel == BAKED_CHANNEL_ROTATION)
+	{
+		return dequantize_rotation(q[0], q[1], q[2]);
+	}
+	return glm::vec4(track.range_min[0] + (float)q[0] * track.range_scale[0],
+					 track.range_min[1] + (float)q[1] * track.range_scale[1],
+					 track.range_min[2] + (float)q[2] * track.range_scale[2], 0.f);
+}
+
+// dense  frame   ̴. stride key ̾ ȭϰ,  dense ġ ִ  ش.
+static float baked_build_track(int channel, const std::vector<glm::vec4>& dense, unsigned frame_count, unsigned stride, BakedTrackKeys* track)
+{
+	const unsigned key_count = baked_key_count(frame_count, stride);
+	track->keys.resize(key_count * 3);
+
+	if (channel != BAKED_CHANNEL_ROTATION)
+	{
+		glm::vec4 value_min = dense[0];
+		glm::vec4 value_max = dense[0];
+		for (const glm::vec4& value : dense)
+		{
+			value_min = glm::min(value_min, value);
+			value_max = glm::max(value_max, value);
+		}
+		for (int c = 0; c < 3; ++c)
+		{
+			track->range_min[c] = value_min[c];
+			track->range_scale[c] = (value_max[c] - value_min[c]) / 65535.f;
+		}
+	}
+
+	for (unsigned key = 0; key < key_count; ++key)
+	{
+		//  key clip  frame δ.
+		const glm::vec4& value = dense[std::min(key * stride, frame_count - 1) * 2];
+		uint16_t* q = &(track->keys[key * 3]);
+		if (channel == BAKED_CHANNEL_ROTATION)
+		{
+			quantize_rotation(value, &q[0], &q[1], &q[2]);
+		}
+		else
+		{
+			for (int c = 0; c < 3; ++c)
+			{
+				q[c] = track->range_scale[c] > 0.f ? (uint16_t)lroundf((value[c] - track->range_min[c]) / track->range_scale[c]) : 0;
+			}
+		}
+	}
+
+	float max_error = 0.f;
+	const unsigned dense_count = (unsigned)dense.size();
+	for (unsigned h = 0; h < dense_count; ++h)
+	{
+		const float key_position = (float)h * 0.5f / (float)stride;
+		const unsigned key0 = std::min((unsigned)key_position, key_count - 1);
+		const unsigned key1 = std::min(key0 + 1, key_count - 1);
+		const float alpha = key_position - (float)key0;
+
+		const glm::vec4 value0 = baked_decode_key(channel, *track, key0);
+		const glm::vec4 value1 = baked_decode_key(channel, *track, key1);
+		glm::vec4 value;
+		if (channel == BAKED_CHANNEL_ROTATION)
+		{
+			value = baked_nlerp(value0, value1, alpha);
+			if (glm::dot(value, dense[h]) < 0.f)
+			{
+				value = -value;
+			}
+		}
+		else
+		{
+			value = value0 + (value1 - value0) * alpha;
+		}
+		max_error = std::max(max_error, baked_max_difference(value, dense[h]));
+	}
+	return max_error;
+}
+
+void baked_clip_bake(const AnimationClip* clip, const Skeleton* skeleton, BakedClip* baked)
+{
+	const float tolerances[BAKED_CHANNEL_COUNT] = { BAKED_CLIP_ROTATION_TOLERANCE, BAKED_CLIP_TRANSLATION_TOLERANCE, BAKED_CLIP_SCALE_TOLERANCE };
+
+	baked->duration = clip->duration;
+	baked->frame_count = (unsigned)ceilf(clip->duration * BAKED_CLIP_SAMPLE_RATE) + 1;
+	baked->base_positions = skeleton->bind_positions;
+	baked->base_rotations = skeleton->bind_rotations;
+	baked->base_scales = skeleton->bind_scales;
+	baked->groups.clear();
+	baked->source_bytes = animation_clip_memory_bytes(clip);
+	for (int channel = 0; channel < BAKED_CHANNEL_COUNT; ++channel)
+	{
+		baked->max_error[channel] = 0.f;
+	}
+	baked->animated_track_count = 0;
+	baked->constant_track_count = 0;
+	baked->is_from_cache = false;
+
+	// channel stride level  group  track .
+	std::vector<BakedTrackKeys> pending[BAKED_CHANNEL_COUNT][BAKED_CLIP_MAX_STRIDE_LEVEL + 1];
+
+	// key frame      frame   sampling Ѵ.
+	const unsigned dense_count = baked->frame_count * 2 - 1;
+	std::vector<glm::vec4> dense(dense_count);
+	for (const AnimationTrack& track : clip->tracks)
+	{
+		for (int channel = 0; channel < BAKED_CHANNEL_COUNT; ++channel)
+		{
+			const unsigned key_count = channel == BAKED_CHANNEL_ROTATION ? track.rotation_count :
+				(channel == BAKED_CHANNEL_TRANSLATION ? track.position_count : track.scale_count);
+			if (key_count == 0)
+			{
+				continue;
+			}
+
+			for (unsigned h = 0; h < dense_count; ++h)
+			{
+				const float time = std::min((float)h * 0.5f / BAKED_CLIP_SAMPLE_RATE, clip->duration);
+				if (channel == BAKED_CHANNEL_ROTATION)
+				{
+					const glm::quat q = animation_sample_quat(&(clip->rotation_times[track.rotation_begin]),
+						&(clip->rotations[track.rotation_begin]), key_count, time);
+					dense[h] = glm::normalize(glm::vec4(q.x, q.y, q.z, q.w));
+
+					// ̿   ݱ ξ   񱳰 ´.
+					if (h > 0 && glm::dot(dense[h], dense[h - 1]) < 0.f)
+					{
+						dense[h] = -dense[h];
+					}
+				}
+				else if (channel == BAKED_CHANNEL_TRANSLATION)
+				{
+					dense[h] = glm::vec4(animation_sample_vec3(&(clip->position_times[track.position_begin]),
+						&(clip->positions[track.position_begin]), key_count, time), 0.f);
+				}
+				else
+				{
+					dense[h] = glm::vec4(animation_sample_vec3(&(clip->scale_times[track.scale_begin]),
+						&(clip->scales[track.scale_begin]), key_count, time), 0.f);
+				}
+			}
+
+			//   ȿ  ʴ´ٸ base  ϳ ϴ.
+			float constant_error = 0.f;
+			for (const glm::vec4& value : dense)
+			{
+				constant_error = std::max(constant_error, baked_max_difference(value, dense[0]));
+			}
+			if (constant_error <= tolerances[channel])
+			{
+				const glm::vec4& value = dense[0];
+				if (channel == BAKED_CHANNEL_ROTATION)
+				{
+					baked->base_rotations[track.node_index] = glm::quat(value.w, value.x, value.y, value.z);
+				}
+				else if (channel == BAKED_CHANNEL_TRANSLATION)
+				{
+					baked->base_positions[track.node_index] = glm::vec3(value);
+				}
+				else
+				{
+					baked->base_scales[track.node_index] = glm::vec3(value);
+				}
+				baked->max_error[channel] = std::max(baked->max_error[channel], constant_error);
+				++baked->constant_track_count;
+				continue;
+			}
+
+			// ū stride ȭ      . stride 1 Ѵ´ٸ stride 1 .
+			BakedTrackKeys keys;
+			keys.node = track.node_index;
+			int level = BAKED_CLIP_MAX_STRIDE_LEVEL;
+			for (; level >= 0; --level)
+			{
+				const float error = baked_build_track(channel, dense, baked->frame_count, 1u << level, &keys);
+				if (error <= tolerances[channel] || level == 0)
+				{
+					baked->max_error[channel] = std::max(baked->max_error[channel], error);
+					break;
+				}
+			}
+			pending[channel][level].push_back(std::move(keys));
+			++baked->animated_track_count;
+		}
+	}
+
+	for (int channel = 0; channel < BAKED_CHANNEL_COUNT; ++channel)
+	{
+		for (int level = 0; level <= BAKED_CLIP_MAX_STRIDE_LEVEL; ++level)
+		{
+			const std::vector<BakedTrackKeys>& tracks = pending[channel][level];
+			if (tracks.empty())
+			{
+				continue;
+			}
+
+			baked->groups.emplace_back();
+			BakedClipGroup* group = &(baked->groups.back());
+			group->channel = channel;
+			group->stride = 1u << level;
+			group->key_count = baked_key_count(baked->frame_count, group->stride);
+			group->track_count = (unsigned)tracks.size();
+			group->lane_count = (group->track_count + 3) & ~3u;
+			group->nodes.assign(group->lane_count, 0);
+			group->data.assign((size_t)group->key_count * 3 * group->lane_count, 0);
+			group->range_min.assign(3 * group->lane_count, 0.f);
+			group->range_scale.assign(3 * group->lane_count, 0.f);
+
+			for (unsigned t = 0; t < group->track_count; ++t)
+			{
+				group->nodes[t] = (uint16_t)tracks[t].node;
+				for (unsigned key = 0; key < group->key_count; ++key)
+				{
+					for (int c = 0; c < 3; ++c)
+					{
+						group->data[(key * 3 + c) * group->lane_count + t] = tracks[t].keys[key * 3 + c];
+					}
+				}
+				if (channel != BAKED_CHANNEL_ROTATION)
+				{
+					for (int c = 0; c < 3; ++c)
+					{
+						group->range_min[c * group->lane_count + t] = tracks[t].range_min[c];
+						group->range_scale[c * group->lane_count + t] = tracks[t].range_scale[c];
+					}
+				}
+			}
+		}
+	}
+}
+
+uint64_t baked_clip_source_key(const AnimationClip* clip, const Skeleton* skeleton)
+{
+	//  key, node  bake  ٸ   ´.
+	const float settings[5] = { BAKED_CLIP_SAMPLE_RATE, (float)BAKED_CLIP_MAX_STRIDE_LEVEL,
+		BAKED_CLIP_ROTATION_TOLERANCE, BAKED_CLIP_TRANSLATION_TOLERANCE, BAKED_CLIP_SCALE_TOLERANCE };
+	const uint64_t node_count = skeleton->parents.size();
+
+	uint64_t hash = FNV_OFFSET_BASIS;
+	hash = hash_bytes(hash, &BAKED_CLIP_VERSION, sizeof(BAKED_CLIP_VERSION));
+	hash = hash_bytes(hash, settings, sizeof(settings));
+	hash = hash_bytes(hash, &node_count, sizeof(node_count));
+	hash = hash_bytes(hash, &(clip->duration), sizeof(clip->duration));
+	hash = hash_vector(hash, clip->tracks);
+	hash = hash_vector(hash, clip->position_times);
+	hash = hash_vector(hash, clip->positions);
+	hash = hash_vector(hash, clip->rotation_times);
+	hash = hash_vector(hash, clip->rotations);
+	hash = hash_vector(hash, clip->scale_times);
+	hash = hash_vector(hash, clip->scales);
+	hash = hash_vector(hash, skeleton->bind_positions);
+	hash = hash_vector(hash, skeleton->bind_rotations);
+	hash = hash_vector(hash, skeleton->bind_scales);
+	return hash;
+}
+
+template <typename T>
+static void write_vector(FILE* fp, const std::vector<T>& values)
+{
+	const uint32_t count = (uint32_t)values.size();
+	fwrite(&count, sizeof(count), 1, fp);
+	fwrite(values.data(), sizeof(T), values.size(), fp);
+}
+
+template <typename T>
+static bool read_vector(FILE* fp, std::vector<T>* values)
+{
+	uint32_t count = 0;
+	if (fread(&count, sizeof(count), 1, fp) != 1 || count > BAKED_CLIP_MAX_VECTOR_COUNT)
+	{
+		return false;
+	}
+	values->resize(count);
+	return fread(values->data(), sizeof(T), count, fp) == count;
+}
+
+// Ͽ ״  group ũ 
+struct BakedClipGroupHeader
+{
+	int32_t channel;
+	uint32_t stride;
+	uint32_t key_count;
+	uint32_t track_count;
+	uint32_t lane_count;
+};
+
+// base/group   
+struct BakedClipStatHeader
+{
+	float duration;
+	uint32_t frame_count;
+	uint64_t source_bytes;
+	float max_error[BAKED_CHANNEL_COUNT];
+	uint32_t animated_track_count;
+	uint32_t constant_track_count;
+	uint32_t group_count;
+};
+
+bool baked_clip_save(const BakedClip* baked, const char* path)
+{
+	FILE* fp = fopen(path, "wb");
+	if (!fp)
+	{
+		printf("Fail to write a baked clip : %s\n", path);
+		return false;
+	}
+
+	BakedClipHeader header;
+	header.magic = BAKED_CLIP_MAGIC;
+	header.version = BAKED_CLIP_VERSION;
+	header.key = baked->source_key;
+	fwrite(&header, sizeof(header), 1, fp);
+
+	BakedClipStatHeader stat;
+	memset(&stat, 0, sizeof(stat));
+	stat.duration = baked->duration;
+	stat.frame_count = baked->frame_count;
+	stat.source_bytes = baked->source_bytes;
+	memcpy(stat.max_error, baked->max_error, sizeof(stat.max_error));
+	stat.animated_track_count = baked->animated_track_count;
+	stat.constant_track_count = baked->constant_track_count;
+	stat.group_count = (uint32_t)baked->groups.size();
+	fwrite(&stat, sizeof(stat), 1, fp);
+
+	write_vector(fp, baked->base_positions);
+	write_vector(fp, baked->base_rotations);
+	write_vector(fp, baked->base_scales);
+	for (const BakedClipGroup& group : baked->groups)
+	{
+		BakedClipGroupHeader group_header;
+		group_header.channel = group.channel;
+		group_header.stride = group.stride;
+		group_header.key_count = group.key_count;
+		group_header.track_count = group.track_count;
+		group_header.lane_count = group.lane_count;
+		fwrite(&group_header, sizeof(group_header), 1, fp);
+
+		write_vector(fp, group.nodes);
+		write_vector(fp, group.data);
+		write_vector(fp, group.range_min);
+		write_vector(fp, group.range_scale);
+	}
+
+	const bool is_ok = ferror(fp) == 0;
+	fclose(fp);
+	return is_ok;
+}
+
+bool baked_clip_load(BakedClip* baked, uint64_t source_key, const char* path)
+{
+	FILE* fp = fopen(path, "rb");
+	if (!fp)
+	{
+		return false;
+	}
+
+	BakedClipHeader header;
+	BakedClipStatHeader stat;
+	bool is_valid = fread(&header, sizeof(header), 1, fp) == 1 &&
+		header.magic == BAKED_CLIP_MAGIC &&
+		header.version == BAKED_CLIP_VERSION &&
+		header.key == source_key &&
+		fread(&stat, sizeof(stat), 1, fp) == 1 &&
+		read_vector(fp, &(baked->base_positions)) &&
+		read_vector(fp, &(baked->base_rotations)) &&
+		read_vector(fp, &(baked->base_scales));
+
+	baked->groups.clear();
+	if (is_valid)
+	{
+		baked->groups.resize(stat.group_count);
+		for (BakedClipGroup& group : baked->groups)
+		{
+			BakedClipGroupHeader group_header;
+			is_valid = fread(&group_header, sizeof(group_header), 1, fp) == 1 &&
+				read_vector(fp, &(group.nodes)) &&
+				read_vector(fp, &(group.data)) &&
+				read_vector(fp, &(group.range_min)) &&
+				read_vector(fp, &(group.range_scale));
+			if (!is_valid)
+			{
+				break;
+			}
+
+			group.channel = group_header.channel;
+			group.stride = group_header.stride;
+			group.key_count = group_header.key_count;
+			group.track_count = group_header.track_count;
+			group.lane_count = group_header.lane_count;
+
+			// sampler  Ѿ  ʴ ȮѴ.
+			is_valid = group.channel >= 0 && group.channel < BAKED_CHANNEL_COUNT &&
+				group.stride > 0 && group.key_count > 0 && group.lane_count % 4 == 0 &&
+				group.track_count <= group.lane_count &&
+				group.nodes.size() == group.lane_count &&
+				group.data.size() == (size_t)group.key_count * 3 * group.lane_count &&
+				group.range_min.size() == 3 * group.lane_count &&
+				group.range_scale.size() == 3 * group.lane_count;
+			for (unsigned t = 0; is_valid && t < group.track_count; ++t)
+			{
+				is_valid = group.nodes[t] < baked->base_positions.size();
+			}
+			if (!is_valid)
+			{
+				break;
+			}
+		}
+	}
+	fclose(fp);
+
+	if (!is_valid)
+	{
+		printf("Invalid baked clip : %s\n", path);
+		return false;
+	}
+
+	baked->duration = stat.duration;
+	baked->frame_count = stat.frame_count;
+	baked->source_bytes = (size_t)stat.source_bytes;
+	memcpy(baked->max_error, stat.max_error, sizeof(stat.max_error));
+	baked->animated_track_count = stat.animated_track_count;
+	baked->constant_track_count = stat.constant_track_count;
+	baked->source_key = source_key;
+	baked->is_from_cache = true;
+	return true;
+}
+
+void baked_clip_load_or_bake(const AnimationClip* clip, const Skeleton* skeleton, BakedClip* baked)
+{
+	const uint64_t key = baked_clip_source_key(clip, skeleton);
+	char path[512];
+	snprintf(path, sizeof(path), "%s/%016llx.clip", BAKED_CLIP_CACHE_FOLDER, (unsigned long long)key);
+
+	const size_t node_count = skeleton->parents.size();
+	if (baked_clip_load(baked, key, path) && baked->base_positions.size() == node_count &&
+		baked->base_rotations.size() == node_count && baked->base_scales.size() == node_count)
+	{
+		return;
+	}
+
+	baked_clip_bake(clip, skeleton, baked);
+	baked->source_key = key;
+
+	// ̹ ִٸ  .
+	file_make_folder(BAKED_CLIP_CACHE_FOLDER);
+	baked_clip_save(baked, path);
+}
+
+// key ϳ ġ  
+static void baked_find_keys(const BakedClipGroup* group, float time, unsigned* key0, unsigned* key1, float* alpha)
+{
+	const float key_position = time * BAKED_CLIP_SAMPLE_RATE / (float)group->stride;
+	if (key_position >= (float)(group->key_count - 1))
+	{
+		*key0 = *key1 = group->key_count - 1;
+		*alpha = 0.f;
+		return;
+	}
+	*key0 = (unsigned)key_position;
+	*key1 = *key0 + 1;
+	*alpha = key_position - (float)*key0;
+}
+
+#if BAKED_CLIP_SSE
+static __m128 baked_select(__m128 mask, __m128 a, __m128 b)
+{
+	return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+static __m128i baked_load_u16x4(const uint16_t* values)
+{
+	return _mm_unpacklo_epi16(_mm_loadl_epi64((const __m128i*)values), _mm_setzero_si128());
+}
+
+// track 4 smallest-three (x, y, z, w) SoA Ǭ.
+static void baked_decode_rotation4(const uint16_t* a, const uint16_t* b, const uint16_t* c, __m128* x, __m128* y, __m128* z, __m128* w)
+{
+	const __m128i ia = baked_load_u16x4(a);
+	const __m128i ib = baked_load_u16x4(b);
+	const __m128i ic = baked_load_u16x4(c);
+	const __m128i largest = _mm_or_si128(_mm_srli_epi32(ia, 15), _mm_slli_epi32(_mm_srli_epi32(ib, 15), 1));
+
+	const __m128i mask15 = _mm_set1_epi32(0x7FFF);
+	const __m128 scale = _mm_set1_ps(QUAT_DEQUANTIZE_SCALE);
+	const __m128 offset = _mm_set1_ps(QUAT_COMPONENT_MAX);
+	const __m128 fa = _mm_sub_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(ia, mask15)), scale), offset);
+	const __m128 fb = _mm_sub_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(ib, mask15)), scale), offset);
+	const __m128 fc = _mm_sub_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(ic, mask15)), scale), offset);
+	const __m128 sum = _mm_add_ps(_mm_add_ps(_mm_mul_ps(fa, fa), _mm_mul_ps(fb, fb)), _mm_mul_ps(fc, fc));
+	const __m128 fd = _mm_sqrt_ps(_mm_max_ps(_mm_sub_ps(_mm_set1_ps(1.f), sum), _mm_setzero_ps()));
+
+	//  (largest) ڸ fd ְ   ä.
+	const __m128 is0 = _mm_castsi128_ps(_mm_cmpeq_epi32(largest, _mm_set1_epi32(0)));
+	const __m128 is1 = _mm_castsi128_ps(_mm_cmpeq_epi32(largest, _mm_set1_epi32(1)));
+	const __m128 is2 = _mm_castsi128_ps(_mm_cmpeq_epi32(largest, _mm_set1_epi32(2)));
+	const __m128 is3 = _mm_castsi128_ps(_mm_cmpeq_epi32(largest, _mm_set1_epi32(3)));
+	*x = baked_select(is0, fd, fa);
+	*y = baked_select(is0, fa, baked_select(is1, fd, fb));
+	*z = baked_select(is2, fd, baked_select(is3, fc, fb));
+	*w = baked_select(is3, fd, fc);
+}
+
+static void baked_sample_rotations(const BakedClipGroup* group, const uint16_t* key0, const uint16_t* key1, float alpha, Pose* pose)
+{
+	const unsigned lane_count = group->lane_count;
+	const __m128 t = _mm_set1_ps(alpha);
+	const __m128 sign_bit = _mm_set1_ps(-0.f);
+	for (unsigned lane = 0; lane < lane_count; lane += 4)
+	{
+		__m128 x0, y0, z0, w0, x1, y1, z1, w1;
+		baked_decode_rotation4(key0 + lane, key0 + lane_count + lane, key0 + 2 * lane_count + lane, &x0, &y0, &z0, &w0);
+		baked_decode_rotation4(key1 + lane, key1 + lane_count + lane, key1 + 2 * lane_count + lane, &x1, &y1, &z1, &w1);
+
+		// nlerp. ݴ ݱ q1 ´.
+		const __m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x0, x1), _mm_mul_ps(y0, y1)), _mm_add_ps(_mm_mul_ps(z0, z1), _mm_mul_ps(w0, w1)));
+		const __m128 flip = _mm_and_ps(_mm_cmplt_ps(dot, _mm_setzero_ps()), sign_bit);
+		x1 = _mm_xor_ps(x1, flip);
+		y1 = _mm_xor_ps(y1, flip);
+		z1 = _mm_xor_ps(z1, flip);
+		w1 = _mm_xor_ps(w1, flip);
+
+		__m128 x = _mm_add_ps(x0, _mm_mul_ps(_mm_sub_ps(x1, x0), t));
+		__m128 y = _mm_add_ps(y0, _mm_mul_ps(_mm_sub_ps(y1, y0), t));
+		__m128 z = _mm_add_ps(z0, _mm_mul_ps(_mm_sub_ps(z1, z0), t));
+		__m128 w = _mm_add_ps(w0, _mm_mul_ps(_mm_sub_ps(w1, w0), t));
+		const __m128 length_sq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_add_ps(_mm_mul_ps(z, z), _mm_mul_ps(w, w)));
+		const __m128 inv_length = _mm_div_ps(_mm_set1_ps(1.f), _mm_sqrt_ps(_mm_max_ps(length_sq, _mm_set1_ps(1e-20f))));
+
+		alignas(16) float out[4][4];
+		_mm_store_ps(out[0], _mm_mul_ps(x, inv_length));
+		_mm_store_ps(out[1], _mm_mul_ps(y, inv_length));
+		_mm_store_ps(out[2], _mm_mul_ps(z, inv_length));
+		_mm_store_ps(out[3], _mm_mul_ps(w, inv_length));
+
+		const unsigned count = std::min(4u, group->track_count - std::min(lane, group->track_count));
+		for (unsigned i = 0; i < count; ++i)
+		{
+			pose->rotations[group->nodes[lane + i]] = glm::quat(out[3][i], out[0][i], out[1][i], out[2][i]);
+		}
+	}
+}
+
+static void baked_sample_vec3s(const BakedClipGroup* group, const uint16_t* key0, const uint16_t* key1, float alpha, glm::vec3* values)
+{
+	const unsigned lane_count = group->lane_count;
+	const __m128 t = _mm_set1_ps(alpha);
+	for (unsigned lane = 0; lane < lane_count; lane += 4)
+	{
+		alignas(16) float out[3][4];
+		for (int c = 0; c < 3; ++c)
+		{
+			const __m128 range_min = _mm_loadu_ps(&(group->range_min[c * lane_count + lane]));
+			const __m128 range_scale = _mm_loadu_ps(&(group->range_scale[c * lane_count + lane]));
+			const __m128 v0 = _mm_add_ps(range_min, _mm_mul_ps(_mm_cvtepi32_ps(baked_load_u16x4(key0 + c * lane_count + lane)), range_scale));
+			const __m128 v1 = _mm_add_ps(range_min, _mm_mul_ps(_mm_cvtepi32_ps(baked_load_u16x4(key1 + c * lane_count + lane)), range_scale));
+			_mm_store_ps(out[c], _mm_add_ps(v0, _mm_mul_ps(_mm_sub_ps(v1, v0), t)));
+		}
+
+		const unsigned count = std::min(4u, group->track_count - std::min(lane, group->track_count));
+		for (unsigned i = 0; i < count; ++i)
+		{
+			values[group->nodes[lane + i]] = glm::vec3(out[0][i], out[1][i], out[2][i]);
+		}
+	}
+}
+#else
+static void baked_sample_rotations(const BakedClipGroup* group, const uint16_t* key0, const uint16_t* key1, float alpha, Pose* pose)
+{
+	const unsigned lane_count = group->lane_count;
+	for (unsigned t = 0; t < group->track_count; ++t)
+	{
+		const glm::vec4 q0 = dequantize_rotation(key0[t], key0[lane_count + t], key0[2 * lane_count + t]);
+		const glm::vec4 q1 = dequantize_rotation(key1[t], key1[lane_count + t], key1[2 * lane_count + t]);
+		const glm::vec4 q = baked_nlerp(q0, q1, alpha);
+		pose->rotations[group->nodes[t]] = glm::quat(q.w, q.x, q.y, q.z);
+	}
+}
+
+static void baked_sample_vec3s(const BakedClipGroup* group, const uint16_t* key0, const uint16_t* key1, float alpha, glm::vec3* values)
+{
+	const unsigned lane_count = group->lane_count;
+	for (unsigned t = 0; t < group->track_count; ++t)
+	{
+		glm::vec3 value;
+		for (int c = 0; c < 3; ++c)
+		{
+			const float range_min = group->range_min[c * lane_count + t];
+			const float range_scale = group->range_scale[c * lane_count + t];
+			const float v0 = range_min + (float)key0[c * lane_count + t] * range_scale;
+			const float v1 = range_min + (float)key1[c * lane_count + t] * range_scale;
+			value[c] = v0 + (v1 - v0) * alpha;
+		}
+		values[group->nodes[t]] = value;
+	}
+}
+#endif
+
+void baked_clip_sample(const BakedClip* baked, float time, Pose* pose)
+{
+	std::copy(baked->base_positions.begin(), baked->base_positions.end(), pose->positions.begin());
+	std::copy(baked->base_rotations.begin(), baked->base_rotations.end(), pose->rotations.begin());
+	std::copy(baked->base_scales.begin(), baked->base_scales.end(), pose->scales.begin());
+
+	time = std::min(std::max(time, 0.f), baked->duration);
+	for (const BakedClipGroup& group : baked->groups)
+	{
+		unsigned key0, key1;
+		float alpha;
+		baked_find_keys(&group, time, &key0, &key1, &alpha);
+		const uint16_t* data0 = &(group.data[(size_t)key0 * 3 * group.lane_count]);
+		const uint16_t* data1 = &(group.data[(size_t)key1 * 3 * group.lane_count]);
+
+		switch (group.channel)
+		{
+		case BAKED_CHANNEL_ROTATION:	baked_sample_rotations(&group, data0, data1, alpha, pose); break;
+		case BAKED_CHANNEL_TRANSLATION:	baked_sample_vec3s(&group, data0, data1, alpha, pose->positions.data()); break;
+		case BAKED_CHANNEL_SCALE:		baked_sample_vec3s(&group, data0, data1, alpha, pose->scales.data()); break;
+		}
+	}
+}
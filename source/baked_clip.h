@@ -0,0 +1,105 @@
+#ifndef __BAKED_CLIP_H__
+#define __BAKED_CLIP_H__
+
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+
+#include "glm/glm.hpp"
+#include "glm/gtc/quaternion.hpp"
+
+struct AnimationClip;
+struct Skeleton;
+struct Pose;
+
+//  animation clip.
+//  key BAKED_CLIP_SAMPLE_RATE ٽ sampling   channel(rotation/translation/scale) 
+//   -   ȿ  ʴ track base  ϳ ,
+//   -     ʴ  ū stride(1, 2, 4, 8, 16 frame key ϳ)   stride group .
+// rotation smallest-three(16bit x 3,  ū  index    ֻ bit), translation/scale track  16bit ȭѴ.
+// group key frame ,  frame ȿ и track ̾ Ƿ(SoA)
+// sampling binary search  frame   о SSE track 4 Ǯ Ѵ.
+//   ȭ ؼ  sampler  frame  Ѵ.
+//   BAKED_CLIP_CACHE_FOLDER  key hash ؼ  ʹ  ʰ д´.
+//  :
+//   baked_clip_load_or_bake(&clip, &skeleton, &baked);
+//   baked_clip_sample(&baked, time, &pose);
+
+constexpr float BAKED_CLIP_SAMPLE_RATE = 30.f;
+constexpr int BAKED_CLIP_MAX_STRIDE_LEVEL = 4;	// stride 16
+
+// rotation quaternion , translation/scale  ִ 
+constexpr float BAKED_CLIP_ROTATION_TOLERANCE = 2e-3f;
+constexpr float BAKED_CLIP_TRANSLATION_TOLERANCE = 1e-3f;
+constexpr float BAKED_CLIP_SCALE_TOLERANCE = 1e-3f;
+
+constexpr const char* BAKED_CLIP_CACHE_FOLDER = "animation_cache";
+
+enum BakedChannel
+{
+	BAKED_CHANNEL_ROTATION = 0,
+	BAKED_CHANNEL_TRANSLATION,
+	BAKED_CHANNEL_SCALE,
+	BAKED_CHANNEL_COUNT
+};
+
+//  channel,  stride  track
+struct BakedClipGroup
+{
+	int channel;
+	unsigned stride;		//  frame key ϳ
+	unsigned key_count;
+	unsigned track_count;	//  track 
+	unsigned lane_count;	// 4  ø track . þ track  0̰  ʴ´.
+
+	std::vector<uint16_t> nodes;	// track -> skeleton node
+
+	// key k  c : data[(k * 3 + c) * lane_count + track]
+	std::vector<uint16_t> data;
+
+	// translation/scale ȭ : min + q * scale. [c * lane_count + track]
+	std::vector<float> range_min;
+	std::vector<float> range_scale;
+};
+
+struct BakedClip
+{
+	float duration;
+	unsigned frame_count;
+
+	// ִϸ̼  ʰų  ʴ channel . node  ϳ
+	std::vector<glm::vec3> base_positions;
+	std::vector<glm::quat> base_rotations;
+	std::vector<glm::vec3> base_scales;
+
+	std::vector<BakedClipGroup> groups;
+
+	// 
+	size_t source_bytes;	//  clip key memory
+	float max_error[BAKED_CHANNEL_COUNT];
+	unsigned animated_track_count;
+	unsigned constant_track_count;
+	bool is_from_cache;
+
+	//  key bake  hash. cache  ̸̴.
+	uint64_t source_key;
+};
+
+//  clip key ϴ memory
+size_t animation_clip_memory_bytes(const AnimationClip* clip);
+size_t baked_clip_memory_bytes(const BakedClip* baked);
+
+void baked_clip_bake(const AnimationClip* clip, const Skeleton* skeleton, BakedClip* baked);
+
+// cache     ִٸ а, ٸ  Ѵ.
+void baked_clip_load_or_bake(const AnimationClip* clip, const Skeleton* skeleton, BakedClip* baked);
+uint64_t baked_clip_source_key(const AnimationClip* clip, const Skeleton* skeleton);
+bool baked_clip_save(const BakedClip* baked, const char* path);
+
+//  key source_key ٸų    false
+bool baked_clip_load(BakedClip* baked, uint64_t source_key, const char* path);
+
+// time() local transform pose ä. pose skeleton node ŭ ־ Ѵ.
+void baked_clip_sample(const BakedClip* baked, float time, Pose* pose);
+
+#endif
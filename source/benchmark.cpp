@@ -0,0 +1,433 @@
+#include "benchmark.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+
+#include "gpu_profiler.h"
+
+Benchmark g_benchmark;
+
+struct BenchmarkStat
+{
+	double mean;
+	double p50;
+	double p95;
+	double p99;
+	double max;
+};
+
+//  ׸. baseline json  ̸ ã´.
+static const char* const BENCHMARK_METRIC_NAMES[] = { "cpu_ms", "gpu_ms", "draw_calls", "triangles", "latency_ms" };
+constexpr int BENCHMARK_METRIC_COUNT = sizeof(BENCHMARK_METRIC_NAMES) / sizeof(BENCHMARK_METRIC_NAMES[0]);
+
+void benchmark_print_usage()
+{
+	printf("  --benchmark PATH_FILE       follow the camera path and record frame statistics\n");
+	printf("  --benchmark-out PREFIX      write PREFIX.json and PREFIX.csv (default benchmark_result)\n");
+	printf("  --benchmark-baseline JSON   compare with a previous result and fail on regression\n");
+	printf("  --benchmark-threshold PCT   allowed regression in percent (default %.0f)\n", BENCHMARK_DEFAULT_THRESHOLD_PERCENT);
+	printf("  --benchmark-warmup N        frames to skip before recording (default %d)\n", BENCHMARK_DEFAULT_WARMUP_FRAMES);
+}
+
+void benchmark_set_defaults()
+{
+	// vector time_point Ƿ memset  value-initialization .
+	g_benchmark = Benchmark();
+	snprintf(g_benchmark.out_prefix, sizeof(g_benchmark.out_prefix), "%s", "benchmark_result");
+	g_benchmark.threshold_percent = BENCHMARK_DEFAULT_THRESHOLD_PERCENT;
+	g_benchmark.warmup_frames = BENCHMARK_DEFAULT_WARMUP_FRAMES;
+	g_benchmark.fixed_delta_time = 1.f / 60.f;
+}
+
+bool benchmark_parse_arg(int argc, char** argv, int* index)
+{
+	const char* arg = argv[*index];
+	if (*index + 1 >= argc)
+	{
+		return false;
+	}
+
+	const char* value = argv[*index + 1];
+	if (strcmp(arg, "--benchmark") == 0)
+	{
+		g_benchmark.is_enable = true;
+		snprintf(g_benchmark.path_file, sizeof(g_benchmark.path_file), "%s", value);
+	}
+	else if (strcmp(arg, "--benchmark-out") == 0)
+	{
+		snprintf(g_benchmark.out_prefix, sizeof(g_benchmark.out_prefix), "%s", value);
+	}
+	else if (strcmp(arg, "--benchmark-baseline") == 0)
+	{
+		snprintf(g_benchmark.baseline_file, sizeof(g_benchmark.baseline_file), "%s", value);
+	}
+	else if (strcmp(arg, "--benchmark-threshold") == 0)
+	{
+		g_benchmark.threshold_percent = (float)atof(value);
+	}
+	else if (strcmp(arg, "--benchmark-warmup") == 0)
+	{
+		g_benchmark.warmup_frames = atoi(value);
+	}
+	else
+	{
+		return false;
+	}
+
+	++(*index);
+	return true;
+}
+
+bool benchmark_init()
+{
+	FILE* fp = fopen(g_benchmark.path_file, "r");
+	if (!fp)
+	{
+		printf("Fail to open a benchmark camera path : %s\n", g_benchmark.path_file);
+		return false;
+	}
+
+	char line[512];
+	while (fgets(line, sizeof(line), fp))
+	{
+		if (line[0] == '#')
+		{
+			continue;
+		}
+
+		BenchmarkKeyframe keyframe;
+		glm::vec3& p = keyframe.position;
+		glm::quat& q = keyframe.rotation;
+		if (sscanf(line, "%f %f %f %f %f %f %f %f", &keyframe.time, &p.x, &p.y, &p.z, &q.w, &q.x, &q.y, &q.z) != 8)
+		{
+			continue;
+		}
+		q = glm::normalize(q);
+
+		if (!g_benchmark.keyframes.empty() && keyframe.time <= g_benchmark.keyframes.back().time)
+		{
+			printf("Benchmark keyframe times must increase : %f\n", keyframe.time);
+			fclose(fp);
+			return false;
+		}
+		g_benchmark.keyframes.push_back(keyframe);
+	}
+	fclose(fp);
+
+	if (g_benchmark.keyframes.empty())
+	{
+		printf("No keyframe in a benchmark camera path : %s\n", g_benchmark.path_file);
+		return false;
+	}
+
+	// warmup  ù keyframe  ְ,  ڷ  keyframe fixed_delta_time Ѵ.
+	const float duration = g_benchmark.keyframes.back().time - g_benchmark.keyframes.front().time;
+	const int path_frame_count = (int)ceilf(duration / g_benchmark.fixed_delta_time) + 1;
+	g_benchmark.total_frame_count = g_benchmark.warmup_frames + path_frame_count;
+
+	g_benchmark.cpu_ms.reserve(path_frame_count);
+	g_benchmark.gpu_ms.reserve(path_frame_count);
+	g_benchmark.draw_calls.reserve(path_frame_count);
+	g_benchmark.triangles.reserve(path_frame_count);
+	g_benchmark.latency_ms.reserve(path_frame_count);
+	return true;
+}
+
+bool benchmark_sample_camera(glm::vec3* position, glm::quat* rotation, bool is_late_latch)
+{
+	const std::vector<BenchmarkKeyframe>& keyframes = g_benchmark.keyframes;
+	const int path_frame = std::max(g_benchmark.frame_index - g_benchmark.warmup_frames, 0);
+	float time = keyframes.front().time + (float)path_frame * g_benchmark.fixed_delta_time;
+
+	// late latch frame ȿ 帥 ðŭ  . fixed_delta_time  ʰ ؼ  frame ڼ ռ ʴ´.
+	if (is_late_latch && g_benchmark.frame_index >= g_benchmark.warmup_frames)
+	{
+		const float elapsed = std::chrono::duration<float>(std::chrono::steady_clock::now() - g_benchmark.cpu_begin).count();
+		time += std::min(elapsed, g_benchmark.fixed_delta_time);
+	}
+
+	size_t next = 1;
+	while (next < keyframes.size() && keyframes[next].time < time)
+	{
+		++next;
+	}
+
+	glm::vec3 sampled_position;
+	glm::quat sampled_rotation;
+	if (next >= keyframes.size())
+	{
+		sampled_position = keyframes.back().position;
+		sampled_rotation = keyframes.back().rotation;
+	}
+	else
+	{
+		const BenchmarkKeyframe& k0 = keyframes[next - 1];
+		const BenchmarkKeyframe& k1 = keyframes[next];
+		const float t = glm::clamp((time - k0.time) / (k1.time - k0.time), 0.f, 1.f);
+		sampled_position = glm::mix(k0.position, k1.position, t);
+		sampled_rotation = glm::slerp(k0.rotation, k1.rotation, t);
+	}
+
+	const bool is_changed = sampled_position != *position || sampled_rotation != *rotation;
+	*position = sampled_position;
+	*rotation = sampled_rotation;
+	return is_changed;
+}
+
+void benchmark_mark_input()
+{
+	g_benchmark.input_time = std::chrono::steady_clock::now();
+}
+
+void benchmark_begin_frame()
+{
+	g_benchmark.cpu_begin = std::chrono::steady_clock::now();
+	g_benchmark.input_time = g_benchmark.cpu_begin;
+}
+
+void benchmark_end_frame(unsigned draw_calls, unsigned long long triangles)
+{
+	const float cpu_ms = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - g_benchmark.cpu_begin).count();
+
+	// GPU   frame ʰ Ƿ     Ѵ.
+	// warmup   query     warmup query latency    ϴ.
+	float gpu_ms = 0.f;
+	bool has_gpu_ms = false;
+	const ProfilerScope* frame_scope = gpu_profiler_find("Frame");
+	if (frame_scope && frame_scope->gpu_result_count != g_benchmark.last_gpu_result_count)
+	{
+		g_benchmark.last_gpu_result_count = frame_scope->gpu_result_count;
+		gpu_ms = gpu_profiler_latest_gpu_ms(frame_scope);
+		has_gpu_ms = true;
+	}
+
+	if (g_benchmark.frame_index++ < g_benchmark.warmup_frames)
+	{
+		return;
+	}
+
+	g_benchmark.cpu_ms.push_back(cpu_ms);
+	if (has_gpu_ms)
+	{
+		g_benchmark.gpu_ms.push_back(gpu_ms);
+	}
+	g_benchmark.draw_calls.push_back(draw_calls);
+	g_benchmark.triangles.push_back(triangles);
+}
+
+void benchmark_present()
+{
+	// benchmark_end_frame frame_index ̹ ÷Ƿ   frame frame_index - 1̴.
+	if (g_benchmark.frame_index <= g_benchmark.warmup_frames)
+	{
+		return;
+	}
+
+	g_benchmark.latency_ms.push_back(std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - g_benchmark.input_time).count());
+}
+
+bool benchmark_is_finished()
+{
+	return g_benchmark.frame_index >= g_benchmark.total_frame_count;
+}
+
+template <typename T>
+static BenchmarkStat benchmark_compute_stat(const std::vector<T>& samples)
+{
+	BenchmarkStat stat;
+	memset(&stat, 0, sizeof(BenchmarkStat));
+	if (samples.empty())
+	{
+		return stat;
+	}
+
+	std::vector<double> sorted(samples.begin(), samples.end());
+	std::sort(sorted.begin(), sorted.end());
+
+	double sum = 0.0;
+	for (double value : sorted)
+	{
+		sum += value;
+	}
+
+	// nearest-rank percentile
+	auto percentile = [&sorted](double p) {
+		size_t rank = (size_t)ceil(p / 100.0 * (double)sorted.size());
+		return sorted[rank > 0 ? rank - 1 : 0];
+	};
+
+	stat.mean = sum / (double)sorted.size();
+	stat.p50 = percentile(50.0);
+	stat.p95 = percentile(95.0);
+	stat.p99 = percentile(99.0);
+	stat.max = sorted.back();
+	return stat;
+}
+
+static bool benchmark_write_csv(const char* path)
+{
+	FILE* fp = fopen(path, "w");
+	if (!fp)
+	{
+		printf("Fail to write a benchmark result : %s\n", path);
+		return false;
+	}
+
+	// GPU  frame 1:1  Ƿ ִ ŭ ä.
+	fprintf(fp, "frame,cpu_ms,gpu_ms,draw_calls,triangles,latency_ms\n");
+	for (size_t i = 0; i < g_benchmark.cpu_ms.size(); ++i)
+	{
+		fprintf(fp, "%zu,%.4f,", i, g_benchmark.cpu_ms[i]);
+		if (i < g_benchmark.gpu_ms.size())
+		{
+			fprintf(fp, "%.4f", g_benchmark.gpu_ms[i]);
+		}
+		fprintf(fp, ",%u,%llu,", g_benchmark.draw_calls[i], g_benchmark.triangles[i]);
+		if (i < g_benchmark.latency_ms.size())
+		{
+			fprintf(fp, "%.4f", g_benchmark.latency_ms[i]);
+		}
+		fprintf(fp, "\n");
+	}
+	fclose(fp);
+	return true;
+}
+
+static bool benchmark_write_json(const char* path, const BenchmarkStat* stats)
+{
+	FILE* fp = fopen(path, "w");
+	if (!fp)
+	{
+		printf("Fail to write a benchmark result : %s\n", path);
+		return false;
+	}
+
+	fprintf(fp, "{\n");
+	fprintf(fp, "  \"path_file\": \"%s\",\n", g_benchmark.path_file);
+	fprintf(fp, "  \"frame_count\": %zu,\n", g_benchmark.cpu_ms.size());
+	fprintf(fp, "  \"gpu_sample_count\": %zu,\n", g_benchmark.gpu_ms.size());
+	fprintf(fp, "  \"fixed_delta_time\": %.6f,\n", g_benchmark.fixed_delta_time);
+	for (int i = 0; i < BENCHMARK_METRIC_COUNT; ++i)
+	{
+		const BenchmarkStat& s = stats[i];
+		fprintf(fp, "  \"%s\": { \"mean\": %.4f, \"p50\": %.4f, \"p95\": %.4f, \"p99\": %.4f, \"max\": %.4f }%s\n",
+			BENCHMARK_METRIC_NAMES[i], s.mean, s.p50, s.p95, s.p99, s.max, i + 1 < BENCHMARK_METRIC_COUNT ? "," : "");
+	}
+	fprintf(fp, "}\n");
+	fclose(fp);
+	return true;
+}
+
+// 츮   json  ǹǷ "metric" ü ȿ "key":  ڸ ã´.
+static bool benchmark_find_number(const char* json, const char* metric, const char* key, double* value)
+{
+	char pattern[64];
+	snprintf(pattern, sizeof(pattern), "\"%s\"", metric);
+	const char* object = strstr(json, pattern);
+	if (!object)
+	{
+		return false;
+	}
+
+	const char* object_end = strchr(object, '}');
+	snprintf(pattern, sizeof(pattern), "\"%s\"", key);
+	const char* found = strstr(object, pattern);
+	if (!found || (object_end && found > object_end))
+	{
+		return false;
+	}
+
+	const char* colon = strchr(found, ':');
+	if (!colon)
+	{
+		return false;
+	}
+
+	char* end = NULL;
+	*value = strtod(colon + 1, &end);
+	return end != colon + 1;
+}
+
+static int benchmark_compare_baseline(const BenchmarkStat* stats)
+{
+	FILE* fp = fopen(g_benchmark.baseline_file, "rb");
+	if (!fp)
+	{
+		printf("Fail to open a benchmark baseline : %s\n", g_benchmark.baseline_file);
+		return BENCHMARK_EXIT_NO_BASELINE;
+	}
+
+	std::vector<char> json;
+	char chunk[4096];
+	size_t read_size;
+	while ((read_size = fread(chunk, 1, sizeof(chunk), fp)) > 0)
+	{
+		json.insert(json.end(), chunk, chunk + read_size);
+	}
+	json.push_back('\0');
+	fclose(fp);
+
+	// հ p95 Ѵ. max/p99 ѵ frame Ʀ  CI ߸ а .
+	const double limit = 1.0 + (double)g_benchmark.threshold_percent / 100.0;
+	bool is_regressed = false;
+	for (int i = 0; i < BENCHMARK_METRIC_COUNT; ++i)
+	{
+		const char* metric = BENCHMARK_METRIC_NAMES[i];
+		if (strcmp(metric, "gpu_ms") == 0 && g_benchmark.gpu_ms.empty())
+		{
+			continue;
+		}
+
+		const char* keys[] = { "mean", "p95" };
+		const double currents[] = { stats[i].mean, stats[i].p95 };
+		for (int k = 0; k < 2; ++k)
+		{
+			double baseline;
+			if (!benchmark_find_number(json.data(), metric, keys[k], &baseline) || baseline <= 0.0)
+			{
+				continue;
+			}
+
+			const bool is_over = currents[k] > baseline * limit;
+			printf("%-10s %-4s : %12.4f (baseline %12.4f, %+6.1f%%)%s\n", metric, keys[k], currents[k], baseline,
+				(currents[k] / baseline - 1.0) * 100.0, is_over ? "  REGRESSION" : "");
+			is_regressed |= is_over;
+		}
+	}
+
+	return is_regressed ? BENCHMARK_EXIT_REGRESSION : 0;
+}
+
+int benchmark_finish()
+{
+	BenchmarkStat stats[BENCHMARK_METRIC_COUNT];
+	stats[0] = benchmark_compute_stat(g_benchmark.cpu_ms);
+	stats[1] = benchmark_compute_stat(g_benchmark.gpu_ms);
+	stats[2] = benchmark_compute_stat(g_benchmark.draw_calls);
+	stats[3] = benchmark_compute_stat(g_benchmark.triangles);
+	stats[4] = benchmark_compute_stat(g_benchmark.latency_ms);
+
+	char path[512];
+	snprintf(path, sizeof(path), "%s.csv", g_benchmark.out_prefix);
+	bool is_written = benchmark_write_csv(path);
+	snprintf(path, sizeof(path), "%s.json", g_benchmark.out_prefix);
+	is_written &= benchmark_write_json(path, stats);
+
+	printf("Benchmark : %zu frames, cpu mean %.3f ms, p95 %.3f ms / gpu mean %.3f ms, p95 %.3f ms / latency mean %.3f ms, p95 %.3f ms\n",
+		g_benchmark.cpu_ms.size(), stats[0].mean, stats[0].p95, stats[1].mean, stats[1].p95, stats[4].mean, stats[4].p95);
+
+	if (!is_written)
+	{
+		return 1;
+	}
+
+	if (g_benchmark.baseline_file[0] == '\0')
+	{
+		return 0;
+	}
+
+	return benchmark_compare_baseline(stats);
+}
@@ -0,0 +1,88 @@
+#ifndef __BENCHMARK_H__
+#define __BENCHMARK_H__
+
+#include <chrono>
+#include <vector>
+
+#include "glm/glm.hpp"
+#include "glm/gtc/quaternion.hpp"
+
+//  camera θ  ð  󰡸鼭 frame  CPU/GPU ð, draw call, ﰢ  Ѵ.
+// camera ڼ  ð(Է  ð) present ð input latency Ѵ.
+//   ð frame ȣ ϹǷ CPU ð  ׻  ڼ ׸.
+// late latch  frame ۵  帥 ð(fixed_delta_time ) ϹǷ, ٽ  ڼ  ڼ  ռ ִ.
+// ΰ  mean/p50/p95/p99/max PREFIX.json, frame   PREFIX.csv ϰ,
+// baseline ־ threshold ̻  ׸   0 ƴ exit code ش.
+//
+// command line : --benchmark PATH_FILE [--benchmark-out PREFIX] [--benchmark-baseline JSON]
+//                [--benchmark-threshold PERCENT] [--benchmark-warmup N]
+//
+// PATH_FILE  ٿ keyframe ϳ "time px py pz qw qx qy qz" ̴. ('#' ϴ  ּ)
+
+constexpr int BENCHMARK_DEFAULT_WARMUP_FRAMES = 30;
+constexpr float BENCHMARK_DEFAULT_THRESHOLD_PERCENT = 10.f;
+
+constexpr int BENCHMARK_EXIT_REGRESSION = 2;
+constexpr int BENCHMARK_EXIT_NO_BASELINE = 3;
+
+struct BenchmarkKeyframe
+{
+	float time;
+	glm::vec3 position;
+	glm::quat rotation;
+};
+
+struct Benchmark
+{
+	bool is_enable;
+	char path_file[256];
+	char out_prefix[256];
+	char baseline_file[256];
+	float threshold_percent;
+	int warmup_frames;
+	float fixed_delta_time;
+
+	std::vector<BenchmarkKeyframe> keyframes;
+	int frame_index;
+	int total_frame_count;
+
+	// warmup   frame  
+	std::vector<float> cpu_ms;
+	std::vector<float> gpu_ms;
+	std::vector<unsigned> draw_calls;
+	std::vector<unsigned long long> triangles;
+	std::vector<float> latency_ms;
+
+	std::chrono::steady_clock::time_point cpu_begin;
+	std::chrono::steady_clock::time_point input_time;
+	unsigned last_gpu_result_count;
+};
+extern Benchmark g_benchmark;
+
+void benchmark_set_defaults();
+void benchmark_print_usage();
+
+// argv[*index] benchmark ɼ̶ () а index ű  true ش.
+bool benchmark_parse_arg(int argc, char** argv, int* index);
+
+// camera   д´. ϸ false
+bool benchmark_init();
+
+//  frame camera ġ . is_late_latch frame ۵  帥 ðŭ   ڼ. Ѱ  ޶ٸ true
+bool benchmark_sample_camera(glm::vec3* position, glm::quat* rotation, bool is_late_latch);
+
+// ̹ frame camera ڼ  ð Ѵ.   Ҹ  ð .
+// ڼ ٲ ʾҴٸ θ ʴ´. (ٲ  ڼ ð ߸ latency پ ó δ.)
+void benchmark_mark_input();
+
+void benchmark_begin_frame();
+void benchmark_end_frame(unsigned draw_calls, unsigned long long triangles);
+
+// swap Ŀ ȣѴ.  benchmark_mark_input ݱ input latency Ѵ.
+void benchmark_present();
+bool benchmark_is_finished();
+
+//  ϰ baseline Ѵ. process exit code ش.
+int benchmark_finish();
+
+#endif
@@ -0,0 +1,1213 @@
+#include "broadphase.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include <assert.h>
+#include <chrono>
+#include <algorithm>
+
+#include "imgui/imgui.h"
+#include "job_system.h"
+#include "memory_tracker.h"
+#include "physics.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define BROADPHASE_SSE 1
+#include <emmintrin.h>
+#else
+#define BROADPHASE_SSE 0
+#endif
+
+// tree    stack ũ.  ߹Ƿ ̴ ̺ ξ ۴.
+constexpr int AABB_TREE_STACK_SIZE = 256;
+
+//  Ŀ proxy  ̺  Űܾ Ѵٸ ó Ѵ.
+constexpr int SAP_MAX_SWAPS_PER_PROXY = 8;
+
+// sap grid cell ϳ  proxy ,   ִ cell , job ϳ ô cell 
+constexpr int SAP_PROXIES_PER_CELL = 64;
+constexpr int SAP_MAX_CELLS_PER_AXIS = 128;
+constexpr int SAP_CELL_BATCH_SIZE = 16;
+
+Broadphase g_broadphase;
+const char* BROADPHASE_TYPE_NAMES[BROADPHASE_TYPE_COUNT] = { "tree", "sap" };
+
+bool broadphase_overlap(const BroadphaseAABB& a, const BroadphaseAABB& b)
+{
+	return a.min.x <= b.max.x && a.max.x >= b.min.x &&
+		a.min.y <= b.max.y && a.max.y >= b.min.y &&
+		a.min.z <= b.max.z && a.max.z >= b.min.z;
+}
+
+static bool broadphase_contains(const BroadphaseAABB& outer, const BroadphaseAABB& inner)
+{
+	return outer.min.x <= inner.min.x && outer.min.y <= inner.min.y && outer.min.z <= inner.min.z &&
+		inner.max.x <= outer.max.x && inner.max.y <= outer.max.y && inner.max.z <= outer.max.z;
+}
+
+static BroadphaseAABB broadphase_union(const BroadphaseAABB& a, const BroadphaseAABB& b)
+{
+	return { glm::min(a.min, b.min), glm::max(a.max, b.max) };
+}
+
+static float broadphase_area(const BroadphaseAABB& aabb)
+{
+	const glm::vec3 size = aabb.max - aabb.min;
+	return 2.f * (size.x * size.y + size.y * size.z + size.z * size.x);
+}
+
+static bool broadphase_pair_less(const BroadphasePair& a, const BroadphasePair& b)
+{
+	return a.a < b.a || (a.a == b.a && a.b < b.b);
+}
+
+static bool broadphase_pair_equal(const BroadphasePair& a, const BroadphasePair& b)
+{
+	return a.a == b.a && a.b == b.b;
+}
+
+// 0   ū  ٲ㼭 0 * inf (NaN)  ʰ Ѵ.
+static glm::vec3 broadphase_inverse_direction(const glm::vec3& direction)
+{
+	glm::vec3 inverse;
+	for (int i = 0; i < 3; ++i)
+	{
+		inverse[i] = fabsf(direction[i]) > 1e-12f ? 1.f / direction[i] : (direction[i] < 0.f ? -1e12f : 1e12f);
+	}
+	return inverse;
+}
+
+// slab test. ¾Ҵٸ  Ÿ(0 ̻), ƴ϶ -1
+static float broadphase_ray_aabb(const glm::vec3& origin, const glm::vec3& inverse_direction, float max_distance, const BroadphaseAABB& aabb)
+{
+	const glm::vec3 t1 = (aabb.min - origin) * inverse_direction;
+	const glm::vec3 t2 = (aabb.max - origin) * inverse_direction;
+	const glm::vec3 t_min = glm::min(t1, t2);
+	const glm::vec3 t_max = glm::max(t1, t2);
+	const float t_enter = std::max(std::max(t_min.x, t_min.y), std::max(t_min.z, 0.f));
+	const float t_exit = std::min(std::min(t_max.x, t_max.y), std::min(t_max.z, max_distance));
+	return t_enter <= t_exit ? t_enter : -1.f;
+}
+
+// hit_function    proxy . Ÿ ٸ  proxy (   )
+static void broadphase_raycast_hit(int proxy, float max_distance, const std::function<float(int proxy, float max_distance)>& hit_function,
+	int* best_proxy, float* best_distance)
+{
+	const float distance = hit_function(proxy, max_distance);
+	if (distance < 0.f || distance > *best_distance)
+	{
+		return;
+	}
+	if (*best_proxy == -1 || distance < *best_distance || proxy < *best_proxy)
+	{
+		*best_proxy = proxy;
+		*best_distance = distance;
+	}
+}
+
+// batch ŭ pair 迭 غѴ.
+static int broadphase_prepare_batches(Broadphase* broadphase, int count, int batch_size)
+{
+	const int batch_count = (count + batch_size - 1) / batch_size;
+	if ((int)broadphase->batch_pairs.size() < batch_count)
+	{
+		broadphase->batch_pairs.resize(batch_count);
+	}
+	for (int i = 0; i < batch_count; ++i)
+	{
+		broadphase->batch_pairs[i].clear();
+	}
+	return batch_count;
+}
+
+
+// dynamic AABB tree
+
+static int aabb_tree_allocate_node(AABBTree* tree)
+{
+	int index = tree->free_list;
+	if (index == -1)
+	{
+		index = (int)tree->nodes.size();
+		tree->nodes.emplace_back();
+	}
+	else
+	{
+		tree->free_list = tree->nodes[index].parent;
+	}
+
+	AABBTreeNode& node = tree->nodes[index];
+	node.parent = -1;
+	node.child1 = -1;
+	node.child2 = -1;
+	node.proxy = -1;
+	node.height = 0;
+	return index;
+}
+
+static void aabb_tree_free_node(AABBTree* tree, int index)
+{
+	tree->nodes[index].parent = tree->free_list;
+	tree->nodes[index].height = -1;
+	tree->free_list = index;
+}
+
+// child other ڽ grand_child ڸ ٲ۴. parent(child other θ) AABB ״δ.
+static void aabb_tree_swap(AABBTree* tree, int parent, int child, int other, int grand_child)
+{
+	std::vector<AABBTreeNode>& nodes = tree->nodes;
+	if (nodes[parent].child1 == child)
+	{
+		nodes[parent].child1 = grand_child;
+	}
+	else
+	{
+		nodes[parent].child2 = grand_child;
+	}
+	nodes[grand_child].parent = parent;
+
+	if (nodes[other].child1 == grand_child)
+	{
+		nodes[other].child1 = child;
+	}
+	else
+	{
+		nodes[other].child2 = child;
+	}
+	nodes[child].parent = other;
+
+	AABBTreeNode& other_node = nodes[other];
+	other_node.aabb = broadphase_union(nodes[other_node.child1].aabb, nodes[other_node.child2].aabb);
+	other_node.height = 1 + std::max(nodes[other_node.child1].height, nodes[other_node.child2].height);
+
+	AABBTreeNode& parent_node = nodes[parent];
+	parent_node.height = 1 + std::max(nodes[parent_node.child1].height, nodes[parent_node.child2].height);
+	++tree->rotation_count;
+}
+
+// A ڽ ϳ(B Ǵ C) ٸ ڽ ڽ() ٲ . ڽ ٲ node ǥ   پ  ,
+// پ  ٸ ״ д. ̸  AVL ȸ ޸ query  ģ  پ.
+static void aabb_tree_rotate(AABBTree* tree, int index_a)
+{
+	const std::vector<AABBTreeNode>& nodes = tree->nodes;
+	const AABBTreeNode& a = nodes[index_a];
+	if (a.child1 == -1 || a.height < 2)
+	{
+		return;
+	}
+
+	const int index_b = a.child1;
+	const int index_c = a.child2;
+	const AABBTreeNode& b = nodes[index_b];
+	const AABBTreeNode& c = nodes[index_c];
+
+	// ĺ ( ڽ, ڽ ٲ node, ö , ǥ ȭ)
+	int best_child = -1, best_other = -1, best_grand_child = -1;
+	float best_cost = 0.f;
+	const auto consider = [&](int child, int other, int grand_child, int remain_child)
+	{
+		const float cost = broadphase_area(broadphase_union(nodes[child].aabb, nodes[remain_child].aabb)) - broadphase_area(nodes[other].aabb);
+		if (cost < best_cost)
+		{
+			best_cost = cost;
+			best_child = child;
+			best_other = other;
+			best_grand_child = grand_child;
+		}
+	};
+	if (c.child1 != -1)
+	{
+		consider(index_b, index_c, c.child1, c.child2);
+		consider(index_b, index_c, c.child2, c.child1);
+	}
+	if (b.child1 != -1)
+	{
+		consider(index_c, index_b, b.child1, b.child2);
+		consider(index_c, index_b, b.child2, b.child1);
+	}
+
+	if (best_child != -1)
+	{
+		aabb_tree_swap(tree, index_a, best_child, best_other, best_grand_child);
+	}
+}
+
+// index root ö󰡸鼭 ȸϰ ̿ AABB ٽ Ѵ.
+static void aabb_tree_refit(AABBTree* tree, int index)
+{
+	std::vector<AABBTreeNode>& nodes = tree->nodes;
+	while (index != -1)
+	{
+		aabb_tree_rotate(tree, index);
+
+		AABBTreeNode& node = nodes[index];
+		const AABBTreeNode& child1 = nodes[node.child1];
+		const AABBTreeNode& child2 = nodes[node.child2];
+		node.height = 1 + std::max(child1.height, child2.height);
+		node.aabb = broadphase_union(child1.aabb, child2.aabb);
+
+		index = node.parent;
+	}
+}
+
+static void aabb_tree_insert_leaf(AABBTree* tree, int leaf)
+{
+	std::vector<AABBTreeNode>& nodes = tree->nodes;
+	if (tree->root == -1)
+	{
+		tree->root = leaf;
+		nodes[leaf].parent = -1;
+		return;
+	}
+
+	//   node ã´. ⼭  θ  , 鼭  node þ (inheritance) Ѵ.
+	const BroadphaseAABB leaf_aabb = nodes[leaf].aabb;
+	int index = tree->root;
+	while (nodes[index].child1 != -1)
+	{
+		const AABBTreeNode& node = nodes[index];
+		const float area = broadphase_area(node.aabb);
+		const float combined_area = broadphase_area(broadphase_union(node.aabb, leaf_aabb));
+		const float cost = 2.f * combined_area;
+		const float inheritance_cost = 2.f * (combined_area - area);
+
+		float child_costs[2];
+		const int children[2] = { node.child1, node.child2 };
+		for (int i = 0; i < 2; ++i)
+		{
+			const AABBTreeNode& child = nodes[children[i]];
+			const float child_area = broadphase_area(broadphase_union(child.aabb, leaf_aabb));
+			child_costs[i] = (child.child1 == -1 ? child_area : child_area - broadphase_area(child.aabb)) + inheritance_cost;
+		}
+
+		if (cost < child_costs[0] && cost < child_costs[1])
+		{
+			break;
+		}
+		index = child_costs[0] < child_costs[1] ? children[0] : children[1];
+	}
+
+	const int sibling = index;
+	const int old_parent = nodes[sibling].parent;
+	const int new_parent = aabb_tree_allocate_node(tree);
+	nodes[new_parent].parent = old_parent;
+	nodes[new_parent].aabb = broadphase_union(leaf_aabb, nodes[sibling].aabb);
+	nodes[new_parent].height = nodes[sibling].height + 1;
+	nodes[new_parent].child1 = sibling;
+	nodes[new_parent].child2 = leaf;
+	nodes[sibling].parent = new_parent;
+	nodes[leaf].parent = new_parent;
+
+	if (old_parent == -1)
+	{
+		tree->root = new_parent;
+	}
+	else if (nodes[old_parent].child1 == sibling)
+	{
+		nodes[old_parent].child1 = new_parent;
+	}
+	else
+	{
+		nodes[old_parent].child2 = new_parent;
+	}
+
+	aabb_tree_refit(tree, nodes[leaf].parent);
+}
+
+// leaf  θ ڸ  ø. leaf node ״ д.
+static void aabb_tree_remove_leaf(AABBTree* tree, int leaf)
+{
+	std::vector<AABBTreeNode>& nodes = tree->nodes;
+	if (leaf == tree->root)
+	{
+		tree->root = -1;
+		return;
+	}
+
+	const int parent = nodes[leaf].parent;
+	const int grand_parent = nodes[parent].parent;
+	const int sibling = nodes[parent].child1 == leaf ? nodes[parent].child2 : nodes[parent].child1;
+
+	nodes[sibling].parent = grand_parent;
+	aabb_tree_free_node(tree, parent);
+	if (grand_parent == -1)
+	{
+		tree->root = sibling;
+		return;
+	}
+
+	if (nodes[grand_parent].child1 == parent)
+	{
+		nodes[grand_parent].child1 = sibling;
+	}
+	else
+	{
+		nodes[grand_parent].child2 = sibling;
+	}
+	aabb_tree_refit(tree, grand_parent);
+}
+
+//  AABB marginŭ ø, ̵   ÷   step  ٽ  ʾƵ ǰ Ѵ.
+static BroadphaseAABB aabb_tree_fatten(const BroadphaseAABB& aabb, const glm::vec3& displacement)
+{
+	const glm::vec3 predicted = displacement * BROADPHASE_DISPLACEMENT_MULTIPLIER;
+	BroadphaseAABB fat;
+	fat.min = aabb.min - glm::vec3(BROADPHASE_AABB_MARGIN) + glm::min(predicted, glm::vec3(0.f));
+	fat.max = aabb.max + glm::vec3(BROADPHASE_AABB_MARGIN) + glm::max(predicted, glm::vec3(0.f));
+	return fat;
+}
+
+template <typename Function>
+static void aabb_tree_query(const AABBTree* tree, const BroadphaseAABB& aabb, const Function& function)
+{
+	if (tree->root == -1)
+	{
+		return;
+	}
+
+	int stack[AABB_TREE_STACK_SIZE];
+	int stack_size = 0;
+	stack[stack_size++] = tree->root;
+	while (stack_size > 0)
+	{
+		const AABBTreeNode& node = tree->nodes[stack[--stack_size]];
+		if (!broadphase_overlap(node.aabb, aabb))
+		{
+			continue;
+		}
+
+		if (node.child1 == -1)
+		{
+			function(node.proxy);
+		}
+		else
+		{
+			assert(stack_size + 2 <= AABB_TREE_STACK_SIZE);
+			stack[stack_size++] = node.child1;
+			stack[stack_size++] = node.child2;
+		}
+	}
+}
+
+int aabb_tree_height(const AABBTree* tree)
+{
+	return tree->root == -1 ? 0 : tree->nodes[tree->root].height;
+}
+
+static void broadphase_update_tree(Broadphase* broadphase, const glm::vec3* displacements)
+{
+	AABBTree* tree = &broadphase->tree;
+	const int count = broadphase->proxy_count;
+	if ((int)tree->leaves.size() != count)
+	{
+		tree->leaves.assign(count, -1);
+		tree->is_moved.assign(count, 0);
+		tree->nodes.reserve(2 * count);
+	}
+
+	//  AABB fat AABB   proxy ٽ ִ´.
+	tree->moved_proxies.clear();
+	for (int proxy = 0; proxy < count; ++proxy)
+	{
+		const BroadphaseAABB& aabb = broadphase->aabbs[proxy];
+		int leaf = tree->leaves[proxy];
+		if (leaf == -1)
+		{
+			leaf = aabb_tree_allocate_node(tree);
+			tree->nodes[leaf].proxy = proxy;
+			tree->leaves[proxy] = leaf;
+		}
+		else if (broadphase_contains(tree->nodes[leaf].aabb, aabb))
+		{
+			tree->is_moved[proxy] = 0;
+			continue;
+		}
+		else
+		{
+			aabb_tree_remove_leaf(tree, leaf);
+		}
+
+		tree->nodes[leaf].aabb = aabb_tree_fatten(aabb, displacements != nullptr ? displacements[proxy] : glm::vec3(0.f));
+		aabb_tree_insert_leaf(tree, leaf);
+		tree->is_moved[proxy] = 1;
+		tree->moved_proxies.push_back(proxy);
+	}
+	const int moved_count = (int)tree->moved_proxies.size();
+	broadphase->moved_count = moved_count;
+
+	//  pair  fat AABB  ġ  .    ʾҴٸ ״ ģ.
+	std::vector<BroadphasePair>& pairs = broadphase->pairs;
+	pairs.erase(std::remove_if(pairs.begin(), pairs.end(), [tree](const BroadphasePair& pair)
+	{
+		return (tree->is_moved[pair.a] || tree->is_moved[pair.b]) &&
+			!broadphase_overlap(tree->nodes[tree->leaves[pair.a]].aabb, tree->nodes[tree->leaves[pair.b]].aabb);
+	}), pairs.end());
+	const size_t kept_count = pairs.size();
+
+	// ٽ  proxy fat AABB  pair ã´.   ٽ ־ٸ  proxy ʿ Ѵ.
+	const int batch_count = broadphase_prepare_batches(broadphase, moved_count, BROADPHASE_BATCH_SIZE);
+	parallel_for_range(moved_count, BROADPHASE_BATCH_SIZE, [broadphase, tree](int begin, int end)
+	{
+		std::vector<BroadphasePair>* out_pairs = &(broadphase->batch_pairs[begin / BROADPHASE_BATCH_SIZE]);
+		for (int i = begin; i < end; ++i)
+		{
+			const int proxy = tree->moved_proxies[i];
+			aabb_tree_query(tree, tree->nodes[tree->leaves[proxy]].aabb, [tree, proxy, out_pairs](int other)
+			{
+				if (other == proxy || (tree->is_moved[other] && other < proxy))
+				{
+					return;
+				}
+				out_pairs->push_back({ std::min(proxy, other), std::max(proxy, other) });
+			});
+		}
+	});
+
+	//  pair ̹ ĵǾ Ƿ  pair ؼ ģ. ѿ  ִ pair ϳ .
+	for (int i = 0; i < batch_count; ++i)
+	{
+		pairs.insert(pairs.end(), broadphase->batch_pairs[i].begin(), broadphase->batch_pairs[i].end());
+	}
+	std::sort(pairs.begin() + kept_count, pairs.end(), broadphase_pair_less);
+	std::inplace_merge(pairs.begin(), pairs.begin() + kept_count, pairs.end(), broadphase_pair_less);
+	pairs.erase(std::unique(pairs.begin(), pairs.end(), broadphase_pair_equal), pairs.end());
+}
+
+
+// sweep and prune
+
+// grid  k(0 : axis + 1, 1 : axis + 2) value ִ cell.   ڸ cell̴.
+static int sap_cell(const SweepAndPrune* sap, int k, float value)
+{
+	const int cell = (int)((value - sap->cell_origins[k]) * sap->inverse_cell_sizes[k]);
+	return std::max(0, std::min(sap->cell_counts[k] - 1, cell));
+}
+
+static void broadphase_update_sap(Broadphase* broadphase)
+{
+	SweepAndPrune* sap = &broadphase->sap;
+	const int count = broadphase->proxy_count;
+	const BroadphaseAABB* aabbs = broadphase->aabbs.data();
+
+	// ߽  а   ؾ sweep  proxy  .
+	double sums[3] = { 0.0, 0.0, 0.0 };
+	double square_sums[3] = { 0.0, 0.0, 0.0 };
+	double size_sums[3] = { 0.0, 0.0, 0.0 };
+	glm::vec3 bounds_min(FLT_MAX), bounds_max(-FLT_MAX);
+	for (int i = 0; i < count; ++i)
+	{
+		const glm::vec3 center = (aabbs[i].min + aabbs[i].max) * 0.5f;
+		for (int k = 0; k < 3; ++k)
+		{
+			sums[k] += center[k];
+			square_sums[k] += (double)center[k] * center[k];
+			size_sums[k] += aabbs[i].max[k] - aabbs[i].min[k];
+		}
+		bounds_min = glm::min(bounds_min, aabbs[i].min);
+		bounds_max = glm::max(bounds_max, aabbs[i].max);
+	}
+	int axis = 0;
+	double max_variance = -1.0;
+	for (int k = 0; k < 3; ++k)
+	{
+		const double mean = count > 0 ? sums[k] / count : 0.0;
+		const double variance = count > 0 ? square_sums[k] / count - mean * mean : 0.0;
+		if (variance > max_variance)
+		{
+			max_variance = variance;
+			axis = k;
+		}
+	}
+	const int axis_b = (axis + 1) % 3;
+	const int axis_c = (axis + 2) % 3;
+
+	//    ĵǾ Ƿ   Ѵ.  ٲų ʹ  Űܾ Ѵٸ ó Ѵ.
+	// min ٸ proxy  ؼ  ׻  Ѵ.
+	std::vector<int>& order = sap->order;
+	const auto less = [aabbs, axis](int a, int b)
+	{
+		const float key_a = aabbs[a].min[axis];
+		const float key_b = aabbs[b].min[axis];
+		return key_a < key_b || (key_a == key_b && a < b);
+	};
+
+	bool is_sorted = false;
+	sap->swap_count = 0;
+	if (axis == sap->axis && (int)order.size() == count)
+	{
+		const size_t max_swap_count = (size_t)count * SAP_MAX_SWAPS_PER_PROXY;
+		is_sorted = true;
+		for (int i = 1; i < count && is_sorted; ++i)
+		{
+			const int proxy = order[i];
+			int j = i;
+			while (j > 0 && less(proxy, order[j - 1]))
+			{
+				order[j] = order[j - 1];
+				--j;
+			}
+			order[j] = proxy;
+			sap->swap_count += i - j;
+			is_sorted = sap->swap_count <= max_swap_count;
+		}
+	}
+	if (!is_sorted)
+	{
+		if ((int)order.size() != count)
+		{
+			order.resize(count);
+			for (int i = 0; i < count; ++i)
+			{
+				order[i] = i;
+			}
+		}
+		std::sort(order.begin(), order.end(), less);
+	}
+	sap->axis = axis;
+
+	//    cell ϳ SAP_PROXIES_PER_CELL    .
+	// proxy  cell  cell  proxy øǷ  ũ  躸ٴ ũ Ѵ.
+	const int grid_axes[2] = { axis_b, axis_c };
+	const float extent_b = std::max(bounds_max[axis_b] - bounds_min[axis_b], 1e-6f);
+	const float extent_c = std::max(bounds_max[axis_c] - bounds_min[axis_c], 1e-6f);
+	const float target_cell_count = std::max(1.f, (float)count / SAP_PROXIES_PER_CELL);
+	const float average_size = count > 0 ? (float)std::max(size_sums[axis_b], size_sums[axis_c]) / count : 0.f;
+	const float cell_size = std::max(sqrtf(extent_b * extent_c / target_cell_count), 2.f * average_size);
+	for (int k = 0; k < 2; ++k)
+	{
+		const float extent = k == 0 ? extent_b : extent_c;
+		sap->cell_counts[k] = std::max(1, std::min(SAP_MAX_CELLS_PER_AXIS, (int)ceilf(extent / cell_size)));
+		sap->cell_origins[k] = count > 0 ? bounds_min[grid_axes[k]] : 0.f;
+		sap->inverse_cell_sizes[k] = sap->cell_counts[k] / extent;
+	}
+	const int cell_count = sap->cell_counts[0] * sap->cell_counts[1];
+
+	// ĵ  ģ cell Ƿ cell ȿ ĵǾ ִ. (counting sort)
+	std::vector<int>& cell_begins = sap->cell_begins;
+	cell_begins.assign(cell_count + 1, 0);
+	for (int s = 0; s < count; ++s)
+	{
+		const BroadphaseAABB& aabb = aabbs[order[s]];
+		const int cell_b_end = sap_cell(sap, 0, aabb.max[axis_b]);
+		const int cell_c_end = sap_cell(sap, 1, aabb.max[axis_c]);
+		for (int cell_c = sap_cell(sap, 1, aabb.min[axis_c]); cell_c <= cell_c_end; ++cell_c)
+		{
+			for (int cell_b = sap_cell(sap, 0, aabb.min[axis_b]); cell_b <= cell_b_end; ++cell_b)
+			{
+				++cell_begins[cell_c * sap->cell_counts[0] + cell_b];
+			}
+		}
+	}
+	int entry_count = 0;
+	for (int cell = 0; cell < cell_count; ++cell)
+	{
+		const int cell_entry_count = cell_begins[cell];
+		cell_begins[cell] = entry_count;
+		entry_count += cell_entry_count;
+	}
+	cell_begins[cell_count] = entry_count;
+
+	//  4 min  ũǷ  cell sweep ű⼭ .
+	sap->entries.resize(entry_count + 4);
+	for (int k = 0; k < 3; ++k)
+	{
+		sap->min[k].resize(entry_count + 4);
+		sap->max[k].resize(entry_count + 4);
+		for (int e = entry_count; e < entry_count + 4; ++e)
+		{
+			sap->min[k][e] = FLT_MAX;
+			sap->max[k][e] = -FLT_MAX;
+		}
+	}
+	for (int s = 0; s < count; ++s)
+	{
+		const int proxy = order[s];
+		const BroadphaseAABB& aabb = aabbs[proxy];
+		const int cell_b_end = sap_cell(sap, 0, aabb.max[axis_b]);
+		const int cell_c_end = sap_cell(sap, 1, aabb.max[axis_c]);
+		for (int cell_c = sap_cell(sap, 1, aabb.min[axis_c]); cell_c <= cell_c_end; ++cell_c)
+		{
+			for (int cell_b = sap_cell(sap, 0, aabb.min[axis_b]); cell_b <= cell_b_end; ++cell_b)
+			{
+				// cell_begins cursor    ĭ о ǵ.
+				const int e = cell_begins[cell_c * sap->cell_counts[0] + cell_b]++;
+				sap->entries[e] = proxy;
+				for (int k = 0; k < 3; ++k)
+				{
+					sap->min[k][e] = aabb.min[k];
+					sap->max[k][e] = aabb.max[k];
+				}
+			}
+		}
+	}
+	for (int cell = cell_count; cell > 0; --cell)
+	{
+		cell_begins[cell] = cell_begins[cell - 1];
+	}
+	cell_begins[0] = 0;
+
+	// cell  entry max  ʴ  entry    Ѵ.
+	const int batch_count = broadphase_prepare_batches(broadphase, cell_count, SAP_CELL_BATCH_SIZE);
+	parallel_for_range(cell_count, SAP_CELL_BATCH_SIZE, [broadphase, sap, axis, axis_b, axis_c](int begin, int end)
+	{
+		std::vector<BroadphasePair>* out_pairs = &(broadphase->batch_pairs[begin / SAP_CELL_BATCH_SIZE]);
+		const float* min_a = sap->min[axis].data();
+		const float* max_a = sap->max[axis].data();
+		const float* min_b = sap->min[axis_b].data();
+		const float* max_b = sap->max[axis_b].data();
+		const float* min_c = sap->min[axis_c].data();
+		const float* max_c = sap->max[axis_c].data();
+		const int* entries = sap->entries.data();
+
+		for (int cell = begin; cell < end; ++cell)
+		{
+			const int cell_b = cell % sap->cell_counts[0];
+			const int cell_c = cell / sap->cell_counts[0];
+			const int first = sap->cell_begins[cell];
+			const int last = sap->cell_begins[cell + 1];
+
+			//  entry AABB ģ  Ʒ 𼭸  cell   Ѵ. ( cell ߺ ʰ)
+			const auto add_pair = [&](int s, int e)
+			{
+				if (sap_cell(sap, 0, std::max(min_b[s], min_b[e])) != cell_b || sap_cell(sap, 1, std::max(min_c[s], min_c[e])) != cell_c)
+				{
+					return;
+				}
+				out_pairs->push_back({ std::min(entries[s], entries[e]), std::max(entries[s], entries[e]) });
+			};
+
+			for (int s = first; s < last; ++s)
+			{
+				const float s_max_a = max_a[s];
+#if BROADPHASE_SSE
+				const __m128 v_max_a = _mm_set1_ps(s_max_a);
+				const __m128 v_min_b = _mm_set1_ps(min_b[s]);
+				const __m128 v_max_b = _mm_set1_ps(max_b[s]);
+				const __m128 v_min_c = _mm_set1_ps(min_c[s]);
+				const __m128 v_max_c = _mm_set1_ps(max_c[s]);
+				for (int j = s + 1; j < last && min_a[j] <= s_max_a; j += 4)
+				{
+					// 4   max   ù ǿ, cell   lane ˻翡 .
+					const __m128 overlap_a = _mm_cmple_ps(_mm_loadu_ps(min_a + j), v_max_a);
+					const __m128 overlap_b = _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(min_b + j), v_max_b), _mm_cmpge_ps(_mm_loadu_ps(max_b + j), v_min_b));
+					const __m128 overlap_c = _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(min_c + j), v_max_c), _mm_cmpge_ps(_mm_loadu_ps(max_c + j), v_min_c));
+					const int mask = _mm_movemask_ps(_mm_and_ps(overlap_a, _mm_and_ps(overlap_b, overlap_c)));
+					if (mask == 0)
+					{
+						continue;
+					}
+					for (int lane = 0; lane < 4 && j + lane < last; ++lane)
+					{
+						if (mask & (1 << lane))
+						{
+							add_pair(s, j + lane);
+						}
+					}
+				}
+#else
+				for (int j = s + 1; j < last && min_a[j] <= s_max_a; ++j)
+				{
+					if (min_b[j] <= max_b[s] && max_b[j] >= min_b[s] && min_c[j] <= max_c[s] && max_c[j] >= min_c[s])
+					{
+						add_pair(s, j);
+					}
+				}
+#endif
+			}
+		}
+	});
+
+	std::vector<BroadphasePair>& pairs = broadphase->pairs;
+	pairs.clear();
+	for (int i = 0; i < batch_count; ++i)
+	{
+		pairs.insert(pairs.end(), broadphase->batch_pairs[i].begin(), broadphase->batch_pairs[i].end());
+	}
+	std::sort(pairs.begin(), pairs.end(), broadphase_pair_less);
+	broadphase->moved_count = count;
+}
+
+void broadphase_set_defaults()
+{
+	g_broadphase.type = BROADPHASE_TREE;
+	broadphase_clear(&g_broadphase);
+}
+
+void broadphase_print_usage()
+{
+	printf("  --broadphase tree|sap       physics broadphase, dynamic AABB tree or sweep and prune (default tree)\n");
+	printf("  --broadphase-bench          run the broadphase tree/sap benchmark without a window and exit\n");
+}
+
+bool broadphase_parse_arg(int argc, char** argv, int* index)
+{
+	const char* arg = argv[*index];
+	if (strcmp(arg, "--broadphase-bench") == 0)
+	{
+		g_physics.test_mode = PHYSICS_TEST_BROADPHASE_BENCH;
+		return true;
+	}
+	if (strcmp(arg, "--broadphase") == 0 && *index + 1 < argc)
+	{
+		for (int type = 0; type < BROADPHASE_TYPE_COUNT; ++type)
+		{
+			if (strcmp(argv[*index + 1], BROADPHASE_TYPE_NAMES[type]) == 0)
+			{
+				g_broadphase.type = type;
+				++(*index);
+				return true;
+			}
+		}
+		return false;
+	}
+	return false;
+}
+
+void broadphase_clear(Broadphase* broadphase)
+{
+	broadphase->proxy_count = 0;
+	broadphase->aabbs.clear();
+	broadphase->pairs.clear();
+	broadphase->moved_count = 0;
+
+	AABBTree* tree = &broadphase->tree;
+	tree->nodes.clear();
+	tree->root = -1;
+	tree->free_list = -1;
+	tree->leaves.clear();
+	tree->moved_proxies.clear();
+	tree->is_moved.clear();
+	tree->rotation_count = 0;
+
+	SweepAndPrune* sap = &broadphase->sap;
+	sap->axis = -1;
+	sap->order.clear();
+	sap->cell_counts[0] = sap->cell_counts[1] = 0;
+	sap->cell_begins.clear();
+	sap->entries.clear();
+	sap->swap_count = 0;
+}
+
+void broadphase_update(Broadphase* broadphase, const BroadphaseAABB* aabbs, const glm::vec3* displacements, int count)
+{
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	const int last_tag = memory_tag_begin(MEMORY_TAG_PHYSICS);
+
+	if (count != broadphase->proxy_count)
+	{
+		const int type = broadphase->type;
+		broadphase_clear(broadphase);
+		broadphase->type = type;
+		broadphase->proxy_count = count;
+	}
+	broadphase->aabbs.assign(aabbs, aabbs + count);
+
+	if (broadphase->type == BROADPHASE_TREE)
+	{
+		broadphase_update_tree(broadphase, displacements);
+	}
+	else
+	{
+		broadphase_update_sap(broadphase);
+	}
+
+	memory_tag_end(last_tag);
+	broadphase->update_ms = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void broadphase_query_aabb(const Broadphase* broadphase, const BroadphaseAABB& aabb, std::vector<int>* out_proxies)
+{
+	out_proxies->clear();
+	if (broadphase->type == BROADPHASE_TREE)
+	{
+		aabb_tree_query(&broadphase->tree, aabb, [out_proxies](int proxy)
+		{
+			out_proxies->push_back(proxy);
+		});
+	}
+	else if (broadphase->sap.axis >= 0)
+	{
+		// aabb ģ cell   min aabb max  պκи .  cell ִ proxy  ϳ .
+		const SweepAndPrune* sap = &broadphase->sap;
+		const int axis = sap->axis;
+		const float* min_a = sap->min[axis].data();
+		const int cell_b_end = sap_cell(sap, 0, aabb.max[(axis + 1) % 3]);
+		const int cell_c_end = sap_cell(sap, 1, aabb.max[(axis + 2) % 3]);
+		for (int cell_c = sap_cell(sap, 1, aabb.min[(axis + 2) % 3]); cell_c <= cell_c_end; ++cell_c)
+		{
+			for (int cell_b = sap_cell(sap, 0, aabb.min[(axis + 1) % 3]); cell_b <= cell_b_end; ++cell_b)
+			{
+				const int cell = cell_c * sap->cell_counts[0] + cell_b;
+				const int first = sap->cell_begins[cell];
+				const int end = (int)(std::upper_bound(min_a + first, min_a + sap->cell_begins[cell + 1], aabb.max[axis]) - min_a);
+#if BROADPHASE_SSE
+				__m128 v_min[3], v_max[3];
+				for (int k = 0; k < 3; ++k)
+				{
+					v_min[k] = _mm_set1_ps(aabb.min[k]);
+					v_max[k] = _mm_set1_ps(aabb.max[k]);
+				}
+				for (int e = first; e < end; e += 4)
+				{
+					__m128 overlap = _mm_castsi128_ps(_mm_set1_epi32(-1));
+					for (int k = 0; k < 3; ++k)
+					{
+						overlap = _mm_and_ps(overlap, _mm_cmple_ps(_mm_loadu_ps(sap->min[k].data() + e), v_max[k]));
+						overlap = _mm_and_ps(overlap, _mm_cmpge_ps(_mm_loadu_ps(sap->max[k].data() + e), v_min[k]));
+					}
+					const int mask = _mm_movemask_ps(overlap);
+					for (int lane = 0; lane < 4 && e + lane < end; ++lane)
+					{
+						if (mask & (1 << lane))
+						{
+							out_proxies->push_back(sap->entries[e + lane]);
+						}
+					}
+				}
+#else
+				for (int e = first; e < end; ++e)
+				{
+					const BroadphaseAABB other = { glm::vec3(sap->min[0][e], sap->min[1][e], sap->min[2][e]), glm::vec3(sap->max[0][e], sap->max[1][e], sap->max[2][e]) };
+					if (broadphase_overlap(other, aabb))
+					{
+						out_proxies->push_back(sap->entries[e]);
+					}
+				}
+#endif
+			}
+		}
+	}
+	std::sort(out_proxies->begin(), out_proxies->end());
+	out_proxies->erase(std::unique(out_proxies->begin(), out_proxies->end()), out_proxies->end());
+}
+
+int broadphase_raycast(const Broadphase* broadphase, const glm::vec3& origin, const glm::vec3& direction, float max_distance, float padding,
+	const std::function<float(int proxy, float max_distance)>& hit_function, float* out_distance)
+{
+	const glm::vec3 inverse_direction = broadphase_inverse_direction(direction);
+	int best_proxy = -1;
+	float best_distance = max_distance;
+
+	if (broadphase->type == BROADPHASE_TREE)
+	{
+		const AABBTree* tree = &broadphase->tree;
+		int stack[AABB_TREE_STACK_SIZE];
+		int stack_size = 0;
+		if (tree->root != -1)
+		{
+			stack[stack_size++] = tree->root;
+		}
+		while (stack_size > 0)
+		{
+			const AABBTreeNode& node = tree->nodes[stack[--stack_size]];
+			const BroadphaseAABB aabb = { node.aabb.min - padding, node.aabb.max + padding };
+			if (broadphase_ray_aabb(origin, inverse_direction, best_distance, aabb) < 0.f)
+			{
+				continue;
+			}
+
+			if (node.child1 == -1)
+			{
+				broadphase_raycast_hit(node.proxy, best_distance, hit_function, &best_proxy, &best_distance);
+			}
+			else
+			{
+				assert(stack_size + 2 <= AABB_TREE_STACK_SIZE);
+				stack[stack_size++] = node.child1;
+				stack[stack_size++] = node.child2;
+			}
+		}
+	}
+	else if (broadphase->sap.axis >= 0)
+	{
+		//  ray   Ƿ  entry 4 slab test Ѵ.  cell ִ proxy Ÿ Ƿ   .
+		const SweepAndPrune* sap = &broadphase->sap;
+		const int count = sap->cell_begins.empty() ? 0 : sap->cell_begins.back();
+#if BROADPHASE_SSE
+		__m128 v_origin[3], v_inverse[3];
+		const __m128 v_padding = _mm_set1_ps(padding);
+		for (int k = 0; k < 3; ++k)
+		{
+			v_origin[k] = _mm_set1_ps(origin[k]);
+			v_inverse[k] = _mm_set1_ps(inverse_direction[k]);
+		}
+		for (int s = 0; s < count; s += 4)
+		{
+			__m128 t_enter = _mm_setzero_ps();
+			__m128 t_exit = _mm_set1_ps(best_distance);
+			for (int k = 0; k < 3; ++k)
+			{
+				const __m128 t1 = _mm_mul_ps(_mm_sub_ps(_mm_sub_ps(_mm_loadu_ps(sap->min[k].data() + s), v_padding), v_origin[k]), v_inverse[k]);
+				const __m128 t2 = _mm_mul_ps(_mm_sub_ps(_mm_add_ps(_mm_loadu_ps(sap->max[k].data() + s), v_padding), v_origin[k]), v_inverse[k]);
+				t_enter = _mm_max_ps(t_enter, _mm_min_ps(t1, t2));
+				t_exit = _mm_min_ps(t_exit, _mm_max_ps(t1, t2));
+			}
+			const int mask = _mm_movemask_ps(_mm_cmple_ps(t_enter, t_exit));
+			for (int lane = 0; lane < 4 && s + lane < count; ++lane)
+			{
+				if (mask & (1 << lane))
+				{
+					broadphase_raycast_hit(sap->entries[s + lane], best_distance, hit_function, &best_proxy, &best_distance);
+				}
+			}
+		}
+#else
+		for (int s = 0; s < count; ++s)
+		{
+			const BroadphaseAABB aabb = { glm::vec3(sap->min[0][s], sap->min[1][s], sap->min[2][s]) - padding, glm::vec3(sap->max[0][s], sap->max[1][s], sap->max[2][s]) + padding };
+			if (broadphase_ray_aabb(origin, inverse_direction, best_distance, aabb) >= 0.f)
+			{
+				broadphase_raycast_hit(sap->entries[s], best_distance, hit_function, &best_proxy, &best_distance);
+			}
+		}
+#endif
+	}
+
+	if (out_distance != nullptr)
+	{
+		*out_distance = best_proxy != -1 ? best_distance : -1.f;
+	}
+	return best_proxy;
+}
+
+
+// --broadphase-bench
+
+//  ̶ ׻  0 ~ 1 
+static float broadphase_hash01(uint32_t value)
+{
+	value ^= value >> 16;
+	value *= 0x7FEB352Du;
+	value ^= value >> 15;
+	value *= 0x846CA68Bu;
+	value ^= value >> 16;
+	return (float)(value & 0xFFFFFF) / (float)0xFFFFFF;
+}
+
+struct BroadphaseBenchScene
+{
+	float half_size;
+	std::vector<glm::vec3> positions;
+	std::vector<glm::vec3> velocities;
+	std::vector<glm::vec3> half_extents;
+	std::vector<BroadphaseAABB> aabbs;
+	std::vector<glm::vec3> displacements;
+};
+
+// е  proxy    ũ⸦ ϰ, ũ ӵ ٸ proxy  ´. moving_percent  proxy  ִ.
+static void broadphase_bench_reset(BroadphaseBenchScene* scene, int count, int moving_percent)
+{
+	scene->half_size = 1.5f * cbrtf((float)count);
+	scene->positions.resize(count);
+	scene->velocities.resize(count);
+	scene->half_extents.resize(count);
+	scene->aabbs.resize(count);
+	scene->displacements.assign(count, glm::vec3(0.f));
+	for (int i = 0; i < count; ++i)
+	{
+		for (int k = 0; k < 3; ++k)
+		{
+			scene->positions[i][k] = (broadphase_hash01(i * 8 + k) * 2.f - 1.f) * scene->half_size;
+			scene->velocities[i][k] = (broadphase_hash01(i * 8 + 3 + k) * 2.f - 1.f) * 3.f;
+		}
+		if (broadphase_hash01(i * 8 + 7) * 100.f >= (float)moving_percent)
+		{
+			scene->velocities[i] = glm::vec3(0.f);
+		}
+		scene->half_extents[i] = glm::vec3(0.25f + 0.5f * broadphase_hash01(i * 8 + 6));
+		scene->aabbs[i] = { scene->positions[i] - scene->half_extents[i], scene->positions[i] + scene->half_extents[i] };
+	}
+}
+
+//   ƨ dtŭ δ.
+static void broadphase_bench_move(BroadphaseBenchScene* scene, float dt)
+{
+	const int count = (int)scene->positions.size();
+	for (int i = 0; i < count; ++i)
+	{
+		glm::vec3& position = scene->positions[i];
+		glm::vec3& velocity = scene->velocities[i];
+		const glm::vec3 previous = position;
+		position += velocity * dt;
+		for (int k = 0; k < 3; ++k)
+		{
+			if (fabsf(position[k]) > scene->half_size)
+			{
+				velocity[k] = -velocity[k];
+				position[k] = std::max(-scene->half_size, std::min(scene->half_size, position[k]));
+			}
+		}
+		scene->displacements[i] = position - previous;
+		scene->aabbs[i] = { position - scene->half_extents[i], position + scene->half_extents[i] };
+	}
+}
+
+//  AABB ġ pair . (tree pair fat AABB ã ̴.)
+static std::vector<BroadphasePair> broadphase_bench_exact_pairs(const std::vector<BroadphasePair>& pairs, const std::vector<BroadphaseAABB>& aabbs)
+{
+	std::vector<BroadphasePair> exact_pairs;
+	for (const BroadphasePair& pair : pairs)
+	{
+		if (broadphase_overlap(aabbs[pair.a], aabbs[pair.b]))
+		{
+			exact_pairs.push_back(pair);
+		}
+	}
+	return exact_pairs;
+}
+
+static bool broadphase_bench_same_pairs(const std::vector<BroadphasePair>& a, const std::vector<BroadphasePair>& b)
+{
+	return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), broadphase_pair_equal);
+}
+
+bool broadphase_run_bench()
+{
+	constexpr int QUERY_COUNT = 200;
+	constexpr int BRUTE_FORCE_MAX_COUNT = 10000;
+
+	job_system_init(g_job_system.requested_worker_count);
+
+	const float dt = 1.f / 60.f;
+	printf("Broadphase bench : %d frames of moving boxes, %d threads\n", BROADPHASE_BENCH_FRAME_COUNT, g_job_system.worker_count + 1);
+	printf("      proxies  moving  type   update ms      pairs    moved  height  rotations  swaps\n");
+
+	bool is_pair_same = true;
+	bool is_query_same = true;
+	bool is_raycast_same = true;
+	bool is_balanced = true;
+	BroadphaseBenchScene scene;
+	Broadphase broadphases[BROADPHASE_TYPE_COUNT];
+	for (int count : BROADPHASE_BENCH_PROXY_COUNTS)
+	{
+		for (int moving_percent : BROADPHASE_BENCH_MOVING_PERCENTS)
+		{
+			std::vector<BroadphasePair> exact_pairs[BROADPHASE_TYPE_COUNT];
+			for (int type = 0; type < BROADPHASE_TYPE_COUNT; ++type)
+			{
+				Broadphase* broadphase = &broadphases[type];
+				broadphase_clear(broadphase);
+				broadphase->type = type;
+
+				// ù update(ü , )  ʴ´.
+				broadphase_bench_reset(&scene, count, moving_percent);
+				broadphase_update(broadphase, scene.aabbs.data(), scene.displacements.data(), count);
+
+				float total_ms = 0.f;
+				size_t total_pair_count = 0;
+				size_t total_moved_count = 0;
+				size_t total_swap_count = 0;
+				for (int frame = 0; frame < BROADPHASE_BENCH_FRAME_COUNT; ++frame)
+				{
+					broadphase_bench_move(&scene, dt);
+					broadphase_update(broadphase, scene.aabbs.data(), scene.displacements.data(), count);
+					total_ms += broadphase->update_ms;
+					total_pair_count += broadphase->pairs.size();
+					total_moved_count += broadphase->moved_count;
+					total_swap_count += broadphase->sap.swap_count;
+				}
+				exact_pairs[type] = broadphase_bench_exact_pairs(broadphase->pairs, scene.aabbs);
+
+				const int height = type == BROADPHASE_TREE ? aabb_tree_height(&broadphase->tree) : 0;
+				if (type == BROADPHASE_TREE)
+				{
+					// ȸ ǥ  ̵ log2(leaf )  踦 ũ  ʾƾ Ѵ.
+					is_balanced &= height <= 2 * (int)ceil(log2((double)count)) + 1;
+				}
+				printf("  %11d %6d%%  %-4s %11.3f %10zu %8zu %7d %10u %6zu\n", count, moving_percent, BROADPHASE_TYPE_NAMES[type],
+					total_ms / BROADPHASE_BENCH_FRAME_COUNT, total_pair_count / BROADPHASE_BENCH_FRAME_COUNT,
+					total_moved_count / BROADPHASE_BENCH_FRAME_COUNT, height, broadphase->tree.rotation_count,
+					total_swap_count / BROADPHASE_BENCH_FRAME_COUNT);
+			}
+
+			//   ã  ġ pair ƾ ϰ,    pair  Ͱ ƾ Ѵ.
+			is_pair_same &= broadphase_bench_same_pairs(exact_pairs[BROADPHASE_TREE], exact_pairs[BROADPHASE_SAP]);
+			if (count <= BRUTE_FORCE_MAX_COUNT)
+			{
+				std::vector<BroadphasePair> brute_force_pairs;
+				for (int a = 0; a < count; ++a)
+				{
+					for (int b = a + 1; b < count; ++b)
+					{
+						if (broadphase_overlap(scene.aabbs[a], scene.aabbs[b]))
+						{
+							brute_force_pairs.push_back({ a, b });
+						}
+					}
+				}
+				is_pair_same &= broadphase_bench_same_pairs(exact_pairs[BROADPHASE_TREE], brute_force_pairs);
+			}
+
+			// AABB query raycast    proxy  Ѵ.
+			std::vector<int> proxies[BROADPHASE_TYPE_COUNT];
+			for (int query = 0; query < QUERY_COUNT; ++query)
+			{
+				glm::vec3 center, direction;
+				for (int k = 0; k < 3; ++k)
+				{
+					center[k] = (broadphase_hash01(0x10000000u + query * 8 + k) * 2.f - 1.f) * scene.half_size;
+					direction[k] = broadphase_hash01(0x20000000u + query * 8 + k) * 2.f - 1.f;
+				}
+				direction = glm::normalize(direction);
+
+				const BroadphaseAABB aabb = { center - glm::vec3(2.f), center + glm::vec3(2.f) };
+				const glm::vec3 inverse_direction = broadphase_inverse_direction(direction);
+				const auto exact_hit_function = [&scene, &center, &inverse_direction](int proxy, float max_distance)
+				{
+					return broadphase_ray_aabb(center, inverse_direction, max_distance, scene.aabbs[proxy]);
+				};
+
+				int hit_proxies[BROADPHASE_TYPE_COUNT];
+				float hit_distances[BROADPHASE_TYPE_COUNT];
+				for (int type = 0; type < BROADPHASE_TYPE_COUNT; ++type)
+				{
+					broadphase_query_aabb(&broadphases[type], aabb, &proxies[type]);
+
+					// tree fat AABB ãǷ  AABB ġ ͸ .
+					proxies[type].erase(std::remove_if(proxies[type].begin(), proxies[type].end(), [&scene, &aabb](int proxy)
+					{
+						return !broadphase_overlap(scene.aabbs[proxy], aabb);
+					}), proxies[type].end());
+
+					hit_proxies[type] = broadphase_raycast(&broadphases[type], center, direction, scene.half_size * 4.f, 0.f, exact_hit_function, &hit_distances[type]);
+				}
+				is_query_same &= proxies[BROADPHASE_TREE] == proxies[BROADPHASE_SAP];
+				is_raycast_same &= hit_proxies[BROADPHASE_TREE] == hit_proxies[BROADPHASE_SAP] && hit_distances[BROADPHASE_TREE] == hit_distances[BROADPHASE_SAP];
+			}
+		}
+	}
+
+	for (Broadphase& broadphase : broadphases)
+	{
+		broadphase_clear(&broadphase);
+	}
+	job_system_terminate();
+
+	const bool is_success = is_pair_same && is_query_same && is_raycast_same && is_balanced;
+	printf("Broadphase bench %s : pairs match %s, aabb queries match %s, raycasts match %s, tree balanced %s\n",
+		is_success ? "passed" : "FAILED", is_pair_same ? "yes" : "no", is_query_same ? "yes" : "no",
+		is_raycast_same ? "yes" : "no", is_balanced ? "yes" : "no");
+	return is_success;
+}
+
+void broadphase_draw_gui()
+{
+	ImGui::Text("Broadphase"); ImGui::SameLine();
+	if (ImGui::Combo("##Broadphase", &g_broadphase.type, "Dynamic AABB Tree\0Sweep And Prune\0"))
+	{
+		broadphase_clear(&g_broadphase);
+	}
+
+	if (g_broadphase.type == BROADPHASE_TREE)
+	{
+		ImGui::Text("Pairs %d, reinserted %d, height %d, rotations %u, %.3f ms", (int)g_broadphase.pairs.size(), g_broadphase.moved_count,
+			aabb_tree_height(&g_broadphase.tree), g_broadphase.tree.rotation_count, g_broadphase.update_ms);
+	}
+	else
+	{
+		ImGui::Text("Pairs %d, axis %c, cells %dx%d, swaps %d, %.3f ms", (int)g_broadphase.pairs.size(), g_broadphase.sap.axis >= 0 ? "xyz"[g_broadphase.sap.axis] : '-',
+			g_broadphase.sap.cell_counts[0], g_broadphase.sap.cell_counts[1], (int)g_broadphase.sap.swap_count, g_broadphase.update_ms);
+	}
+}
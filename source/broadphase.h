@@ -0,0 +1,167 @@
+#ifndef __BROADPHASE_H__
+#define __BROADPHASE_H__
+
+#include <stdint.h>
+#include <vector>
+#include <functional>
+
+#include "glm/glm.hpp"
+
+// broadphase. proxy(0 ~ count - 1) AABB ޾Ƽ ĥ  ִ pair , raycast/AABB query Ѵ.
+//     ϳ .
+//   tree : dynamic AABB tree. leaf margin ̵ ⸸ŭ ø (fat) AABB ,  AABB     ٽ ִ´.
+//           ġ θ ǥ   þ  , ö鼭 ڽİ ڸ ٲ(ȸ) ǥ پٸ ٲ۴.
+//          pair  pair  fat AABB  ġ Ϳ, ٽ  proxy query  Ѵ.
+//   sap  : sweep and prune. AABB ߽ л  ū  min ϰ(   ),    grid .
+//          cell ĵ   proxy max  ʴ  proxy 4    SSE Ѵ.
+//           cell ģ pair ģ  Ʒ 𼭸 ִ cell Ѵ.
+//    pair (a < b)̰ a, b  ĵǾ Ƿ job    .
+// tree pair fat AABB ġ pair Ƿ,  AABB ġ ͸  sap pair .
+//  :
+//   broadphase_update(&g_broadphase, aabbs, displacements, count);
+//   for (const BroadphasePair& pair : g_broadphase.pairs) { ... }
+//   int proxy = broadphase_raycast(&g_broadphase, origin, direction, max_distance, padding, hit_function, &distance);
+//
+// command line : [--broadphase tree|sap] [--broadphase-bench]
+
+// tree leaf AABB ø . ̵(displacement)  ŭ    ø.
+constexpr float BROADPHASE_AABB_MARGIN = 0.1f;
+constexpr float BROADPHASE_DISPLACEMENT_MULTIPLIER = 4.f;
+
+// pair   job ϳ ô proxy 
+constexpr int BROADPHASE_BATCH_SIZE = 1024;
+
+// --broadphase-bench proxy  ̴ proxy (%)
+constexpr int BROADPHASE_BENCH_PROXY_COUNTS[] = { 1000, 10000, 100000 };
+constexpr int BROADPHASE_BENCH_MOVING_PERCENTS[] = { 100, 10 };
+constexpr int BROADPHASE_BENCH_FRAME_COUNT = 30;
+
+enum BroadphaseType
+{
+	BROADPHASE_TREE = 0,
+	BROADPHASE_SAP,
+	BROADPHASE_TYPE_COUNT
+};
+extern const char* BROADPHASE_TYPE_NAMES[BROADPHASE_TYPE_COUNT];
+
+struct BroadphaseAABB
+{
+	glm::vec3 min;
+	glm::vec3 max;
+};
+
+struct BroadphasePair
+{
+	int a;
+	int b;
+};
+
+struct AABBTreeNode
+{
+	BroadphaseAABB aabb;
+
+	//  node   node
+	int parent;
+
+	// leaf child1 -1̰ proxy ִ.
+	int child1;
+	int child2;
+	int proxy;
+
+	// leaf 0,  node -1
+	int height;
+};
+
+struct AABBTree
+{
+	std::vector<AABBTreeNode> nodes;
+	int root;
+	int free_list;
+
+	// proxy -> leaf node
+	std::vector<int> leaves;
+
+	// ̹ update ٽ  proxy proxy  ǥ
+	std::vector<int> moved_proxies;
+	std::vector<uint8_t> is_moved;
+
+	unsigned rotation_count;
+};
+
+struct SweepAndPrune
+{
+	//   (0 : x, 1 : y, 2 : z). -1̶   ʾҴ.
+	int axis;
+
+	// ĵ  proxy
+	std::vector<int> order;
+
+	//   ((axis + 1) % 3, (axis + 2) % 3)  grid. cell i entry [cell_begins[i], cell_begins[i + 1])
+	int cell_counts[2];
+	float cell_origins[2];
+	float inverse_cell_sizes[2];
+	std::vector<int> cell_begins;
+
+	// cell ̰ cell ȿ ĵ  entry proxy AABB (  SoA).  4  д.
+	std::vector<int> entries;
+	std::vector<float> min[3];
+	std::vector<float> max[3];
+
+	//  Ŀ ű Ƚ
+	size_t swap_count;
+};
+
+struct Broadphase
+{
+	int type;
+
+	int proxy_count;
+	std::vector<BroadphaseAABB> aabbs;
+
+	AABBTree tree;
+	SweepAndPrune sap;
+
+	std::vector<BroadphasePair> pairs;
+
+	// job batch   pair.  ̾ δ.
+	std::vector<std::vector<BroadphasePair>> batch_pairs;
+
+	//  (GUI)
+	float update_ms;
+	int moved_count;
+};
+extern Broadphase g_broadphase;
+
+void broadphase_set_defaults();
+void broadphase_print_usage();
+
+// argv[*index] broadphase ɼ̶  а index ű  true ش. (physics_parse_arg)
+bool broadphase_parse_arg(int argc, char** argv, int* index);
+
+//  AABB ġ (踦 Ѵ.)
+bool broadphase_overlap(const BroadphaseAABB& a, const BroadphaseAABB& b);
+
+//  proxy . type ٲ ڿ θ.
+void broadphase_clear(Broadphase* broadphase);
+
+// proxy i AABB  update  ̵. count ٲ ó ٽ .
+void broadphase_update(Broadphase* broadphase, const BroadphaseAABB* aabbs, const glm::vec3* displacements, int count);
+
+// aabb ġ proxy (tree fat AABB Ѵ.)
+void broadphase_query_aabb(const Broadphase* broadphase, const BroadphaseAABB& aabb, std::vector<int>* out_proxies);
+
+// AABB  proxy hit_function(proxy, ݱ   Ÿ) θ. ¾Ҵٸ Ÿ, ƴ϶  ش.
+// AABB ึ paddingŭ ÷ Ѵ. (update ڿ proxy   )
+//   proxy Ÿ. ٸ -1
+int broadphase_raycast(const Broadphase* broadphase, const glm::vec3& origin, const glm::vec3& direction, float max_distance, float padding,
+	const std::function<float(int proxy, float max_distance)>& hit_function, float* out_distance);
+
+// tree .  Ȯο .
+int aabb_tree_height(const AABBTree* tree);
+
+// --broadphase-bench. â̳ GL context  proxy    update ð  pair/query   ϰ .
+bool broadphase_run_bench();
+
+void broadphase_draw_gui();
+
+#endif
@@ -0,0 +1,285 @@
+#include "dynamic_resolution.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <assert.h>
+#include <vector>
+
+#include "imgui/imgui.h"
+#include "gl_state.h"
+#include "gpu_profiler.h"
+#include "memory_tracker.h"
+#include "utility.h"
+
+DynamicResolution g_dynamic_resolution;
+
+// GPU   frame ʰ Ƿ ϴ scale    ʰ  ŭ 󰣴.
+constexpr float DYNAMIC_RESOLUTION_DAMPING = 0.3f;
+
+void dynamic_resolution_print_usage()
+{
+	printf("  --dynamic-resolution MS     scale the scene resolution to keep the GPU frame time under MS\n");
+}
+
+void dynamic_resolution_set_defaults()
+{
+	memset(&g_dynamic_resolution, 0, sizeof(DynamicResolution));
+	g_dynamic_resolution.budget_ms = DYNAMIC_RESOLUTION_DEFAULT_BUDGET_MS;
+	g_dynamic_resolution.min_scale = DYNAMIC_RESOLUTION_MIN_SCALE;
+	g_dynamic_resolution.max_scale = DYNAMIC_RESOLUTION_MAX_SCALE;
+	g_dynamic_resolution.filter = UPSCALE_SHARPEN;
+	g_dynamic_resolution.sharpness = 0.5f;
+	g_dynamic_resolution.desired_scale = DYNAMIC_RESOLUTION_MAX_SCALE;
+	g_dynamic_resolution.scale = DYNAMIC_RESOLUTION_MAX_SCALE;
+}
+
+bool dynamic_resolution_parse_arg(int argc, char** argv, int* index)
+{
+	const char* arg = argv[*index];
+	if (*index + 1 >= argc || strcmp(arg, "--dynamic-resolution") != 0)
+	{
+		return false;
+	}
+
+	const float budget_ms = (float)atof(argv[*index + 1]);
+	if (budget_ms <= 0.f)
+	{
+		return false;
+	}
+
+	g_dynamic_resolution.is_enable = true;
+	g_dynamic_resolution.budget_ms = budget_ms;
+	++(*index);
+	return true;
+}
+
+void dynamic_resolution_init()
+{
+	std::vector<char> shader_source;
+
+	// ui_composite.vert vertex buffer  ȭ ü  ﰢ ϳ .
+	file_open_fill_buffer("ui_composite.vert", shader_source);
+	GLuint vso = glCreateShader(GL_VERTEX_SHADER);
+	gl_validate_shader(vso, (const char*)shader_source.data());
+
+	file_open_fill_buffer("upscale_sharpen.frag", shader_source);
+	GLuint fso = glCreateShader(GL_FRAGMENT_SHADER);
+	gl_validate_shader(fso, (const char*)shader_source.data());
+
+	GLuint pso = glCreateProgram();
+	gl_validate_program(pso, vso, fso);
+
+	g_dynamic_resolution.shader_vertex = vso;
+	g_dynamic_resolution.shader_frag = fso;
+	g_dynamic_resolution.pso_sharpen = pso;
+	g_dynamic_resolution.loc_scene_texture = glGetUniformLocation(pso, "scene_texture");
+	g_dynamic_resolution.loc_uv_scale = glGetUniformLocation(pso, "uv_scale");
+	g_dynamic_resolution.loc_output_size = glGetUniformLocation(pso, "output_size");
+	g_dynamic_resolution.loc_sharpness = glGetUniformLocation(pso, "sharpness");
+
+	glGenVertexArrays(1, &(g_dynamic_resolution.vao));
+}
+
+static void dynamic_resolution_destroy_target()
+{
+	if (g_dynamic_resolution.fbo == 0)
+	{
+		return;
+	}
+
+	memory_tracker_gpu_release(GPU_MEMORY_TEXTURE, g_dynamic_resolution.color_texture);
+	memory_tracker_gpu_release(GPU_MEMORY_RENDERBUFFER, g_dynamic_resolution.rbo_depth);
+	glDeleteFramebuffers(1, &(g_dynamic_resolution.fbo));
+	glDeleteTextures(1, &(g_dynamic_resolution.color_texture));
+	glDeleteRenderbuffers(1, &(g_dynamic_resolution.rbo_depth));
+	g_dynamic_resolution.fbo = 0;
+	g_dynamic_resolution.color_texture = 0;
+	g_dynamic_resolution.rbo_depth = 0;
+	g_dynamic_resolution.target_width = 0;
+	g_dynamic_resolution.target_height = 0;
+}
+
+void dynamic_resolution_terminate()
+{
+	dynamic_resolution_destroy_target();
+	glDeleteVertexArrays(1, &(g_dynamic_resolution.vao));
+	glDeleteProgram(g_dynamic_resolution.pso_sharpen);
+	glDeleteShader(g_dynamic_resolution.shader_frag);
+	glDeleteShader(g_dynamic_resolution.shader_vertex);
+}
+
+static void dynamic_resolution_create_target(int width, int height)
+{
+	dynamic_resolution_destroy_target();
+
+	glGenTextures(1, &(g_dynamic_resolution.color_texture));
+	glBindTexture(GL_TEXTURE_2D, g_dynamic_resolution.color_texture);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+	memory_tracker_gpu_set(GPU_MEMORY_TEXTURE, g_dynamic_resolution.color_texture, (size_t)width * height * 4);
+
+	// Hi-Z build glCopyTexSubImage2D оǷ headless target  depth format .
+	glGenRenderbuffers(1, &(g_dynamic_resolution.rbo_depth));
+	glBindRenderbuffer(GL_RENDERBUFFER, g_dynamic_resolution.rbo_depth);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
+	memory_tracker_gpu_set(GPU_MEMORY_RENDERBUFFER, g_dynamic_resolution.rbo_depth, (size_t)width * height * 4);
+	glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+	glGenFramebuffers(1, &(g_dynamic_resolution.fbo));
+	glBindFramebuffer(GL_FRAMEBUFFER, g_dynamic_resolution.fbo);
+	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, g_dynamic_resolution.color_texture, 0);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, g_dynamic_resolution.rbo_depth);
+	if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+	{
+		printf("Dynamic resolution framebuffer is not complete\n");
+		assert(false);
+	}
+
+	g_dynamic_resolution.target_width = width;
+	g_dynamic_resolution.target_height = height;
+}
+
+static void dynamic_resolution_update_scale()
+{
+	const ProfilerScope* frame_scope = gpu_profiler_find("Frame");
+	if (frame_scope == NULL || frame_scope->gpu_result_count == g_dynamic_resolution.last_gpu_result_count)
+	{
+		return;
+	}
+	g_dynamic_resolution.last_gpu_result_count = frame_scope->gpu_result_count;
+
+	const float gpu_ms = gpu_profiler_latest_gpu_ms(frame_scope);
+	g_dynamic_resolution.last_gpu_ms = gpu_ms;
+	if (gpu_ms <= 0.f)
+	{
+		return;
+	}
+
+	// scene pixel  scale  ϹǷ, budget ð  ٸŭ scale ٲ۴.
+	const float ideal_scale = g_dynamic_resolution.scale * sqrtf(g_dynamic_resolution.budget_ms / gpu_ms);
+	float desired_scale = g_dynamic_resolution.desired_scale + (ideal_scale - g_dynamic_resolution.desired_scale) * DYNAMIC_RESOLUTION_DAMPING;
+	desired_scale = fminf(fmaxf(desired_scale, g_dynamic_resolution.min_scale), g_dynamic_resolution.max_scale);
+	g_dynamic_resolution.desired_scale = desired_scale;
+
+	// step ϳ ̻    scale ű.
+	if (fabsf(desired_scale - g_dynamic_resolution.scale) >= DYNAMIC_RESOLUTION_SCALE_STEP)
+	{
+		float scale = roundf(desired_scale / DYNAMIC_RESOLUTION_SCALE_STEP) * DYNAMIC_RESOLUTION_SCALE_STEP;
+		g_dynamic_resolution.scale = fminf(fmaxf(scale, g_dynamic_resolution.min_scale), g_dynamic_resolution.max_scale);
+	}
+}
+
+void dynamic_resolution_begin_scene(int width, int height)
+{
+	g_dynamic_resolution.is_offscreen = g_dynamic_resolution.is_enable && width > 0 && height > 0;
+	if (!g_dynamic_resolution.is_offscreen)
+	{
+		g_dynamic_resolution.desired_scale = g_dynamic_resolution.max_scale;
+		g_dynamic_resolution.scale = g_dynamic_resolution.max_scale;
+		g_dynamic_resolution.render_width = width;
+		g_dynamic_resolution.render_height = height;
+		return;
+	}
+
+	dynamic_resolution_update_scale();
+
+	if (width != g_dynamic_resolution.target_width || height != g_dynamic_resolution.target_height)
+	{
+		dynamic_resolution_create_target(width, height);
+	}
+
+	const float scale = g_dynamic_resolution.scale;
+	g_dynamic_resolution.render_width = (int)fmaxf((float)width * scale + 0.5f, 1.f);
+	g_dynamic_resolution.render_height = (int)fmaxf((float)height * scale + 0.5f, 1.f);
+
+	glBindFramebuffer(GL_FRAMEBUFFER, g_dynamic_resolution.fbo);
+	glViewport(0, 0, g_dynamic_resolution.render_width, g_dynamic_resolution.render_height);
+}
+
+void dynamic_resolution_end_scene(GLuint target_fbo)
+{
+	if (!g_dynamic_resolution.is_offscreen)
+	{
+		return;
+	}
+
+	const int width = g_dynamic_resolution.target_width;
+	const int height = g_dynamic_resolution.target_height;
+	const int render_width = g_dynamic_resolution.render_width;
+	const int render_height = g_dynamic_resolution.render_height;
+
+	// blit scissor test  ޴´.
+	gl_state_set_enable(GL_SCISSOR_TEST, false);
+
+	// ũⰡ ٸ ״ 縸 Ѵ.
+	// ø  glBlitFramebuffer GL_LINEAR source  ( ʴ κ)   Ƿ
+	// bilinear uv   clamp ϴ shader Ѵ. (sharpness 0)
+	if (render_width == width && render_height == height)
+	{
+		glBindFramebuffer(GL_READ_FRAMEBUFFER, g_dynamic_resolution.fbo);
+		glBindFramebuffer(GL_DRAW_FRAMEBUFFER, target_fbo);
+		glBlitFramebuffer(0, 0, width, height, 0, 0, width, height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+		glBindFramebuffer(GL_FRAMEBUFFER, target_fbo);
+		glViewport(0, 0, width, height);
+		return;
+	}
+
+	glBindFramebuffer(GL_FRAMEBUFFER, target_fbo);
+	glViewport(0, 0, width, height);
+
+	const GLState last_state = g_gl_state;
+	gl_state_set_enable(GL_BLEND, false);
+	gl_state_set_enable(GL_CULL_FACE, false);
+	gl_state_set_enable(GL_DEPTH_TEST, false);
+	gl_state_set_enable(GL_STENCIL_TEST, false);
+	gl_state_set_polygon_mode(GL_FILL);
+
+	glUseProgram(g_dynamic_resolution.pso_sharpen);
+	glActiveTexture(GL_TEXTURE0);
+	glBindTexture(GL_TEXTURE_2D, g_dynamic_resolution.color_texture);
+	glUniform1i(g_dynamic_resolution.loc_scene_texture, 0);
+	glUniform2f(g_dynamic_resolution.loc_uv_scale, (float)render_width / (float)width, (float)render_height / (float)height);
+	glUniform2f(g_dynamic_resolution.loc_output_size, (float)width, (float)height);
+	glUniform1f(g_dynamic_resolution.loc_sharpness, g_dynamic_resolution.filter == UPSCALE_SHARPEN ? g_dynamic_resolution.sharpness : 0.f);
+	glBindVertexArray(g_dynamic_resolution.vao);
+	glDrawArrays(GL_TRIANGLES, 0, 3);
+	glBindVertexArray(0);
+
+	gl_state_restore(last_state);
+}
+
+void dynamic_resolution_draw_gui()
+{
+	ImGui::Text("Dynamic Resolution"); ImGui::SameLine();
+	ImGui::Checkbox("##DynamicResolution", &g_dynamic_resolution.is_enable);
+	if (!g_dynamic_resolution.is_enable)
+	{
+		return;
+	}
+
+	ImGui::Text("GPU Budget"); ImGui::SameLine();
+	ImGui::SliderFloat("##GPUBudget", &g_dynamic_resolution.budget_ms, 4.f, 50.f, "%.1f ms");
+	ImGui::Text("Min Scale"); ImGui::SameLine();
+	ImGui::SliderFloat("##MinScale", &g_dynamic_resolution.min_scale, DYNAMIC_RESOLUTION_MIN_SCALE, g_dynamic_resolution.max_scale, "%.2f");
+	ImGui::Text("Max Scale"); ImGui::SameLine();
+	ImGui::SliderFloat("##MaxScale", &g_dynamic_resolution.max_scale, g_dynamic_resolution.min_scale, DYNAMIC_RESOLUTION_MAX_SCALE, "%.2f");
+	ImGui::Text("Upscale Filter"); ImGui::SameLine();
+	ImGui::Combo("##UpscaleFilter", &g_dynamic_resolution.filter, "Bilinear\0Sharpen\0");
+	if (g_dynamic_resolution.filter == UPSCALE_SHARPEN)
+	{
+		ImGui::Text("Sharpness"); ImGui::SameLine();
+		ImGui::SliderFloat("##Sharpness", &g_dynamic_resolution.sharpness, 0.f, 1.f, "%.2f");
+	}
+
+	ImGui::Text("Scale %.2f (%dx%d) / GPU Frame %.3f ms", g_dynamic_resolution.scale,
+		g_dynamic_resolution.render_width, g_dynamic_resolution.render_height, g_dynamic_resolution.last_gpu_ms);
+	if (!g_gpu_profiler.is_supported || !g_gpu_profiler.is_enable)
+	{
+		ImGui::Text("(needs the GPU profiler to adapt)");
+	}
+}
@@ -0,0 +1,90 @@
+#ifndef __DYNAMIC_RESOLUTION_H__
+#define __DYNAMIC_RESOLUTION_H__
+
+#include "glad/glad.h"
+
+// Dynamic resolution.
+// scene(Clear/Model) framebuffer ۰ offscreen color/depth target ׸,
+// ImGui ׸  bilinear Ǵ sharpen filter framebuffer ũ⸸ŭ ÷ ű.
+//   scale GPU profiler "Frame" scope ð budget µ     Ѵ.
+//  :
+//   dynamic_resolution_begin_scene(width, height);
+//   (Clear, model_draw g_dynamic_resolution.render_width x render_height ׸.)
+//   dynamic_resolution_end_scene(target_fbo);
+//   ImGui ...
+//
+// command line : [--dynamic-resolution BUDGET_MS]
+
+constexpr float DYNAMIC_RESOLUTION_MIN_SCALE = 0.5f;
+constexpr float DYNAMIC_RESOLUTION_MAX_SCALE = 1.f;
+
+// scale  θ ٲ۴.  鸲 target ũ Hi-Z ٲ ʰ Ѵ.
+constexpr float DYNAMIC_RESOLUTION_SCALE_STEP = 0.05f;
+constexpr float DYNAMIC_RESOLUTION_DEFAULT_BUDGET_MS = 16.f;
+
+enum UpscaleFilter
+{
+	UPSCALE_BILINEAR = 0,
+	UPSCALE_SHARPEN,
+	UPSCALE_FILTER_COUNT
+};
+
+struct DynamicResolution
+{
+	bool is_enable;
+	float budget_ms;
+	float min_scale;
+	float max_scale;
+
+	int filter;
+	float sharpness;		// UPSCALE_SHARPEN  (0 ~ 1)
+
+	// controller ϴ scale, step  缭   scale
+	float desired_scale;
+	float scale;
+	unsigned last_gpu_result_count;
+	float last_gpu_ms;
+
+	// framebuffer ũ   Ʒ render_width x render_height ŭ .
+	// ׷ scale ٲ ٽ  ʴ´.
+	GLuint fbo;
+	GLuint color_texture;
+	GLuint rbo_depth;
+	int target_width;
+	int target_height;
+
+	// ̹ frame scene ׸ ũ.  ִٸ framebuffer ũ .
+	int render_width;
+	int render_height;
+	bool is_offscreen;
+
+	GLuint shader_vertex;
+	GLuint shader_frag;
+	GLuint pso_sharpen;
+	GLuint vao;
+	GLint loc_scene_texture;
+	GLint loc_uv_scale;
+	GLint loc_output_size;
+	GLint loc_sharpness;
+};
+extern DynamicResolution g_dynamic_resolution;
+
+void dynamic_resolution_set_defaults();
+void dynamic_resolution_print_usage();
+
+// argv[*index] dynamic resolution ɼ̶  а index ű  true ش.
+bool dynamic_resolution_parse_arg(int argc, char** argv, int* index);
+
+void dynamic_resolution_init();
+void dynamic_resolution_terminate();
+
+// gpu_profiler_begin_frame , scene ׸  ȣѴ.
+// GPU ð scale ϰ,  ִٸ offscreen target bind Ѵ.
+void dynamic_resolution_begin_scene(int width, int height);
+
+// scene  ׸  ȣѴ. offscreen ׷ȴٸ target_fbo framebuffer ũ ÷ ű.
+void dynamic_resolution_end_scene(GLuint target_fbo);
+
+void dynamic_resolution_draw_gui();
+
+#endif
@@ -0,0 +1,252 @@
+#include "frame_allocator.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <assert.h>
+
+#include "imgui/imgui.h"
+#include "memory_tracker.h"
+
+FrameAllocator g_frame_allocator;
+
+static FrameArenaBlock* frame_arena_create_block(size_t size)
+{
+	// block header ڰ Ҵ ̴.
+	FrameArenaBlock* block = (FrameArenaBlock*)memory_tracker_malloc(sizeof(FrameArenaBlock) + size, MEMORY_TAG_FRAME_ARENA);
+	if (block == nullptr)
+	{
+		printf("Fail to allocate frame arena block (%zu bytes)\n", size);
+		assert(false);
+		return nullptr;
+	}
+	block->next = nullptr;
+	block->size = size;
+	block->used = 0;
+	return block;
+}
+
+static void frame_arena_free_blocks(FrameArena* arena)
+{
+	FrameArenaBlock* block = arena->blocks;
+	while (block != nullptr)
+	{
+		FrameArenaBlock* next = block->next;
+		memory_tracker_free(block);
+		block = next;
+	}
+	arena->blocks = nullptr;
+}
+
+// ڶ block  ٿٸ, ʹ  block   ģ ũ⸦ block_size ݿѴ.
+static void frame_arena_update_block_size(const FrameArena* arena)
+{
+	if (arena->blocks == nullptr || arena->blocks->next == nullptr)
+	{
+		return;
+	}
+
+	size_t total_size = 0;
+	for (const FrameArenaBlock* block = arena->blocks; block != nullptr; block = block->next)
+	{
+		total_size += block->size;
+	}
+	if (total_size > g_frame_allocator.block_size)
+	{
+		g_frame_allocator.block_size = total_size;
+	}
+}
+
+static void frame_arena_reset(FrameArena* arena)
+{
+	if (arena->blocks == nullptr || arena->blocks->next != nullptr || arena->blocks->size < g_frame_allocator.block_size)
+	{
+		frame_arena_free_blocks(arena);
+		arena->blocks = frame_arena_create_block(g_frame_allocator.block_size);
+	}
+
+	arena->blocks->used = 0;
+	arena->used_bytes = 0;
+}
+
+static void* frame_arena_alloc(FrameArena* arena, size_t size, size_t alignment)
+{
+	FrameArenaBlock* block = arena->blocks;
+	if (block != nullptr)
+	{
+		uint8_t* base = (uint8_t*)(block + 1);
+		const uintptr_t current = (uintptr_t)(base + block->used);
+		const uintptr_t aligned = (current + (alignment - 1)) & ~(uintptr_t)(alignment - 1);
+		const size_t padding = (size_t)(aligned - current);
+		if (block->used + padding + size <= block->size)
+		{
+			block->used += padding + size;
+			arena->used_bytes += padding + size;
+			return (void*)aligned;
+		}
+	}
+
+	//  block տ δ.    ʿ ũ⿡ 굵  block   , ķ и ŭ Ѵ.
+	size_t block_size = block != nullptr ? block->size * 2 : g_frame_allocator.block_size;
+	while (block_size < size + alignment)
+	{
+		block_size *= 2;
+	}
+	FrameArenaBlock* new_block = frame_arena_create_block(block_size);
+	new_block->next = arena->blocks;
+	arena->blocks = new_block;
+	return frame_arena_alloc(arena, size, alignment);
+}
+
+void frame_allocator_print_usage()
+{
+	printf("  --zero-alloc-check FRAMES   fail if any frame after FRAMES warm-up frames allocates from the heap\n");
+}
+
+void frame_allocator_set_defaults()
+{
+	g_frame_allocator.check_warmup_frames = -1;
+}
+
+bool frame_allocator_parse_arg(int argc, char** argv, int* index)
+{
+	const char* arg = argv[*index];
+	if (*index + 1 >= argc)
+	{
+		return false;
+	}
+
+	const char* value = argv[*index + 1];
+	if (strcmp(arg, "--zero-alloc-check") == 0)
+	{
+		int warmup_frames = atoi(value);
+		if (warmup_frames < 0)
+		{
+			return false;
+		}
+		g_frame_allocator.check_warmup_frames = warmup_frames;
+	}
+	else
+	{
+		return false;
+	}
+
+	++(*index);
+	return true;
+}
+
+void frame_allocator_init()
+{
+	assert(!g_frame_allocator.is_init);
+
+	g_frame_allocator.buffer_index = 0;
+	g_frame_allocator.frame_count = 0;
+	g_frame_allocator.block_size = FRAME_ALLOCATOR_BLOCK_SIZE;
+	memset(g_frame_allocator.arenas, 0, sizeof(g_frame_allocator.arenas));
+	g_frame_allocator.last_frame_bytes = 0;
+	g_frame_allocator.peak_frame_bytes = 0;
+	g_frame_allocator.frame_start_heap_alloc_count = memory_tracker_alloc_count();
+	g_frame_allocator.last_frame_heap_allocs = 0;
+	g_frame_allocator.check_frame_count = 0;
+	g_frame_allocator.violation_frame_count = 0;
+	g_frame_allocator.is_init = true;
+}
+
+void frame_allocator_terminate()
+{
+	for (int buffer = 0; buffer < FRAME_ALLOCATOR_BUFFER_COUNT; ++buffer)
+	{
+		for (int thread = 0; thread < FRAME_ALLOCATOR_THREAD_COUNT; ++thread)
+		{
+			frame_arena_free_blocks(&(g_frame_allocator.arenas[buffer][thread]));
+		}
+	}
+	g_frame_allocator.is_init = false;
+}
+
+void frame_allocator_begin_frame()
+{
+	assert(g_frame_allocator.is_init);
+
+	// block ٽ  ͵ ̹ frame heap Ҵ .
+	g_frame_allocator.frame_start_heap_alloc_count = memory_tracker_alloc_count();
+
+	for (int buffer = 0; buffer < FRAME_ALLOCATOR_BUFFER_COUNT; ++buffer)
+	{
+		for (int thread = 0; thread < FRAME_ALLOCATOR_THREAD_COUNT; ++thread)
+		{
+			frame_arena_update_block_size(&(g_frame_allocator.arenas[buffer][thread]));
+		}
+	}
+
+	// job   ִ thread arena .
+	g_frame_allocator.buffer_index = (g_frame_allocator.buffer_index + 1) % FRAME_ALLOCATOR_BUFFER_COUNT;
+	const int thread_count = g_job_system.is_init ? g_job_system.worker_count + 1 : 1;
+	for (int thread = 0; thread < thread_count; ++thread)
+	{
+		frame_arena_reset(&(g_frame_allocator.arenas[g_frame_allocator.buffer_index][thread]));
+	}
+}
+
+void frame_allocator_end_frame()
+{
+	const FrameArena* arenas = g_frame_allocator.arenas[g_frame_allocator.buffer_index];
+	size_t frame_bytes = 0;
+	for (int thread = 0; thread < FRAME_ALLOCATOR_THREAD_COUNT; ++thread)
+	{
+		frame_bytes += arenas[thread].used_bytes;
+	}
+	g_frame_allocator.last_frame_bytes = frame_bytes;
+	if (frame_bytes > g_frame_allocator.peak_frame_bytes)
+	{
+		g_frame_allocator.peak_frame_bytes = frame_bytes;
+	}
+
+	const unsigned heap_allocs = (unsigned)(memory_tracker_alloc_count() - g_frame_allocator.frame_start_heap_alloc_count);
+	g_frame_allocator.last_frame_heap_allocs = heap_allocs;
+	++g_frame_allocator.frame_count;
+
+	if (g_frame_allocator.check_warmup_frames >= 0 && g_frame_allocator.frame_count > (unsigned)g_frame_allocator.check_warmup_frames)
+	{
+		++g_frame_allocator.check_frame_count;
+		if (heap_allocs > 0)
+		{
+			if (g_frame_allocator.violation_frame_count < FRAME_ALLOCATOR_MAX_REPORT)
+			{
+				printf("Frame %u : %u heap allocations\n", g_frame_allocator.frame_count, heap_allocs);
+			}
+			++g_frame_allocator.violation_frame_count;
+		}
+	}
+}
+
+void* frame_alloc(size_t size, size_t alignment)
+{
+	assert(g_frame_allocator.is_init);
+	assert(alignment > 0 && (alignment & (alignment - 1)) == 0);
+
+	// job system (ʱȭ )̶ main thread arena .
+	int thread = job_thread_index();
+	thread = thread >= 0 ? thread : 0;
+	return frame_arena_alloc(&(g_frame_allocator.arenas[g_frame_allocator.buffer_index][thread]), size, alignment);
+}
+
+bool frame_allocator_check_result()
+{
+	if (g_frame_allocator.check_warmup_frames < 0)
+	{
+		return true;
+	}
+
+	const bool is_success = g_frame_allocator.check_frame_count > 0 && g_frame_allocator.violation_frame_count == 0;
+	printf("Zero alloc check %s : %u / %u frames allocated from the heap after %d warm-up frames\n", is_success ? "passed" : "FAILED",
+		g_frame_allocator.violation_frame_count, g_frame_allocator.check_frame_count, g_frame_allocator.check_warmup_frames);
+	return is_success;
+}
+
+void frame_allocator_draw_gui()
+{
+	ImGui::Text("Frame Arena %.1f KB (peak %.1f KB) / Heap Allocs %u", (float)g_frame_allocator.last_frame_bytes / 1024.f,
+		(float)g_frame_allocator.peak_frame_bytes / 1024.f, g_frame_allocator.last_frame_heap_allocs);
+}
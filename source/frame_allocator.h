@@ -0,0 +1,133 @@
+#ifndef __FRAME_ALLOCATOR_H__
+#define __FRAME_ALLOCATOR_H__
+
+#include <stddef.h>
+#include <vector>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "job_system.h"
+
+//  frame ȸ  ӽ Ϳ linear(bump) allocator.
+//   ʰ, frame    buffer ° ǵ.
+// buffer 2  Ƿ  frame Ҵ  ̹ frame о ȴ.
+// thread(main + job worker)  arena  ιǷ job ȿ lock  ҴѴ.
+// block ڶ  ٿٸ  ǵ  ü ũ block ϳ ġ ٸ thread arena  ũ ߹Ƿ,
+//  frame ڿ heap Ҵ .
+//  :
+//   frame_allocator_begin_frame();		// frame ó
+//   FrameVector<unsigned> order(count);
+//   frame_allocator_end_frame();		// frame  (heap Ҵ  )
+//
+// command line : [--zero-alloc-check WARMUP_FRAMES]
+
+constexpr int FRAME_ALLOCATOR_BUFFER_COUNT = 2;
+constexpr int FRAME_ALLOCATOR_THREAD_COUNT = JOB_MAX_WORKER_COUNT + 1;
+constexpr size_t FRAME_ALLOCATOR_BLOCK_SIZE = 256 * 1024;
+constexpr size_t FRAME_ALLOCATOR_DEFAULT_ALIGNMENT = 16;
+
+// zero alloc check  ŭ ڼ Ѵ.
+constexpr int FRAME_ALLOCATOR_MAX_REPORT = 8;
+
+struct FrameArenaBlock
+{
+	FrameArenaBlock* next;
+	size_t size;
+	size_t used;
+};
+
+struct FrameArena
+{
+	//  Ҵϴ block  ̴.
+	FrameArenaBlock* blocks;
+	size_t used_bytes;
+};
+
+struct FrameAllocator
+{
+	bool is_init;
+	int buffer_index;
+	unsigned frame_count;
+
+	FrameArena arenas[FRAME_ALLOCATOR_BUFFER_COUNT][FRAME_ALLOCATOR_THREAD_COUNT];
+
+	// ݱ  arena  frame ʿߴ  ū block ũ.
+	// job  thread  𸣹Ƿ  thread arena  ũ .
+	size_t block_size;
+
+	//  frame  thread frame allocator Ҵ byte 
+	size_t last_frame_bytes;
+	size_t peak_frame_bytes;
+
+	// frame  memory_tracker_alloc_count().   ̷  frame heap Ҵ  .
+	unsigned long long frame_start_heap_alloc_count;
+	unsigned last_frame_heap_allocs;
+
+	// --zero-alloc-check. warmup  heap Ҵ ־ frame  . -1̶ .
+	int check_warmup_frames;
+	unsigned check_frame_count;
+	unsigned violation_frame_count;
+};
+extern FrameAllocator g_frame_allocator;
+
+void frame_allocator_set_defaults();
+void frame_allocator_print_usage();
+
+// argv[*index] frame allocator ɼ̶  а index ű  true ش.
+bool frame_allocator_parse_arg(int argc, char** argv, int* index);
+
+void frame_allocator_init();
+void frame_allocator_terminate();
+
+// main thread job     ȣѴ. ̹ buffer ǵ.
+void frame_allocator_begin_frame();
+void frame_allocator_end_frame();
+
+// ̹ frame   ȿ memory. ȣ thread arena ҴѴ.
+void* frame_alloc(size_t size, size_t alignment = FRAME_ALLOCATOR_DEFAULT_ALIGNMENT);
+
+// zero alloc check ״ٸ warmup  heap Ҵ  ϰ  ش.
+bool frame_allocator_check_result();
+
+void frame_allocator_draw_gui();
+
+// STL container allocator. deallocate  ʴ´.
+template <typename T>
+struct FrameStlAllocator
+{
+	typedef T value_type;
+
+	FrameStlAllocator() {}
+	template <typename U> FrameStlAllocator(const FrameStlAllocator<U>&) {}
+
+	T* allocate(size_t count)
+	{
+		return (T*)frame_alloc(count * sizeof(T), alignof(T) > FRAME_ALLOCATOR_DEFAULT_ALIGNMENT ? alignof(T) : FRAME_ALLOCATOR_DEFAULT_ALIGNMENT);
+	}
+
+	void deallocate(T*, size_t) {}
+};
+
+template <typename T, typename U>
+bool operator==(const FrameStlAllocator<T>&, const FrameStlAllocator<U>&) { return true; }
+template <typename T, typename U>
+bool operator!=(const FrameStlAllocator<T>&, const FrameStlAllocator<U>&) { return false; }
+
+template <typename T>
+using FrameVector = std::vector<T, FrameStlAllocator<T>>;
+
+using FrameString = std::basic_string<char, std::char_traits<char>, FrameStlAllocator<char>>;
+
+struct FrameStringHash
+{
+	size_t operator()(const FrameString& str) const
+	{
+		return std::hash<std::string_view>()(std::string_view(str.data(), str.size()));
+	}
+};
+
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+using FrameHashMap = std::unordered_map<Key, Value, Hash, std::equal_to<Key>, FrameStlAllocator<std::pair<const Key, Value>>>;
+
+#endif
@@ -0,0 +1,249 @@
+#include "frame_pacing.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include <thread>
+#include <algorithm>
+
+#if defined(_WIN32) || defined(_WIN64)
+#include <windows.h>
+#include <mmsystem.h>
+#endif
+
+#include "glad/glad.h"
+#include "GLFW/glfw3.h"
+#include "imgui/imgui.h"
+
+FramePacing g_frame_pacing;
+
+// ̺    ִ (idle, window ̵ )  jitter 꿡 .
+constexpr float PACING_PAUSE_MS = 250.f;
+
+static const char* const VSYNC_MODE_NAMES[VSYNC_MODE_COUNT] = { "off", "on", "adaptive" };
+
+void frame_pacing_print_usage()
+{
+	printf("  --vsync off|on|adaptive     swap interval (default on)\n");
+	printf("  --fps-limit N               cap the frame rate with sleep + spin (default 0, no limit)\n");
+}
+
+void frame_pacing_set_defaults()
+{
+	// time_point Ƿ memset  value-initialization 0 ä.
+	g_frame_pacing = FramePacing();
+	g_frame_pacing.vsync_mode = VSYNC_ON;
+	g_frame_pacing.applied_vsync_mode = -1;
+	g_frame_pacing.spin_ms = PACING_MIN_SPIN_MS;
+}
+
+bool frame_pacing_parse_arg(int argc, char** argv, int* index)
+{
+	const char* arg = argv[*index];
+	if (*index + 1 >= argc)
+	{
+		return false;
+	}
+
+	const char* value = argv[*index + 1];
+	if (strcmp(arg, "--vsync") == 0)
+	{
+		int mode = -1;
+		for (int i = 0; i < VSYNC_MODE_COUNT; ++i)
+		{
+			if (strcmp(value, VSYNC_MODE_NAMES[i]) == 0)
+			{
+				mode = i;
+			}
+		}
+		if (mode < 0)
+		{
+			return false;
+		}
+		g_frame_pacing.vsync_mode = mode;
+	}
+	else if (strcmp(arg, "--fps-limit") == 0)
+	{
+		int fps_limit = atoi(value);
+		if (fps_limit < 0 || fps_limit > PACING_MAX_FPS_LIMIT)
+		{
+			return false;
+		}
+		g_frame_pacing.fps_limit = fps_limit;
+	}
+	else
+	{
+		return false;
+	}
+
+	++(*index);
+	return true;
+}
+
+void frame_pacing_init(bool has_window)
+{
+	g_frame_pacing.has_window = has_window;
+	if (has_window)
+	{
+		g_frame_pacing.has_adaptive_vsync = glfwExtensionSupported("WGL_EXT_swap_control_tear") == GLFW_TRUE ||
+			glfwExtensionSupported("GLX_EXT_swap_control_tear") == GLFW_TRUE;
+	}
+
+#if defined(_WIN32) || defined(_WIN64)
+	// ⺻ timer ػ(15.6ms)δ sleep ʹ ʰ Ƿ 1ms ø.
+	timeBeginPeriod(1);
+#endif
+}
+
+void frame_pacing_terminate()
+{
+#if defined(_WIN32) || defined(_WIN64)
+	timeEndPeriod(1);
+#endif
+}
+
+static void frame_pacing_apply_vsync()
+{
+	if (g_frame_pacing.applied_vsync_mode == g_frame_pacing.vsync_mode)
+	{
+		return;
+	}
+	g_frame_pacing.applied_vsync_mode = g_frame_pacing.vsync_mode;
+
+	if (!g_frame_pacing.has_window)
+	{
+		return;
+	}
+
+	int interval = 0;
+	switch (g_frame_pacing.vsync_mode)
+	{
+	case VSYNC_OFF:			interval = 0; break;
+	case VSYNC_ON:			interval = 1; break;
+	case VSYNC_ADAPTIVE:	interval = g_frame_pacing.has_adaptive_vsync ? -1 : 1; break;
+	}
+	glfwSwapInterval(interval);
+
+	//  ٲǷ  ó ٽ Ѵ.
+	g_frame_pacing.present_history_count = 0;
+	g_frame_pacing.present_history_index = 0;
+	g_frame_pacing.has_last_present = false;
+}
+
+void frame_pacing_wait()
+{
+	frame_pacing_apply_vsync();
+
+	g_frame_pacing.limiter_wait_ms = 0.f;
+	if (g_frame_pacing.fps_limit <= 0)
+	{
+		return;
+	}
+
+	using namespace std::chrono;
+	const steady_clock::duration period = duration_cast<steady_clock::duration>(duration<double>(1.0 / g_frame_pacing.fps_limit));
+	steady_clock::time_point now = steady_clock::now();
+	const steady_clock::time_point wait_start = now;
+
+	//  period Ѱ ʾٸ (ó̰ų  ־ٸ) и frame Ƽ ׸ ʵ ݺ ٽ .
+	if (g_frame_pacing.next_frame_time + period < now)
+	{
+		g_frame_pacing.next_frame_time = now;
+	}
+
+	// sleep û ʰ   Ƿ, ֱٿ ʰ  ðŭ  sleep    spin Ѵ.
+	const steady_clock::time_point target = g_frame_pacing.next_frame_time;
+	while (true)
+	{
+		const float remain_ms = duration<float, std::milli>(target - now).count();
+		if (remain_ms <= g_frame_pacing.spin_ms)
+		{
+			break;
+		}
+
+		const float sleep_ms = remain_ms - g_frame_pacing.spin_ms;
+		const steady_clock::time_point sleep_start = now;
+		std::this_thread::sleep_for(duration<float, std::milli>(sleep_ms));
+		now = steady_clock::now();
+
+		//   ũ  sleep(ٸ и  )   spin  ʵ ̵  󰡰  д.
+		const float oversleep_ms = std::max(duration<float, std::milli>(now - sleep_start).count() - sleep_ms, 0.f);
+		const float rate = oversleep_ms > g_frame_pacing.oversleep_ms ? PACING_OVERSLEEP_RISE : PACING_OVERSLEEP_DECAY;
+		g_frame_pacing.oversleep_ms += (oversleep_ms - g_frame_pacing.oversleep_ms) * rate;
+		g_frame_pacing.spin_ms = std::max(PACING_MIN_SPIN_MS, std::min(PACING_MAX_SPIN_MS, g_frame_pacing.oversleep_ms));
+	}
+
+	while (steady_clock::now() < target)
+	{
+		std::this_thread::yield();
+	}
+
+	g_frame_pacing.next_frame_time = target + period;
+	g_frame_pacing.limiter_wait_ms = duration<float, std::milli>(steady_clock::now() - wait_start).count();
+}
+
+void frame_pacing_end_frame()
+{
+	const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+	if (g_frame_pacing.has_last_present)
+	{
+		const float interval_ms = std::chrono::duration<float, std::milli>(now - g_frame_pacing.last_present_time).count();
+		if (interval_ms < PACING_PAUSE_MS)
+		{
+			g_frame_pacing.present_history[g_frame_pacing.present_history_index] = interval_ms;
+			g_frame_pacing.present_history_index = (g_frame_pacing.present_history_index + 1) % PACING_HISTORY_COUNT;
+			if (g_frame_pacing.present_history_count < PACING_HISTORY_COUNT)
+			{
+				++g_frame_pacing.present_history_count;
+			}
+		}
+	}
+
+	g_frame_pacing.last_present_time = now;
+	g_frame_pacing.has_last_present = true;
+}
+
+void frame_pacing_draw_gui()
+{
+	ImGui::Text("VSync"); ImGui::SameLine();
+	ImGui::Combo("##VSync", &g_frame_pacing.vsync_mode, "Off\0On\0Adaptive\0");
+	if (g_frame_pacing.vsync_mode == VSYNC_ADAPTIVE && !g_frame_pacing.has_adaptive_vsync)
+	{
+		ImGui::SameLine();
+		ImGui::Text("(Not Supported, On)");
+	}
+
+	ImGui::Text("FPS Limit"); ImGui::SameLine();
+	ImGui::SliderInt("##FPSLimit", &g_frame_pacing.fps_limit, 0, PACING_MAX_FPS_LIMIT, g_frame_pacing.fps_limit == 0 ? "Off" : "%d");
+
+	// present  հ ǥ(jitter)
+	const int count = g_frame_pacing.present_history_count;
+	float avg = 0.f;
+	float min = count > 0 ? FLT_MAX : 0.f;
+	float max = 0.f;
+	for (int i = 0; i < count; ++i)
+	{
+		const float value = g_frame_pacing.present_history[i];
+		avg += value;
+		min = value < min ? value : min;
+		max = value > max ? value : max;
+	}
+	avg = count > 0 ? avg / (float)count : 0.f;
+
+	float variance = 0.f;
+	for (int i = 0; i < count; ++i)
+	{
+		const float diff = g_frame_pacing.present_history[i] - avg;
+		variance += diff * diff;
+	}
+	const float jitter = count > 0 ? sqrtf(variance / (float)count) : 0.f;
+
+	ImGui::Text("Present Interval avg %.3f / min %.3f / max %.3f ms", avg, min, max);
+	ImGui::Text("Present Jitter %.3f ms / Limiter Wait %.3f ms (spin %.2f ms)", jitter, g_frame_pacing.limiter_wait_ms, g_frame_pacing.spin_ms);
+
+	int offset = count < PACING_HISTORY_COUNT ? 0 : g_frame_pacing.present_history_index;
+	ImGui::PlotLines("##PresentInterval", g_frame_pacing.present_history, count, offset,
+		NULL, 0.f, max > 0.f ? max * 1.2f : 1.f, ImVec2(0.f, 40.f));
+}
@@ -0,0 +1,72 @@
+#ifndef __FRAME_PACING_H__
+#define __FRAME_PACING_H__
+
+#include <chrono>
+
+// swap interval(vsync) frame rate , present (jitter) .
+//  ǥ ð  sleep ϰ  ð spin ؼ .
+// captureó  frame time ʿϸ vsync + fps limit,  ߿ϸ vsync off .
+//
+// command line : [--vsync off|on|adaptive] [--fps-limit N]
+
+enum VSyncMode
+{
+	VSYNC_OFF = 0,
+	VSYNC_ON,
+	VSYNC_ADAPTIVE,		//  frame ٸ ʰ ٷ ش. (EXT_swap_control_tear,  ON)
+	VSYNC_MODE_COUNT
+};
+
+constexpr int PACING_HISTORY_COUNT = 120;
+constexpr int PACING_MAX_FPS_LIMIT = 480;
+
+//  ð   sleep  ʰ spin Ѵ. ֱ sleep ʰ  ð ̵     ȿ ٲ.
+constexpr float PACING_MIN_SPIN_MS = 1.f;
+constexpr float PACING_MAX_SPIN_MS = 4.f;
+
+// ʰ  ð ̵  . þ   󰡰 پ  õõ ƿ´.
+constexpr float PACING_OVERSLEEP_RISE = 0.5f;
+constexpr float PACING_OVERSLEEP_DECAY = 0.05f;
+
+struct FramePacing
+{
+	bool has_window;
+	bool has_adaptive_vsync;
+
+	int vsync_mode;
+	int applied_vsync_mode;		//   ʾҴٸ -1
+
+	int fps_limit;				// 0 :  
+	std::chrono::steady_clock::time_point next_frame_time;
+	float oversleep_ms;			// sleep ʰ  ð ̵ 
+	float spin_ms;
+
+	// present present   (ms)
+	std::chrono::steady_clock::time_point last_present_time;
+	bool has_last_present;
+	float present_history[PACING_HISTORY_COUNT];
+	int present_history_index;
+	int present_history_count;
+	float limiter_wait_ms;
+};
+extern FramePacing g_frame_pacing;
+
+void frame_pacing_set_defaults();
+void frame_pacing_print_usage();
+
+// argv[*index] frame pacing ɼ̶  а index ű  true ش.
+bool frame_pacing_parse_arg(int argc, char** argv, int* index);
+
+// GL context current  ڿ ȣѴ. has_window false (headless) vsync Ѵ.
+void frame_pacing_init(bool has_window);
+void frame_pacing_terminate();
+
+// swap  ȣѴ. vsync  ٲٸ ϰ, fps limit ŭ ٸ.
+void frame_pacing_wait();
+
+// swap Ŀ ȣѴ.
+void frame_pacing_end_frame();
+
+void frame_pacing_draw_gui();
+
+#endif
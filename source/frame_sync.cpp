@@ -0,0 +1,95 @@
+#include "frame_sync.h"
+
+#include <string.h>
+#include <chrono>
+
+FrameSync g_frame_sync;
+
+//   glClientWaitSync ٸ ִ ð (ns)
+constexpr GLuint64 FRAME_SYNC_WAIT_TIMEOUT = 100000000; // 100ms
+
+static void frame_sync_wait_and_release(GLsync* fence)
+{
+	if (*fence == NULL)
+	{
+		return;
+	}
+
+	// GL_SYNC_FLUSH_COMMANDS_BIT : fence  ̹ ׿ ־  ٸ ʵ flush ش.
+	GLenum result = glClientWaitSync(*fence, GL_SYNC_FLUSH_COMMANDS_BIT, FRAME_SYNC_WAIT_TIMEOUT);
+	while (result == GL_TIMEOUT_EXPIRED)
+	{
+		result = glClientWaitSync(*fence, 0, FRAME_SYNC_WAIT_TIMEOUT);
+	}
+
+	glDeleteSync(*fence);
+	*fence = NULL;
+}
+
+static int frame_sync_clamp(int max_frames_in_flight)
+{
+	if (max_frames_in_flight < 1)
+	{
+		return 1;
+	}
+	if (max_frames_in_flight > MAX_FRAMES_IN_FLIGHT)
+	{
+		return MAX_FRAMES_IN_FLIGHT;
+	}
+	return max_frames_in_flight;
+}
+
+void frame_sync_init(int max_frames_in_flight)
+{
+	memset(&g_frame_sync, 0, sizeof(FrameSync));
+	g_frame_sync.max_frames_in_flight = frame_sync_clamp(max_frames_in_flight);
+}
+
+void frame_sync_terminate()
+{
+	for (int i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i)
+	{
+		frame_sync_wait_and_release(&(g_frame_sync.fences[i]));
+	}
+}
+
+void frame_sync_set_max_frames_in_flight(int max_frames_in_flight)
+{
+	max_frames_in_flight = frame_sync_clamp(max_frames_in_flight);
+	if (max_frames_in_flight == g_frame_sync.max_frames_in_flight)
+	{
+		return;
+	}
+
+	// slot frame  ٲǷ   frame   ó ٽ .
+	for (int i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i)
+	{
+		frame_sync_wait_and_release(&(g_frame_sync.fences[i]));
+	}
+	g_frame_sync.max_frames_in_flight = max_frames_in_flight;
+	g_frame_sync.frame_number = 0;
+}
+
+int frame_sync_begin()
+{
+	g_frame_sync.frame_slot = (int)(g_frame_sync.frame_number % (unsigned)g_frame_sync.max_frames_in_flight);
+
+	std::chrono::steady_clock::time_point wait_start = std::chrono::steady_clock::now();
+	frame_sync_wait_and_release(&(g_frame_sync.fences[g_frame_sync.frame_slot]));
+	std::chrono::steady_clock::time_point wait_end = std::chrono::steady_clock::now();
+	g_frame_sync.wait_ms = std::chrono::duration<float, std::milli>(wait_end - wait_start).count();
+
+	return g_frame_sync.frame_slot;
+}
+
+void frame_sync_end()
+{
+	GLsync* fence = &(g_frame_sync.fences[g_frame_sync.frame_slot]);
+	if (*fence != NULL)
+	{
+		glDeleteSync(*fence);
+	}
+	*fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+	++g_frame_sync.frame_number;
+}
@@ -0,0 +1,40 @@
+#ifndef __FRAME_SYNC_H__
+#define __FRAME_SYNC_H__
+
+#include "glad/glad.h"
+
+// GPU frame N ׸  CPU frame N+1   ֵ, frame fence ɾ
+// ִ max_frames_in_flight  frame GPU ̰ Ѵ.
+//  frame  ä GPU ڿ(dynamic buffer ) MAX_FRAMES_IN_FLIGHT   frame_slot  ,
+// ش slot  frame fence ̹ ٷǷ ̹ Ϲ sync    ִ.
+
+constexpr int MAX_FRAMES_IN_FLIGHT = 4;
+constexpr int DEFAULT_FRAMES_IN_FLIGHT = 2;
+
+struct FrameSync
+{
+	int max_frames_in_flight;	// 1 ~ MAX_FRAMES_IN_FLIGHT
+	unsigned frame_number;
+	int frame_slot;				// ̹ frame  ڿ set index
+
+	GLsync fences[MAX_FRAMES_IN_FLIGHT];
+
+	// ̹ frame_sync_begin GPU ٸ ð
+	float wait_ms;
+};
+extern FrameSync g_frame_sync;
+
+void frame_sync_init(int max_frames_in_flight);
+void frame_sync_terminate();
+
+//   frame  ٸ ڿ ٲ۴.
+void frame_sync_set_max_frames_in_flight(int max_frames_in_flight);
+
+// frame GL  ֱ  ȣѴ.
+// ̹ slot   frame GPU ۾   ٸ slot index ش.
+int frame_sync_begin();
+
+// frame GL    (swap ) ȣѴ.
+void frame_sync_end();
+
+#endif
@@ -0,0 +1,114 @@
+#include "gl_extension.h"
+
+#include <stdio.h>
+#include <string.h>
+
+GLExtension g_gl_ext;
+
+PFNGLDISPATCHCOMPUTEPROC glad_ext_glDispatchCompute = NULL;
+PFNGLMEMORYBARRIERPROC glad_ext_glMemoryBarrier = NULL;
+PFNGLBINDIMAGETEXTUREPROC glad_ext_glBindImageTexture = NULL;
+PFNGLMULTIDRAWELEMENTSINDIRECTPROC glad_ext_glMultiDrawElementsIndirect = NULL;
+PFNGLMULTIDRAWELEMENTSINDIRECTCOUNTPROC glad_ext_glMultiDrawElementsIndirectCount = NULL;
+PFNGLMAXSHADERCOMPILERTHREADSKHRPROC glad_ext_glMaxShaderCompilerThreadsKHR = NULL;
+PFNGLGETPROGRAMBINARYPROC glad_ext_glGetProgramBinary = NULL;
+PFNGLPROGRAMBINARYPROC glad_ext_glProgramBinary = NULL;
+PFNGLPROGRAMPARAMETERIPROC glad_ext_glProgramParameteri = NULL;
+PFNGLBUFFERSTORAGEPROC glad_ext_glBufferStorage = NULL;
+
+static bool gl_is_version_at_least(int major, int minor)
+{
+	return g_gl_ext.major_version > major ||
+		(g_gl_ext.major_version == major && g_gl_ext.minor_version >= minor);
+}
+
+bool gl_has_extension(const char* name)
+{
+	GLint extension_count = 0;
+	glGetIntegerv(GL_NUM_EXTENSIONS, &extension_count);
+	for (GLint i = 0; i < extension_count; ++i)
+	{
+		const char* extension = (const char*)glGetStringi(GL_EXTENSIONS, i);
+		if (extension && strcmp(extension, name) == 0)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void gl_extension_init(GLADloadproc load)
+{
+	memset(&g_gl_ext, 0, sizeof(GLExtension));
+	glGetIntegerv(GL_MAJOR_VERSION, &g_gl_ext.major_version);
+	glGetIntegerv(GL_MINOR_VERSION, &g_gl_ext.minor_version);
+
+	// 3.3 core context ûص κ ̹(Mesa llvmpipe )
+	//     core  ֹǷ,  Ȥ extension ڿ  θ ǴѴ.
+	if (gl_is_version_at_least(4, 3) ||
+		(gl_has_extension("GL_ARB_compute_shader") &&
+		 gl_has_extension("GL_ARB_shader_storage_buffer_object") &&
+		 gl_has_extension("GL_ARB_shader_image_load_store") &&
+		 gl_has_extension("GL_ARB_multi_draw_indirect")))
+	{
+		glad_ext_glDispatchCompute = (PFNGLDISPATCHCOMPUTEPROC)load("glDispatchCompute");
+		glad_ext_glMemoryBarrier = (PFNGLMEMORYBARRIERPROC)load("glMemoryBarrier");
+		glad_ext_glBindImageTexture = (PFNGLBINDIMAGETEXTUREPROC)load("glBindImageTexture");
+		glad_ext_glMultiDrawElementsIndirect = (PFNGLMULTIDRAWELEMENTSINDIRECTPROC)load("glMultiDrawElementsIndirect");
+
+		g_gl_ext.has_compute_shader = glad_ext_glDispatchCompute != NULL &&
+			glad_ext_glMemoryBarrier != NULL &&
+			glad_ext_glBindImageTexture != NULL &&
+			glad_ext_glMultiDrawElementsIndirect != NULL;
+	}
+
+	if (gl_is_version_at_least(4, 6))
+	{
+		glad_ext_glMultiDrawElementsIndirectCount = (PFNGLMULTIDRAWELEMENTSINDIRECTCOUNTPROC)load("glMultiDrawElementsIndirectCount");
+	}
+	else if (gl_has_extension("GL_ARB_indirect_parameters"))
+	{
+		glad_ext_glMultiDrawElementsIndirectCount = (PFNGLMULTIDRAWELEMENTSINDIRECTCOUNTPROC)load("glMultiDrawElementsIndirectCountARB");
+	}
+	g_gl_ext.has_indirect_parameters = glad_ext_glMultiDrawElementsIndirectCount != NULL;
+
+	if (gl_has_extension("GL_KHR_parallel_shader_compile"))
+	{
+		glad_ext_glMaxShaderCompilerThreadsKHR = (PFNGLMAXSHADERCOMPILERTHREADSKHRPROC)load("glMaxShaderCompilerThreadsKHR");
+	}
+	else if (gl_has_extension("GL_ARB_parallel_shader_compile"))
+	{
+		glad_ext_glMaxShaderCompilerThreadsKHR = (PFNGLMAXSHADERCOMPILERTHREADSKHRPROC)load("glMaxShaderCompilerThreadsARB");
+	}
+	g_gl_ext.has_parallel_shader_compile = glad_ext_glMaxShaderCompilerThreadsKHR != NULL;
+
+	if (gl_is_version_at_least(4, 1) || gl_has_extension("GL_ARB_get_program_binary"))
+	{
+		glad_ext_glGetProgramBinary = (PFNGLGETPROGRAMBINARYPROC)load("glGetProgramBinary");
+		glad_ext_glProgramBinary = (PFNGLPROGRAMBINARYPROC)load("glProgramBinary");
+		glad_ext_glProgramParameteri = (PFNGLPROGRAMPARAMETERIPROC)load("glProgramParameteri");
+
+		GLint binary_format_count = 0;
+		glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &binary_format_count);
+		g_gl_ext.has_program_binary = binary_format_count > 0 &&
+			glad_ext_glGetProgramBinary != NULL &&
+			glad_ext_glProgramBinary != NULL &&
+			glad_ext_glProgramParameteri != NULL;
+	}
+
+	if (gl_is_version_at_least(4, 4) || gl_has_extension("GL_ARB_buffer_storage"))
+	{
+		glad_ext_glBufferStorage = (PFNGLBUFFERSTORAGEPROC)load("glBufferStorage");
+	}
+	g_gl_ext.has_buffer_storage = glad_ext_glBufferStorage != NULL;
+
+	printf("GL Version %d.%d | %s | %s\n", g_gl_ext.major_version, g_gl_ext.minor_version,
+		(const char*)glGetString(GL_VENDOR), (const char*)glGetString(GL_RENDERER));
+	printf("Compute Shader : %s / Indirect Parameters : %s / Parallel Shader Compile : %s / Program Binary : %s / Buffer Storage : %s\n",
+		g_gl_ext.has_compute_shader ? "YES" : "NO",
+		g_gl_ext.has_indirect_parameters ? "YES" : "NO",
+		g_gl_ext.has_parallel_shader_compile ? "YES" : "NO",
+		g_gl_ext.has_program_binary ? "YES" : "NO",
+		g_gl_ext.has_buffer_storage ? "YES" : "NO");
+}
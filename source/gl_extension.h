@@ -0,0 +1,114 @@
+#ifndef __GL_EXTENSION_H__
+#define __GL_EXTENSION_H__
+
+#include "glad/glad.h"
+
+// glad gl 3.3 core profileθ Ǿ ֱ ,
+//   (4.x)̳ extension  ɵ ⼭ Ÿӿ  Լ ͸ ҷ´.
+// ̹  ʴ  Լ Ͱ NULL̹Ƿ, ݵ g_gl_ext flag Ȯϰ ؾ Ѵ.
+
+#ifndef GL_COMPUTE_SHADER
+#define GL_COMPUTE_SHADER 0x91B9
+#endif
+#ifndef GL_SHADER_STORAGE_BUFFER
+#define GL_SHADER_STORAGE_BUFFER 0x90D2
+#endif
+#ifndef GL_DRAW_INDIRECT_BUFFER
+#define GL_DRAW_INDIRECT_BUFFER 0x8F3F
+#endif
+#ifndef GL_PARAMETER_BUFFER
+#define GL_PARAMETER_BUFFER 0x80EE
+#endif
+#ifndef GL_SHADER_STORAGE_BARRIER_BIT
+#define GL_SHADER_STORAGE_BARRIER_BIT 0x00002000
+#endif
+#ifndef GL_COMMAND_BARRIER_BIT
+#define GL_COMMAND_BARRIER_BIT 0x00000040
+#endif
+#ifndef GL_SHADER_IMAGE_ACCESS_BARRIER_BIT
+#define GL_SHADER_IMAGE_ACCESS_BARRIER_BIT 0x00000020
+#endif
+#ifndef GL_TEXTURE_FETCH_BARRIER_BIT
+#define GL_TEXTURE_FETCH_BARRIER_BIT 0x00000008
+#endif
+#ifndef GL_COMPLETION_STATUS_KHR
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
+#ifndef GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+#define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
+#endif
+#ifndef GL_PROGRAM_BINARY_LENGTH
+#define GL_PROGRAM_BINARY_LENGTH 0x8741
+#endif
+#ifndef GL_NUM_PROGRAM_BINARY_FORMATS
+#define GL_NUM_PROGRAM_BINARY_FORMATS 0x87FE
+#endif
+#ifndef GL_MAP_PERSISTENT_BIT
+#define GL_MAP_PERSISTENT_BIT 0x0040
+#endif
+#ifndef GL_MAP_COHERENT_BIT
+#define GL_MAP_COHERENT_BIT 0x0080
+#endif
+
+typedef void (APIENTRYP PFNGLDISPATCHCOMPUTEPROC)(GLuint num_groups_x, GLuint num_groups_y, GLuint num_groups_z);
+typedef void (APIENTRYP PFNGLMEMORYBARRIERPROC)(GLbitfield barriers);
+typedef void (APIENTRYP PFNGLBINDIMAGETEXTUREPROC)(GLuint unit, GLuint texture, GLint level, GLboolean layered, GLint layer, GLenum access, GLenum format);
+typedef void (APIENTRYP PFNGLMULTIDRAWELEMENTSINDIRECTPROC)(GLenum mode, GLenum type, const void* indirect, GLsizei drawcount, GLsizei stride);
+typedef void (APIENTRYP PFNGLMULTIDRAWELEMENTSINDIRECTCOUNTPROC)(GLenum mode, GLenum type, const void* indirect, GLintptr drawcount, GLsizei maxdrawcount, GLsizei stride);
+typedef void (APIENTRYP PFNGLMAXSHADERCOMPILERTHREADSKHRPROC)(GLuint count);
+typedef void (APIENTRYP PFNGLGETPROGRAMBINARYPROC)(GLuint program, GLsizei buf_size, GLsizei* length, GLenum* binary_format, void* binary);
+typedef void (APIENTRYP PFNGLPROGRAMBINARYPROC)(GLuint program, GLenum binary_format, const void* binary, GLsizei length);
+typedef void (APIENTRYP PFNGLPROGRAMPARAMETERIPROC)(GLuint program, GLenum pname, GLint value);
+typedef void (APIENTRYP PFNGLBUFFERSTORAGEPROC)(GLenum target, GLsizeiptr size, const void* data, GLbitfield flags);
+
+struct GLExtension
+{
+	int major_version;
+	int minor_version;
+
+	// GL 4.3 / ARB_compute_shader + ARB_shader_storage_buffer_object + ARB_multi_draw_indirect
+	bool has_compute_shader;
+
+	// GL 4.6 / ARB_indirect_parameters (glMultiDrawElementsIndirectCount)
+	bool has_indirect_parameters;
+
+	// KHR_parallel_shader_compile (ARB_parallel_shader_compile)
+	// compile/link ̹ thread ǰ, GL_COMPLETION_STATUS_KHR  ٸ ʰ   ִ.
+	bool has_parallel_shader_compile;
+
+	// GL 4.1 / ARB_get_program_binary
+	// ̹ binary format ϳ  ʴ 쵵 Ƿ format  ȮѴ.
+	bool has_program_binary;
+
+	// GL 4.4 / ARB_buffer_storage
+	//   map ص pointer GL  ִ ȿ    ִ. (GL_MAP_PERSISTENT_BIT)
+	bool has_buffer_storage;
+};
+extern GLExtension g_gl_ext;
+
+extern PFNGLDISPATCHCOMPUTEPROC glad_ext_glDispatchCompute;
+extern PFNGLMEMORYBARRIERPROC glad_ext_glMemoryBarrier;
+extern PFNGLBINDIMAGETEXTUREPROC glad_ext_glBindImageTexture;
+extern PFNGLMULTIDRAWELEMENTSINDIRECTPROC glad_ext_glMultiDrawElementsIndirect;
+extern PFNGLMULTIDRAWELEMENTSINDIRECTCOUNTPROC glad_ext_glMultiDrawElementsIndirectCount;
+extern PFNGLMAXSHADERCOMPILERTHREADSKHRPROC glad_ext_glMaxShaderCompilerThreadsKHR;
+extern PFNGLGETPROGRAMBINARYPROC glad_ext_glGetProgramBinary;
+extern PFNGLPROGRAMBINARYPROC glad_ext_glProgramBinary;
+extern PFNGLPROGRAMPARAMETERIPROC glad_ext_glProgramParameteri;
+extern PFNGLBUFFERSTORAGEPROC glad_ext_glBufferStorage;
+#define glDispatchCompute glad_ext_glDispatchCompute
+#define glMemoryBarrier glad_ext_glMemoryBarrier
+#define glBindImageTexture glad_ext_glBindImageTexture
+#define glMultiDrawElementsIndirect glad_ext_glMultiDrawElementsIndirect
+#define glMultiDrawElementsIndirectCount glad_ext_glMultiDrawElementsIndirectCount
+#define glMaxShaderCompilerThreadsKHR glad_ext_glMaxShaderCompilerThreadsKHR
+#define glGetProgramBinary glad_ext_glGetProgramBinary
+#define glProgramBinary glad_ext_glProgramBinary
+#define glProgramParameteri glad_ext_glProgramParameteri
+#define glBufferStorage glad_ext_glBufferStorage
+
+// gladLoadGLLoader  ,  loader ȣؾ Ѵ.
+void gl_extension_init(GLADloadproc load);
+bool gl_has_extension(const char* name);
+
+#endif
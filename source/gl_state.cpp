@@ -0,0 +1,150 @@
+#include "gl_state.h"
+
+#include <stdio.h>
+#include <assert.h>
+
+GLState g_gl_state;
+
+static bool* gl_state_enable_flag(GLenum cap)
+{
+	switch (cap)
+	{
+	case GL_BLEND:			return &(g_gl_state.is_blend);
+	case GL_CULL_FACE:		return &(g_gl_state.is_cull_face);
+	case GL_DEPTH_TEST:		return &(g_gl_state.is_depth_test);
+	case GL_STENCIL_TEST:	return &(g_gl_state.is_stencil_test);
+	case GL_SCISSOR_TEST:	return &(g_gl_state.is_scissor_test);
+	}
+
+	printf("Untracked GL capability : 0x%04X\n", cap);
+	assert(false);
+	return NULL;
+}
+
+static GLState gl_state_query()
+{
+	GLState state;
+	state.is_blend = glIsEnabled(GL_BLEND) == GL_TRUE;
+	state.is_cull_face = glIsEnabled(GL_CULL_FACE) == GL_TRUE;
+	state.is_depth_test = glIsEnabled(GL_DEPTH_TEST) == GL_TRUE;
+	state.is_stencil_test = glIsEnabled(GL_STENCIL_TEST) == GL_TRUE;
+	state.is_scissor_test = glIsEnabled(GL_SCISSOR_TEST) == GL_TRUE;
+
+	glGetIntegerv(GL_BLEND_EQUATION_RGB, (GLint*)&state.blend_equation_rgb);
+	glGetIntegerv(GL_BLEND_EQUATION_ALPHA, (GLint*)&state.blend_equation_alpha);
+	glGetIntegerv(GL_BLEND_SRC_RGB, (GLint*)&state.blend_src_rgb);
+	glGetIntegerv(GL_BLEND_DST_RGB, (GLint*)&state.blend_dst_rgb);
+	glGetIntegerv(GL_BLEND_SRC_ALPHA, (GLint*)&state.blend_src_alpha);
+	glGetIntegerv(GL_BLEND_DST_ALPHA, (GLint*)&state.blend_dst_alpha);
+
+	// core profile front/back ׻ Ƿ ù °  .
+	GLint polygon_mode[2];
+	glGetIntegerv(GL_POLYGON_MODE, polygon_mode);
+	state.polygon_mode = (GLenum)polygon_mode[0];
+	return state;
+}
+
+void gl_state_init()
+{
+	g_gl_state = gl_state_query();
+}
+
+void gl_state_set_enable(GLenum cap, bool is_enable)
+{
+	bool* flag = gl_state_enable_flag(cap);
+	if (flag == NULL || *flag == is_enable)
+	{
+		return;
+	}
+
+	*flag = is_enable;
+	if (is_enable)
+	{
+		glEnable(cap);
+	}
+	else
+	{
+		glDisable(cap);
+	}
+}
+
+void gl_state_set_blend_equation(GLenum mode_rgb, GLenum mode_alpha)
+{
+	if (g_gl_state.blend_equation_rgb == mode_rgb && g_gl_state.blend_equation_alpha == mode_alpha)
+	{
+		return;
+	}
+
+	g_gl_state.blend_equation_rgb = mode_rgb;
+	g_gl_state.blend_equation_alpha = mode_alpha;
+	glBlendEquationSeparate(mode_rgb, mode_alpha);
+}
+
+void gl_state_set_blend_func(GLenum src_rgb, GLenum dst_rgb, GLenum src_alpha, GLenum dst_alpha)
+{
+	if (g_gl_state.blend_src_rgb == src_rgb && g_gl_state.blend_dst_rgb == dst_rgb &&
+		g_gl_state.blend_src_alpha == src_alpha && g_gl_state.blend_dst_alpha == dst_alpha)
+	{
+		return;
+	}
+
+	g_gl_state.blend_src_rgb = src_rgb;
+	g_gl_state.blend_dst_rgb = dst_rgb;
+	g_gl_state.blend_src_alpha = src_alpha;
+	g_gl_state.blend_dst_alpha = dst_alpha;
+	glBlendFuncSeparate(src_rgb, dst_rgb, src_alpha, dst_alpha);
+}
+
+void gl_state_set_polygon_mode(GLenum mode)
+{
+	if (g_gl_state.polygon_mode == mode)
+	{
+		return;
+	}
+
+	g_gl_state.polygon_mode = mode;
+	glPolygonMode(GL_FRONT_AND_BACK, mode);
+}
+
+void gl_state_restore(const GLState& saved)
+{
+	gl_state_set_enable(GL_BLEND, saved.is_blend);
+	gl_state_set_enable(GL_CULL_FACE, saved.is_cull_face);
+	gl_state_set_enable(GL_DEPTH_TEST, saved.is_depth_test);
+	gl_state_set_enable(GL_STENCIL_TEST, saved.is_stencil_test);
+	gl_state_set_enable(GL_SCISSOR_TEST, saved.is_scissor_test);
+	gl_state_set_blend_equation(saved.blend_equation_rgb, saved.blend_equation_alpha);
+	gl_state_set_blend_func(saved.blend_src_rgb, saved.blend_dst_rgb, saved.blend_src_alpha, saved.blend_dst_alpha);
+	gl_state_set_polygon_mode(saved.polygon_mode);
+}
+
+void gl_state_validate(const char* file, int line)
+{
+	const GLState actual = gl_state_query();
+	const GLState& tracked = g_gl_state;
+
+	bool is_valid = true;
+#define GL_STATE_CHECK(field) \
+	if (actual.field != tracked.field) \
+	{ \
+		printf("GL state mismatch %s : tracked 0x%X, actual 0x%X | %s ( %d )\n", #field, (unsigned)tracked.field, (unsigned)actual.field, file, line); \
+		is_valid = false; \
+	}
+
+	GL_STATE_CHECK(is_blend);
+	GL_STATE_CHECK(is_cull_face);
+	GL_STATE_CHECK(is_depth_test);
+	GL_STATE_CHECK(is_stencil_test);
+	GL_STATE_CHECK(is_scissor_test);
+	GL_STATE_CHECK(blend_equation_rgb);
+	GL_STATE_CHECK(blend_equation_alpha);
+	GL_STATE_CHECK(blend_src_rgb);
+	GL_STATE_CHECK(blend_dst_rgb);
+	GL_STATE_CHECK(blend_src_alpha);
+	GL_STATE_CHECK(blend_dst_alpha);
+	GL_STATE_CHECK(polygon_mode);
+#undef GL_STATE_CHECK
+
+	// 򰡿 gl_state_* ġ ʰ GL state ٲ ̴.
+	assert(is_valid);
+}
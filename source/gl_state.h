@@ -0,0 +1,50 @@
+#ifndef __GL_STATE_H__
+#define __GL_STATE_H__
+
+#include "glad/glad.h"
+
+// pass  ٲ rasterization state CPU ʿ  д.
+// glGet/glIsEnabled ̹  GPU sync ŰǷ,   g_gl_state а
+// ٲ    ٸ  GL ȣѴ.
+// ׷  ִ state ݵ gl_state_* Լθ ٲ Ѵ.
+
+struct GLState
+{
+	bool is_blend;
+	bool is_cull_face;
+	bool is_depth_test;
+	bool is_stencil_test;
+	bool is_scissor_test;
+
+	GLenum blend_equation_rgb;
+	GLenum blend_equation_alpha;
+	GLenum blend_src_rgb;
+	GLenum blend_dst_rgb;
+	GLenum blend_src_alpha;
+	GLenum blend_dst_alpha;
+
+	GLenum polygon_mode; // GL_FRONT_AND_BACK
+};
+extern GLState g_gl_state;
+
+// context      GL о´.
+void gl_state_init();
+
+// GL_BLEND, GL_CULL_FACE, GL_DEPTH_TEST, GL_STENCIL_TEST, GL_SCISSOR_TEST
+void gl_state_set_enable(GLenum cap, bool is_enable);
+void gl_state_set_blend_equation(GLenum mode_rgb, GLenum mode_alpha);
+void gl_state_set_blend_func(GLenum src_rgb, GLenum dst_rgb, GLenum src_alpha, GLenum dst_alpha);
+void gl_state_set_polygon_mode(GLenum mode);
+
+// ̸   state ǵ. ޶ ͸ GL ȣѴ.
+void gl_state_restore(const GLState& saved);
+
+// g_gl_state  GL state  glGet ȮѴ. (Ƿ debug 忡 .)
+void gl_state_validate(const char* file, int line);
+#if defined(_DEBUG) || defined(GL_STATE_VALIDATION)
+#define GL_STATE_VALIDATE() gl_state_validate(__FILE__, __LINE__)
+#else
+#define GL_STATE_VALIDATE() ((void)0)
+#endif
+
+#endif
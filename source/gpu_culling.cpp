@@ -0,0 +1,337 @@
+#include "gpu_culling.h"
+
+#include <stdio.h>
+#include <assert.h>
+#include <math.h>
+
+#include "gl_extension.h"
+#include "memory_tracker.h"
+#include "utility.h"
+
+GPUCulling g_gpu_culling;
+
+constexpr unsigned CULLING_GROUP_SIZE = 64;	// culling_shader.comp local_size_x
+constexpr unsigned HIZ_GROUP_SIZE = 8;		// hiz_shader.comp local_size_x/y
+
+// view projection matrixκ world space 6 frustum plane ̾Ƴ. (Gribb-Hartmann)
+static void extract_frustum_planes(const glm::mat4& view_projection, glm::vec4 planes[6])
+{
+	glm::vec4 row0(view_projection[0][0], view_projection[1][0], view_projection[2][0], view_projection[3][0]);
+	glm::vec4 row1(view_projection[0][1], view_projection[1][1], view_projection[2][1], view_projection[3][1]);
+	glm::vec4 row2(view_projection[0][2], view_projection[1][2], view_projection[2][2], view_projection[3][2]);
+	glm::vec4 row3(view_projection[0][3], view_projection[1][3], view_projection[2][3], view_projection[3][3]);
+
+	planes[0] = row3 + row0; // left
+	planes[1] = row3 - row0; // right
+	planes[2] = row3 + row1; // bottom
+	planes[3] = row3 - row1; // top
+	planes[4] = row3 + row2; // near
+	planes[5] = row3 - row2; // far
+
+	for (int i = 0; i < 6; ++i)
+	{
+		float length = glm::length(glm::vec3(planes[i]));
+		planes[i] /= length;
+	}
+}
+
+static void hiz_release()
+{
+	if (g_gpu_culling.tex_depth_copy != 0)
+	{
+		memory_tracker_gpu_release(GPU_MEMORY_TEXTURE, g_gpu_culling.tex_depth_copy);
+		memory_tracker_gpu_release(GPU_MEMORY_TEXTURE, g_gpu_culling.tex_hiz);
+		glDeleteTextures(1, &g_gpu_culling.tex_depth_copy);
+		glDeleteTextures(1, &g_gpu_culling.tex_hiz);
+	}
+	g_gpu_culling.tex_depth_copy = 0;
+	g_gpu_culling.tex_hiz = 0;
+	g_gpu_culling.hiz_width = 0;
+	g_gpu_culling.hiz_height = 0;
+	g_gpu_culling.hiz_mip_count = 0;
+	g_gpu_culling.is_hiz_valid = false;
+}
+
+static void hiz_resize(int width, int height)
+{
+	hiz_release();
+
+	g_gpu_culling.hiz_width = width;
+	g_gpu_culling.hiz_height = height;
+	g_gpu_culling.hiz_mip_count = (int)floor(log2((double)(width > height ? width : height))) + 1;
+
+	// default framebuffer depth shader ٷ   Ƿ texture ؼ Ѵ.
+	glGenTextures(1, &g_gpu_culling.tex_depth_copy);
+	glBindTexture(GL_TEXTURE_2D, g_gpu_culling.tex_depth_copy);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT24, width, height, 0, GL_DEPTH_COMPONENT, GL_UNSIGNED_INT, NULL);
+	memory_tracker_gpu_set(GPU_MEMORY_TEXTURE, g_gpu_culling.tex_depth_copy, (size_t)width * height * 4);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_COMPARE_MODE, GL_NONE);
+
+	//  mip level Ʒ level ڽ     depth .
+	glGenTextures(1, &g_gpu_culling.tex_hiz);
+	glBindTexture(GL_TEXTURE_2D, g_gpu_culling.tex_hiz);
+	int level_width = width;
+	int level_height = height;
+	size_t hiz_bytes = 0;
+	for (int level = 0; level < g_gpu_culling.hiz_mip_count; ++level)
+	{
+		glTexImage2D(GL_TEXTURE_2D, level, GL_R32F, level_width, level_height, 0, GL_RED, GL_FLOAT, NULL);
+		hiz_bytes += (size_t)level_width * level_height * sizeof(float);
+		level_width = level_width > 1 ? level_width / 2 : 1;
+		level_height = level_height > 1 ? level_height / 2 : 1;
+	}
+	memory_tracker_gpu_set(GPU_MEMORY_TEXTURE, g_gpu_culling.tex_hiz, hiz_bytes);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, g_gpu_culling.hiz_mip_count - 1);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+}
+
+void gpu_culling_init()
+{
+	g_gpu_culling.is_supported = g_gl_ext.has_compute_shader;
+	g_gpu_culling.is_use_draw_count = g_gl_ext.has_indirect_parameters;
+	g_gpu_culling.is_enable = false;
+	g_gpu_culling.is_enable_occlusion = true;
+	g_gpu_culling.hiz_view_projection = glm::mat4(1.0f);
+	g_gpu_culling.mesh_count = 0;
+	g_gpu_culling.instance_capacity = 0;
+	g_gpu_culling.instance_count = 0;
+	g_gpu_culling.is_hiz_valid = false;
+
+	if (!g_gpu_culling.is_supported)
+	{
+		printf("GPU Culling is not supported on this driver\n");
+		return;
+	}
+
+	std::vector<char> shader_source;
+
+	file_open_fill_buffer("culling_shader.comp", shader_source);
+	GLuint cso = glCreateShader(GL_COMPUTE_SHADER);
+	gl_validate_shader(cso, (const char*)shader_source.data());
+	g_gpu_culling.shader_cull = cso;
+
+	GLuint pso = glCreateProgram();
+	gl_validate_compute_program(pso, cso);
+	g_gpu_culling.pso_cull = pso;
+
+	g_gpu_culling.loc_instance_count = glGetUniformLocation(pso, "instance_count");
+	g_gpu_culling.loc_mesh_count = glGetUniformLocation(pso, "mesh_count");
+	g_gpu_culling.loc_instance_capacity = glGetUniformLocation(pso, "instance_capacity");
+	g_gpu_culling.loc_is_compact = glGetUniformLocation(pso, "is_compact");
+	g_gpu_culling.loc_frustum_planes = glGetUniformLocation(pso, "frustum_planes");
+	g_gpu_culling.loc_is_use_occlusion = glGetUniformLocation(pso, "is_use_occlusion");
+	g_gpu_culling.loc_hiz_texture = glGetUniformLocation(pso, "hiz_texture");
+	g_gpu_culling.loc_hiz_view_projection = glGetUniformLocation(pso, "hiz_view_projection");
+	g_gpu_culling.loc_hiz_size = glGetUniformLocation(pso, "hiz_size");
+	g_gpu_culling.loc_hiz_mip_count = glGetUniformLocation(pso, "hiz_mip_count");
+
+	file_open_fill_buffer("hiz_shader.comp", shader_source);
+	cso = glCreateShader(GL_COMPUTE_SHADER);
+	gl_validate_shader(cso, (const char*)shader_source.data());
+	g_gpu_culling.shader_hiz = cso;
+
+	pso = glCreateProgram();
+	gl_validate_compute_program(pso, cso);
+	g_gpu_culling.pso_hiz = pso;
+
+	g_gpu_culling.loc_is_copy_depth = glGetUniformLocation(pso, "is_copy_depth");
+	g_gpu_culling.loc_depth_texture = glGetUniformLocation(pso, "depth_texture");
+	g_gpu_culling.loc_src_size = glGetUniformLocation(pso, "src_size");
+	g_gpu_culling.loc_dst_size = glGetUniformLocation(pso, "dst_size");
+
+	glGenBuffers(1, &g_gpu_culling.ssbo_mesh);
+	glGenBuffers(1, &g_gpu_culling.indirect_buffer);
+	glGenBuffers(1, &g_gpu_culling.draw_count_buffer);
+}
+
+void gpu_culling_terminate()
+{
+	if (!g_gpu_culling.is_supported)
+	{
+		return;
+	}
+
+	hiz_release();
+	memory_tracker_gpu_release(GPU_MEMORY_BUFFER, g_gpu_culling.draw_count_buffer);
+	memory_tracker_gpu_release(GPU_MEMORY_BUFFER, g_gpu_culling.indirect_buffer);
+	memory_tracker_gpu_release(GPU_MEMORY_BUFFER, g_gpu_culling.ssbo_mesh);
+	glDeleteBuffers(1, &g_gpu_culling.draw_count_buffer);
+	glDeleteBuffers(1, &g_gpu_culling.indirect_buffer);
+	glDeleteBuffers(1, &g_gpu_culling.ssbo_mesh);
+	glDeleteProgram(g_gpu_culling.pso_hiz);
+	glDeleteShader(g_gpu_culling.shader_hiz);
+	glDeleteProgram(g_gpu_culling.pso_cull);
+	glDeleteShader(g_gpu_culling.shader_cull);
+}
+
+void gpu_culling_set_meshes(const std::vector<GPUCullingMesh>& meshes, unsigned instance_count)
+{
+	if (!g_gpu_culling.is_supported)
+	{
+		return;
+	}
+
+	const unsigned mesh_count = (unsigned)meshes.size();
+
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, g_gpu_culling.ssbo_mesh);
+	glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(GPUCullingMesh) * mesh_count, meshes.data(), GL_STATIC_DRAW);
+	memory_tracker_gpu_set(GPU_MEMORY_BUFFER, g_gpu_culling.ssbo_mesh, sizeof(GPUCullingMesh) * mesh_count);
+
+	// command buffer instance  þ  ٽ ҴѴ.
+	if (mesh_count != g_gpu_culling.mesh_count || instance_count > g_gpu_culling.instance_capacity)
+	{
+		unsigned capacity = g_gpu_culling.instance_capacity > 0 ? g_gpu_culling.instance_capacity : 1;
+		while (capacity < instance_count)
+		{
+			capacity *= 2;
+		}
+
+		g_gpu_culling.mesh_count = mesh_count;
+		g_gpu_culling.instance_capacity = capacity;
+
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, g_gpu_culling.indirect_buffer);
+		glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(DrawElementsIndirectCommand) * mesh_count * capacity, NULL, GL_DYNAMIC_DRAW);
+		memory_tracker_gpu_set(GPU_MEMORY_BUFFER, g_gpu_culling.indirect_buffer, sizeof(DrawElementsIndirectCommand) * mesh_count * capacity);
+
+		g_gpu_culling.zero_draw_count.assign(mesh_count, 0);
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, g_gpu_culling.draw_count_buffer);
+		glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(GLuint) * mesh_count, g_gpu_culling.zero_draw_count.data(), GL_DYNAMIC_DRAW);
+		memory_tracker_gpu_set(GPU_MEMORY_BUFFER, g_gpu_culling.draw_count_buffer, sizeof(GLuint) * mesh_count);
+	}
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+}
+
+void gpu_culling_dispatch(GLuint instance_buffer, unsigned instance_count, const glm::mat4& view_projection)
+{
+	if (!g_gpu_culling.is_supported || !g_gpu_culling.is_enable)
+	{
+		return;
+	}
+	assert(instance_count <= g_gpu_culling.instance_capacity);
+
+	glUseProgram(g_gpu_culling.pso_cull);
+
+	// Ƴ draw   count buffer   0 ´.
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, g_gpu_culling.draw_count_buffer);
+	glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, sizeof(GLuint) * g_gpu_culling.mesh_count, g_gpu_culling.zero_draw_count.data());
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, instance_buffer);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, g_gpu_culling.ssbo_mesh);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, g_gpu_culling.indirect_buffer);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, g_gpu_culling.draw_count_buffer);
+
+	glm::vec4 planes[6];
+	extract_frustum_planes(view_projection, planes);
+
+	const bool is_use_occlusion = g_gpu_culling.is_enable_occlusion && g_gpu_culling.is_hiz_valid;
+
+	glUniform1ui(g_gpu_culling.loc_instance_count, instance_count);
+	glUniform1ui(g_gpu_culling.loc_mesh_count, g_gpu_culling.mesh_count);
+	glUniform1ui(g_gpu_culling.loc_instance_capacity, g_gpu_culling.instance_capacity);
+	glUniform1i(g_gpu_culling.loc_is_compact, g_gpu_culling.is_use_draw_count);
+	glUniform4fv(g_gpu_culling.loc_frustum_planes, 6, &(planes[0][0]));
+	glUniform1i(g_gpu_culling.loc_is_use_occlusion, is_use_occlusion);
+
+	glActiveTexture(GL_TEXTURE0);
+	glBindTexture(GL_TEXTURE_2D, is_use_occlusion ? g_gpu_culling.tex_hiz : 0);
+	glUniform1i(g_gpu_culling.loc_hiz_texture, 0);
+	if (is_use_occlusion)
+	{
+		glUniformMatrix4fv(g_gpu_culling.loc_hiz_view_projection, 1, GL_FALSE, &(g_gpu_culling.hiz_view_projection[0][0]));
+		glUniform2f(g_gpu_culling.loc_hiz_size, (float)g_gpu_culling.hiz_width, (float)g_gpu_culling.hiz_height);
+		glUniform1i(g_gpu_culling.loc_hiz_mip_count, g_gpu_culling.hiz_mip_count);
+	}
+
+	const unsigned draw_count = instance_count * g_gpu_culling.mesh_count;
+	glDispatchCompute((draw_count + CULLING_GROUP_SIZE - 1) / CULLING_GROUP_SIZE, 1, 1);
+
+	// indirect command count draw б  compute write ־ Ѵ.
+	glMemoryBarrier(GL_COMMAND_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT);
+
+	g_gpu_culling.instance_count = instance_count;
+}
+
+void gpu_culling_draw_mesh(unsigned mesh_index)
+{
+	assert(mesh_index < g_gpu_culling.mesh_count);
+
+	const GLintptr command_offset = (GLintptr)sizeof(DrawElementsIndirectCommand) * mesh_index * g_gpu_culling.instance_capacity;
+
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, g_gpu_culling.indirect_buffer);
+	if (g_gpu_culling.is_use_draw_count)
+	{
+		glBindBuffer(GL_PARAMETER_BUFFER, g_gpu_culling.draw_count_buffer);
+		glMultiDrawElementsIndirectCount(GL_TRIANGLES, GL_UNSIGNED_INT, (const void*)command_offset,
+			(GLintptr)(sizeof(GLuint) * mesh_index), (GLsizei)g_gpu_culling.instance_capacity, sizeof(DrawElementsIndirectCommand));
+		glBindBuffer(GL_PARAMETER_BUFFER, 0);
+	}
+	else
+	{
+		glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, (const void*)command_offset,
+			(GLsizei)g_gpu_culling.instance_count, sizeof(DrawElementsIndirectCommand));
+	}
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+}
+
+void gpu_culling_build_hiz(int width, int height, const glm::mat4& view_projection)
+{
+	if (!g_gpu_culling.is_supported || !g_gpu_culling.is_enable || !g_gpu_culling.is_enable_occlusion ||
+		width <= 0 || height <= 0)
+	{
+		g_gpu_culling.is_hiz_valid = false;
+		return;
+	}
+
+	if (width != g_gpu_culling.hiz_width || height != g_gpu_culling.hiz_height)
+	{
+		hiz_resize(width, height);
+	}
+
+	//  ׸ scene depth texture Ѵ.
+	glActiveTexture(GL_TEXTURE0);
+	glBindTexture(GL_TEXTURE_2D, g_gpu_culling.tex_depth_copy);
+	glCopyTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, 0, 0, width, height);
+
+	glUseProgram(g_gpu_culling.pso_hiz);
+	glUniform1i(g_gpu_culling.loc_depth_texture, 0);
+
+	// level 0 : depth 
+	glUniform1i(g_gpu_culling.loc_is_copy_depth, true);
+	glUniform2i(g_gpu_culling.loc_src_size, width, height);
+	glUniform2i(g_gpu_culling.loc_dst_size, width, height);
+	glBindImageTexture(1, g_gpu_culling.tex_hiz, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32F);
+	glDispatchCompute((width + HIZ_GROUP_SIZE - 1) / HIZ_GROUP_SIZE, (height + HIZ_GROUP_SIZE - 1) / HIZ_GROUP_SIZE, 1);
+
+	// level n : level n - 1 max reduction
+	glUniform1i(g_gpu_culling.loc_is_copy_depth, false);
+	int src_width = width;
+	int src_height = height;
+	for (int level = 1; level < g_gpu_culling.hiz_mip_count; ++level)
+	{
+		int dst_width = src_width > 1 ? src_width / 2 : 1;
+		int dst_height = src_height > 1 ? src_height / 2 : 1;
+
+		glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+		glBindImageTexture(0, g_gpu_culling.tex_hiz, level - 1, GL_FALSE, 0, GL_READ_ONLY, GL_R32F);
+		glBindImageTexture(1, g_gpu_culling.tex_hiz, level, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32F);
+		glUniform2i(g_gpu_culling.loc_src_size, src_width, src_height);
+		glUniform2i(g_gpu_culling.loc_dst_size, dst_width, dst_height);
+		glDispatchCompute((dst_width + HIZ_GROUP_SIZE - 1) / HIZ_GROUP_SIZE, (dst_height + HIZ_GROUP_SIZE - 1) / HIZ_GROUP_SIZE, 1);
+
+		src_width = dst_width;
+		src_height = dst_height;
+	}
+
+	//   culling sampler д´.
+	glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT);
+
+	g_gpu_culling.hiz_view_projection = view_projection;
+	g_gpu_culling.is_hiz_valid = true;
+}
@@ -0,0 +1,97 @@
+#ifndef __GPU_CULLING_H__
+#define __GPU_CULLING_H__
+
+#include <vector>
+
+#include "glad/glad.h"
+#include "glm/glm.hpp"
+
+// compute shader instance ϳ  mesh ϳ(draw ϳ) frustum/occlusion culling ϰ,
+// Ƴ draw indirect buffer ä glMultiDrawElementsIndirect(Count) ׸ Ѵ.
+
+// culling_shader.comp MeshCullData  layout(std430)̾ Ѵ.
+struct GPUCullingMesh
+{
+	glm::vec4 aabb_min;
+	glm::vec4 aabb_max;
+	glm::uvec4 draw; // x : index count
+};
+
+// glMultiDrawElementsIndirect о command layout
+struct DrawElementsIndirectCommand
+{
+	GLuint count;
+	GLuint instance_count;
+	GLuint first_index;
+	GLint base_vertex;
+	GLuint base_instance;
+};
+
+struct GPUCulling
+{
+	// GL 4.3 (compute shader/SSBO/multi draw indirect) ٸ CPU  instance ׸.
+	bool is_supported;
+	bool is_enable;
+	bool is_enable_occlusion;
+
+	// ARB_indirect_parameters ִٸ Ƴ draw ؼ count buffer Բ ׸,
+	// ٸ  slot ä culling draw instance_count 0 д.
+	bool is_use_draw_count;
+
+	GLuint shader_cull;
+	GLuint pso_cull;
+	GLuint shader_hiz;
+	GLuint pso_hiz;
+
+	// mesh  instance_capacity ŭ command  .
+	GLuint ssbo_mesh;
+	GLuint indirect_buffer;
+	GLuint draw_count_buffer;
+	unsigned mesh_count;
+	unsigned instance_capacity;
+	unsigned instance_count;	//  dispatch instance 
+	std::vector<GLuint> zero_draw_count;
+
+	//   depth  Hi-Z pyramid
+	GLuint tex_depth_copy;
+	GLuint tex_hiz;
+	int hiz_width;
+	int hiz_height;
+	int hiz_mip_count;
+	bool is_hiz_valid;
+	glm::mat4 hiz_view_projection;
+
+	// uniform locations
+	GLint loc_instance_count;
+	GLint loc_mesh_count;
+	GLint loc_instance_capacity;
+	GLint loc_is_compact;
+	GLint loc_frustum_planes;
+	GLint loc_is_use_occlusion;
+	GLint loc_hiz_texture;
+	GLint loc_hiz_view_projection;
+	GLint loc_hiz_size;
+	GLint loc_hiz_mip_count;
+	GLint loc_is_copy_depth;
+	GLint loc_depth_texture;
+	GLint loc_src_size;
+	GLint loc_dst_size;
+};
+extern GPUCulling g_gpu_culling;
+
+void gpu_culling_init();
+void gpu_culling_terminate();
+
+// mesh (bounds / index count) ٲų instance  capacity   ȣѴ.
+void gpu_culling_set_meshes(const std::vector<GPUCullingMesh>& meshes, unsigned instance_count);
+
+// instance_buffer instance mat4 world ϳ  ־ Ѵ.
+void gpu_culling_dispatch(GLuint instance_buffer, unsigned instance_count, const glm::mat4& view_projection);
+
+// ̹ VAO material bind ¿, ش mesh Ƴ instance ׸.
+void gpu_culling_draw_mesh(unsigned mesh_index);
+
+// scene  ׸   depth buffer  ӿ  Hi-Z pyramid .
+void gpu_culling_build_hiz(int width, int height, const glm::mat4& view_projection);
+
+#endif
@@ -0,0 +1,243 @@
+#include "gpu_profiler.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <float.h>
+
+#include "imgui/imgui.h"
+
+GPUProfiler g_gpu_profiler;
+
+static void profiler_history_push(float* history, int* index, int* count, float value)
+{
+	history[*index] = value;
+	*index = (*index + 1) % PROFILER_HISTORY_COUNT;
+	if (*count < PROFILER_HISTORY_COUNT)
+	{
+		++(*count);
+	}
+}
+
+static void profiler_history_stat(const float* history, int count, float* avg, float* min, float* max)
+{
+	*avg = 0.f;
+	*min = count > 0 ? FLT_MAX : 0.f;
+	*max = 0.f;
+	for (int i = 0; i < count; ++i)
+	{
+		*avg += history[i];
+		*min = history[i] < *min ? history[i] : *min;
+		*max = history[i] > *max ? history[i] : *max;
+	}
+
+	if (count > 0)
+	{
+		*avg /= (float)count;
+	}
+}
+
+static int profiler_find_scope(const char* name)
+{
+	for (int i = 0; i < g_gpu_profiler.scope_count; ++i)
+	{
+		if (g_gpu_profiler.scopes[i].name == name || strcmp(g_gpu_profiler.scopes[i].name, name) == 0)
+		{
+			return i;
+		}
+	}
+
+	if (g_gpu_profiler.scope_count >= PROFILER_MAX_SCOPES)
+	{
+		printf("Too many profiler scopes : %s\n", name);
+		assert(false);
+		return -1;
+	}
+
+	int scope_index = g_gpu_profiler.scope_count++;
+	ProfilerScope* scope = &(g_gpu_profiler.scopes[scope_index]);
+	scope->name = name;
+	scope->depth = g_gpu_profiler.scope_stack_size;
+	if (g_gpu_profiler.is_supported)
+	{
+		glGenQueries(PROFILER_QUERY_LATENCY * 2, &(scope->queries[0][0]));
+	}
+
+	return scope_index;
+}
+
+void gpu_profiler_init()
+{
+	// ProfilerScope time_point Ƿ memset  value-initialization 0 ä.
+	g_gpu_profiler = GPUProfiler();
+
+	GLint timestamp_bits = 0;
+	glGetQueryiv(GL_TIMESTAMP, GL_QUERY_COUNTER_BITS, &timestamp_bits);
+	g_gpu_profiler.is_supported = timestamp_bits > 0;
+	g_gpu_profiler.is_enable = true;
+}
+
+void gpu_profiler_terminate()
+{
+	for (int i = 0; i < g_gpu_profiler.scope_count; ++i)
+	{
+		if (g_gpu_profiler.is_supported)
+		{
+			glDeleteQueries(PROFILER_QUERY_LATENCY * 2, &(g_gpu_profiler.scopes[i].queries[0][0]));
+		}
+	}
+	g_gpu_profiler.scope_count = 0;
+}
+
+void gpu_profiler_begin_frame()
+{
+	g_gpu_profiler.query_slot = (int)(g_gpu_profiler.frame_number % PROFILER_QUERY_LATENCY);
+	g_gpu_profiler.scope_stack_size = 0;
+
+	// ̹ slot query PROFILER_QUERY_LATENCY frame   ̴.
+	//  غǾٸ а, ̶ ٸ ʰ .
+	const int slot = g_gpu_profiler.query_slot;
+	for (int i = 0; i < g_gpu_profiler.scope_count; ++i)
+	{
+		ProfilerScope* scope = &(g_gpu_profiler.scopes[i]);
+		if (!scope->is_issued[slot])
+		{
+			continue;
+		}
+		scope->is_issued[slot] = false;
+
+		GLint is_available = GL_FALSE;
+		glGetQueryObjectiv(scope->queries[slot][1], GL_QUERY_RESULT_AVAILABLE, &is_available);
+		if (!is_available)
+		{
+			continue;
+		}
+
+		GLuint64 begin_ns, end_ns;
+		glGetQueryObjectui64v(scope->queries[slot][0], GL_QUERY_RESULT, &begin_ns);
+		glGetQueryObjectui64v(scope->queries[slot][1], GL_QUERY_RESULT, &end_ns);
+		float gpu_ms = end_ns > begin_ns ? (float)(end_ns - begin_ns) / 1000000.f : 0.f;
+		profiler_history_push(scope->gpu_history, &(scope->gpu_history_index), &(scope->gpu_history_count), gpu_ms);
+		++scope->gpu_result_count;
+	}
+}
+
+void gpu_profiler_end_frame()
+{
+	assert(g_gpu_profiler.scope_stack_size == 0);
+	++g_gpu_profiler.frame_number;
+}
+
+void gpu_profiler_begin(const char* name)
+{
+	if (!g_gpu_profiler.is_enable)
+	{
+		return;
+	}
+
+	int scope_index = profiler_find_scope(name);
+	if (scope_index < 0 || g_gpu_profiler.scope_stack_size >= PROFILER_MAX_DEPTH)
+	{
+		assert(false);
+		return;
+	}
+	g_gpu_profiler.scope_stack[g_gpu_profiler.scope_stack_size++] = scope_index;
+
+	ProfilerScope* scope = &(g_gpu_profiler.scopes[scope_index]);
+	if (g_gpu_profiler.is_supported)
+	{
+		glQueryCounter(scope->queries[g_gpu_profiler.query_slot][0], GL_TIMESTAMP);
+	}
+	scope->cpu_begin = std::chrono::steady_clock::now();
+}
+
+void gpu_profiler_end()
+{
+	if (!g_gpu_profiler.is_enable)
+	{
+		return;
+	}
+
+	assert(g_gpu_profiler.scope_stack_size > 0);
+	int scope_index = g_gpu_profiler.scope_stack[--g_gpu_profiler.scope_stack_size];
+	ProfilerScope* scope = &(g_gpu_profiler.scopes[scope_index]);
+
+	// CPU ð GL  ̹ ִ  ɸ ð̴.
+	float cpu_ms = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - scope->cpu_begin).count();
+	profiler_history_push(scope->cpu_history, &(scope->cpu_history_index), &(scope->cpu_history_count), cpu_ms);
+
+	if (g_gpu_profiler.is_supported)
+	{
+		glQueryCounter(scope->queries[g_gpu_profiler.query_slot][1], GL_TIMESTAMP);
+		scope->is_issued[g_gpu_profiler.query_slot] = true;
+	}
+}
+
+const ProfilerScope* gpu_profiler_find(const char* name)
+{
+	for (int i = 0; i < g_gpu_profiler.scope_count; ++i)
+	{
+		if (strcmp(g_gpu_profiler.scopes[i].name, name) == 0)
+		{
+			return &(g_gpu_profiler.scopes[i]);
+		}
+	}
+
+	return NULL;
+}
+
+float gpu_profiler_latest_gpu_ms(const ProfilerScope* scope)
+{
+	if (scope->gpu_history_count == 0)
+	{
+		return 0.f;
+	}
+
+	int last_index = (scope->gpu_history_index + PROFILER_HISTORY_COUNT - 1) % PROFILER_HISTORY_COUNT;
+	return scope->gpu_history[last_index];
+}
+
+void gpu_profiler_draw_gui()
+{
+	ImGui::Text("Profiler"); ImGui::SameLine();
+	ImGui::Checkbox("##Profiler", &g_gpu_profiler.is_enable);
+	if (!g_gpu_profiler.is_supported)
+	{
+		ImGui::Text("GPU Timer Query : Not Supported");
+	}
+
+	if (ImGui::BeginTable("##ProfilerTable", 4, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingFixedFit))
+	{
+		ImGui::TableSetupColumn("Scope");
+		ImGui::TableSetupColumn("CPU avg / min / max (ms)");
+		ImGui::TableSetupColumn("GPU avg / min / max (ms)");
+		ImGui::TableSetupColumn("GPU History");
+		ImGui::TableHeadersRow();
+
+		for (int i = 0; i < g_gpu_profiler.scope_count; ++i)
+		{
+			const ProfilerScope* scope = &(g_gpu_profiler.scopes[i]);
+			float cpu_avg, cpu_min, cpu_max;
+			float gpu_avg, gpu_min, gpu_max;
+			profiler_history_stat(scope->cpu_history, scope->cpu_history_count, &cpu_avg, &cpu_min, &cpu_max);
+			profiler_history_stat(scope->gpu_history, scope->gpu_history_count, &gpu_avg, &gpu_min, &gpu_max);
+
+			ImGui::PushID(i);
+			ImGui::TableNextRow();
+			ImGui::TableSetColumnIndex(0);
+			ImGui::Text("%*s%s", scope->depth * 2, "", scope->name);
+			ImGui::TableSetColumnIndex(1);
+			ImGui::Text("%.3f / %.3f / %.3f", cpu_avg, cpu_min, cpu_max);
+			ImGui::TableSetColumnIndex(2);
+			ImGui::Text("%.3f / %.3f / %.3f", gpu_avg, gpu_min, gpu_max);
+			ImGui::TableSetColumnIndex(3);
+
+			// history ring buffer̹Ƿ    ׸ offset ش.
+			int offset = scope->gpu_history_count < PROFILER_HISTORY_COUNT ? 0 : scope->gpu_history_index;
+			ImGui::PlotLines("##GPUHistory", scope->gpu_history, scope->gpu_history_count, offset,
+				NULL, 0.f, gpu_max > 0.f ? gpu_max * 1.2f : 1.f, ImVec2(160.f, 24.f));
+			ImGui::PopID();
+		}
+		ImGui::EndTable();
+	}
+}
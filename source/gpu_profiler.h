@@ -0,0 +1,83 @@
+#ifndef __GPU_PROFILER_H__
+#define __GPU_PROFILER_H__
+
+#include <chrono>
+
+#include "glad/glad.h"
+#include "frame_sync.h"
+
+// pass  GPU ð(GL_TIMESTAMP query) CPU ð  .
+// query   frame ڿ   Ȯϰ б  GPU ٸ ʴ´.
+//  :
+//   gpu_profiler_begin_frame();
+//   gpu_profiler_begin("Model"); model_draw(); gpu_profiler_end();
+//   gpu_profiler_end_frame();
+// scope ø  ִ.
+
+constexpr int PROFILER_MAX_SCOPES = 16;
+constexpr int PROFILER_MAX_DEPTH = 8;
+constexpr int PROFILER_HISTORY_COUNT = 120;
+
+// frame in flight ŭ GPU   Ƿ ׺ ְ query set  .
+constexpr int PROFILER_QUERY_LATENCY = MAX_FRAMES_IN_FLIGHT + 2;
+
+struct ProfilerScope
+{
+	const char* name;
+	int depth;
+
+	// [latency slot][0 : begin, 1 : end]
+	GLuint queries[PROFILER_QUERY_LATENCY][2];
+	bool is_issued[PROFILER_QUERY_LATENCY];
+
+	std::chrono::steady_clock::time_point cpu_begin;
+
+	// ֱ PROFILER_HISTORY_COUNT   (ms)
+	float cpu_history[PROFILER_HISTORY_COUNT];
+	float gpu_history[PROFILER_HISTORY_COUNT];
+	int cpu_history_index;
+	int gpu_history_index;
+	int cpu_history_count;
+	int gpu_history_count;
+
+	// ݱ о GPU   .   Դ Ȯ  .
+	unsigned gpu_result_count;
+};
+
+struct GPUProfiler
+{
+	// ̹ timestamp counter 0 bit̸ GPU ð  ʴ´.
+	bool is_supported;
+	bool is_enable;
+
+	unsigned frame_number;
+	int query_slot;
+
+	ProfilerScope scopes[PROFILER_MAX_SCOPES];
+	int scope_count;
+
+	int scope_stack[PROFILER_MAX_DEPTH];
+	int scope_stack_size;
+};
+extern GPUProfiler g_gpu_profiler;
+
+void gpu_profiler_init();
+void gpu_profiler_terminate();
+
+void gpu_profiler_begin_frame();
+void gpu_profiler_end_frame();
+
+// name α׷   ȿ ڿ(ڿ literal)̾ Ѵ.
+void gpu_profiler_begin(const char* name);
+void gpu_profiler_end();
+
+// ش ̸ scope  ٸ NULL
+const ProfilerScope* gpu_profiler_find(const char* name);
+
+//  ֱٿ о GPU ð (ms)
+float gpu_profiler_latest_gpu_ms(const ProfilerScope* scope);
+
+// ϵ scope CPU/GPU , ּ/ִ GPU history graph ش.
+void gpu_profiler_draw_gui();
+
+#endif
@@ -0,0 +1,392 @@
+#include "headless.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <assert.h>
+#include <vector>
+
+#if defined(HEADLESS_EGL)
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#endif
+
+#include "utility.h"
+#include "memory_tracker.h"
+
+Headless g_headless;
+
+void headless_print_usage()
+{
+	printf("  --headless            render offscreen without a visible window\n");
+	printf("  --size WxH            offscreen framebuffer size (default %dx%d)\n", HEADLESS_DEFAULT_WIDTH, HEADLESS_DEFAULT_HEIGHT);
+	printf("  --frames N            number of frames to render in headless mode (default %d)\n", HEADLESS_DEFAULT_FRAME_COUNT);
+	printf("  --dump FOLDER         save frames as PNG into FOLDER\n");
+	printf("  --dump-every K        save every K-th frame (default 1)\n");
+}
+
+void headless_set_defaults()
+{
+	memset(&g_headless, 0, sizeof(Headless));
+	g_headless.width = HEADLESS_DEFAULT_WIDTH;
+	g_headless.height = HEADLESS_DEFAULT_HEIGHT;
+	g_headless.frame_count = HEADLESS_DEFAULT_FRAME_COUNT;
+	g_headless.fixed_delta_time = 1.f / 60.f;
+}
+
+bool headless_parse_arg(int argc, char** argv, int* index)
+{
+	const char* arg = argv[*index];
+	const bool has_value = *index + 1 < argc;
+	if (strcmp(arg, "--headless") == 0)
+	{
+		g_headless.is_enable = true;
+		return true;
+	}
+
+	if (!has_value)
+	{
+		return false;
+	}
+
+	if (strcmp(arg, "--size") == 0)
+	{
+		int width, height;
+		if (sscanf(argv[*index + 1], "%dx%d", &width, &height) != 2 || width <= 0 || height <= 0)
+		{
+			return false;
+		}
+		g_headless.width = width;
+		g_headless.height = height;
+	}
+	else if (strcmp(arg, "--frames") == 0)
+	{
+		g_headless.frame_count = atoi(argv[*index + 1]);
+	}
+	else if (strcmp(arg, "--dump") == 0)
+	{
+		snprintf(g_headless.dump_folder, sizeof(g_headless.dump_folder), "%s", argv[*index + 1]);
+		if (g_headless.dump_interval == 0)
+		{
+			g_headless.dump_interval = 1;
+		}
+	}
+	else if (strcmp(arg, "--dump-every") == 0)
+	{
+		g_headless.dump_interval = atoi(argv[*index + 1]);
+	}
+	else
+	{
+		return false;
+	}
+
+	++(*index);
+	return true;
+}
+
+#if defined(HEADLESS_EGL)
+bool headless_egl_create_context()
+{
+	// Mesa surfaceless platform ִٸ display   context   ִ.
+	EGLDisplay display = EGL_NO_DISPLAY;
+	const char* client_extensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+	PFNEGLGETPLATFORMDISPLAYEXTPROC get_platform_display = (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+	if (get_platform_display && client_extensions && strstr(client_extensions, "EGL_MESA_platform_surfaceless"))
+	{
+		display = get_platform_display(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL);
+	}
+	if (display == EGL_NO_DISPLAY)
+	{
+		display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+	}
+	if (display == EGL_NO_DISPLAY || !eglInitialize(display, NULL, NULL))
+	{
+		printf("Failed to initialize EGL display\n");
+		return false;
+	}
+	eglBindAPI(EGL_OPENGL_API);
+
+	const EGLint config_attribs[] =
+	{
+		EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+		EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+		EGL_RED_SIZE, 8, EGL_GREEN_SIZE, 8, EGL_BLUE_SIZE, 8, EGL_ALPHA_SIZE, 8,
+		EGL_DEPTH_SIZE, 24,
+		EGL_NONE
+	};
+	EGLConfig config = NULL;
+	EGLint config_count = 0;
+	eglChooseConfig(display, config_attribs, &config, 1, &config_count);
+
+	// glfw_init  3.3 core profile ûѴ.
+	const EGLint context_attribs[] =
+	{
+		EGL_CONTEXT_MAJOR_VERSION, 3,
+		EGL_CONTEXT_MINOR_VERSION, 3,
+		EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+		EGL_NONE
+	};
+	EGLContext context = eglCreateContext(display, config_count > 0 ? config : EGL_NO_CONFIG_KHR, EGL_NO_CONTEXT, context_attribs);
+	if (context == EGL_NO_CONTEXT)
+	{
+		printf("Failed to create EGL context\n");
+		eglTerminate(display);
+		return false;
+	}
+
+	//  FBO ׸Ƿ surface ʿ ,
+	// surfaceless context  ʴ ̹  pbuffer  current ´.
+	EGLSurface surface = EGL_NO_SURFACE;
+	const char* display_extensions = eglQueryString(display, EGL_EXTENSIONS);
+	if (!display_extensions || !strstr(display_extensions, "EGL_KHR_surfaceless_context"))
+	{
+		const EGLint pbuffer_attribs[] = { EGL_WIDTH, 16, EGL_HEIGHT, 16, EGL_NONE };
+		surface = eglCreatePbufferSurface(display, config, pbuffer_attribs);
+	}
+
+	if (!eglMakeCurrent(display, surface, surface, context))
+	{
+		printf("Failed to make EGL context current\n");
+		eglDestroyContext(display, context);
+		eglTerminate(display);
+		return false;
+	}
+
+	g_headless.egl_display = (void*)display;
+	g_headless.egl_surface = (void*)surface;
+	g_headless.egl_context = (void*)context;
+	return true;
+}
+
+void headless_egl_destroy_context()
+{
+	EGLDisplay display = (EGLDisplay)g_headless.egl_display;
+	if (display == EGL_NO_DISPLAY)
+	{
+		return;
+	}
+
+	eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+	if (g_headless.egl_surface != NULL)
+	{
+		eglDestroySurface(display, (EGLSurface)g_headless.egl_surface);
+	}
+	eglDestroyContext(display, (EGLContext)g_headless.egl_context);
+	eglTerminate(display);
+
+	g_headless.egl_display = NULL;
+	g_headless.egl_surface = NULL;
+	g_headless.egl_context = NULL;
+}
+
+void* headless_egl_get_proc_address(const char* name)
+{
+	return (void*)eglGetProcAddress(name);
+}
+#endif
+
+void headless_init()
+{
+	if (!g_headless.is_enable)
+	{
+		return;
+	}
+
+	glGenRenderbuffers(1, &(g_headless.rbo_color));
+	glBindRenderbuffer(GL_RENDERBUFFER, g_headless.rbo_color);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, g_headless.width, g_headless.height);
+	memory_tracker_gpu_set(GPU_MEMORY_RENDERBUFFER, g_headless.rbo_color, (size_t)g_headless.width * g_headless.height * 4);
+
+	glGenRenderbuffers(1, &(g_headless.rbo_depth));
+	glBindRenderbuffer(GL_RENDERBUFFER, g_headless.rbo_depth);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, g_headless.width, g_headless.height);
+	memory_tracker_gpu_set(GPU_MEMORY_RENDERBUFFER, g_headless.rbo_depth, (size_t)g_headless.width * g_headless.height * 4);
+	glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+	glGenFramebuffers(1, &(g_headless.fbo));
+	glBindFramebuffer(GL_FRAMEBUFFER, g_headless.fbo);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, g_headless.rbo_color);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, g_headless.rbo_depth);
+	if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+	{
+		printf("Headless framebuffer is not complete\n");
+		assert(false);
+	}
+	glViewport(0, 0, g_headless.width, g_headless.height);
+
+	if (g_headless.dump_interval > 0 && g_headless.dump_folder[0] != '\0')
+	{
+		file_make_folder(g_headless.dump_folder);
+	}
+
+	printf("Headless : %dx%d, %d frames\n", g_headless.width, g_headless.height, g_headless.frame_count);
+}
+
+void headless_terminate()
+{
+	if (!g_headless.is_enable)
+	{
+		return;
+	}
+
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	glDeleteFramebuffers(1, &(g_headless.fbo));
+	memory_tracker_gpu_release(GPU_MEMORY_RENDERBUFFER, g_headless.rbo_depth);
+	memory_tracker_gpu_release(GPU_MEMORY_RENDERBUFFER, g_headless.rbo_color);
+	glDeleteRenderbuffers(1, &(g_headless.rbo_depth));
+	glDeleteRenderbuffers(1, &(g_headless.rbo_color));
+}
+
+void headless_begin_frame()
+{
+	if (!g_headless.is_enable)
+	{
+		return;
+	}
+
+	glBindFramebuffer(GL_FRAMEBUFFER, g_headless.fbo);
+}
+
+// PNG ̴ CRC32 / Adler32
+static uint32_t png_crc32(uint32_t crc, const uint8_t* data, size_t size)
+{
+	static uint32_t table[256];
+	static bool is_table_ready = false;
+	if (!is_table_ready)
+	{
+		for (uint32_t n = 0; n < 256; ++n)
+		{
+			uint32_t c = n;
+			for (int k = 0; k < 8; ++k)
+			{
+				c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+			}
+			table[n] = c;
+		}
+		is_table_ready = true;
+	}
+
+	crc = ~crc;
+	for (size_t i = 0; i < size; ++i)
+	{
+		crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+	}
+	return ~crc;
+}
+
+static void png_put_u32(std::vector<uint8_t>& out, uint32_t value)
+{
+	out.push_back((uint8_t)(value >> 24));
+	out.push_back((uint8_t)(value >> 16));
+	out.push_back((uint8_t)(value >> 8));
+	out.push_back((uint8_t)(value));
+}
+
+static void png_write_chunk(FILE* fp, const char* type, const std::vector<uint8_t>& data)
+{
+	std::vector<uint8_t> chunk;
+	png_put_u32(chunk, (uint32_t)data.size());
+	chunk.insert(chunk.end(), type, type + 4);
+	chunk.insert(chunk.end(), data.begin(), data.end());
+	uint32_t crc = png_crc32(0, chunk.data() + 4, chunk.size() - 4);
+	png_put_u32(chunk, crc);
+	fwrite(chunk.data(), 1, chunk.size(), fp);
+}
+
+//  ̺귯 Ƿ deflate (stored) block RGBA8 PNG .
+//  Ŀ  viewerε   ִ.
+static bool headless_write_png(const char* path, const uint8_t* rgba, int width, int height)
+{
+	FILE* fp = fopen(path, "wb");
+	if (!fp)
+	{
+		return false;
+	}
+
+	const uint8_t signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+	fwrite(signature, 1, sizeof(signature), fp);
+
+	std::vector<uint8_t> header;
+	png_put_u32(header, (uint32_t)width);
+	png_put_u32(header, (uint32_t)height);
+	header.push_back(8);	// bit depth
+	header.push_back(6);	// color type : RGBA
+	header.push_back(0);	// compression
+	header.push_back(0);	// filter
+	header.push_back(0);	// interlace
+	png_write_chunk(fp, "IHDR", header);
+
+	//   տ filter type(0 : None) δ.
+	// glReadPixels Ʒ ٺ оǷ Ʒ ´.
+	const size_t row_size = (size_t)width * 4;
+	std::vector<uint8_t> raw((row_size + 1) * height);
+	for (int y = 0; y < height; ++y)
+	{
+		uint8_t* dst = &raw[(row_size + 1) * y];
+		dst[0] = 0;
+		memcpy(dst + 1, rgba + row_size * (height - 1 - y), row_size);
+	}
+
+	std::vector<uint8_t> zlib;
+	zlib.push_back(0x78);
+	zlib.push_back(0x01);
+	uint32_t adler_a = 1, adler_b = 0;
+	size_t offset = 0;
+	do
+	{
+		const size_t block_size = raw.size() - offset < 65535 ? raw.size() - offset : 65535;
+		const bool is_last = offset + block_size == raw.size();
+		zlib.push_back(is_last ? 1 : 0);
+		zlib.push_back((uint8_t)(block_size & 0xFF));
+		zlib.push_back((uint8_t)(block_size >> 8));
+		zlib.push_back((uint8_t)(~block_size & 0xFF));
+		zlib.push_back((uint8_t)((~block_size >> 8) & 0xFF));
+		for (size_t i = 0; i < block_size; ++i)
+		{
+			uint8_t value = raw[offset + i];
+			zlib.push_back(value);
+			adler_a = (adler_a + value) % 65521;
+			adler_b = (adler_b + adler_a) % 65521;
+		}
+		offset += block_size;
+	} while (offset < raw.size());
+	png_put_u32(zlib, (adler_b << 16) | adler_a);
+	png_write_chunk(fp, "IDAT", zlib);
+
+	png_write_chunk(fp, "IEND", std::vector<uint8_t>());
+	fclose(fp);
+	return true;
+}
+
+void headless_end_frame()
+{
+	if (!g_headless.is_enable)
+	{
+		return;
+	}
+
+	if (g_headless.dump_interval > 0 && g_headless.frame_index % g_headless.dump_interval == 0)
+	{
+		// dump ϴ frame GPU ٸ ǹǷ benchmark  ԽŰ ʴ  .
+		std::vector<uint8_t> pixels((size_t)g_headless.width * g_headless.height * 4);
+		glBindFramebuffer(GL_READ_FRAMEBUFFER, g_headless.fbo);
+		glPixelStorei(GL_PACK_ALIGNMENT, 1);
+		glReadPixels(0, 0, g_headless.width, g_headless.height, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+
+		char path[512];
+		snprintf(path, sizeof(path), "%s/frame_%05d.png",
+			g_headless.dump_folder[0] != '\0' ? g_headless.dump_folder : ".", g_headless.frame_index);
+		if (!headless_write_png(path, pixels.data(), g_headless.width, g_headless.height))
+		{
+			printf("Fail to write %s\n", path);
+		}
+	}
+
+	++g_headless.frame_index;
+}
+
+bool headless_should_close()
+{
+	return g_headless.frame_index >= g_headless.frame_count;
+}
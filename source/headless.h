@@ -0,0 +1,66 @@
+#ifndef __HEADLESS_H__
+#define __HEADLESS_H__
+
+#include "glad/glad.h"
+
+// display (  )  frame ŭ offscreen FBO ׸ ϴ .
+// ⺻δ  ʴ GLFW window context ,
+// HEADLESS_EGL ϸ GLFW  EGL surfaceless(pbuffer) context . (Mesa llvmpipe )
+//
+// command line : --headless [--size WxH] [--frames N] [--dump FOLDER] [--dump-every K]
+
+constexpr int HEADLESS_DEFAULT_WIDTH = 1280;
+constexpr int HEADLESS_DEFAULT_HEIGHT = 720;
+constexpr int HEADLESS_DEFAULT_FRAME_COUNT = 300;
+
+struct Headless
+{
+	bool is_enable;
+	int width;
+	int height;
+	int frame_count;
+	int frame_index;
+
+	// Է Ƿ  frame  ð     ϰ Ѵ.
+	float fixed_delta_time;
+
+	// dump_interval frame  dump_folder PNG Ѵ. (0 :   )
+	int dump_interval;
+	char dump_folder[256];
+
+	GLuint fbo;
+	GLuint rbo_color;
+	GLuint rbo_depth;
+
+	// EGL ü (HEADLESS_EGL  )
+	void* egl_display;
+	void* egl_surface;
+	void* egl_context;
+};
+extern Headless g_headless;
+
+void headless_set_defaults();
+void headless_print_usage();
+
+// argv[*index] headless ɼ̶ ( ִٸ ) а index ű  true ش.
+bool headless_parse_arg(int argc, char** argv, int* index);
+
+#if defined(HEADLESS_EGL)
+bool headless_egl_create_context();
+void headless_egl_destroy_context();
+void* headless_egl_get_proc_address(const char* name);
+#endif
+
+// GL context  ڿ ȣѴ.
+void headless_init();
+void headless_terminate();
+
+// frame ù GL   offscreen FBO bind Ѵ.
+void headless_begin_frame();
+
+// frame  ׸  ȣѴ. ʿϸ PNG Ѵ.
+void headless_end_frame();
+
+bool headless_should_close();
+
+#endif
@@ -0,0 +1,67 @@
+#include "idle.h"
+
+IdleRender g_idle;
+
+void idle_init(bool is_enable)
+{
+	// ImVec2 Ƿ memset  value-initialization 0 ä.
+	g_idle = IdleRender();
+	g_idle.is_enable = is_enable;
+	g_idle.wait_timeout = IDLE_DEFAULT_WAIT_TIMEOUT;
+	g_idle.dirty_frames = IDLE_SETTLE_FRAMES;
+}
+
+void idle_mark_dirty()
+{
+	g_idle.dirty_frames = IDLE_SETTLE_FRAMES;
+}
+
+bool idle_is_sleeping()
+{
+	return g_idle.is_enable && g_idle.dirty_frames == 0;
+}
+
+bool idle_begin_frame()
+{
+	ImGuiIO& io = ImGui::GetIO();
+
+	// 콺 ̸ hover  ٲ, ư  ִٸ drag camera ȸ   ִ.
+	bool is_input = io.MousePos.x != g_idle.last_mouse_pos.x || io.MousePos.y != g_idle.last_mouse_pos.y ||
+		io.MouseWheel != 0.f || io.MouseWheelH != 0.f || io.InputQueueCharacters.Size > 0 ||
+		ImGui::IsAnyItemActive() || io.WantTextInput;
+	for (int i = 0; i < IM_ARRAYSIZE(io.MouseDown); ++i)
+	{
+		is_input |= io.MouseDown[i];
+	}
+	g_idle.last_mouse_pos = io.MousePos;
+
+	if (is_input)
+	{
+		idle_mark_dirty();
+	}
+
+	if (!g_idle.is_enable)
+	{
+		++g_idle.rendered_count;
+		return true;
+	}
+
+	if (g_idle.dirty_frames == 0)
+	{
+		g_idle.was_skipped = true;
+		++g_idle.skipped_count;
+		return false;
+	}
+	--g_idle.dirty_frames;
+
+	//  ٰ  frame delta time  ִ ð ϹǷ,
+	// ״  camera     ũ δ.
+	if (g_idle.was_skipped)
+	{
+		io.DeltaTime = 1.f / 60.f;
+		g_idle.was_skipped = false;
+	}
+
+	++g_idle.rendered_count;
+	return true;
+}
@@ -0,0 +1,40 @@
+#ifndef __IDLE_H__
+#define __IDLE_H__
+
+#include "imgui/imgui.h"
+
+// On-demand rendering.
+// Էµ  scene ٲ ʾҴٸ frame ׸ ʰ glfwWaitEventsTimeout  CPU/GPU  Ѵ.
+// scene ٲٴ (camera ̵, window ũ , streaming Ϸ, animation ) idle_mark_dirty() ȣؾ Ѵ.
+// ImGui Է(콺 ̵/Ŭ, wheel,  Է, drag  item) idle_begin_frame  ȮѴ.
+
+// ٲ ڿ  frame  ׷,  frame   ͵(Hi-Z, UI hover )  Ѵ.
+constexpr int IDLE_SETTLE_FRAMES = 3;
+constexpr double IDLE_DEFAULT_WAIT_TIMEOUT = 1.0;
+
+struct IdleRender
+{
+	bool is_enable;
+
+	// event   ð()   ٽ ȮѴ.
+	double wait_timeout;
+
+	int dirty_frames;
+	bool was_skipped;
+	ImVec2 last_mouse_pos;
+
+	unsigned rendered_count;
+	unsigned skipped_count;
+};
+extern IdleRender g_idle;
+
+void idle_init(bool is_enable);
+void idle_mark_dirty();
+
+// true glfwPollEvents  glfwWaitEventsTimeout(g_idle.wait_timeout) ٸ.
+bool idle_is_sleeping();
+
+// imgui_prepare ڿ ȣѴ. false ̹ frame ׸ ʰ ѱ.
+bool idle_begin_frame();
+
+#endif
@@ -0,0 +1,648 @@
+#include "job_system.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <assert.h>
+#include <chrono>
+#include <vector>
+#include <algorithm>
+
+#include "imgui/imgui.h"
+
+JobSystem g_job_system;
+
+//  thread  deque index. main thread 0, worker 1.
+static thread_local int t_thread_index = -1;
+
+// ĥ deque    thread  xorshift 
+static thread_local uint32_t t_random_state = 0;
+
+//  frame job  heap Ҵ   thread pool ư .
+// job ٸ thread   Ƿ,  is_usedθ ȮѴ.
+static Job* job_alloc()
+{
+	JobDeque* deque = &(g_job_system.deques[t_thread_index]);
+	Job* job = &(deque->job_pool[deque->job_pool_next]);
+	if (job->is_used.load(std::memory_order_acquire))
+	{
+		// pool ũ⺸  job   ʾҴ.
+		return new Job;
+	}
+
+	deque->job_pool_next = (deque->job_pool_next + 1) % JOB_POOL_SIZE;
+	job->is_pooled = true;
+	job->is_used.store(true, std::memory_order_relaxed);
+	return job;
+}
+
+static void job_free(Job* job)
+{
+	// capture  ٷ Ѵ.
+	job->function = nullptr;
+	if (job->is_pooled)
+	{
+		job->is_used.store(false, std::memory_order_release);
+	}
+	else
+	{
+		delete job;
+	}
+}
+
+static uint32_t job_random()
+{
+	uint32_t x = t_random_state;
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	t_random_state = x;
+	return x;
+}
+
+//  thread ȣѴ.  áٸ false.
+static bool job_deque_push(JobDeque* deque, Job* job)
+{
+	const int64_t bottom = deque->bottom.load(std::memory_order_relaxed);
+	const int64_t top = deque->top.load(std::memory_order_acquire);
+	if (bottom - top >= JOB_DEQUE_CAPACITY)
+	{
+		return false;
+	}
+
+	//   thread bottom  job Ƿ job   д.
+	deque->buffer[bottom & (JOB_DEQUE_CAPACITY - 1)].store(job, std::memory_order_relaxed);
+	deque->bottom.store(bottom + 1, std::memory_order_release);
+	return true;
+}
+
+//  thread ȣѴ.   job .
+static Job* job_deque_pop(JobDeque* deque)
+{
+	const int64_t bottom = deque->bottom.load(std::memory_order_relaxed) - 1;
+	deque->bottom.store(bottom, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	int64_t top = deque->top.load(std::memory_order_relaxed);
+
+	if (top > bottom)
+	{
+		//  ִ.
+		deque->bottom.store(bottom + 1, std::memory_order_relaxed);
+		return nullptr;
+	}
+
+	Job* job = deque->buffer[bottom & (JOB_DEQUE_CAPACITY - 1)].load(std::memory_order_relaxed);
+	if (top == bottom)
+	{
+		//  ϳ   thread top ΰ Ѵ.
+		if (!deque->top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+		{
+			job = nullptr;
+		}
+		deque->bottom.store(bottom + 1, std::memory_order_relaxed);
+	}
+	return job;
+}
+
+// ٸ thread ȣѴ.    job .
+static Job* job_deque_steal(JobDeque* deque)
+{
+	int64_t top = deque->top.load(std::memory_order_acquire);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	const int64_t bottom = deque->bottom.load(std::memory_order_acquire);
+	if (top >= bottom)
+	{
+		return nullptr;
+	}
+
+	Job* job = deque->buffer[top & (JOB_DEQUE_CAPACITY - 1)].load(std::memory_order_relaxed);
+	if (!deque->top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+	{
+		return nullptr;
+	}
+	return job;
+}
+
+// ڽ deque  ,  ִٸ  deque ư ģ.
+static Job* job_find()
+{
+	const int deque_count = g_job_system.worker_count + 1;
+	Job* job = job_deque_pop(&(g_job_system.deques[t_thread_index]));
+	if (job == nullptr && deque_count > 1)
+	{
+		const int start = (int)(job_random() % (uint32_t)deque_count);
+		for (int i = 0; i < deque_count && job == nullptr; ++i)
+		{
+			const int index = (start + i) % deque_count;
+			if (index != t_thread_index)
+			{
+				job = job_deque_steal(&(g_job_system.deques[index]));
+			}
+		}
+
+		if (job != nullptr)
+		{
+			g_job_system.stolen_count.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+
+	if (job != nullptr)
+	{
+		g_job_system.queued_count.fetch_sub(1, std::memory_order_relaxed);
+	}
+	return job;
+}
+
+static void job_execute(Job* job);
+
+//  thread deque ְ  worker .  áٸ ٷ Ѵ.
+static void job_submit(Job* job)
+{
+	//   thread   ʵ ֱ  ø.
+	const int last_queued_count = g_job_system.queued_count.fetch_add(1, std::memory_order_acq_rel);
+	if (!job_deque_push(&(g_job_system.deques[t_thread_index]), job))
+	{
+		g_job_system.queued_count.fetch_sub(1, std::memory_order_relaxed);
+		g_job_system.inline_count.fetch_add(1, std::memory_order_relaxed);
+		job_execute(job);
+		return;
+	}
+
+	// worker lock ȿ queued_count  Ƿ, 0 ÷ȴٸ lock   Ƽ   worker ߳ ʰ Ѵ.
+	if (last_queued_count == 0)
+	{
+		std::lock_guard<std::mutex> lock(g_job_system.wake_mutex);
+	}
+	g_job_system.wake_cv.notify_one();
+}
+
+static void job_execute(Job* job)
+{
+	job->function();
+	g_job_system.executed_count.fetch_add(1, std::memory_order_relaxed);
+
+	JobCounter* counter = job->counter;
+	job_free(job);
+	if (counter == nullptr)
+	{
+		return;
+	}
+
+	// 0 Ǿٸ Ŵ޷ ִ job ִ´. job_wait  lock Ǯ ڿ ưǷ  ڷ counter ǵ帮 ʴ´.
+	Job* waiting = nullptr;
+	{
+		std::lock_guard<std::mutex> lock(counter->waiting_mutex);
+		if (counter->count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+		{
+			waiting = counter->waiting_head;
+			counter->waiting_head = nullptr;
+		}
+	}
+
+	while (waiting != nullptr)
+	{
+		Job* next = waiting->next_waiting;
+		job_submit(waiting);
+		waiting = next;
+	}
+}
+
+static void job_worker_main(int thread_index)
+{
+	t_thread_index = thread_index;
+	t_random_state = 0x9E3779B9u * (uint32_t)(thread_index + 1);
+
+	int spin = 0;
+	while (!g_job_system.is_quit.load(std::memory_order_acquire))
+	{
+		if (Job* job = job_find())
+		{
+			job_execute(job);
+			spin = 0;
+			continue;
+		}
+
+		if (++spin < JOB_SPIN_COUNT)
+		{
+			std::this_thread::yield();
+			continue;
+		}
+
+		//   queued_count  ø notify ϹǷ, Ȯΰ   lock ȿ ϸ   ġ ʴ´.
+		std::unique_lock<std::mutex> lock(g_job_system.wake_mutex);
+		g_job_system.wake_cv.wait(lock, []()
+		{
+			return g_job_system.is_quit.load(std::memory_order_acquire) ||
+				g_job_system.queued_count.load(std::memory_order_acquire) > 0;
+		});
+		spin = 0;
+	}
+}
+
+void job_system_print_usage()
+{
+	printf("  --jobs N                    worker thread count (default cores - 1)\n");
+	printf("  --job-stress ITERATIONS     run the job system stress test without a window and exit\n");
+	printf("  --job-scaling               run the job system scaling benchmark without a window and exit\n");
+}
+
+void job_system_set_defaults()
+{
+	g_job_system.requested_worker_count = -1;
+	g_job_system.test_mode = JOB_TEST_NONE;
+	g_job_system.stress_iterations = 0;
+}
+
+bool job_system_parse_arg(int argc, char** argv, int* index)
+{
+	const char* arg = argv[*index];
+	if (strcmp(arg, "--job-scaling") == 0)
+	{
+		g_job_system.test_mode = JOB_TEST_SCALING;
+		return true;
+	}
+
+	if (*index + 1 >= argc)
+	{
+		return false;
+	}
+
+	const char* value = argv[*index + 1];
+	if (strcmp(arg, "--jobs") == 0)
+	{
+		int worker_count = atoi(value);
+		if (worker_count < 0 || worker_count > JOB_MAX_WORKER_COUNT)
+		{
+			return false;
+		}
+		g_job_system.requested_worker_count = worker_count;
+	}
+	else if (strcmp(arg, "--job-stress") == 0)
+	{
+		int iterations = atoi(value);
+		if (iterations <= 0)
+		{
+			return false;
+		}
+		g_job_system.test_mode = JOB_TEST_STRESS;
+		g_job_system.stress_iterations = iterations;
+	}
+	else
+	{
+		return false;
+	}
+
+	++(*index);
+	return true;
+}
+
+void job_system_init(int worker_count)
+{
+	assert(!g_job_system.is_init);
+
+	if (worker_count < 0)
+	{
+		// GL thread(main) job ϹǷ   .
+		const int core_count = (int)std::thread::hardware_concurrency();
+		worker_count = core_count > 1 ? core_count - 1 : 0;
+	}
+	if (worker_count > JOB_MAX_WORKER_COUNT)
+	{
+		worker_count = JOB_MAX_WORKER_COUNT;
+	}
+
+	g_job_system.worker_count = worker_count;
+	g_job_system.deques = new JobDeque[worker_count + 1];
+	for (int i = 0; i < worker_count + 1; ++i)
+	{
+		g_job_system.deques[i].top.store(0, std::memory_order_relaxed);
+		g_job_system.deques[i].bottom.store(0, std::memory_order_relaxed);
+		g_job_system.deques[i].job_pool = new Job[JOB_POOL_SIZE];
+		g_job_system.deques[i].job_pool_next = 0;
+	}
+
+	g_job_system.is_quit.store(false);
+	g_job_system.queued_count.store(0);
+	g_job_system.executed_count.store(0);
+	g_job_system.stolen_count.store(0);
+	g_job_system.inline_count.store(0);
+
+	t_thread_index = 0;
+	t_random_state = 0x9E3779B9u;
+
+	for (int i = 0; i < worker_count; ++i)
+	{
+		g_job_system.workers[i] = std::thread(job_worker_main, i + 1);
+	}
+
+	g_job_system.is_init = true;
+}
+
+void job_system_terminate()
+{
+	assert(g_job_system.is_init);
+
+	//  job main thread  Ѵ.
+	while (Job* job = job_find())
+	{
+		job_execute(job);
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(g_job_system.wake_mutex);
+		g_job_system.is_quit.store(true, std::memory_order_release);
+	}
+	g_job_system.wake_cv.notify_all();
+
+	for (int i = 0; i < g_job_system.worker_count; ++i)
+	{
+		g_job_system.workers[i].join();
+	}
+
+	for (int i = 0; i < g_job_system.worker_count + 1; ++i)
+	{
+		delete[] g_job_system.deques[i].job_pool;
+	}
+	delete[] g_job_system.deques;
+	g_job_system.deques = nullptr;
+	g_job_system.worker_count = 0;
+	g_job_system.is_init = false;
+	t_thread_index = -1;
+}
+
+void job_run(std::function<void()> function, JobCounter* counter, JobCounter* dependency)
+{
+	assert(g_job_system.is_init);
+	assert(t_thread_index >= 0);
+
+	Job* job = job_alloc();
+	job->function = std::move(function);
+	job->counter = counter;
+	job->next_waiting = nullptr;
+
+	if (counter != nullptr)
+	{
+		counter->count.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	if (dependency != nullptr)
+	{
+		std::lock_guard<std::mutex> lock(dependency->waiting_mutex);
+		if (dependency->count.load(std::memory_order_acquire) > 0)
+		{
+			job->next_waiting = dependency->waiting_head;
+			dependency->waiting_head = job;
+			return;
+		}
+	}
+
+	job_submit(job);
+}
+
+void job_wait(JobCounter* counter)
+{
+	assert(t_thread_index >= 0);
+
+	while (counter->count.load(std::memory_order_acquire) > 0)
+	{
+		if (Job* job = job_find())
+		{
+			job_execute(job);
+		}
+		else
+		{
+			std::this_thread::yield();
+		}
+	}
+
+	//  job  thread  lock    ִ. ư  counter  ǵ Ǯ  ٸ.
+	std::lock_guard<std::mutex> lock(counter->waiting_mutex);
+}
+
+int job_thread_index()
+{
+	return t_thread_index;
+}
+
+void parallel_for_range_run(int count, int batch_size, const std::function<void(int begin, int end)>& function)
+{
+	if (count <= 0)
+	{
+		return;
+	}
+
+	if (batch_size <= 0)
+	{
+		//    ֵ thread  4  .
+		const int batch_count = (g_job_system.worker_count + 1) * 4;
+		batch_size = (count + batch_count - 1) / batch_count;
+	}
+
+	if (batch_size >= count || g_job_system.worker_count == 0)
+	{
+		function(0, count);
+		return;
+	}
+
+	JobCounter counter;
+	for (int begin = batch_size; begin < count; begin += batch_size)
+	{
+		const int end = begin + batch_size < count ? begin + batch_size : count;
+		job_run([&function, begin, end]() { function(begin, end); }, &counter);
+	}
+
+	// ù batch  ʰ ٷ Ѵ.
+	function(0, batch_size);
+	job_wait(&counter);
+}
+
+
+// job ȿ ٽ job  worker deque   Ѵ.
+static void job_stress_spawn(std::atomic<int>* sum, JobCounter* counter, int depth)
+{
+	sum->fetch_add(1, std::memory_order_relaxed);
+	if (depth == 0)
+	{
+		return;
+	}
+
+	for (int i = 0; i < 4; ++i)
+	{
+		job_run([sum, counter, depth]() { job_stress_spawn(sum, counter, depth - 1); }, counter);
+	}
+}
+
+static bool job_system_run_stress()
+{
+	constexpr int SMALL_JOB_COUNT = 10000;
+	constexpr int SPAWN_DEPTH = 5;				// 1 + 4 + 16 + ... + 4^5 = 1365
+	constexpr int SPAWN_TOTAL = 1365;
+	constexpr int CHAIN_STAGE_COUNT = 8;
+	constexpr int CHAIN_STAGE_WIDTH = 64;
+	constexpr int PARALLEL_FOR_COUNT = 100000;
+
+	job_system_init(g_job_system.requested_worker_count);
+	printf("Job stress : %d workers, %d iterations\n", g_job_system.worker_count, g_job_system.stress_iterations);
+
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	std::vector<int> visit(PARALLEL_FOR_COUNT);
+	bool is_success = true;
+	for (int iteration = 0; iteration < g_job_system.stress_iterations && is_success; ++iteration)
+	{
+		// 1.  job   (deque   inline ȴ)
+		{
+			std::atomic<int> sum(0);
+			JobCounter counter;
+			for (int i = 0; i < SMALL_JOB_COUNT; ++i)
+			{
+				job_run([&sum, i]() { sum.fetch_add(i, std::memory_order_relaxed); }, &counter);
+			}
+			job_wait(&counter);
+
+			const int expected = SMALL_JOB_COUNT * (SMALL_JOB_COUNT - 1) / 2;
+			if (sum.load() != expected)
+			{
+				printf("  [%d] small jobs : sum %d, expected %d\n", iteration, sum.load(), expected);
+				is_success = false;
+			}
+		}
+
+		// 2. job  job
+		{
+			std::atomic<int> sum(0);
+			JobCounter counter;
+			job_run([&sum, &counter]() { job_stress_spawn(&sum, &counter, SPAWN_DEPTH); }, &counter);
+			job_wait(&counter);
+			if (sum.load() != SPAWN_TOTAL)
+			{
+				printf("  [%d] nested jobs : %d, expected %d\n", iteration, sum.load(), SPAWN_TOTAL);
+				is_success = false;
+			}
+		}
+
+		// 3. dependency.  stage  stage   ڿ Ǿ Ѵ.
+		{
+			std::atomic<int> finished(0);
+			std::atomic<int> order_error(0);
+			JobCounter stages[CHAIN_STAGE_COUNT];
+			for (int stage = 0; stage < CHAIN_STAGE_COUNT; ++stage)
+			{
+				JobCounter* dependency = stage > 0 ? &(stages[stage - 1]) : nullptr;
+				for (int i = 0; i < CHAIN_STAGE_WIDTH; ++i)
+				{
+					job_run([&finished, &order_error, stage]()
+					{
+						if (finished.load(std::memory_order_acquire) < stage * CHAIN_STAGE_WIDTH)
+						{
+							order_error.fetch_add(1, std::memory_order_relaxed);
+						}
+						finished.fetch_add(1, std::memory_order_acq_rel);
+					}, &(stages[stage]), dependency);
+				}
+			}
+			for (int stage = 0; stage < CHAIN_STAGE_COUNT; ++stage)
+			{
+				job_wait(&(stages[stage]));
+			}
+
+			if (order_error.load() != 0 || finished.load() != CHAIN_STAGE_COUNT * CHAIN_STAGE_WIDTH)
+			{
+				printf("  [%d] dependency : %d out of order, %d finished\n", iteration, order_error.load(), finished.load());
+				is_success = false;
+			}
+		}
+
+		// 4. parallel_for  index Ȯ   ؾ Ѵ.
+		{
+			std::fill(visit.begin(), visit.end(), 0);
+			const int batch_size = 1 + iteration % 97;
+			parallel_for(PARALLEL_FOR_COUNT, batch_size, [&visit](int index) { ++visit[index]; });
+			for (int i = 0; i < PARALLEL_FOR_COUNT; ++i)
+			{
+				if (visit[i] != 1)
+				{
+					printf("  [%d] parallel_for : index %d visited %d times\n", iteration, i, visit[i]);
+					is_success = false;
+					break;
+				}
+			}
+		}
+	}
+
+	const float elapsed_ms = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+	printf("Job stress %s : %.1f ms, executed %u, stolen %u, inline %u\n", is_success ? "passed" : "FAILED",
+		elapsed_ms, g_job_system.executed_count.load(), g_job_system.stolen_count.load(), g_job_system.inline_count.load());
+
+	job_system_terminate();
+	return is_success;
+}
+
+static bool job_system_run_scaling()
+{
+	constexpr int WORK_COUNT = 1 << 16;
+	constexpr int WORK_INNER_COUNT = 256;
+	constexpr int REPEAT_COUNT = 5;
+
+	int max_worker_count = g_job_system.requested_worker_count;
+	if (max_worker_count < 0)
+	{
+		const int core_count = (int)std::thread::hardware_concurrency();
+		max_worker_count = core_count > 1 ? core_count - 1 : 0;
+	}
+
+	printf("Job scaling : %u hardware threads, parallel_for of %d items\n", std::thread::hardware_concurrency(), WORK_COUNT);
+	printf("  threads      ms   speedup\n");
+
+	std::vector<float> result(WORK_COUNT);
+	float base_ms = 0.f;
+	for (int worker_count = 0; worker_count <= max_worker_count; ++worker_count)
+	{
+		job_system_init(worker_count);
+
+		//    .
+		float best_ms = 0.f;
+		for (int repeat = 0; repeat < REPEAT_COUNT; ++repeat)
+		{
+			const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			parallel_for(WORK_COUNT, 0, [&result](int index)
+			{
+				float value = (float)index;
+				for (int i = 0; i < WORK_INNER_COUNT; ++i)
+				{
+					value = sinf(value) * 0.5f + cosf(value * 0.25f);
+				}
+				result[index] = value;
+			});
+			const float ms = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+			best_ms = repeat == 0 || ms < best_ms ? ms : best_ms;
+		}
+
+		if (worker_count == 0)
+		{
+			base_ms = best_ms;
+		}
+		printf("  %7d %7.2f %8.2fx\n", worker_count + 1, best_ms, best_ms > 0.f ? base_ms / best_ms : 0.f);
+
+		job_system_terminate();
+	}
+
+	return true;
+}
+
+bool job_system_run_test()
+{
+	switch (g_job_system.test_mode)
+	{
+	case JOB_TEST_STRESS:	return job_system_run_stress();
+	case JOB_TEST_SCALING:	return job_system_run_scaling();
+	}
+	return true;
+}
+
+void job_system_draw_gui()
+{
+	ImGui::Text("Job Workers %d (+ main)", g_job_system.worker_count);
+	ImGui::Text("Jobs Executed %u / Stolen %u / Inline %u", g_job_system.executed_count.load(),
+		g_job_system.stolen_count.load(), g_job_system.inline_count.load());
+}
@@ -0,0 +1,157 @@
+#ifndef __JOB_SYSTEM_H__
+#define __JOB_SYSTEM_H__
+
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <stdint.h>
+
+// Work stealing job system.
+// worker thread (core  - 1) ϰ, main(GL) thread  thread  deque ϳ .
+// ڽ deque (bottom) ְ ,    thread ٸ deque (top)  ´. (Chase-Lev)
+//  JobCounter   ְ, job_wait ٸ  ٸ job  Ѵ.
+// GL ȣ main thread ؾ ϹǷ job ȿ CPU ۾ Ѵ.
+//  :
+//   JobCounter counter;
+//   job_run([]() { ... }, &counter);
+//   parallel_for(count, 0, [&](int index) { ... });		//   ٸ.
+//   job_wait(&counter);
+//
+// command line : [--jobs N] [--job-stress ITERATIONS] [--job-scaling]
+
+// 2 ŵ.   ִ thread  ڸ ٷ Ѵ.
+constexpr int JOB_DEQUE_CAPACITY = 4096;
+constexpr int JOB_MAX_WORKER_COUNT = 63;
+
+// thread  ̸  ΰ ư  job .  ڸ   ̶ heap ҴѴ.
+constexpr int JOB_POOL_SIZE = 4096;
+
+//   ã     ٽ ãƺ Ƚ
+constexpr int JOB_SPIN_COUNT = 64;
+
+enum JobTestMode
+{
+	JOB_TEST_NONE = 0,
+	JOB_TEST_STRESS,
+	JOB_TEST_SCALING
+};
+
+struct Job
+{
+	std::function<void()> function;
+	struct JobCounter* counter;
+
+	// dependency ⸦ ٸ job list
+	Job* next_waiting;
+
+	// pool job̶    ٸ thread is_used  ش.
+	bool is_pooled;
+	std::atomic<bool> is_used;
+
+	Job() : counter(nullptr), next_waiting(nullptr), is_pooled(false), is_used(false) {}
+};
+
+struct JobCounter
+{
+	std::atomic<int> count;
+
+	//  counter 0 Ǹ deque  job. 0 Ǵ Ͱ list ִ  ߳ ʵ lock ȿ Ѵ.
+	std::mutex waiting_mutex;
+	Job* waiting_head;
+
+	JobCounter() : count(0), waiting_head(nullptr) {}
+};
+
+struct JobDeque
+{
+	// top   , bottom  thread ְ  .  ٸ cache line д.
+	alignas(64) std::atomic<int64_t> top;
+	alignas(64) std::atomic<int64_t> bottom;
+	alignas(64) std::atomic<Job*> buffer[JOB_DEQUE_CAPACITY];
+
+	//  thread  job pool
+	Job* job_pool;
+	int job_pool_next;
+};
+
+struct JobSystem
+{
+	bool is_init;
+
+	// option. -1̶ core  - 1
+	int requested_worker_count;
+	int test_mode;
+	int stress_iterations;
+
+	int worker_count;
+	std::thread workers[JOB_MAX_WORKER_COUNT];
+
+	// [0] main thread, [1 ~ worker_count] worker
+	JobDeque* deques;
+
+	std::atomic<bool> is_quit;
+
+	//    ƹ   job . 0̶ worker .
+	std::atomic<int> queued_count;
+	std::mutex wake_mutex;
+	std::condition_variable wake_cv;
+
+	//  (GUI)
+	std::atomic<unsigned> executed_count;
+	std::atomic<unsigned> stolen_count;
+	std::atomic<unsigned> inline_count;
+};
+extern JobSystem g_job_system;
+
+void job_system_set_defaults();
+void job_system_print_usage();
+
+// argv[*index] job system ɼ̶  а index ű  true ش.
+bool job_system_parse_arg(int argc, char** argv, int* index);
+
+// main thread ȣѴ. worker_count  core  - 1 ŭ .
+void job_system_init(int worker_count);
+void job_system_terminate();
+
+// counter ִٸ job   1 δ.
+// job thread  pool Ƿ, capture std::function ȿ  ũ(pointer 2) heap Ҵ .
+// dependency ִٸ  counter 0   deque  ʰ counter Ŵ޾ д.
+void job_run(std::function<void()> function, JobCounter* counter, JobCounter* dependency = nullptr);
+
+// counter 0   ٸ job ϸ鼭 ٸ. job ȿ ҷ ȴ.
+void job_wait(JobCounter* counter);
+
+// [0, count) batch_size   job ϰ    ٸ.
+// batch_size 0̶ thread   .
+void parallel_for_range_run(int count, int batch_size, const std::function<void(int begin, int end)>& function);
+
+// function referenceθ μ ѱǷ capture  lambda std::function heap  ʴ´.
+template <typename Function>
+void parallel_for_range(int count, int batch_size, const Function& function)
+{
+	parallel_for_range_run(count, batch_size, [&function](int begin, int end) { function(begin, end); });
+}
+
+template <typename Function>
+void parallel_for(int count, int batch_size, const Function& function)
+{
+	parallel_for_range_run(count, batch_size, [&function](int begin, int end)
+	{
+		for (int i = begin; i < end; ++i)
+		{
+			function(i);
+		}
+	});
+}
+
+// ȣ thread deque index. main thread 0, worker 1 ~ worker_count,  ܴ -1.
+int job_thread_index();
+
+// --job-stress / --job-scaling  ־ٸ â  ϰ  θ ش.
+bool job_system_run_test();
+
+void job_system_draw_gui();
+
+#endif
@@ -1,6 +1,9 @@
 #include <stdio.h>
+#include <limits.h>
 #include <unordered_map>
 #include <string>
+#include <algorithm>
+#include <chrono>
 
 #include "glad/glad.h"
 #include "GLFW/glfw3.h"
@@ -13,10 +16,36 @@
 #include "assimp/scene.h"
 #include "assimp/postprocess.h"
 #include "assimp/DefaultLogger.hpp"
+#include "assimp/pbrmaterial.h"
 
+#include "memory_tracker.h"
+#include "animation.h"
+#include "animation_graph.h"
+#include "physics.h"
+
+// stb_image decode   memory tag ٿ .
+#define STBI_MALLOC(size) memory_tracker_malloc(size, MEMORY_TAG_STB_IMAGE)
+#define STBI_REALLOC(ptr, size) memory_tracker_realloc(ptr, size, MEMORY_TAG_STB_IMAGE)
+#define STBI_FREE(ptr) memory_tracker_free(ptr)
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb/stb_image.h"
 #include "utility.h"
+#include "gl_extension.h"
+#include "gpu_culling.h"
+#include "shader_permutation.h"
+#include "program_cache.h"
+#include "frame_sync.h"
+#include "gpu_profiler.h"
+#include "headless.h"
+#include "benchmark.h"
+#include "gl_state.h"
+#include "ui_cache.h"
+#include "idle.h"
+#include "frame_pacing.h"
+#include "dynamic_resolution.h"
+#include "transform.h"
+#include "job_system.h"
+#include "frame_allocator.h"
 
 #if defined(_WIN32) || defined(_WIN64) || defined(_DEBUG)
 #define _CRTDBG_MAP_ALLOC
@@ -31,20 +60,66 @@ int g_window_width = INITIAL_WINDOW_WIDTH;
 int g_window_height = INITIAL_WINDOW_HEIGHT;
 double g_time = 0.0;
 
+// ̹ frame  draw call ﰢ . (benchmark ϰ Information â .)
+struct RenderStats
+{
+	unsigned draw_calls;
+	unsigned long long triangles;
+}g_render_stats;
+
+// model_draw  Է ٽ о view matrix ٽ . (--late-latch)
+bool g_is_late_latch_camera = false;
+
+// mesh  ͸ CPU/GPU   .  ҷ   mesh Ѵ. (--mesh-residency)
+enum MeshResidency
+{
+	MESH_RESIDENCY_GPU_ONLY = 0,	// GL buffer ø  CPU 迭 Ѵ.
+	MESH_RESIDENCY_CPU_GPU,			// picking/physicsó CPU  о  
+	MESH_RESIDENCY_CPU_ONLY,		// GL buffer  Ƿ ׷ ʴ´.
+	MESH_RESIDENCY_COUNT
+};
+const char* const MESH_RESIDENCY_NAMES[MESH_RESIDENCY_COUNT] = { "gpu", "cpu_gpu", "cpu" };
+MeshResidency g_mesh_residency = MESH_RESIDENCY_GPU_ONLY;
+
+bool parse_command_line(int argc, char** argv);
+
 void do_your_gui_code();
+void ui_watch_values();
 
 void camera_reset();
+void camera_init();
+void camera_terminate();
+void camera_rotate(float mouse_delta_x, float mouse_delta_y);
+void camera_update_view_matrix();
+void camera_update_projection();
 void camera_update();
-
+void camera_upload();
+void camera_late_latch();
+glm::vec3 camera_get_position();
+
+unsigned material_shader_features(const struct Material* mat);
+void mesh_upload(struct Mesh* mesh);
+void mesh_release_cpu_data(struct Mesh* mesh);
+void mesh_release_gpu_data(struct Mesh* mesh);
 void process_scene_mesh(const aiScene* scene);
+void process_scene_skeleton(const aiScene* scene, std::vector<int>* mesh_node_indices);
+void process_scene_animation(const aiScene* scene);
+void process_scene_skin(const aiScene* scene, const std::vector<int>& mesh_node_indices);
 void process_scene_material(const aiScene* scene, const char* base_folder);
+std::vector<GPUCullingMesh> model_culling_meshes();
 void model_init();
 void model_terminate();
+void model_update_instances(const Transform* model_transform);
+struct ModelProgram* model_get_program(unsigned feature_mask);
+void model_upload_bone_palettes();
+void model_skin_meshes();
 void model_draw();
 
 void imgui_init();
 void imgui_terminate();
 void imgui_prepare();
+void imgui_create_ring(int vtx_capacity, int idx_capacity);
+void imgui_destroy_ring();
 void imgui_draw();
 
 void imgui_glfw_scroll_callback(GLFWwindow* window, double xoffset, double yoffset);
@@ -56,8 +131,9 @@ void imgui_glfw_clipboard_set(void* user_data, const char* text);
 void glfw_init();
 void glfw_terminate();
 void framebuffer_size_callback(GLFWwindow* window, int width, int height);
+void window_refresh_callback(GLFWwindow* window);
 
-int main(void)
+int main(int argc, char** argv)
 {
 #if defined(_WIN32) || defined(_WIN64) || defined(_DEBUG)
 	// https://docs.microsoft.com/en-us/visualstudio/debugger/finding-memory-leaks-using-the-crt-library?view=vs-2019
@@ -71,19 +147,98 @@ int main(void)
 	_CrtSetDbgFlag(_CRTDBG_ALLOC_MEM_DF | _CRTDBG_LEAK_CHECK_DF);
 #endif
 
+	if (!parse_command_line(argc, argv))
+	{
+		return 1;
+	}
+
+	// job system ܵ stress test / scaling benchmark. â̳ GL context  ϰ .
+	if (g_job_system.test_mode != JOB_TEST_NONE)
+	{
+		return job_system_run_test() ? 0 : 1;
+	}
+	if (g_animation.test_mode != ANIMATION_TEST_NONE)
+	{
+		return animation_run_test() ? 0 : 1;
+	}
+	if (g_physics.test_mode != PHYSICS_TEST_NONE)
+	{
+		return physics_run_test() ? 0 : 1;
+	}
+
+	if (g_benchmark.is_enable)
+	{
+		if (!benchmark_init())
+		{
+			return 1;
+		}
+
+		// headless ΰ  frame ׸.
+		if (g_headless.is_enable)
+		{
+			g_headless.frame_count = g_benchmark.total_frame_count;
+		}
+	}
+
+	job_system_init(g_job_system.requested_worker_count);
+	frame_allocator_init();
+	memory_tracker_init();
 	glfw_init();
+	frame_pacing_init(g_window != NULL && !g_headless.is_enable);
+	frame_sync_init(DEFAULT_FRAMES_IN_FLIGHT);
+	gpu_profiler_init();
 	imgui_init();
+	ui_cache_init();
+	dynamic_resolution_init();
+	transform_system_init();
 	model_init();
 
+	camera_init();
 	camera_reset();
 
-	while (!glfwWindowShouldClose(g_window))
+	// ȭ     ִ windowed mode . headless/benchmark  frame ׷ Ѵ.
+	idle_init(!g_headless.is_enable && !g_benchmark.is_enable);
+
+	while (g_headless.is_enable ? !headless_should_close() : !glfwWindowShouldClose(g_window))
 	{
-		glfwPollEvents();
+		if (g_benchmark.is_enable && benchmark_is_finished())
+		{
+			break;
+		}
+
+		if (g_window != NULL)
+		{
+			// ٲ  ٸ event   .
+			if (idle_is_sleeping())
+			{
+				glfwWaitEventsTimeout(g_idle.wait_timeout);
+			}
+			else
+			{
+				glfwPollEvents();
+			}
+		}
 
 		// ImGui Data غ
+		// Է    ״ζ UI ٽ  ʰ  overlay .
+		imgui_prepare();			// ImGui ο   display,time,interaction  
+		if (!idle_begin_frame())
+		{
+			continue;
+		}
+
+		// ǳʶ frame  ʴ´. (arena ѱ  ׸ frame ӽ Ͱ  .)
+		if (g_benchmark.is_enable)
+		{
+			benchmark_begin_frame();
+		}
+
+		//   buffer  frame ӽ ͸ ° ǵ.
+		frame_allocator_begin_frame();
+
+		ui_watch_values();
+		if (ui_cache_begin_frame())
 		{
-			imgui_prepare();		// ImGui ο   display,time,interaction  
 			ImGui::NewFrame();		// ο   ImGui  
 			{
 				do_your_gui_code(); // ImGui ڵ ۼ
@@ -93,21 +248,179 @@ int main(void)
 
 		camera_update();
 
+		// GUI  Է ٲ transform鸸 world matrix ٽ .
+		transform_system_update();
+
+		//  ̶ pose  ٲǷ idle  ʰ Ѵ.
+		if (animation_update(ImGui::GetIO().DeltaTime, camera_get_position()))
+		{
+			idle_mark_dirty();
+		}
+
+		// physics frame ð   step ϰ, ׸    step ̸ Ѵ.
+		if (physics_update(ImGui::GetIO().DeltaTime))
+		{
+			idle_mark_dirty();
+		}
+
+		//  GPU   frame غϴ CPU ۾̴.
+		// GL  ֱ , ̹ frame ڿ set  frame GPU ۾  ȮѴ.
+		frame_sync_begin();
+		memset(&g_render_stats, 0, sizeof(RenderStats));
+		camera_upload();
+
+		// pass  CPU/GPU ð .   frame ڿ profiler â Ÿ.
+		gpu_profiler_begin_frame();
+		gpu_profiler_begin("Frame");
+		headless_begin_frame();
+		const GLuint frame_fbo = g_headless.is_enable ? g_headless.fbo : 0;
+
+		// scene GPU ð  dynamic resolution  ũ ׸. ( ִٸ frame_fbo ٷ ׸.)
+		dynamic_resolution_begin_scene(g_window_width, g_window_height);
+
 		// ImGui Data 
+		gpu_profiler_begin("Clear");
 		glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
 		glClearDepth(1.0f);
 		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+		gpu_profiler_end();
+
+		// UI   CPU ۾   콺 Է GPU ۾ ֱ  ݿѴ.
+		camera_late_latch();
+
+		gpu_profiler_begin("Model");
 		model_draw();
-		imgui_draw();					// ImGUi  ͸ GPU ÷ óѴ.
+		gpu_profiler_end();
+
+		//  ػ󵵷 ׸ scene ÷ ű. UI  ػ󵵷 ׸.
+		if (g_dynamic_resolution.is_offscreen)
+		{
+			gpu_profiler_begin("Upscale");
+			dynamic_resolution_end_scene(frame_fbo);
+			gpu_profiler_end();
+		}
+
+		gpu_profiler_begin("ImGui");
+		// ImGUi  ͸ GPU ÷ óѴ. (retained mode overlay ռѴ.)
+		ui_cache_draw(imgui_draw, frame_fbo);
+		gpu_profiler_end();
 
-		glfwSwapBuffers(g_window);
+		headless_end_frame();
+		gpu_profiler_end();
+		gpu_profiler_end_frame();
+
+		frame_sync_end();
+		if (g_benchmark.is_enable)
+		{
+			benchmark_end_frame(g_render_stats.draw_calls, g_render_stats.triangles);
+		}
+
+		// fps limit ִٸ ǥ ð ٸ  present Ѵ.
+		frame_pacing_wait();
+		if (!g_headless.is_enable)
+		{
+			glfwSwapBuffers(g_window);
+		}
+		frame_pacing_end_frame();
+		if (g_benchmark.is_enable)
+		{
+			benchmark_present();
+		}
+
+		frame_allocator_end_frame();
+		memory_tracker_update();
 	}
 
+	int exit_code = 0;
+	if (g_benchmark.is_enable)
+	{
+		exit_code = benchmark_finish();
+	}
+	if (!frame_allocator_check_result() && exit_code == 0)
+	{
+		exit_code = 1;
+	}
+
+	// GL object    뷮 Ѵ.
+	memory_tracker_terminate();
+	frame_sync_terminate();
+	gpu_profiler_terminate();
+	camera_terminate();
 	model_terminate();
+	transform_system_terminate();
+	dynamic_resolution_terminate();
+	ui_cache_terminate();
 	imgui_terminate();
 	glfw_terminate();
+	frame_pacing_terminate();
+	frame_allocator_terminate();
+	physics_terminate();
+	job_system_terminate();
+
+	return exit_code;
+}
+
+bool parse_command_line(int argc, char** argv)
+{
+	headless_set_defaults();
+	benchmark_set_defaults();
+	frame_pacing_set_defaults();
+	dynamic_resolution_set_defaults();
+	job_system_set_defaults();
+	frame_allocator_set_defaults();
+	memory_tracker_set_defaults();
+	animation_set_defaults();
+	physics_set_defaults();
+
+	for (int i = 1; i < argc; ++i)
+	{
+		if (headless_parse_arg(argc, argv, &i) || benchmark_parse_arg(argc, argv, &i) ||
+			frame_pacing_parse_arg(argc, argv, &i) || dynamic_resolution_parse_arg(argc, argv, &i) ||
+			job_system_parse_arg(argc, argv, &i) || frame_allocator_parse_arg(argc, argv, &i) ||
+			memory_tracker_parse_arg(argc, argv, &i) || animation_parse_arg(argc, argv, &i) ||
+			physics_parse_arg(argc, argv, &i))
+		{
+			continue;
+		}
+
+		if (strcmp(argv[i], "--late-latch") == 0)
+		{
+			g_is_late_latch_camera = true;
+			continue;
+		}
+
+		if (strcmp(argv[i], "--mesh-residency") == 0 && i + 1 < argc)
+		{
+			int residency = 0;
+			while (residency < MESH_RESIDENCY_COUNT && strcmp(argv[i + 1], MESH_RESIDENCY_NAMES[residency]) != 0)
+			{
+				++residency;
+			}
+			if (residency < MESH_RESIDENCY_COUNT)
+			{
+				g_mesh_residency = (MeshResidency)residency;
+				++i;
+				continue;
+			}
+		}
+
+		printf("Unknown option : %s\n", argv[i]);
+		printf("Usage : %s [options]\n", argv[0]);
+		headless_print_usage();
+		benchmark_print_usage();
+		frame_pacing_print_usage();
+		dynamic_resolution_print_usage();
+		job_system_print_usage();
+		frame_allocator_print_usage();
+		memory_tracker_print_usage();
+		animation_print_usage();
+		physics_print_usage();
+		printf("  --late-latch                re-read the mouse right before the scene is drawn\n");
+		printf("  --mesh-residency MODE       where mesh vertex data lives after loading : gpu (default), cpu_gpu, cpu\n");
+		return false;
+	}
 
-	return 0;
+	return true;
 }
 
 struct Camera
@@ -129,8 +442,59 @@ struct Camera
 	float near_plane;
 	float far_plane;
 	glm::mat4 projection;
+
+	// ̹ frame 콺 ȸϰ ִ
+	bool is_mouse_look;
+
+	// late latch  ݿ 콺 ̵.  frame MouseDelta ԵǾ Ƿ camera_update .
+	glm::vec2 latched_mouse_delta;
+
+	// projection     fov/aspect/near/far. ٲ  ٽ .
+	glm::vec4 projection_params;
+
+	// view projection ٽ   ö󰣴.
+	unsigned version;
+
+	// model_shader CameraBlock. frame slot  ϳ ΰ,  ø camera version ؼ ٲ  ٽ ø.
+	GLuint ubo[MAX_FRAMES_IN_FLIGHT];
+	unsigned ubo_version[MAX_FRAMES_IN_FLIGHT];
 }g_camera;
 
+// model_shader CameraBlock  std140 layout
+struct CameraBlock
+{
+	glm::mat4 view;
+	glm::mat4 projection;
+	glm::vec4 position;
+};
+constexpr GLuint CAMERA_UBO_BINDING = 0;
+
+void camera_init()
+{
+	glGenBuffers(MAX_FRAMES_IN_FLIGHT, g_camera.ubo);
+	for (int i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i)
+	{
+		glBindBuffer(GL_UNIFORM_BUFFER, g_camera.ubo[i]);
+		glBufferData(GL_UNIFORM_BUFFER, sizeof(CameraBlock), NULL, GL_DYNAMIC_DRAW);
+		memory_tracker_gpu_set(GPU_MEMORY_BUFFER, g_camera.ubo[i], sizeof(CameraBlock));
+	}
+	glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+void camera_terminate()
+{
+	for (int i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i)
+	{
+		memory_tracker_gpu_release(GPU_MEMORY_BUFFER, g_camera.ubo[i]);
+	}
+	glDeleteBuffers(MAX_FRAMES_IN_FLIGHT, g_camera.ubo);
+}
+
+glm::vec3 camera_get_position()
+{
+	return g_camera.position;
+}
+
 void camera_reset()
 {
 	// Ƿ move speed mouse sensitivity ϰ 
@@ -147,16 +511,31 @@ void camera_reset()
 	g_camera.forward = glm::vec3(0.0f, 0.0f, 1.0f);
 
 	//  rotation position  view matrix 
-	g_camera.view = glm::mat4_cast(glm::conjugate(g_camera.rotation));
-	g_camera.view[3][0] = -(g_camera.view[0][0] * g_camera.position.x + g_camera.view[1][0] * g_camera.position.y + g_camera.view[2][0] * g_camera.position.z);
-	g_camera.view[3][1] = -(g_camera.view[0][1] * g_camera.position.x + g_camera.view[1][1] * g_camera.position.y + g_camera.view[2][1] * g_camera.position.z);
-	g_camera.view[3][2] = -(g_camera.view[0][2] * g_camera.position.x + g_camera.view[1][2] * g_camera.position.y + g_camera.view[2][2] * g_camera.position.z);
+	camera_update_view_matrix();
 
 	// perspective projection  fov near/far plane  ϰ, projection matrix .
 	g_camera.fov_degree = 60.0f;
 	g_camera.near_plane = 0.1f;
 	g_camera.far_plane = 1000.0f;
+	camera_update_projection();
 
+	g_camera.latched_mouse_delta = glm::vec2(0.f);
+}
+
+void camera_update_view_matrix()
+{
+	// camera ȸ Ͱ   ٸ 繰  ϱ 
+	// quaternion conjugate ݴ ȸش.
+	// ׸ camera position  rotation ǥ踦  view[3] positionڸ ־ش.
+	g_camera.view = glm::mat4_cast(glm::conjugate(g_camera.rotation));
+	g_camera.view[3][0] = -(g_camera.view[0][0] * g_camera.position.x + g_camera.view[1][0] * g_camera.position.y + g_camera.view[2][0] * g_camera.position.z);
+	g_camera.view[3][1] = -(g_camera.view[0][1] * g_camera.position.x + g_camera.view[1][1] * g_camera.position.y + g_camera.view[2][1] * g_camera.position.z);
+	g_camera.view[3][2] = -(g_camera.view[0][2] * g_camera.position.x + g_camera.view[1][2] * g_camera.position.y + g_camera.view[2][2] * g_camera.position.z);
+	++g_camera.version;
+}
+
+void camera_update_projection()
+{
 	float aspect = (float)g_window_width;
 	if (g_window_height != 0)
 	{
@@ -164,7 +543,72 @@ void camera_reset()
 		aspect /= g_window_height;
 	}
 
+	// window ũ⳪ fov/near/far ٲ  perspective ٽ .
+	const glm::vec4 params(g_camera.fov_degree, aspect, g_camera.near_plane, g_camera.far_plane);
+	if (params == g_camera.projection_params)
+	{
+		return;
+	}
+
+	g_camera.projection_params = params;
 	g_camera.projection = glm::perspective(glm::radians(g_camera.fov_degree), aspect, g_camera.near_plane, g_camera.far_plane);
+	++g_camera.version;
+}
+
+// 콺  ŭ(pixel) ī޶ ȸŲ.
+void camera_rotate(float mouse_delta_x, float mouse_delta_y)
+{
+	// mouse delta degree ϰ, radian ٲٰ mouse sensitivitiy Ͽ
+	// ϴ ΰ ̰ Ѵ.
+	float x_delta = glm::radians(mouse_delta_x) * g_camera.mouse_sensitivity;
+	float y_delta = glm::radians(mouse_delta_y) * g_camera.mouse_sensitivity;
+
+	// ڰ x 콺 ٸ y࿡  ȸ  Ѵ.
+	//    ٸ  ȸ Ѿ ϴµ, x_delta ε, 3 ȸ   ȸŰ
+	//  ȸϹǷ  ٲپش.
+	glm::quat y_rot = glm::angleAxis(-x_delta, glm::vec3(0.f, 1.f, 0.f));
+
+	// ڰ y 콺 ٸ x࿡  ȸ  Ѵ.
+	glm::quat x_rot = glm::angleAxis(-y_delta, glm::vec3(1.f, 0.0, 0.f));
+
+	/*
+		Rotation Order : Y -> Previous Rotation -> X
+		Previous Rotation is also Y -> X
+		 ü  Y -> Y -> X -> X ̹Ƿ,  Y -> X̴.
+
+		׷  ȸ  delta roation ϴ° .
+
+		 ĵ  غν  ϴ , Ư Y -> Y  ȸ࿡  ȸ Ű   ִ
+		float ya1 = 31.f;
+		float ya2 = 78.f;
+		glm::quat y1 = glm::angleAxis(glm::radians(ya1), glm::vec3(0.f, 1.f, 0.f));
+		glm::quat y2 = glm::angleAxis(glm::radians(ya2), glm::vec3(0.f, 1.f, 0.f));
+		glm::quat y3 = glm::angleAxis(glm::radians(ya1 + ya2), glm::vec3(0.f, 1.f, 0.f));
+		glm::quat ycomb = y1 * y2;
+		glm::quat ycomb_reverse = y2 * y1;
+
+		float xa1 = 3.f;
+		float xa2 = 142.f;
+		glm::quat x1 = glm::angleAxis(glm::radians(xa1), glm::vec3(1.f, 0.f, 0.f));
+		glm::quat x2 = glm::angleAxis(glm::radians(xa2), glm::vec3(1.f, 0.f, 0.f));
+		glm::quat x3 = glm::angleAxis(glm::radians(xa1 + xa2), glm::vec3(1.f, 0.f, 0.f));
+		glm::quat xcomb = x1 * x2;
+		glm::quat xcomb_reverse = x2 * x1;
+
+		glm::quat new_y_rot = glm::angleAxis(glm::raidnas(30.f), glm::vec3(0.f, 1.f, 0.f));
+		glm::quat new_x_rot = glm::angleAxis(glm::raidnas(16.f), glm::vec3(1.f, 0.f, 0.f));
+		glm::quat r1 = ((new_y_rot * (y1 * x1)) * new_x_rot);
+		glm::quat r2 = ((y1 * (new_y_rot * x1)) * new_x_rot);
+	*/
+
+	// mouse  delta   ī޶ ο ȸ 
+	g_camera.rotation = (y_rot * g_camera.rotation) * x_rot;
+
+	// ȸ ŵǾǷ, quat matrix· ٲپ ش ǥ  right/up/forward  ־ش.
+	glm::mat3 rot_mat = glm::mat3_cast(g_camera.rotation);
+	g_camera.right = rot_mat[0];
+	g_camera.up = rot_mat[1];
+	g_camera.forward = rot_mat[2];
 }
 
 void camera_update()
@@ -177,63 +621,17 @@ void camera_update()
 
 	bool should_update_view_matrix = false;
 
+	//  frame late latch  ݿ 콺 ̵ ̹ MouseDelta  Ƿ ش.
+	const glm::vec2 latched_mouse_delta = g_camera.latched_mouse_delta;
+	g_camera.latched_mouse_delta = glm::vec2(0.f);
+
 	//  콺  ŬǾִ && ׸ ImGui UI Ŭ ȵǾ ִ
 	// io.WantCaptureMouse   ּ  .
-	if (io.MouseDown[GLFW_MOUSE_BUTTON_LEFT] && !io.WantCaptureMouse)
+	g_camera.is_mouse_look = io.MouseDown[GLFW_MOUSE_BUTTON_LEFT] && !io.WantCaptureMouse;
+	if (g_camera.is_mouse_look)
 	{
 		should_update_view_matrix = true;
-
-		// mouse delta degree ϰ, radian ٲٰ mouse sensitivitiy Ͽ
-		// ϴ ΰ ̰ Ѵ.
-		float x_delta = glm::radians(io.MouseDelta.x) * g_camera.mouse_sensitivity;
-		float y_delta = glm::radians(io.MouseDelta.y) * g_camera.mouse_sensitivity;
-
-		// ڰ x 콺 ٸ y࿡  ȸ  Ѵ.
-		//    ٸ  ȸ Ѿ ϴµ, x_delta ε, 3 ȸ   ȸŰ
-		//  ȸϹǷ  ٲپش.
-		glm::quat y_rot = glm::angleAxis(-x_delta, glm::vec3(0.f, 1.f, 0.f));
-
-		// ڰ y 콺 ٸ x࿡  ȸ  Ѵ.
-		glm::quat x_rot = glm::angleAxis(-y_delta, glm::vec3(1.f, 0.0, 0.f));
-
-		/*
-			Rotation Order : Y -> Previous Rotation -> X
-			Previous Rotation is also Y -> X
-			 ü  Y -> Y -> X -> X ̹Ƿ,  Y -> X̴.
-
-			׷  ȸ  delta roation ϴ° .
-
-			 ĵ  غν  ϴ , Ư Y -> Y  ȸ࿡  ȸ Ű   ִ
-			float ya1 = 31.f;
-			float ya2 = 78.f;
-			glm::quat y1 = glm::angleAxis(glm::radians(ya1), glm::vec3(0.f, 1.f, 0.f));
-			glm::quat y2 = glm::angleAxis(glm::radians(ya2), glm::vec3(0.f, 1.f, 0.f));
-			glm::quat y3 = glm::angleAxis(glm::radians(ya1 + ya2), glm::vec3(0.f, 1.f, 0.f));
-			glm::quat ycomb = y1 * y2;
-			glm::quat ycomb_reverse = y2 * y1;
-
-			float xa1 = 3.f;
-			float xa2 = 142.f;
-			glm::quat x1 = glm::angleAxis(glm::radians(xa1), glm::vec3(1.f, 0.f, 0.f));
-			glm::quat x2 = glm::angleAxis(glm::radians(xa2), glm::vec3(1.f, 0.f, 0.f));
-			glm::quat x3 = glm::angleAxis(glm::radians(xa1 + xa2), glm::vec3(1.f, 0.f, 0.f));
-			glm::quat xcomb = x1 * x2;
-			glm::quat xcomb_reverse = x2 * x1;
-
-			glm::quat new_y_rot = glm::angleAxis(glm::raidnas(30.f), glm::vec3(0.f, 1.f, 0.f));
-			glm::quat new_x_rot = glm::angleAxis(glm::raidnas(16.f), glm::vec3(1.f, 0.f, 0.f));
-			glm::quat r1 = ((new_y_rot * (y1 * x1)) * new_x_rot);
-			glm::quat r2 = ((y1 * (new_y_rot * x1)) * new_x_rot);
-		*/
-
-		// mouse  delta   ī޶ ο ȸ 
-		g_camera.rotation = (y_rot * g_camera.rotation) * x_rot;
-
-		// ȸ ŵǾǷ, quat matrix· ٲپ ش ǥ  right/up/forward  ־ش.
-		glm::mat3 rot_mat = glm::mat3_cast(g_camera.rotation);
-		g_camera.right = rot_mat[0];
-		g_camera.up = rot_mat[1];
-		g_camera.forward = rot_mat[2];
+		camera_rotate(io.MouseDelta.x - latched_mouse_delta.x, io.MouseDelta.y - latched_mouse_delta.y);
 	}
 
 	// ڰ ImGUi Ű ȣۿ ϰ   , ڼ  ּ .
@@ -275,46 +673,177 @@ void camera_update()
 		}
 	}
 
+	// benchmark ߿ Է  camera θ 󰣴.
+	if (g_benchmark.is_enable)
+	{
+		should_update_view_matrix = true;
+		benchmark_sample_camera(&g_camera.position, &g_camera.rotation, false);
+		benchmark_mark_input();
+
+		glm::mat3 rot_mat = glm::mat3_cast(g_camera.rotation);
+		g_camera.right = rot_mat[0];
+		g_camera.up = rot_mat[1];
+		g_camera.forward = rot_mat[2];
+	}
+
 	//  camera position/rotation   ϳ Ʈ Ǿٸ
 	// view matrix Ʈ ش.
 	if (should_update_view_matrix)
 	{
-		// camera ȸ Ͱ   ٸ 繰  ϱ 
-		// quaternion conjugate ݴ ȸش.
-		// ׸ camera position  rotation ǥ踦  view[3] positionڸ ־ش.
-		g_camera.view = glm::mat4_cast(glm::conjugate(g_camera.rotation));
-		g_camera.view[3][0] = -(g_camera.view[0][0] * g_camera.position.x + g_camera.view[1][0] * g_camera.position.y + g_camera.view[2][0] * g_camera.position.z);
-		g_camera.view[3][1] = -(g_camera.view[0][1] * g_camera.position.x + g_camera.view[1][1] * g_camera.position.y + g_camera.view[2][1] * g_camera.position.z);
-		g_camera.view[3][2] = -(g_camera.view[0][2] * g_camera.position.x + g_camera.view[1][2] * g_camera.position.y + g_camera.view[2][2] * g_camera.position.z);
+		idle_mark_dirty();
+		camera_update_view_matrix();
 	}
 
-	float aspect = (float)g_window_width;
-	if (g_window_height != 0)
+	camera_update_projection();
+
+	// physics  ִٸ  Ŭ  body broadphase raycast ã о.
+	if (g_physics.is_enable && io.MouseClicked[GLFW_MOUSE_BUTTON_RIGHT] && !io.WantCaptureMouse && io.DisplaySize.x > 0.f && io.DisplaySize.y > 0.f)
 	{
-		// handle with when the window minimized
-		aspect /= g_window_height;
+		// cursor NDC near/far plane world ǥ ǵ ray .
+		const glm::mat4 inverse_view_projection = glm::inverse(g_camera.projection * g_camera.view);
+		const float ndc_x = io.MousePos.x / io.DisplaySize.x * 2.f - 1.f;
+		const float ndc_y = 1.f - io.MousePos.y / io.DisplaySize.y * 2.f;
+		const glm::vec4 near_point = inverse_view_projection * glm::vec4(ndc_x, ndc_y, -1.f, 1.f);
+		const glm::vec4 far_point = inverse_view_projection * glm::vec4(ndc_x, ndc_y, 1.f, 1.f);
+		const glm::vec3 origin = glm::vec3(near_point) / near_point.w;
+		const glm::vec3 direction = glm::vec3(far_point) / far_point.w - origin;
+		physics_pick(origin, direction, glm::length(direction), 8.f);
+		idle_mark_dirty();
 	}
+}
 
-	// perspective ش. ̰   ٲ  Ʈ ൵ Ǵµ
-	// window dimension ŵǴ   ΰ ȮϱⰡ Ƽ ׳ ̷  Ӹ ϰ д.
-	g_camera.projection = glm::perspective(glm::radians(g_camera.fov_degree), aspect, g_camera.near_plane, g_camera.far_plane);
+// frame_sync_begin ڿ ȣѴ. ̹ frame slot camera UBO view/projection/position  .
+void camera_upload()
+{
+	const int slot = g_frame_sync.frame_slot;
+	const GLuint ubo = g_camera.ubo[slot];
+	if (g_camera.ubo_version[slot] != g_camera.version)
+	{
+		CameraBlock block;
+		block.view = g_camera.view;
+		block.projection = g_camera.projection;
+		block.position = glm::vec4(g_camera.position, 1.f);
+
+		glBindBuffer(GL_UNIFORM_BUFFER, ubo);
+		glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(CameraBlock), &block);
+		glBindBuffer(GL_UNIFORM_BUFFER, 0);
+		g_camera.ubo_version[slot] = g_camera.version;
+	}
+	glBindBufferBase(GL_UNIFORM_BUFFER, CAMERA_UBO_BINDING, ubo);
+}
+
+// camera_update frame ʿ Է Ƿ,   UI/CPU ۾ ðŭ Է ȭ鿡 ʰ ݿȴ.
+// model_draw GPU ۾ ֱ  cursor ٽ о    ŭ  ȸϰ,
+// UBO view matrix ġ ٽ . (projection camera_update  ״ .)
+// benchmark ߿ cursor  ο frame ۵  帥 ðŭ   ڼ ٽ ´.
+void camera_late_latch()
+{
+	if (!g_is_late_latch_camera)
+	{
+		return;
+	}
+
+	if (g_benchmark.is_enable)
+	{
+		// benchmark Է  θ 󰡹Ƿ,  ð ڼ ٽ ´.
+		// ڼ ״ζ(warmup,  ) Է ð camera_update  ״ д.
+		if (!benchmark_sample_camera(&g_camera.position, &g_camera.rotation, true))
+		{
+			return;
+		}
+		benchmark_mark_input();
+
+		const glm::mat3 rot_mat = glm::mat3_cast(g_camera.rotation);
+		g_camera.right = rot_mat[0];
+		g_camera.up = rot_mat[1];
+		g_camera.forward = rot_mat[2];
+	}
+	else if (g_window != NULL && g_camera.is_mouse_look)
+	{
+		// glfwGetCursorPos event poll  ʾƵ OS  cursor ġ ´.
+		const ImGuiIO& io = ImGui::GetIO();
+		double mouse_x, mouse_y;
+		glfwGetCursorPos(g_window, &mouse_x, &mouse_y);
+		if (!ImGui::IsMousePosValid(&io.MousePos))
+		{
+			return;
+		}
+
+		const glm::vec2 delta((float)mouse_x - io.MousePos.x, (float)mouse_y - io.MousePos.y);
+		if (delta.x == 0.f && delta.y == 0.f)
+		{
+			return;
+		}
+		camera_rotate(delta.x, delta.y);
+		g_camera.latched_mouse_delta = delta;
+	}
+	else
+	{
+		return;
+	}
+
+	camera_update_view_matrix();
+
+	// ̹ slot camera_upload ̹ ֽ̾Ƿ view ġ  ٽ ֽ ȴ.
+	const int slot = g_frame_sync.frame_slot;
+	const glm::vec4 position(g_camera.position, 1.f);
+	glBindBuffer(GL_UNIFORM_BUFFER, g_camera.ubo[slot]);
+	glBufferSubData(GL_UNIFORM_BUFFER, offsetof(CameraBlock, view), sizeof(glm::mat4), &(g_camera.view[0][0]));
+	glBufferSubData(GL_UNIFORM_BUFFER, offsetof(CameraBlock, position), sizeof(glm::vec4), &position);
+	glBindBuffer(GL_UNIFORM_BUFFER, 0);
+	g_camera.ubo_version[slot] = g_camera.version;
 }
 
 struct DirectionalLight
 {
-	glm::vec3 rot_euler;
+	//  transform rotationθ Ѵ. (forward ݴ   .)
+	TransformHandle transform;
 	glm::vec3 ambient;
 	glm::vec3 diffuse;
 	glm::vec3 specular;
+
+	//  ٲ  ø.
+	unsigned version;
 };
 
-struct Mesh
+// assimp   . GPU_ONLY GL buffer ø  .
+struct MeshCPUData
 {
 	std::vector<float> position;
 	std::vector<float> normal;
 	std::vector<float> tangent;
 	std::vector<float> uv;
 	std::vector<uint32_t> indices;
+};
+
+constexpr int MESH_VBO_COUNT = 5;	// pos / normal / tangent / uv / skin (joint 4 + weight 4 byte, skinning ϴ mesh)
+
+// mesh ׸   GL object. CPU_ONLY  0̴.
+struct MeshGPUData
+{
+	GLuint vao;
+	GLuint vbos[MESH_VBO_COUNT];
+	GLuint ibo;
+};
+
+struct Mesh
+{
+	MeshResidency residency;
+	MeshCPUData cpu;
+	MeshGPUData gpu;
+
+	// CPU 迭  ڿ ׸ 迡  
+	unsigned vertex_count;
+	unsigned index_count;
+
+	// g_animation.skinned_meshes index. skinning  ʴ mesh -1
+	// CPU skinning̶ position/normal/tangent VBO pose ٲ  skinning  ٽ ä,
+	// GPU skinning̶ bind pose ״ ΰ vertex shader skin VBO joint/weight skinning Ѵ.
+	int skin_index;
+
+	// local space AABB. GPU culling instance world matrix ȯؼ Ѵ.
+	glm::vec3 aabb_min;
+	glm::vec3 aabb_max;
 
 	// Model struct std::vector<Material> material element index Ų.
 	//  0 ̻̾ ȿϰ, ƴ϶ g_default_material Ἥ  ؾ Ѵ.
@@ -339,33 +868,41 @@ struct Material
 	bool has_normal_texture;
 	GLuint gl_normal;
 
+	// glTF alphaMode MASKó blending  alpha  fragment  
+	bool is_alpha_test;
+	float alpha_cutoff;
+
+	//  flag Ǵ model shader variant (ModelShaderFeature )
+	unsigned shader_features;
+
 	char debug_mat_name[64];
 };
 
-struct Model
+// model_shader.vert/frag #define variant. bit  MODEL_SHADER_DEFINES ƾ Ѵ.
+enum ModelShaderFeature
 {
-	// Model data 
-	std::vector<Mesh> mesh;
-	std::vector<Material> material;
-
-	//  Mesh   ؾ  ,
-	//  vector ִ  std::vector<Mesh> mesh ϴµ ȴ.
-	std::vector<unsigned> draw_order;
+	MODEL_SHADER_NORMAL_MAP = 1 << 0,
+	MODEL_SHADER_ALPHA_TEST = 1 << 1,
+	MODEL_SHADER_TRANSPARENCY = 1 << 2,
+	MODEL_SHADER_INSTANCING = 1 << 3,
+	MODEL_SHADER_SKINNING = 1 << 4,
+	MODEL_SHADER_FEATURE_COUNT = 5,
+};
+const char* MODEL_SHADER_DEFINES[MODEL_SHADER_FEATURE_COUNT] =
+{
+	"USE_NORMAL_MAP",
+	"USE_ALPHA_TEST",
+	"USE_TRANSPARENCY",
+	"USE_INSTANCING",
+	"USE_SKINNING",
+};
 
-	// Model Rendering ̿Ǵ PSO(Pipeline State Object) + Buffers
-	GLuint shader_vertex;
-	GLuint shader_frag;
+// shader variant ϳ  program uniform location
+struct ModelProgram
+{
 	GLuint pso;
-	std::vector<GLuint> vaos;	// vertex array object
-	std::vector<GLuint> vbos;	// vertex buffer object
-	std::vector<GLuint> ibos;	// index buffer object
 
-	// uniform locations
 	GLint loc_world_mat;
-	GLint loc_view_mat;
-	GLint loc_projection_mat;
-	GLint loc_is_use_tangent;
-	GLint loc_cam_pos;
 	GLint loc_sun_dir;
 	GLint loc_sun_ambient;
 	GLint loc_sun_diffuse;
@@ -376,12 +913,62 @@ struct Model
 	GLint loc_mat_diffuse;
 	GLint loc_mat_specular;
 	GLint loc_mat_shininess;
+	GLint loc_mat_alpha_cutoff;
+	GLint loc_bone_palette;
+	GLint loc_bone_base;
+	GLint loc_palette_stride;
+
+	//  uniform ø model/light transform light  version. ٸ ٽ ø ʴ´.
+	unsigned world_version;
+	unsigned light_transform_version;
+	unsigned light_version;
+};
+
+struct Model
+{
+	// Model data 
+	std::vector<Mesh> mesh;
+	std::vector<Material> material;
+
+	// Model Rendering ̿Ǵ PSO(Pipeline State Object) + Buffers
+	// PSO shader variant(feature mask) ϳ ʿ  .
+	ShaderPermutation shader;
+	std::vector<ModelProgram> programs;	// index : feature mask
+
+	// instance world matrix(mat4) ϳ  buffer.
+	// vertex attribute(location 4 ~ 7, divisor 1)ε ̰, GPU culling SSBOε д´.
+	GLuint instance_buffer;
+	std::vector<glm::mat4> instance_world;
+
+	// skinning  VBO   pose. g_animation.pose_version ٸ  ٽ skinning Ѵ.
+	// 0̶ VBO bind pose ִ. (GPU skinning д )
+	unsigned skinned_pose_version;
+
+	// GPU skinning. instance  pose index (location 10, divisor 1)
+	// g_animation.gpu_palettes  texture buffer (RGBA32F, bone ϳ texel 3)
+	GLuint instance_pose_buffer;
+	int instance_built_pose_count;
+	GLuint bone_palette_buffer;
+	GLuint bone_palette_texture;
+	unsigned bone_palette_version;
+
+	// instance XZ 鿡 grid ġѴ.
+	int instance_count;
+	float instance_spacing;
+
+	// mesh AABB δ  (model space). physics body ũ ̴߽.
+	glm::vec3 bounding_center;
+	float bounding_radius;
+
+	// instance_world     . ٲ  ٽ  ø.
+	unsigned instance_built_version;
+	int instance_built_count;
+	float instance_built_spacing;
+	unsigned instance_built_physics_version;
 
 	// Model transform .
 	// rotation  Unityó  xyz Euler Angle Ÿ.
-	glm::vec3 scale;
-	glm::vec3 rot_euler;
-	glm::vec3 position;
+	TransformHandle transform;
 }g_model;
 
 DirectionalLight g_light;
@@ -392,15 +979,36 @@ GLuint g_default_texture_white;
 constexpr glm::vec3 INITIAL_MODEL_SCALE(1.0f);
 constexpr glm::vec3 INITIAL_MODEL_ROTATION(0.0f);	// xyz Euler Angle Ÿ.
 constexpr glm::vec3 INITIAL_MODEL_POSITION(0.0f);
+constexpr int INITIAL_INSTANCE_COUNT = 1;
+constexpr int MAX_INSTANCE_COUNT = 100000;
 constexpr glm::vec3 INITIAL_MATERIAL_AMBIENT(0.0f);
 constexpr glm::vec3 INITIAL_MATERIAL_DIFFUSE(1.f);
 constexpr glm::vec3 INITIAL_MATERIAL_SPECULAR(1.f);
 constexpr float INITIAL_MATERIAL_SHININESS = 0.f;
+constexpr float INITIAL_MATERIAL_ALPHA_CUTOFF = 0.5f;
 constexpr glm::vec3 INITIAL_LIGHT_ROT_EULER = glm::vec3(65.f, 45.f, 32.f);
 constexpr glm::vec3 INITIAL_LIGHT_AMBIENT = glm::vec3(0.1f);
 constexpr glm::vec3 INITIAL_LIGHT_DIFFUSE = glm::vec3(0.5f);
 constexpr glm::vec3 INITIAL_LIGHT_SPECULAR = glm::vec3(0.2f);
 
+unsigned material_shader_features(const Material* mat)
+{
+	unsigned features = 0;
+	if (mat->has_normal_texture)
+	{
+		features |= MODEL_SHADER_NORMAL_MAP;
+	}
+	if (mat->is_alpha_test)
+	{
+		features |= MODEL_SHADER_ALPHA_TEST;
+	}
+	if (mat->is_transparent)
+	{
+		features |= MODEL_SHADER_TRANSPARENCY;
+	}
+	return features;
+}
+
 void process_scene_mesh(const aiScene* scene)
 {
 	assert(scene != nullptr &&
@@ -409,7 +1017,8 @@ void process_scene_mesh(const aiScene* scene)
 
 	g_model.mesh.resize(scene->mNumMeshes);
 
-	for (int mesh_index = 0; mesh_index < scene->mNumMeshes; ++mesh_index)
+	// mesh  ڽ Mesh Ƿ job system  Ѵ.
+	parallel_for((int)scene->mNumMeshes, 1, [scene](int mesh_index)
 	{
 		const aiMesh* ai_mesh = scene->mMeshes[mesh_index];
 
@@ -441,28 +1050,38 @@ void process_scene_mesh(const aiScene* scene)
 		
 		Mesh* my_mesh = &(g_model.mesh[mesh_index]);
 
+		//  job ϴ thread Ҵ mesh .
+		const int last_tag = memory_tag_begin(MEMORY_TAG_MESH);
+
 		// mesh  ִ     CPU Buffer ̸ Ҵ.
-		my_mesh->position.resize(ai_mesh->mNumVertices * 4);
-		my_mesh->normal.resize(ai_mesh->mNumVertices * 3);
-		my_mesh->tangent.resize(ai_mesh->mNumVertices * 3);
-		my_mesh->uv.resize(ai_mesh->mNumVertices * 2);
+		MeshCPUData* cpu = &(my_mesh->cpu);
+		cpu->position.resize(ai_mesh->mNumVertices * 4);
+		cpu->normal.resize(ai_mesh->mNumVertices * 3);
+		cpu->tangent.resize(ai_mesh->mNumVertices * 3);
+		cpu->uv.resize(ai_mesh->mNumVertices * 2);
+		my_mesh->aabb_min = glm::vec3(FLT_MAX);
+		my_mesh->aabb_max = glm::vec3(-FLT_MAX);
 		for (unsigned ai_vertex_index = 0; ai_vertex_index < ai_mesh->mNumVertices; ++ai_vertex_index)
 		{
+			const aiVector3D& ai_pos = ai_mesh->mVertices[ai_vertex_index];
+			my_mesh->aabb_min = glm::min(my_mesh->aabb_min, glm::vec3(ai_pos.x, ai_pos.y, ai_pos.z));
+			my_mesh->aabb_max = glm::max(my_mesh->aabb_max, glm::vec3(ai_pos.x, ai_pos.y, ai_pos.z));
+
 			unsigned access_index = ai_vertex_index * 4;
-			my_mesh->position[access_index++] = ai_mesh->mVertices[ai_vertex_index].x;
-			my_mesh->position[access_index++] = ai_mesh->mVertices[ai_vertex_index].y;
-			my_mesh->position[access_index++] = ai_mesh->mVertices[ai_vertex_index].z;
-			my_mesh->position[access_index] = 1.f;
+			cpu->position[access_index++] = ai_mesh->mVertices[ai_vertex_index].x;
+			cpu->position[access_index++] = ai_mesh->mVertices[ai_vertex_index].y;
+			cpu->position[access_index++] = ai_mesh->mVertices[ai_vertex_index].z;
+			cpu->position[access_index] = 1.f;
 
 			access_index = ai_vertex_index * 3;
-			my_mesh->normal[access_index++] = ai_mesh->mNormals[ai_vertex_index].x;
-			my_mesh->normal[access_index++] = ai_mesh->mNormals[ai_vertex_index].y;
-			my_mesh->normal[access_index] = ai_mesh->mNormals[ai_vertex_index].z;
+			cpu->normal[access_index++] = ai_mesh->mNormals[ai_vertex_index].x;
+			cpu->normal[access_index++] = ai_mesh->mNormals[ai_vertex_index].y;
+			cpu->normal[access_index] = ai_mesh->mNormals[ai_vertex_index].z;
 
 			access_index = ai_vertex_index * 3;
-			my_mesh->tangent[access_index++] = ai_mesh->mTangents[ai_vertex_index].x;
-			my_mesh->tangent[access_index++] = ai_mesh->mTangents[ai_vertex_index].y;
-			my_mesh->tangent[access_index] = ai_mesh->mTangents[ai_vertex_index].z;
+			cpu->tangent[access_index++] = ai_mesh->mTangents[ai_vertex_index].x;
+			cpu->tangent[access_index++] = ai_mesh->mTangents[ai_vertex_index].y;
+			cpu->tangent[access_index] = ai_mesh->mTangents[ai_vertex_index].z;
 
 			// UV ش Ͱ ϴ Ȯϰ, 0° ǥ ϵ Ѵ.
 			// ؽ ǥ   ̴  Ƿ Ͱ  0 ־ش.
@@ -470,13 +1089,13 @@ void process_scene_mesh(const aiScene* scene)
 
 			if (ai_mesh->mTextureCoords[0])
 			{
-				my_mesh->uv[access_index++] = ai_mesh->mTextureCoords[0][ai_vertex_index].x;
-				my_mesh->uv[access_index] = ai_mesh->mTextureCoords[0][ai_vertex_index].y;
+				cpu->uv[access_index++] = ai_mesh->mTextureCoords[0][ai_vertex_index].x;
+				cpu->uv[access_index] = ai_mesh->mTextureCoords[0][ai_vertex_index].y;
 			}
 			else
 			{
-				my_mesh->uv[access_index++] = 0.f;
-				my_mesh->uv[access_index] = 0.f;
+				cpu->uv[access_index++] = 0.f;
+				cpu->uv[access_index] = 0.f;
 			}
 		}
 
@@ -484,11 +1103,18 @@ void process_scene_mesh(const aiScene* scene)
 		for (unsigned ai_face_index = 0; ai_face_index < ai_mesh->mNumFaces; ++ai_face_index)
 		{
 			aiFace face = ai_mesh->mFaces[ai_face_index];
-			size_t indices_size = my_mesh->indices.size();
-			my_mesh->indices.resize(indices_size + face.mNumIndices);
-			memcpy(my_mesh->indices.data() + indices_size, face.mIndices, sizeof(unsigned) * face.mNumIndices);
+			size_t indices_size = cpu->indices.size();
+			cpu->indices.resize(indices_size + face.mNumIndices);
+			memcpy(cpu->indices.data() + indices_size, face.mIndices, sizeof(unsigned) * face.mNumIndices);
 		}
 
+		//   ҷ  policy . GL buffer model_init main thread .
+		my_mesh->residency = g_mesh_residency;
+		my_mesh->skin_index = -1;
+		my_mesh->vertex_count = ai_mesh->mNumVertices;
+		my_mesh->index_count = (unsigned)cpu->indices.size();
+		memset(&(my_mesh->gpu), 0, sizeof(MeshGPUData));
+
 		// assimp mesh Ű material index ִٸ
 		// װ mesh struct material_index ־ش.
 		// ٸ   ־ش.
@@ -500,29 +1126,304 @@ void process_scene_mesh(const aiScene* scene)
 		{
 			my_mesh->material_index = -1;
 		}
+
+		memory_tag_end(last_tag);
+	});
+}
+
+// aiMatrix4x4 row-major, glm column-major
+static glm::mat4 ai_to_glm(const aiMatrix4x4& m)
+{
+	return glm::mat4(m.a1, m.b1, m.c1, m.d1,
+					 m.a2, m.b2, m.c2, m.d2,
+					 m.a3, m.b3, m.c3, m.d3,
+					 m.a4, m.b4, m.c4, m.d4);
+}
+
+void process_scene_skeleton(const aiScene* scene, std::vector<int>* mesh_node_indices)
+{
+	Skeleton* skeleton = &(g_animation.skeleton);
+	mesh_node_indices->assign(scene->mNumMeshes, -1);
+
+	// θ ڽĺ տ  root  켱 ȣ δ.
+	std::vector<std::pair<const aiNode*, int>> stack;
+	stack.push_back(std::make_pair(scene->mRootNode, -1));
+	while (!stack.empty())
+	{
+		const aiNode* node = stack.back().first;
+		const int parent = stack.back().second;
+		stack.pop_back();
+
+		const int node_index = (int)skeleton->parents.size();
+		skeleton->node_names.push_back(node->mName.C_Str());
+		skeleton->parents.push_back(parent);
+
+		aiVector3D scaling, position;
+		aiQuaternion rotation;
+		node->mTransformation.Decompose(scaling, rotation, position);
+		skeleton->bind_positions.push_back(glm::vec3(position.x, position.y, position.z));
+		skeleton->bind_rotations.push_back(glm::quat(rotation.w, rotation.x, rotation.y, rotation.z));
+		skeleton->bind_scales.push_back(glm::vec3(scaling.x, scaling.y, scaling.z));
+
+		for (unsigned i = 0; i < node->mNumMeshes; ++i)
+		{
+			(*mesh_node_indices)[node->mMeshes[i]] = node_index;
+		}
+
+		// ù ° ڽ   Ųٷ ִ´.
+		for (unsigned i = node->mNumChildren; i > 0; --i)
+		{
+			stack.push_back(std::make_pair(node->mChildren[i - 1], node_index));
+		}
 	}
 }
 
-void process_scene_material(const aiScene* scene, const char* base_folder)
+void process_scene_animation(const aiScene* scene)
 {
-	// ̹ ҷ  ο  string  ó ϱ  base_folder ̸ Ѵ.
-	size_t base_folder_len = strlen(base_folder);
+	const Skeleton* skeleton = &(g_animation.skeleton);
+	g_animation.clips.resize(scene->mNumAnimations);
+	for (unsigned anim_index = 0; anim_index < scene->mNumAnimations; ++anim_index)
+	{
+		const aiAnimation* ai_anim = scene->mAnimations[anim_index];
+		AnimationClip* clip = &(g_animation.clips[anim_index]);
+
+		// key ð tick . tick  ٸ assimp ⺻(25) .
+		const double ticks_per_second = ai_anim->mTicksPerSecond > 0.0 ? ai_anim->mTicksPerSecond : 25.0;
+		const float time_scale = (float)(1.0 / ticks_per_second);
+		clip->name = ai_anim->mName.length > 0 ? ai_anim->mName.C_Str() : "Clip " + std::to_string(anim_index);
+		clip->duration = (float)(ai_anim->mDuration / ticks_per_second);
+
+		for (unsigned channel_index = 0; channel_index < ai_anim->mNumChannels; ++channel_index)
+		{
+			const aiNodeAnim* channel = ai_anim->mChannels[channel_index];
+			AnimationTrack track;
+			track.node_index = animation_find_node(skeleton, channel->mNodeName.C_Str());
+			if (track.node_index < 0)
+			{
+				printf("Animation channel without node : %s\n", channel->mNodeName.C_Str());
+				continue;
+			}
+
+			track.position_begin = (unsigned)clip->positions.size();
+			track.position_count = channel->mNumPositionKeys;
+			for (unsigned key = 0; key < channel->mNumPositionKeys; ++key)
+			{
+				const aiVectorKey& ai_key = channel->mPositionKeys[key];
+				clip->position_times.push_back((float)ai_key.mTime * time_scale);
+				clip->positions.push_back(glm::vec3(ai_key.mValue.x, ai_key.mValue.y, ai_key.mValue.z));
+			}
+
+			track.rotation_begin = (unsigned)clip->rotations.size();
+			track.rotation_count = channel->mNumRotationKeys;
+			for (unsigned key = 0; key < channel->mNumRotationKeys; ++key)
+			{
+				const aiQuatKey& ai_key = channel->mRotationKeys[key];
+				clip->rotation_times.push_back((float)ai_key.mTime * time_scale);
+				clip->rotations.push_back(glm::quat(ai_key.mValue.w, ai_key.mValue.x, ai_key.mValue.y, ai_key.mValue.z));
+			}
+
+			track.scale_begin = (unsigned)clip->scales.size();
+			track.scale_count = channel->mNumScalingKeys;
+			for (unsigned key = 0; key < channel->mNumScalingKeys; ++key)
+			{
+				const aiVectorKey& ai_key = channel->mScalingKeys[key];
+				clip->scale_times.push_back((float)ai_key.mTime * time_scale);
+				clip->scales.push_back(glm::vec3(ai_key.mValue.x, ai_key.mValue.y, ai_key.mValue.z));
+			}
 
+			clip->tracks.push_back(track);
+		}
+	}
+}
+
+void process_scene_skin(const aiScene* scene, const std::vector<int>& mesh_node_indices)
+{
+	// bone ִ mesh SkinnedMesh ϳ .
+	for (unsigned mesh_index = 0; mesh_index < scene->mNumMeshes; ++mesh_index)
+	{
+		if (!scene->mMeshes[mesh_index]->HasBones())
+		{
+			continue;
+		}
+
+		g_model.mesh[mesh_index].skin_index = (int)g_animation.skinned_meshes.size();
+		g_animation.skinned_meshes.emplace_back();
+		SkinnedMesh* skinned_mesh = &(g_animation.skinned_meshes.back());
+		skinned_mesh->mesh_index = (int)mesh_index;
+		skinned_mesh->mesh_node_index = mesh_node_indices[mesh_index] >= 0 ? mesh_node_indices[mesh_index] : 0;
+	}
+
+	// mesh  ڽ SkinnedMesh Ƿ job system  Ѵ.
+	parallel_for((int)g_animation.skinned_meshes.size(), 1, [scene](int skin_index)
+	{
+		const int last_tag = memory_tag_begin(MEMORY_TAG_ANIMATION);
+
+		SkinnedMesh* skinned_mesh = &(g_animation.skinned_meshes[skin_index]);
+		const aiMesh* ai_mesh = scene->mMeshes[skinned_mesh->mesh_index];
+		if (ai_mesh->mNumBones > SKIN_MAX_BONES)
+		{
+			printf("Too many bones in a mesh : %u\n", ai_mesh->mNumBones);
+			assert(false);
+		}
+
+		// bind pose SoA  д. (model CPU 迭 residency    ִ.)
+		const unsigned vertex_count = ai_mesh->mNumVertices;
+		skinned_mesh->vertex_count = vertex_count;
+		std::vector<float>* streams[9] = { &skinned_mesh->position_x, &skinned_mesh->position_y, &skinned_mesh->position_z,
+			&skinned_mesh->normal_x, &skinned_mesh->normal_y, &skinned_mesh->normal_z,
+			&skinned_mesh->tangent_x, &skinned_mesh->tangent_y, &skinned_mesh->tangent_z };
+		const aiVector3D* sources[3] = { ai_mesh->mVertices, ai_mesh->mNormals, ai_mesh->mTangents };
+		for (int i = 0; i < 9; ++i)
+		{
+			streams[i]->resize(vertex_count);
+			for (unsigned v = 0; v < vertex_count; ++v)
+			{
+				(*streams[i])[v] = sources[i / 3][v][i % 3];
+			}
+		}
+
+		//  weight ū 4 .
+		std::vector<float> top_weights(vertex_count * SKIN_MAX_INFLUENCES, 0.f);
+		skinned_mesh->joints.assign(vertex_count * SKIN_MAX_INFLUENCES, 0);
+		skinned_mesh->bone_nodes.resize(ai_mesh->mNumBones);
+		skinned_mesh->bone_offsets.resize(ai_mesh->mNumBones);
+		for (unsigned bone_index = 0; bone_index < ai_mesh->mNumBones; ++bone_index)
+		{
+			const aiBone* ai_bone = ai_mesh->mBones[bone_index];
+			int node_index = animation_find_node(&(g_animation.skeleton), ai_bone->mName.C_Str());
+			if (node_index < 0)
+			{
+				printf("Bone without node : %s\n", ai_bone->mName.C_Str());
+				node_index = skinned_mesh->mesh_node_index;
+			}
+			skinned_mesh->bone_nodes[bone_index] = node_index;
+			skinned_mesh->bone_offsets[bone_index] = ai_to_glm(ai_bone->mOffsetMatrix);
+
+			for (unsigned weight_index = 0; weight_index < ai_bone->mNumWeights; ++weight_index)
+			{
+				const aiVertexWeight& ai_weight = ai_bone->mWeights[weight_index];
+				float* weights = &(top_weights[ai_weight.mVertexId * SKIN_MAX_INFLUENCES]);
+				uint8_t* joints = &(skinned_mesh->joints[ai_weight.mVertexId * SKIN_MAX_INFLUENCES]);
+
+				// ū  ϸ  ִ´. 4 ۴ٸ .
+				int slot = SKIN_MAX_INFLUENCES;
+				while (slot > 0 && weights[slot - 1] < ai_weight.mWeight)
+				{
+					--slot;
+				}
+				for (int k = SKIN_MAX_INFLUENCES - 1; k > slot; --k)
+				{
+					weights[k] = weights[k - 1];
+					joints[k] = joints[k - 1];
+				}
+				if (slot < SKIN_MAX_INFLUENCES)
+				{
+					weights[slot] = ai_weight.mWeight;
+					joints[slot] = (uint8_t)bone_index;
+				}
+			}
+		}
+
+		skinned_mesh->weights.resize(vertex_count * SKIN_MAX_INFLUENCES);
+		for (unsigned v = 0; v < vertex_count; ++v)
+		{
+			skinning_quantize_weights(&(top_weights[v * SKIN_MAX_INFLUENCES]), &(skinned_mesh->weights[v * SKIN_MAX_INFLUENCES]));
+		}
+
+		memory_tag_end(last_tag);
+	});
+}
+
+void process_scene_material(const aiScene* scene, const char* base_folder)
+{
 	//  Material  ̹ ̿  ֱ 
-	//  ̹   θ ,   ε ϸ  ̹ ٷ   ֵ
-	// Key string̰, Value ImageInfo map ̿Ѵ.
+	//  ̹   θ , θ   ҷ  ̹ ٷ   ֵ
+	// Key string̰, Value images index map ̿Ѵ.
+	//  Լ ȿ  ͵̹Ƿ frame allocator ҴѴ. (ù frame   ǵ.)
 	struct ImageInfo
 	{
+		FrameString path;
 		int width, height, comp;
+		unsigned char* data;
 		GLuint gl_id;
 	};
-	std::unordered_map<std::string, ImageInfo> path_texture_map;
+	FrameVector<ImageInfo> images;
+	FrameHashMap<FrameString, int, FrameStringHash> path_image_map;
+
+	// material  diffuse/normal ̹ index. ٸ -1
+	FrameVector<int> diffuse_images(scene->mNumMaterials, -1);
+	FrameVector<int> normal_images(scene->mNumMaterials, -1);
 
 	// assimpκ texture path   ̿ϴ string
 	aiString assimp_str;
 
-	// stbi ̿ path   ̿ϴ string
-	std::string std_str;
+	// ش texture Ѵٸ θ  images (ó̶) ߰ϰ  index ش.
+	auto find_image = [&](const aiMaterial* assimp_mat, aiTextureType type) -> int
+	{
+		if (assimp_mat->GetTextureCount(type) == 0)
+		{
+			return -1;
+		}
+
+		// assimp_str base_folder ܵ ä  ,
+		//   θ ߰  θ ϼش.
+		assimp_mat->GetTexture(type, 0, &assimp_str);
+		FrameString path(base_folder);
+		path.append("/");
+		path.append(assimp_str.C_Str());
+
+		auto ret = path_image_map.find(path);
+		if (ret != path_image_map.end())
+		{
+			return ret->second;
+		}
+
+		ImageInfo info;
+		info.path = path;
+		info.width = info.height = info.comp = 0;
+		info.data = nullptr;
+		info.gl_id = 0;
+		images.push_back(info);
+
+		const int image_index = (int)images.size() - 1;
+		path_image_map[path] = image_index;
+		return image_index;
+	};
+
+	for (unsigned i = 0; i < scene->mNumMaterials; ++i)
+	{
+		diffuse_images[i] = find_image(scene->mMaterials[i], aiTextureType_DIFFUSE);
+		normal_images[i] = find_image(scene->mMaterials[i], aiTextureType_NORMALS);
+	}
+
+	{
+		clock_t intense_start, intense_end;
+
+		// ̹ decode  谡 Ƿ job system  file memory ø.
+		// (clock process ü CPU ð̹Ƿ ⼭ steady_clock .)
+		std::chrono::steady_clock::time_point decode_start = std::chrono::steady_clock::now();
+		parallel_for((int)images.size(), 1, [&images](int index)
+		{
+			ImageInfo* info = &(images[index]);
+			info->data = stbi_load(info->path.c_str(), &info->width, &info->height, &info->comp, 0);
+		});
+		printf("stbi load %u images %f\n", (unsigned)images.size(),
+			std::chrono::duration<float>(std::chrono::steady_clock::now() - decode_start).count());
+
+		// GL ȣ main thread   Ƿ upload ʴ Ѵ.
+		intense_start = clock();
+		for (ImageInfo& info : images)
+		{
+			// ش cpu memory gpu memory ø
+			info.gl_id = gl_load_model_texture(info.data, info.width, info.height, info.comp);
+
+			// gpu ÷Ƿ cpu ޸ 
+			stbi_image_free(info.data);
+			info.data = nullptr;
+		}
+		intense_end = clock();
+		printf("GPU upload %f\n", (float)(intense_end - intense_start) / CLOCKS_PER_SEC);
+	}
 
 	// Material ŭ ̸ ޸ Ҵ
 	g_model.material.resize(scene->mNumMaterials);
@@ -537,6 +1438,7 @@ void process_scene_material(const aiScene* scene, const char* base_folder)
 		model_mat->diffuse = INITIAL_MATERIAL_DIFFUSE;
 		model_mat->specular = INITIAL_MATERIAL_SPECULAR;
 		model_mat->shininess = INITIAL_MATERIAL_SHININESS;
+		model_mat->alpha_cutoff = INITIAL_MATERIAL_ALPHA_CUTOFF;
 
 		model_mat->gl_diffuse = g_default_texture_white;
 
@@ -548,57 +1450,10 @@ void process_scene_material(const aiScene* scene, const char* base_folder)
 		memcpy(model_mat->debug_mat_name, mat_name.C_Str(), copy_size);
 		model_mat->debug_mat_name[copy_size] = '\0';
 
-		clock_t start, end;
-		start = clock();
 		// Diffuse Texture ϴ?
-		if (unsigned texture_count = assimp_mat->GetTextureCount(aiTextureType_DIFFUSE))
+		if (diffuse_images[i] >= 0)
 		{
-			// Ѵٸ assimp_str ش texture θ ´.
-			assimp_mat->GetTexture(aiTextureType_DIFFUSE, 0, &assimp_str);
-
-			// assimp_str base_folder ܵ ä  ,
-			//   θ ߰  θ ϼش.
-			std_str.reserve(base_folder_len + 1 + assimp_str.length);
-			std_str.assign(base_folder);
-			std_str.append("/");
-			std_str.append(assimp_str.C_Str());
-
-			// ش  ̹ ̹ ҷԴ ȮѴ.
-			auto ret = path_texture_map.find(std_str);
-
-			ImageInfo info;
-			if (ret == path_texture_map.end())
-			{
-				//  ̹ ó ҷ ̹Ƿ stbi  file memory ̹ ø, GPU ø.
-				clock_t intense_start, intense_end;
-				intense_start = clock();
-
-				// image memory ø
-				unsigned char* data = stbi_load(std_str.c_str(), &info.width, &info.height, &info.comp, 0);
-				intense_end = clock();
-				printf("stbi load %f\n", (float)(intense_end - intense_start) / CLOCKS_PER_SEC);
-
-				intense_start = clock();
-
-				// ش cpu memory gpu memory ø
-				info.gl_id = gl_load_model_texture(data, info.width, info.height, info.comp);
-				intense_end = clock();
-				printf("GPU upload %f\n", (float)(intense_end - intense_start) / CLOCKS_PER_SEC);
-
-				// map key/value ߰
-				path_texture_map[std_str] = info;
-				intense_start = clock();
-				
-				// gpu ÷Ƿ cpu ޸ 
-				stbi_image_free(data);
-				intense_end = clock();
-				printf("stbi image free %f\n", (float)(intense_end - intense_start) / CLOCKS_PER_SEC);
-			}
-			else
-			{
-				// ش  ̹  ҷǷ   ´
-				info = ret->second;
-			}
+			const ImageInfo& info = images[diffuse_images[i]];
 
 			// gpu ö diffuse texture id ־ش.
 			model_mat->gl_diffuse = info.gl_id;
@@ -611,44 +1466,9 @@ void process_scene_material(const aiScene* scene, const char* base_folder)
 			}
 		}
 
-		if (unsigned texture_count = assimp_mat->GetTextureCount(aiTextureType_NORMALS))
+		if (normal_images[i] >= 0)
 		{
-			assimp_mat->GetTexture(aiTextureType_NORMALS, 0, &assimp_str);
-
-			std_str.reserve(base_folder_len + 1 + assimp_str.length);
-			std_str.assign(base_folder);
-			std_str.append("/");
-			std_str.append(assimp_str.C_Str());
-
-			auto ret = path_texture_map.find(std_str);
-
-			ImageInfo info;
-			if (ret == path_texture_map.end())
-			{
-				clock_t intense_start, intense_end;
-
-				intense_start = clock();
-				unsigned char* data = stbi_load(std_str.c_str(), &info.width, &info.height, &info.comp, 0);
-				intense_end = clock();
-
-				printf("stbi load %f\n", (float)(intense_end - intense_start) / CLOCKS_PER_SEC);
-
-				intense_start = clock();
-				info.gl_id = gl_load_model_texture(data, info.width, info.height, info.comp);
-				intense_end = clock();
-				printf("GPU upload %f\n", (float)(intense_end - intense_start) / CLOCKS_PER_SEC);
-
-				path_texture_map[std_str] = info;
-
-				intense_start = clock();
-				stbi_image_free(data);
-				intense_end = clock();
-				printf("stbi image free %f\n", (float)(intense_end - intense_start) / CLOCKS_PER_SEC);
-			}
-			else
-			{
-				info = ret->second;
-			}
+			const ImageInfo& info = images[normal_images[i]];
 
 			model_mat->has_normal_texture = true;
 			model_mat->gl_normal = info.gl_id;
@@ -658,8 +1478,6 @@ void process_scene_material(const aiScene* scene, const char* base_folder)
 				model_mat->is_transparent = true;
 			}
 		}
-		end = clock();
-		printf("Mat %u : Texture Processing Time %f\n", i, (float)(end - start) / CLOCKS_PER_SEC);
 
 		// lighting map  material color value lighting parameter ȸѴ.
 		constexpr float alpha_threshold = 0.0001f;
@@ -720,7 +1538,150 @@ void process_scene_material(const aiScene* scene, const char* base_folder)
 		{
 			model_mat->two_sided = is_two_sided;
 		}
+
+		// glTF alphaMode MASK blending  alpha cutoff fragment .
+		aiString alpha_mode;
+		if (AI_SUCCESS == assimp_mat->Get(AI_MATKEY_GLTF_ALPHAMODE, alpha_mode) && strcmp(alpha_mode.C_Str(), "MASK") == 0)
+		{
+			model_mat->is_alpha_test = true;
+			model_mat->is_transparent = false;
+
+			float alpha_cutoff;
+			if (AI_SUCCESS == assimp_mat->Get(AI_MATKEY_GLTF_ALPHACUTOFF, alpha_cutoff))
+			{
+				model_mat->alpha_cutoff = alpha_cutoff;
+			}
+		}
+
+		model_mat->shader_features = material_shader_features(model_mat);
+	}
+}
+
+void mesh_upload(Mesh* mesh)
+{
+	if (mesh->residency == MESH_RESIDENCY_CPU_ONLY)
+	{
+		return;
+	}
+
+	MeshGPUData* gpu = &(mesh->gpu);
+	const MeshCPUData* cpu = &(mesh->cpu);
+
+	// skinning ϴ mesh position/normal/tangent pose ٲ  ٽ .
+	const GLenum skinned_usage = mesh->skin_index >= 0 ? GL_STREAM_DRAW : GL_STATIC_DRAW;
+	glGenBuffers(MESH_VBO_COUNT, gpu->vbos);
+	glGenBuffers(1, &(gpu->ibo));
+	glGenVertexArrays(1, &(gpu->vao));
+
+	glBindVertexArray(gpu->vao);
+
+	glEnableVertexAttribArray(0);
+	glEnableVertexAttribArray(1);
+	glEnableVertexAttribArray(2);
+	glEnableVertexAttribArray(3);
+
+	glBindBuffer(GL_ARRAY_BUFFER, gpu->vbos[0]);
+	glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, sizeof(float) * 4, (void*)0);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(float)* cpu->position.size(), cpu->position.data(), skinned_usage);
+
+	glBindBuffer(GL_ARRAY_BUFFER, gpu->vbos[1]);
+	glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(float) * 3, (void*)0);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(float)* cpu->normal.size(), cpu->normal.data(), skinned_usage);
+
+	glBindBuffer(GL_ARRAY_BUFFER, gpu->vbos[2]);
+	glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, sizeof(float) * 3, (void*)0);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(float)* cpu->tangent.size(), cpu->tangent.data(), skinned_usage);
+
+	glBindBuffer(GL_ARRAY_BUFFER, gpu->vbos[3]);
+	glVertexAttribPointer(3, 2, GL_FLOAT, GL_FALSE, sizeof(float) * 2, (void*)0);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(float)* cpu->uv.size(), cpu->uv.data(), GL_STATIC_DRAW);
+
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, gpu->ibo);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(uint32_t)* cpu->indices.size(), cpu->indices.data(), GL_STATIC_DRAW);
+
+	memory_tracker_gpu_set(GPU_MEMORY_BUFFER, gpu->vbos[0], sizeof(float) * cpu->position.size());
+	memory_tracker_gpu_set(GPU_MEMORY_BUFFER, gpu->vbos[1], sizeof(float) * cpu->normal.size());
+	memory_tracker_gpu_set(GPU_MEMORY_BUFFER, gpu->vbos[2], sizeof(float) * cpu->tangent.size());
+	memory_tracker_gpu_set(GPU_MEMORY_BUFFER, gpu->vbos[3], sizeof(float) * cpu->uv.size());
+	memory_tracker_gpu_set(GPU_MEMORY_BUFFER, gpu->ibo, sizeof(uint32_t) * cpu->indices.size());
+
+	// GPU skinning joint index(uvec4) weight(0~255 0~1).   8 byte ٿ ø.
+	if (mesh->skin_index >= 0)
+	{
+		const SkinnedMesh* skinned_mesh = &(g_animation.skinned_meshes[mesh->skin_index]);
+		const size_t skin_size = sizeof(uint8_t) * SKIN_MAX_INFLUENCES * 2 * skinned_mesh->vertex_count;
+		std::vector<uint8_t> skin(skin_size);
+		for (unsigned v = 0; v < skinned_mesh->vertex_count; ++v)
+		{
+			memcpy(&(skin[v * SKIN_MAX_INFLUENCES * 2]), &(skinned_mesh->joints[v * SKIN_MAX_INFLUENCES]), SKIN_MAX_INFLUENCES);
+			memcpy(&(skin[v * SKIN_MAX_INFLUENCES * 2 + SKIN_MAX_INFLUENCES]), &(skinned_mesh->weights[v * SKIN_MAX_INFLUENCES]), SKIN_MAX_INFLUENCES);
+		}
+
+		glBindBuffer(GL_ARRAY_BUFFER, gpu->vbos[4]);
+		glBufferData(GL_ARRAY_BUFFER, skin_size, skin.data(), GL_STATIC_DRAW);
+		memory_tracker_gpu_set(GPU_MEMORY_BUFFER, gpu->vbos[4], skin_size);
+
+		glEnableVertexAttribArray(8);
+		glVertexAttribIPointer(8, 4, GL_UNSIGNED_BYTE, SKIN_MAX_INFLUENCES * 2, (void*)0);
+		glEnableVertexAttribArray(9);
+		glVertexAttribPointer(9, 4, GL_UNSIGNED_BYTE, GL_TRUE, SKIN_MAX_INFLUENCES * 2, (void*)SKIN_MAX_INFLUENCES);
+
+		// instance world matrix  indirect draw base_instanceŭ offset ȴ.
+		glBindBuffer(GL_ARRAY_BUFFER, g_model.instance_pose_buffer);
+		glEnableVertexAttribArray(10);
+		glVertexAttribIPointer(10, 1, GL_UNSIGNED_INT, sizeof(GLuint), (void*)0);
+		glVertexAttribDivisor(10, 1);
+	}
+
+	// mat4 attribute vec4 4 location Ѵ.
+	// divisor 1̹Ƿ instance ϳ , indirect draw base_instanceŭ offset ȴ.
+	glBindBuffer(GL_ARRAY_BUFFER, g_model.instance_buffer);
+	for (GLuint column = 0; column < 4; ++column)
+	{
+		glEnableVertexAttribArray(4 + column);
+		glVertexAttribPointer(4 + column, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4), (void*)(sizeof(glm::vec4) * column));
+		glVertexAttribDivisor(4 + column, 1);
+	}
+	glBindVertexArray(0);
+}
+
+void mesh_release_cpu_data(Mesh* mesh)
+{
+	// clear capacity Ƿ  vector ٲ㼭 memory ش.
+	MeshCPUData empty;
+	std::swap(mesh->cpu, empty);
+}
+
+void mesh_release_gpu_data(Mesh* mesh)
+{
+	MeshGPUData* gpu = &(mesh->gpu);
+	if (gpu->vao == 0)
+	{
+		return;
+	}
+
+	for (int i = 0; i < MESH_VBO_COUNT; ++i)
+	{
+		memory_tracker_gpu_release(GPU_MEMORY_BUFFER, gpu->vbos[i]);
+	}
+	memory_tracker_gpu_release(GPU_MEMORY_BUFFER, gpu->ibo);
+
+	glDeleteVertexArrays(1, &(gpu->vao));
+	glDeleteBuffers(MESH_VBO_COUNT, gpu->vbos);
+	glDeleteBuffers(1, &(gpu->ibo));
+	memset(gpu, 0, sizeof(MeshGPUData));
+}
+
+std::vector<GPUCullingMesh> model_culling_meshes()
+{
+	std::vector<GPUCullingMesh> culling_meshes(g_model.mesh.size());
+	for (size_t i = 0; i < g_model.mesh.size(); ++i)
+	{
+		culling_meshes[i].aabb_min = glm::vec4(g_model.mesh[i].aabb_min, 1.0f);
+		culling_meshes[i].aabb_max = glm::vec4(g_model.mesh[i].aabb_max, 1.0f);
+		culling_meshes[i].draw = glm::uvec4(g_model.mesh[i].gpu.vao != 0 ? g_model.mesh[i].index_count : 0, 0, 0, 0);
 	}
+	return culling_meshes;
 }
 
 void model_init()
@@ -739,12 +1700,13 @@ void model_init()
 		glBindTexture(GL_TEXTURE_2D, g_default_texture_white);
 		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, white);
 		glGenerateMipmap(GL_TEXTURE_2D);
+		memory_tracker_gpu_set(GPU_MEMORY_TEXTURE, g_default_texture_white, sizeof(white));
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
-		g_light.rot_euler = INITIAL_LIGHT_ROT_EULER;
+		g_light.transform = transform_create(glm::vec3(0.f), INITIAL_LIGHT_ROT_EULER, glm::vec3(1.f));
 		g_light.ambient = INITIAL_LIGHT_AMBIENT;
 		g_light.diffuse = INITIAL_LIGHT_DIFFUSE;
 		g_light.specular = INITIAL_LIGHT_SPECULAR;
@@ -758,10 +1720,16 @@ void model_init()
 		g_default_material.two_sided = false;
 		g_default_material.gl_diffuse = g_default_texture_white;
 		g_default_material.has_normal_texture = false;
+		g_default_material.is_alpha_test = false;
+		g_default_material.alpha_cutoff = INITIAL_MATERIAL_ALPHA_CUTOFF;
+		g_default_material.shader_features = material_shader_features(&g_default_material);
 
-		g_model.scale = INITIAL_MODEL_SCALE;
-		g_model.position = INITIAL_MODEL_POSITION;
-		g_model.rot_euler = INITIAL_MODEL_ROTATION;
+		g_model.transform = transform_create(INITIAL_MODEL_POSITION, INITIAL_MODEL_ROTATION, INITIAL_MODEL_SCALE);
+		g_model.instance_count = INITIAL_INSTANCE_COUNT;
+		g_model.instance_built_count = 0;
+		g_model.skinned_pose_version = 0;
+		g_model.instance_built_pose_count = 0;
+		g_model.bone_palette_version = 0;
 
 		// Model Data Handling with Assimp
 		{
@@ -770,6 +1738,9 @@ void model_init()
 			// severity verbose / debuggin / normal  츮 α     ִ.
 			Assimp::Logger::LogSeverity severity = Assimp::Logger::VERBOSE;
 
+			// assimp allocator ٲ  Ƿ, ҷ  operator new assimp tag .
+			const int last_tag = memory_tag_begin(MEMORY_TAG_ASSIMP);
+
 			// stdout logger ϰ ؼ 츮 ܼâ ߰ ش.
 			Assimp::DefaultLogger::create("", severity, aiDefaultLogStream_STDOUT);
 
@@ -796,6 +1767,7 @@ void model_init()
 				assert(false);
 			}
 			end = clock();
+			memory_tag_end(last_tag);
 
 			printf("Assimp Read Time %f seconds\n", (float)(end - start) / CLOCKS_PER_SEC);
 
@@ -822,188 +1794,457 @@ void model_init()
 				printf("Assimp Process Scene Mesh Time %f seconds\n", (float)(end - start) / CLOCKS_PER_SEC);
 			}
 
+			{
+				start = clock();
+
+				// node hierarchy, animation clip, bone weight animation   ű.
+				const int last_tag = memory_tag_begin(MEMORY_TAG_ANIMATION);
+				std::vector<int> mesh_node_indices;
+				process_scene_skeleton(scene, &mesh_node_indices);
+				process_scene_animation(scene);
+				process_scene_skin(scene, mesh_node_indices);
+				memory_tag_end(last_tag);
+				animation_init();
+
+				// GPU skinning palette texture buffer ϳ  ϹǷ character  Ѵ.
+				GLint max_texture_buffer_size = 0;
+				glGetIntegerv(GL_MAX_TEXTURE_BUFFER_SIZE, &max_texture_buffer_size);
+				if (g_animation.palette_stride > 0)
+				{
+					g_animation.max_instance_pose_count = std::max(1, (int)(max_texture_buffer_size / (g_animation.palette_stride * 3)));
+					if (g_animation.instance_pose_count > g_animation.max_instance_pose_count)
+					{
+						printf("Skinning poses are limited to %d by GL_MAX_TEXTURE_BUFFER_SIZE\n", g_animation.max_instance_pose_count);
+						g_animation.instance_pose_count = g_animation.max_instance_pose_count;
+						animation_evaluate();
+					}
+				}
+
+				end = clock();
+				printf("Assimp Process Scene Animation Time %f seconds\n", (float)(end - start) / CLOCKS_PER_SEC);
+			}
+
 			//  ̻ θ Ƿ logger Ⱦϱ 
 			Assimp::DefaultLogger::kill();
 		}
+
+		// instance grid  model ü AABB XZ ũ⸦  ´.
+		glm::vec3 model_aabb_min(FLT_MAX);
+		glm::vec3 model_aabb_max(-FLT_MAX);
+		for (const Mesh& mesh : g_model.mesh)
+		{
+			model_aabb_min = glm::min(model_aabb_min, mesh.aabb_min);
+			model_aabb_max = glm::max(model_aabb_max, mesh.aabb_max);
+		}
+		glm::vec3 model_extent = model_aabb_max - model_aabb_min;
+		g_model.instance_spacing = std::max(model_extent.x, model_extent.z) * 1.5f;
+		g_model.bounding_center = (model_aabb_min + model_aabb_max) * 0.5f;
+		g_model.bounding_radius = glm::length(model_extent) * 0.5f;
 	}
 
 	{
 		//  ۴µ  ̴ ҷͼ pso Ѵ.
-		std::vector<char> shader_source;
-
-		file_open_fill_buffer("model_shader.vert", shader_source);
-		GLuint vso = glCreateShader(GL_VERTEX_SHADER);
-		gl_validate_shader(vso, (const char*)shader_source.data());
-		g_model.shader_vertex = vso;
-
-		file_open_fill_buffer("model_shader.frag", shader_source);
-		GLuint fso = glCreateShader(GL_FRAGMENT_SHADER);
-		gl_validate_shader(fso, (const char*)shader_source.data());
-		g_model.shader_frag = fso;
-
-		GLuint pso = glCreateProgram();
-		gl_validate_program(pso, vso, fso);
-		g_model.pso = pso;
-
-		// ش ̴ uniform ġ ̸ ã Ѵ.
-		g_model.loc_world_mat = glGetUniformLocation(pso, "world_mat");
-		g_model.loc_view_mat = glGetUniformLocation(pso, "view_mat");
-		g_model.loc_projection_mat = glGetUniformLocation(pso, "projection_mat");
-		g_model.loc_is_use_tangent = glGetUniformLocation(pso, "is_use_tangent");
-		g_model.loc_cam_pos = glGetUniformLocation(pso, "cam_pos");
-		g_model.loc_sun_dir = glGetUniformLocation(pso, "sun_dir");
-		g_model.loc_sun_ambient = glGetUniformLocation(pso, "sun_ambient");
-		g_model.loc_sun_diffuse = glGetUniformLocation(pso, "sun_diffuse");
-		g_model.loc_sun_specular = glGetUniformLocation(pso, "sun_specular");
-		g_model.loc_diffuse_texture = glGetUniformLocation(pso, "diffuse_texture");
-		g_model.loc_normal_texture = glGetUniformLocation(pso, "normal_texture");
-		g_model.loc_mat_ambient = glGetUniformLocation(pso, "mat_ambient");
-		g_model.loc_mat_diffuse = glGetUniformLocation(pso, "mat_diffuse");
-		g_model.loc_mat_specular = glGetUniformLocation(pso, "mat_specular");
-		g_model.loc_mat_shininess = glGetUniformLocation(pso, "mat_shininess");
-
-		//  Mesh  GL Buffers Ѵ.
-		constexpr size_t BUFFER_COUNT = 5; // VBO + IBO
-		constexpr size_t VBO_COUNT = 4;
-		const size_t mesh_count = g_model.mesh.size();
-		g_model.vbos.reserve(VBO_COUNT * mesh_count);
-		g_model.ibos.reserve(mesh_count);
-		g_model.vaos.reserve(mesh_count);
+		// variant ʿ  compileǹǷ ⼭ source од.
+		shader_permutation_system_init();
+		shader_permutation_init(&g_model.shader, "model_shader", "model_shader.vert", "model_shader.frag",
+			MODEL_SHADER_DEFINES, MODEL_SHADER_FEATURE_COUNT);
+
+		ModelProgram empty_program;
+		memset(&empty_program, 0, sizeof(ModelProgram));
+		g_model.programs.assign(g_model.shader.variants.size(), empty_program);
+
+		// material  variant ̸ ûؼ,
+		// parallel compile ϴ ̹ ε  ÿ compile ǰ Ѵ.
+		shader_permutation_request(&g_model.shader, g_default_material.shader_features);
+		for (const Material& mat : g_model.material)
+		{
+			shader_permutation_request(&g_model.shader, mat.shader_features);
+		}
+		if (g_animation.skinning_mode == SKINNING_MODE_GPU)
+		{
+			for (const SkinnedMesh& skinned_mesh : g_animation.skinned_meshes)
+			{
+				const int material_index = g_model.mesh[skinned_mesh.mesh_index].material_index;
+				const Material* mat = material_index >= 0 ? &(g_model.material[material_index]) : &(g_default_material);
+				shader_permutation_request(&g_model.shader, mat->shader_features | MODEL_SHADER_SKINNING);
+			}
+		}
+
+		// instance world matrix buffer.  ʹ model_draw instance ٲ  ø.
+		// mesh VAO  buffer ŰǷ mesh  .
+		const glm::mat4 instance_identity(1.0f);
+		glGenBuffers(1, &(g_model.instance_buffer));
+		glBindBuffer(GL_ARRAY_BUFFER, g_model.instance_buffer);
+		glBufferData(GL_ARRAY_BUFFER, sizeof(glm::mat4), &(instance_identity[0][0]), GL_DYNAMIC_DRAW);
+		memory_tracker_gpu_set(GPU_MEMORY_BUFFER, g_model.instance_buffer, sizeof(glm::mat4));
+
+		// instance pose index. instancing    pose 0 е ϳ äд.
+		const GLuint first_pose = 0;
+		glGenBuffers(1, &(g_model.instance_pose_buffer));
+		glBindBuffer(GL_ARRAY_BUFFER, g_model.instance_pose_buffer);
+		glBufferData(GL_ARRAY_BUFFER, sizeof(GLuint), &first_pose, GL_DYNAMIC_DRAW);
+		memory_tracker_gpu_set(GPU_MEMORY_BUFFER, g_model.instance_pose_buffer, sizeof(GLuint));
+
+		// GPU skinning palette.  ʹ pose ٲ  ø.
+		glGenBuffers(1, &(g_model.bone_palette_buffer));
+		glGenTextures(1, &(g_model.bone_palette_texture));
+		glBindBuffer(GL_TEXTURE_BUFFER, g_model.bone_palette_buffer);
+		glBufferData(GL_TEXTURE_BUFFER, sizeof(SkinMatrix), NULL, GL_STREAM_DRAW);
+		glBindTexture(GL_TEXTURE_BUFFER, g_model.bone_palette_texture);
+		glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, g_model.bone_palette_buffer);
+		glBindTexture(GL_TEXTURE_BUFFER, 0);
+		glBindBuffer(GL_TEXTURE_BUFFER, 0);
+		memory_tracker_gpu_set(GPU_MEMORY_BUFFER, g_model.bone_palette_buffer, sizeof(SkinMatrix));
+
+		//  Mesh  GL Buffers ϰ, residency  CPU 迭 Ѵ.
+		for (Mesh& mesh : g_model.mesh)
+		{
+			mesh_upload(&mesh);
+			if (mesh.residency == MESH_RESIDENCY_GPU_ONLY)
+			{
+				mesh_release_cpu_data(&mesh);
+			}
+		}
+	}
+
+	{
+		// compute shader  frustum/occlusion culling غ
+		gpu_culling_init();
+
+		gpu_culling_set_meshes(model_culling_meshes(), g_model.instance_count);
+	}
+}
+
+void model_terminate()
+{
+	gpu_culling_terminate();
+
+	//   .
+	for (Mesh& mesh : g_model.mesh)
+	{
+		mesh_release_gpu_data(&mesh);
+	}
+	animation_terminate();
+	glDeleteTextures(1, &(g_model.bone_palette_texture));
+	memory_tracker_gpu_release(GPU_MEMORY_BUFFER, g_model.bone_palette_buffer);
+	glDeleteBuffers(1, &(g_model.bone_palette_buffer));
+	memory_tracker_gpu_release(GPU_MEMORY_BUFFER, g_model.instance_pose_buffer);
+	glDeleteBuffers(1, &(g_model.instance_pose_buffer));
+	memory_tracker_gpu_release(GPU_MEMORY_BUFFER, g_model.instance_buffer);
+	glDeleteBuffers(1, &(g_model.instance_buffer));
+	shader_permutation_terminate(&g_model.shader);
+}
+
+void model_update_instances(const Transform* model_transform)
+{
+	// physics  ִٸ body   ٽ .  ִٸ 0 Ѵ.
+	const unsigned physics_version = g_physics.is_enable ? g_physics.version : 0;
+	const bool is_layout_changed = g_model.instance_built_count != g_model.instance_count ||
+		g_model.instance_built_spacing != g_model.instance_spacing ||
+		g_model.instance_built_version != model_transform->version;
+	const bool is_pose_changed = g_model.instance_built_pose_count != g_animation.instance_pose_count;
+	if (!is_layout_changed && !is_pose_changed && g_model.instance_built_physics_version == physics_version)
+	{
+		return;
+	}
+
+	const int instance_count = g_model.instance_count;
+	g_model.instance_world.resize(instance_count);
+	if (g_physics.is_enable)
+	{
+		// ġ ٲٸ  grid ٽ ߸.
+		const float model_scale = std::max(model_transform->scale.x, std::max(model_transform->scale.y, model_transform->scale.z));
+		if (is_layout_changed || g_physics.body_count != instance_count)
+		{
+			physics_reset_grid(instance_count, g_model.instance_spacing, g_model.bounding_radius * model_scale);
+		}
+
+		// model bounding sphere ߽  ű   body transform Ѵ.
+		const glm::vec3 world_center = glm::vec3(model_transform->world * glm::vec4(g_model.bounding_center, 1.f));
+		const glm::mat4 body_local = glm::translate(glm::mat4(1.0f), -world_center) * model_transform->world;
+		parallel_for_range(instance_count, PHYSICS_BATCH_SIZE, [&body_local](int begin, int end)
+		{
+			for (int i = begin; i < end; ++i)
+			{
+				g_model.instance_world[i] = physics_body_matrix(i) * body_local;
+			}
+		});
+	}
+	else
+	{
+		// instance  ߽  簢 grid ġѴ.
+		const int grid_side = (int)ceil(sqrt((double)instance_count));
+		const float grid_half = (grid_side - 1) * 0.5f;
+		for (int i = 0; i < instance_count; ++i)
+		{
+			glm::vec3 offset(((i % grid_side) - grid_half) * g_model.instance_spacing,
+							 0.0f,
+							 ((i / grid_side) - grid_half) * g_model.instance_spacing);
+			g_model.instance_world[i] = glm::translate(glm::mat4(1.0f), offset) * model_transform->world;
+		}
+	}
+
+	glBindBuffer(GL_ARRAY_BUFFER, g_model.instance_buffer);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(glm::mat4) * instance_count, g_model.instance_world.data(), GL_DYNAMIC_DRAW);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	memory_tracker_gpu_set(GPU_MEMORY_BUFFER, g_model.instance_buffer, sizeof(glm::mat4) * instance_count);
+
+	if (is_layout_changed || is_pose_changed)
+	{
+		// ̿ instance  ٸ pose  ư ش.
+		const int pose_count = g_animation.instance_pose_count;
+		FrameVector<GLuint> instance_poses(instance_count);
+		for (int i = 0; i < instance_count; ++i)
+		{
+			instance_poses[i] = (GLuint)(i % pose_count);
+		}
+		glBindBuffer(GL_ARRAY_BUFFER, g_model.instance_pose_buffer);
+		glBufferData(GL_ARRAY_BUFFER, sizeof(GLuint) * instance_count, instance_poses.data(), GL_DYNAMIC_DRAW);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		memory_tracker_gpu_set(GPU_MEMORY_BUFFER, g_model.instance_pose_buffer, sizeof(GLuint) * instance_count);
+
+		// pose p ó  instance ġ  character animation LOD Ѵ.
+		const int character_count = std::min(pose_count, instance_count);
+		FrameVector<glm::vec3> character_positions(character_count);
+		for (int i = 0; i < character_count; ++i)
+		{
+			character_positions[i] = glm::vec3(g_model.instance_world[i][3]);
+		}
+		animation_graph_set_positions(character_positions.data(), character_count);
+	}
+
+	// instance  command buffer capacity Ѿٸ culling  buffer ÷ش.
+	if ((unsigned)instance_count > g_gpu_culling.instance_capacity)
+	{
+		gpu_culling_set_meshes(model_culling_meshes(), instance_count);
+	}
 
-		for (const Mesh& mesh : g_model.mesh)
-		{
-			// pos / normal / tangent / uv / indicies
-			GLuint buffers[BUFFER_COUNT] = { 0,0,0,0,0 };
-			glGenBuffers(BUFFER_COUNT, buffers);
+	g_model.instance_built_count = instance_count;
+	g_model.instance_built_spacing = g_model.instance_spacing;
+	g_model.instance_built_physics_version = g_physics.is_enable ? g_physics.version : 0;
+	g_model.instance_built_version = model_transform->version;
+	g_model.instance_built_pose_count = g_animation.instance_pose_count;
+}
 
-			g_model.vbos.push_back(buffers[0]);
-			g_model.vbos.push_back(buffers[1]);
-			g_model.vbos.push_back(buffers[2]);
-			g_model.vbos.push_back(buffers[3]);
+ModelProgram* model_get_program(unsigned feature_mask)
+{
+	ModelProgram* program = &(g_model.programs[feature_mask]);
+	if (program->pso != 0)
+	{
+		return program;
+	}
 
-			g_model.ibos.push_back(buffers[4]);
+	// ó ̴ variant ( compile ̸ ٷ) program  uniform ġ ã Ѵ.
+	// variant   ʴ uniform -1 ǰ, glUniform* -1 Ѵ.
+	const ShaderVariant* variant = shader_permutation_get(&g_model.shader, feature_mask);
+	GLuint pso = variant->pso;
+	program->pso = pso;
+
+	// ó   version  ø  version д.
+	program->world_version = UINT_MAX;
+	program->light_transform_version = UINT_MAX;
+	program->light_version = UINT_MAX;
+	program->loc_world_mat = glGetUniformLocation(pso, "world_mat");
+	program->loc_sun_dir = glGetUniformLocation(pso, "sun_dir");
+	program->loc_sun_ambient = glGetUniformLocation(pso, "sun_ambient");
+	program->loc_sun_diffuse = glGetUniformLocation(pso, "sun_diffuse");
+	program->loc_sun_specular = glGetUniformLocation(pso, "sun_specular");
+	program->loc_diffuse_texture = glGetUniformLocation(pso, "diffuse_texture");
+	program->loc_normal_texture = glGetUniformLocation(pso, "normal_texture");
+	program->loc_mat_ambient = glGetUniformLocation(pso, "mat_ambient");
+	program->loc_mat_diffuse = glGetUniformLocation(pso, "mat_diffuse");
+	program->loc_mat_specular = glGetUniformLocation(pso, "mat_specular");
+	program->loc_mat_shininess = glGetUniformLocation(pso, "mat_shininess");
+	program->loc_mat_alpha_cutoff = glGetUniformLocation(pso, "mat_alpha_cutoff");
+	program->loc_bone_palette = glGetUniformLocation(pso, "bone_palette");
+	program->loc_bone_base = glGetUniformLocation(pso, "bone_base");
+	program->loc_palette_stride = glGetUniformLocation(pso, "palette_stride");
+
+	// view/projection/camera position frame    ä camera UBO д´.
+	GLuint camera_block = glGetUniformBlockIndex(pso, "CameraBlock");
+	if (camera_block != GL_INVALID_INDEX)
+	{
+		glUniformBlockBinding(pso, camera_block, CAMERA_UBO_BINDING);
+	}
 
-			GLuint vao;
-			glGenVertexArrays(1, &vao);
-			g_model.vaos.push_back(vao);
+	return program;
+}
 
-			glBindVertexArray(vao);
+void model_upload_bone_palettes()
+{
+	if (g_model.bone_palette_version == g_animation.pose_version)
+	{
+		return;
+	}
+	g_model.bone_palette_version = g_animation.pose_version;
+
+	// ° ٽ Ҵؼ  frame draw а ִ storage ٸ ʴ´.
+	const size_t palette_size = sizeof(SkinMatrix) * g_animation.gpu_palettes.size();
+	glBindBuffer(GL_TEXTURE_BUFFER, g_model.bone_palette_buffer);
+	glBufferData(GL_TEXTURE_BUFFER, palette_size, g_animation.gpu_palettes.data(), GL_STREAM_DRAW);
+	glBindBuffer(GL_TEXTURE_BUFFER, 0);
+	memory_tracker_gpu_set(GPU_MEMORY_BUFFER, g_model.bone_palette_buffer, palette_size);
+}
 
-			glEnableVertexAttribArray(0);
-			glEnableVertexAttribArray(1);
-			glEnableVertexAttribArray(2);
-			glEnableVertexAttribArray(3);
+void model_skin_meshes()
+{
+	// GPU skinning palette ø, VBO bind pose(version 0) ־ Ѵ.
+	const bool is_gpu_skinning = g_animation.skinning_mode == SKINNING_MODE_GPU;
+	if (is_gpu_skinning && !g_animation.skinned_meshes.empty())
+	{
+		model_upload_bone_palettes();
+	}
 
-			glBindBuffer(GL_ARRAY_BUFFER, buffers[0]);
-			glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, sizeof(float) * 4, (void*)0);
-			glBufferData(GL_ARRAY_BUFFER, sizeof(float)* mesh.position.size(), mesh.position.data(), GL_STATIC_DRAW);
+	//  ִٸ  skinning  ״ .
+	const unsigned target_version = is_gpu_skinning ? 0 : g_animation.pose_version;
+	if (g_model.skinned_pose_version == target_version)
+	{
+		return;
+	}
+	g_model.skinned_pose_version = target_version;
 
-			glBindBuffer(GL_ARRAY_BUFFER, buffers[1]);
-			glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(float) * 3, (void*)0);
-			glBufferData(GL_ARRAY_BUFFER, sizeof(float)* mesh.normal.size(), mesh.normal.data(), GL_STATIC_DRAW);
+	// CPU skinning GPU skinning ٲٸ identity palette skinning ؼ bind pose ǵ ´.
+	FrameVector<SkinMatrix> identity_palette;
+	if (is_gpu_skinning)
+	{
+		SkinMatrix identity = {};
+		identity.rows[0][0] = identity.rows[1][1] = identity.rows[2][2] = 1.f;
+		identity_palette.assign(SKIN_MAX_BONES, identity);
+	}
 
-			glBindBuffer(GL_ARRAY_BUFFER, buffers[2]);
-			glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, sizeof(float) * 3, (void*)0);
-			glBufferData(GL_ARRAY_BUFFER, sizeof(float)* mesh.tangent.size(), mesh.tangent.data(), GL_STATIC_DRAW);
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	unsigned skinned_vertex_count = 0;
+	for (const SkinnedMesh& skinned_mesh : g_animation.skinned_meshes)
+	{
+		const Mesh& mesh = g_model.mesh[skinned_mesh.mesh_index];
+		if (mesh.gpu.vao == 0)
+		{
+			continue;
+		}
 
-			glBindBuffer(GL_ARRAY_BUFFER, buffers[3]);
-			glVertexAttribPointer(3, 2, GL_FLOAT, GL_FALSE, sizeof(float) * 2, (void*)0);
-			glBufferData(GL_ARRAY_BUFFER, sizeof(float)* mesh.uv.size(), mesh.uv.data(), GL_STATIC_DRAW);
+		//   ʿ Ƿ invalidate map ؼ GPU а ִ buffer ٸ ʰ ϰ,
+		// job map  memory ٷ .
+		const GLbitfield map_flags = GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT;
+		const GLsizeiptr vec4_size = sizeof(float) * 4 * skinned_mesh.vertex_count;
+		const GLsizeiptr vec3_size = sizeof(float) * 3 * skinned_mesh.vertex_count;
+		SkinningOutput output;
+		glBindBuffer(GL_ARRAY_BUFFER, mesh.gpu.vbos[0]);
+		output.position = (float*)glMapBufferRange(GL_ARRAY_BUFFER, 0, vec4_size, map_flags);
+		glBindBuffer(GL_ARRAY_BUFFER, mesh.gpu.vbos[1]);
+		output.normal = (float*)glMapBufferRange(GL_ARRAY_BUFFER, 0, vec3_size, map_flags);
+		glBindBuffer(GL_ARRAY_BUFFER, mesh.gpu.vbos[2]);
+		output.tangent = (float*)glMapBufferRange(GL_ARRAY_BUFFER, 0, vec3_size, map_flags);
+
+		if (output.position != NULL && output.normal != NULL && output.tangent != NULL)
+		{
+			skinning_cpu(&skinned_mesh, is_gpu_skinning ? identity_palette.data() : skinned_mesh.palette.data(), &output);
+			skinned_vertex_count += skinned_mesh.vertex_count;
+		}
+		else
+		{
+			printf("Fail to map skinned mesh buffers\n");
+		}
 
-			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffers[4]);
-			glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(uint32_t)* mesh.indices.size(), mesh.indices.data(), GL_STATIC_DRAW);
+		for (int i = 0; i < 3; ++i)
+		{
+			glBindBuffer(GL_ARRAY_BUFFER, mesh.gpu.vbos[i]);
+			glUnmapBuffer(GL_ARRAY_BUFFER);
 		}
 	}
-}
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
 
-void model_terminate()
-{
-	//   .
-	glDeleteVertexArrays((GLsizei)g_model.vaos.size(), g_model.vaos.data());
-	glDeleteBuffers((GLsizei)g_model.vbos.size(), g_model.vbos.data());
-	glDeleteBuffers((GLsizei)g_model.ibos.size(), g_model.ibos.data());
-	glDeleteProgram(g_model.pso);
-	glDeleteShader(g_model.shader_frag);
-	glDeleteShader(g_model.shader_vertex);
+	g_animation.skinning_ms = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+	g_animation.skinned_vertex_count = skinned_vertex_count;
 }
 
 static bool is_sort_draw_order = true;
 void model_draw()
 {
-	assert(g_model.mesh.size() == g_model.vaos.size());
-
-	// viewport 
-	glViewport(0, 0, g_window_width, g_window_height);
+	// viewport . dynamic resolution  ִٸ framebuffer   ִ.
+	const int render_width = g_dynamic_resolution.render_width;
+	const int render_height = g_dynamic_resolution.render_height;
+	glViewport(0, 0, render_width, render_height);
 
 	// 3d rendering̹Ƿ depth test Ȱȭش.
-	glEnable(GL_DEPTH_TEST);
-
-	// model rendering  pso 
-	glUseProgram(g_model.pso);
-
-	constexpr glm::mat4 identity(1.0f);
+	gl_state_set_enable(GL_DEPTH_TEST, true);
 
 	/* 
-	* model local to world ǥ踦 ش.
+	* model local to world ǥ transform_system_update Է ٲ  ٽ .
 	*/ 
-	
-	// Rotation Order : Y -> X -> Z
-	glm::quat rot = glm::angleAxis(glm::radians(g_model.rot_euler.y), glm::vec3(0.0f, 1.0f, 0.0f)) *
-		glm::angleAxis(glm::radians(g_model.rot_euler.x), glm::vec3(1.0f, 0.0f, 0.0f)) *
-		glm::angleAxis(glm::radians(g_model.rot_euler.z), glm::vec3(0.0f, 0.0f, 1.0f));
-	glm::mat4 model_transform = glm::translate(identity, g_model.position) *
-								glm::mat4_cast(rot) *
-								glm::scale(identity, g_model.scale);
-
-	// local to world matrix / world to view matrix / view to clip matrix Ʈ ְ,
-	// lighting  position Ʈ ش.
-	glUniformMatrix4fv(g_model.loc_world_mat, 1, GL_FALSE, &(model_transform[0][0]));
-	glUniformMatrix4fv(g_model.loc_view_mat, 1, GL_FALSE, &(g_camera.view[0][0]));
-	glUniformMatrix4fv(g_model.loc_projection_mat, 1, GL_FALSE, &(g_camera.projection[0][0]));
-	glUniform3fv(g_model.loc_cam_pos, 1, &(g_camera.position[0]));
-
-	glm::quat light_rot = glm::angleAxis(glm::radians(g_light.rot_euler.y), glm::vec3(0.0f, 1.f, 0.f)) *
-		glm::angleAxis(glm::radians(g_light.rot_euler.x), glm::vec3(1.0f, 0.f, 0.f)) *
-		glm::angleAxis(glm::radians(g_light.rot_euler.z), glm::vec3(0.f, 0.f, 1.f));
-	glm::vec3 light_dir = -(glm::mat3_cast(light_rot)[2]);
-	glUniform3fv(g_model.loc_sun_dir, 1, &(light_dir[0]));
-	glUniform3fv(g_model.loc_sun_ambient, 1, &(g_light.ambient[0]));
-	glUniform3fv(g_model.loc_sun_diffuse, 1, &(g_light.diffuse[0]));
-	glUniform3fv(g_model.loc_sun_specular, 1, &(g_light.specular[0]));
-
-	// diffuse/normal texture  Texture Image Unit ̸ صд.
-	glUniform1i(g_model.loc_diffuse_texture, 0);
-	glUniform1i(g_model.loc_normal_texture, 1);
+	const Transform* model = transform_get(g_model.transform);
+
+	// instance  ̰ų GPU culling   instance buffer world matrix Ѵ.
+	const bool is_use_gpu_culling = g_gpu_culling.is_supported && g_gpu_culling.is_enable;
+	const bool is_use_instancing = is_use_gpu_culling || g_model.instance_count > 1 || g_physics.is_enable;
+	if (is_use_instancing)
+	{
+		model_update_instances(model);
+	}
+
+	// pose ٲٸ skinning ϴ mesh VBO(CPU skinning) palette(GPU skinning) ٽ ä.
+	gpu_profiler_begin("Skinning Upload");
+	model_skin_meshes();
+	gpu_profiler_end();
+
+	// compute shader instance culling ϰ Ƴ draw indirect buffer ä.
+	if (is_use_gpu_culling)
+	{
+		gpu_profiler_begin("GPU Culling");
+		gpu_culling_dispatch(g_model.instance_buffer, (unsigned)g_model.instance_count, g_camera.projection * g_camera.view);
+		gpu_profiler_end();
+	}
+
+	const Transform* light = transform_get(g_light.transform);
 
 	//  ޽ draw_order  Ѵ.
 
 	// transparent mesh rendering   opaque object   Ŀ ؾѴ.
 	//  draw_order  material transparent η opaque   ǰ,
 	//  Ŀ transparent  ǰ Ѵ.
-	g_model.draw_order.resize(g_model.mesh.size());
+	//  Mesh   ؾ    draw_orders ̹ frame Ƿ frame allocator ҴѴ.
+	FrameVector<unsigned> draw_orders(g_model.mesh.size());
 	for (unsigned i = 0; i < g_model.mesh.size(); ++i)
 	{
-		g_model.draw_order[i] = i;
+		draw_orders[i] = i;
 	}
 
 	if (is_sort_draw_order)
 	{
-		std::sort(g_model.draw_order.begin(), g_model.draw_order.end(), [](unsigned a, unsigned b) -> bool
+		std::sort(draw_orders.begin(), draw_orders.end(), [](unsigned a, unsigned b) -> bool
 			{
 				int am_index = g_model.mesh[a].material_index;
 				int bm_index = g_model.mesh[b].material_index;
 				Material* am = am_index >= 0 ? &(g_model.material[am_index]) : &(g_default_material);
 				Material* bm = bm_index >= 0 ? &(g_model.material[bm_index]) : &(g_default_material);
-				return am->is_transparent < bm->is_transparent;
+				//  transparent  ȿ shader variant  Ƽ program ȯ δ.
+				if (am->is_transparent != bm->is_transparent)
+				{
+					return am->is_transparent < bm->is_transparent;
+				}
+				return am->shader_features < bm->shader_features;
 			});
 	}
 
+	// GPU skinning palette draw  texture unit 2 д.
+	const bool is_use_gpu_skinning = g_animation.skinning_mode == SKINNING_MODE_GPU && !g_animation.skinned_meshes.empty();
+	if (is_use_gpu_skinning)
+	{
+		glActiveTexture(GL_TEXTURE2);
+		glBindTexture(GL_TEXTURE_BUFFER, g_model.bone_palette_texture);
+	}
+
+	ModelProgram* program = NULL;
 	const int mesh_count = (int)g_model.mesh.size();
 	for (int i = 0; i < mesh_count; ++i)
 	{
-		unsigned draw_order = g_model.draw_order[i];
+		unsigned draw_order = draw_orders[i];
 		const Mesh& mesh = g_model.mesh[draw_order];
-		GLuint vao = g_model.vaos[draw_order];
+
+		// CPU_ONLY mesh GL buffer Ƿ ׸ ʴ´.
+		if (mesh.gpu.vao == 0)
+		{
+			continue;
+		}
 
 		//  mehs material ´.  default material.
 		const Material* mat = &(g_model.material[mesh.material_index]);
@@ -1016,52 +2257,118 @@ void model_draw()
 			mat = &(g_default_material);
 		}
 
-		// ̿   texture, uniform data ׸ rasterization state ش.
-		glActiveTexture(GL_TEXTURE0);
-		glBindTexture(GL_TEXTURE_2D, mat->gl_diffuse);
-		glUniform3fv(g_model.loc_mat_ambient, 1, &(mat->ambient[0]));
-		glUniform3fv(g_model.loc_mat_diffuse, 1, &(mat->diffuse[0]));
-		glUniform3fv(g_model.loc_mat_specular, 1, &(mat->specular[0]));
-		glUniform1f(g_model.loc_mat_shininess, mat->shininess);
-		
-		if (mat->two_sided)
+		// material feature ´ shader variant , program ٲٸ frame  uniform ٽ Ѵ.
+		unsigned feature_mask = mat->shader_features;
+		if (is_use_instancing)
 		{
-			glDisable(GL_CULL_FACE);
+			feature_mask |= MODEL_SHADER_INSTANCING;
 		}
-		else
+		const bool is_gpu_skinned = is_use_gpu_skinning && mesh.skin_index >= 0;
+		if (is_gpu_skinned)
+		{
+			feature_mask |= MODEL_SHADER_SKINNING;
+		}
+
+		ModelProgram* mesh_program = model_get_program(feature_mask);
+		if (mesh_program != program)
+		{
+			program = mesh_program;
+			glUseProgram(program->pso);
+
+			// uniform program  Ƿ  program  ø  ٲ ͸ ٽ ø.
+			// local to world matrix Ʈ ش. view/projection matrix camera position camera UBO ִ.
+			if (program->world_version != model->version)
+			{
+				glUniformMatrix4fv(program->loc_world_mat, 1, GL_FALSE, &(model->world[0][0]));
+				program->world_version = model->version;
+			}
+
+			// light transform ũⰡ 1̹Ƿ world z ״ forward.
+			if (program->light_transform_version != light->version)
+			{
+				const glm::vec3 light_dir = -glm::vec3(light->world[2]);
+				glUniform3fv(program->loc_sun_dir, 1, &(light_dir[0]));
+				program->light_transform_version = light->version;
+			}
+
+			if (program->light_version != g_light.version)
+			{
+				glUniform3fv(program->loc_sun_ambient, 1, &(g_light.ambient[0]));
+				glUniform3fv(program->loc_sun_diffuse, 1, &(g_light.diffuse[0]));
+				glUniform3fv(program->loc_sun_specular, 1, &(g_light.specular[0]));
+				program->light_version = g_light.version;
+			}
+
+			// diffuse/normal texture  Texture Image Unit ̸ صд.
+			glUniform1i(program->loc_diffuse_texture, 0);
+			glUniform1i(program->loc_normal_texture, 1);
+			glUniform1i(program->loc_bone_palette, 2);
+			glUniform1i(program->loc_palette_stride, (GLint)g_animation.palette_stride);
+		}
+
+		if (is_gpu_skinned)
 		{
-			glEnable(GL_CULL_FACE);
+			glUniform1i(program->loc_bone_base, (GLint)g_animation.skinned_meshes[mesh.skin_index].palette_base);
 		}
 
+		// ̿   texture, uniform data ׸ rasterization state ش.
+		glActiveTexture(GL_TEXTURE0);
+		glBindTexture(GL_TEXTURE_2D, mat->gl_diffuse);
+		glUniform3fv(program->loc_mat_ambient, 1, &(mat->ambient[0]));
+		glUniform3fv(program->loc_mat_diffuse, 1, &(mat->diffuse[0]));
+		glUniform3fv(program->loc_mat_specular, 1, &(mat->specular[0]));
+		glUniform1f(program->loc_mat_shininess, mat->shininess);
+		glUniform1f(program->loc_mat_alpha_cutoff, mat->alpha_cutoff);
+		
+		gl_state_set_enable(GL_CULL_FACE, !mat->two_sided);
+
 		// transparent material̶ Ϲ blending equation ش.
 		if (mat->is_transparent)
 		{
-			glEnable(GL_BLEND);
-			glBlendEquation(GL_FUNC_ADD);
-			glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+			gl_state_set_enable(GL_BLEND, true);
+			gl_state_set_blend_equation(GL_FUNC_ADD, GL_FUNC_ADD);
+			gl_state_set_blend_func(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 		}
 		else
 		{
-			glDisable(GL_BLEND);
+			gl_state_set_enable(GL_BLEND, false);
 		}
 
-		// normal texture  ִٸ normal mapping 
-		//  unifrom data Ʈ ش.
+		// normal texture  ִٸ normal mapping  texture bind ش.
 		if (mat->has_normal_texture)
 		{
-			glUniform1i(g_model.loc_is_use_tangent, true);
 			glActiveTexture(GL_TEXTURE1);
 			glBindTexture(GL_TEXTURE_2D, mat->gl_normal);
 		}
+
+		//  VAO εϰ, mesh index   Ѵ.
+		glBindVertexArray(mesh.gpu.vao);
+
+		// GPU culling   ׷ instance  GPU Ƿ culling  instance  .
+		const unsigned draw_instance_count = is_use_instancing ? (unsigned)g_model.instance_count : 1;
+		++g_render_stats.draw_calls;
+		g_render_stats.triangles += (unsigned long long)(mesh.index_count / 3) * draw_instance_count;
+
+		if (is_use_gpu_culling)
+		{
+			gpu_culling_draw_mesh(draw_order);
+		}
+		else if (is_use_instancing)
+		{
+			glDrawElementsInstanced(GL_TRIANGLES, (GLsizei)mesh.index_count, GL_UNSIGNED_INT, 0, g_model.instance_count);
+		}
 		else
 		{
-			glUniform1i(g_model.loc_is_use_tangent, false);
+			glDrawElements(GL_TRIANGLES, (GLsizei)mesh.index_count, GL_UNSIGNED_INT, 0);
 		}
-
-		//  VAO εϰ, mesh index   Ѵ.
-		glBindVertexArray(vao);
-		glDrawElements(GL_TRIANGLES, (GLsizei)mesh.indices.size(), GL_UNSIGNED_INT, 0);
 	}
+	glBindVertexArray(0);
+
+	//   occlusion culling  ̹  depth Hi-Z pyramid .
+	// (culling ִٸ pyramid ȿȭ Ѵ.)
+	gpu_profiler_begin("Hi-Z Build");
+	gpu_culling_build_hiz(render_width, render_height, g_camera.projection * g_camera.view);
+	gpu_profiler_end();
 }
 
 struct ImguiGLBackEnd
@@ -1069,15 +2376,29 @@ struct ImguiGLBackEnd
 	GLuint shader_vertex;
 	GLuint shader_frag;
 	GLuint pso_imgui; // PipelineStateObject
+
+	// vertex/index ring buffer ϳ MAX_FRAMES_IN_FLIGHT    frame slot    .
+	// ش slot fence frame_sync_begin ̹ ٷǷ,  sync    ִ.
 	GLuint vao_ui;
 	GLuint vbo_ui;
 	GLuint ibo_ui;
+	int vtx_slot_capacity;	//   vertex 
+	int idx_slot_capacity;	//   index 
+
+	// buffer storage      map صΰ  . (  frame  map Ѵ.)
+	bool is_persistent;
+	char* vbo_mapped;
+	char* ibo_mapped;
+
 	GLuint tex_font;
 
 	GLint loc_projection;
 	GLint loc_texture;
 } g_imgui_gl;
 
+constexpr int IMGUI_INITIAL_VERTEX_CAPACITY = 1 << 15;
+constexpr int IMGUI_INITIAL_INDEX_CAPACITY = 1 << 16;
+
 void imgui_init()
 {
 	// Create Imgui Context and set color scheme
@@ -1117,10 +2438,14 @@ void imgui_init()
 	io.GetClipboardTextFn = imgui_glfw_clipboard_get;
 	io.ClipboardUserData = (void*)g_window;
 
-	// glfw callback  input imgui ޵ǰ Ѵ.
-	glfwSetScrollCallback(g_window, imgui_glfw_scroll_callback);
-	glfwSetKeyCallback(g_window, imgui_glfw_key_callback);
-	glfwSetCharCallback(g_window, imgui_glfw_char_callback);
+	// headless mode Է  ʴ´.
+	if (!g_headless.is_enable)
+	{
+		// glfw callback  input imgui ޵ǰ Ѵ.
+		glfwSetScrollCallback(g_window, imgui_glfw_scroll_callback);
+		glfwSetKeyCallback(g_window, imgui_glfw_key_callback);
+		glfwSetCharCallback(g_window, imgui_glfw_char_callback);
+	}
 
 	// initialize imgui opengl objects
 	const char* vertex_shader =
@@ -1147,50 +2472,62 @@ void imgui_init()
 		"{ "
 		"   Out_Color = Frag_Color * texture(Texture, Frag_UV.st); "
 		"}";
-	GLuint vso = glCreateShader(GL_VERTEX_SHADER);
-	glShaderSource(vso, 1, &vertex_shader, NULL);
-	glCompileShader(vso);
+	//  ࿡ ص program binary ִٸ compile  Ѵ.
+	const char* imgui_shader_sources[2] = { vertex_shader, frag_shader };
+	const uint64_t imgui_cache_key = program_cache_key(imgui_shader_sources, 2);
+	GLuint vso = 0;
+	GLuint fso = 0;
+	GLuint pso = program_cache_load(imgui_cache_key);
+	if (pso == 0)
 	{
-		GLint success;
-		glGetShaderiv(vso, GL_COMPILE_STATUS, &success);
-		if (!success)
+		vso = glCreateShader(GL_VERTEX_SHADER);
+		glShaderSource(vso, 1, &vertex_shader, NULL);
+		glCompileShader(vso);
 		{
-			char info_logs[512];
-			glGetShaderInfoLog(vso, 512, NULL, info_logs);
-			printf("Fail to Compile source : %s\n", info_logs);
-			assert(false);
+			GLint success;
+			glGetShaderiv(vso, GL_COMPILE_STATUS, &success);
+			if (!success)
+			{
+				char info_logs[512];
+				glGetShaderInfoLog(vso, 512, NULL, info_logs);
+				printf("Fail to Compile source : %s\n", info_logs);
+				assert(false);
+			}
 		}
-	}
 
-	GLuint fso = glCreateShader(GL_FRAGMENT_SHADER);
-	glShaderSource(fso, 1, &frag_shader, NULL);
-	glCompileShader(fso);
-	{
-		GLint success;
-		glGetShaderiv(fso, GL_COMPILE_STATUS, &success);
-		if (!success)
+		fso = glCreateShader(GL_FRAGMENT_SHADER);
+		glShaderSource(fso, 1, &frag_shader, NULL);
+		glCompileShader(fso);
 		{
-			char info_logs[512];
-			glGetShaderInfoLog(fso, 512, NULL, info_logs);
-			printf("Fail to Compile source : %s\n", info_logs);
-			assert(false);
+			GLint success;
+			glGetShaderiv(fso, GL_COMPILE_STATUS, &success);
+			if (!success)
+			{
+				char info_logs[512];
+				glGetShaderInfoLog(fso, 512, NULL, info_logs);
+				printf("Fail to Compile source : %s\n", info_logs);
+				assert(false);
+			}
 		}
-	}
 
-	GLuint pso = glCreateProgram();
-	glAttachShader(pso, vso);
-	glAttachShader(pso, fso);
-	glLinkProgram(pso);
-	{
-		GLint success;
-		glGetProgramiv(pso, GL_LINK_STATUS, &success);
-		if (!success)
+		pso = glCreateProgram();
+		glAttachShader(pso, vso);
+		glAttachShader(pso, fso);
+		program_cache_prepare(pso);
+		glLinkProgram(pso);
 		{
-			char info_logs[512];
-			glGetProgramInfoLog(pso, 512, NULL, info_logs);
-			printf("Fail to Compile source : %s\n", info_logs);
-			assert(false);
+			GLint success;
+			glGetProgramiv(pso, GL_LINK_STATUS, &success);
+			if (!success)
+			{
+				char info_logs[512];
+				glGetProgramInfoLog(pso, 512, NULL, info_logs);
+				printf("Fail to Compile source : %s\n", info_logs);
+				assert(false);
+			}
 		}
+
+		program_cache_save(pso, imgui_cache_key);
 	}
 
 	// Build texture atlas
@@ -1205,6 +2542,7 @@ void imgui_init()
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+	memory_tracker_gpu_set(GPU_MEMORY_TEXTURE, tex, (size_t)width * height * 4);
 	io.Fonts->SetTexID((ImTextureID)(intptr_t)tex);
 
 	g_imgui_gl.shader_vertex = vso;
@@ -1217,41 +2555,95 @@ void imgui_init()
 	g_imgui_gl.loc_texture = glGetUniformLocation(pso, "Texture");
 
 	// imgui  ʿ  غ
+	// ū mesh 16bit index ׸  ֵ VtxOffset ٰ ˷ش.
+	io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;
+	g_imgui_gl.is_persistent = g_gl_ext.has_buffer_storage;
+	imgui_create_ring(IMGUI_INITIAL_VERTEX_CAPACITY, IMGUI_INITIAL_INDEX_CAPACITY);
+}
+
+void imgui_terminate()
+{
+	imgui_destroy_ring();
+	memory_tracker_gpu_release(GPU_MEMORY_TEXTURE, g_imgui_gl.tex_font);
+	glDeleteTextures(1, &(g_imgui_gl.tex_font));
+	glDeleteProgram(g_imgui_gl.pso_imgui);
+	glDeleteShader(g_imgui_gl.shader_frag);
+	glDeleteShader(g_imgui_gl.shader_vertex);
+
+	ImGui::DestroyContext();
+}
+
+void imgui_create_ring(int vtx_capacity, int idx_capacity)
+{
+	g_imgui_gl.vtx_slot_capacity = vtx_capacity;
+	g_imgui_gl.idx_slot_capacity = idx_capacity;
+	const GLsizeiptr vbo_size = (GLsizeiptr)vtx_capacity * (int)sizeof(ImDrawVert) * MAX_FRAMES_IN_FLIGHT;
+	const GLsizeiptr ibo_size = (GLsizeiptr)idx_capacity * (int)sizeof(ImDrawIdx) * MAX_FRAMES_IN_FLIGHT;
+
+	glGenVertexArrays(1, &(g_imgui_gl.vao_ui));
 	glGenBuffers(1, &(g_imgui_gl.vbo_ui));
 	glGenBuffers(1, &(g_imgui_gl.ibo_ui));
-	glGenVertexArrays(1, &(g_imgui_gl.vao_ui));
 	glBindVertexArray(g_imgui_gl.vao_ui);
-	{
-		glEnableVertexAttribArray(0);
-		glEnableVertexAttribArray(1);
-		glEnableVertexAttribArray(2);
-
-		glBindBuffer(GL_ARRAY_BUFFER, g_imgui_gl.vbo_ui);
-		glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(ImDrawVert), (void*)offsetof(ImDrawVert, pos));
-		glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(ImDrawVert), (void*)offsetof(ImDrawVert, uv));
-		glVertexAttribPointer(2, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(ImDrawVert), (void*)offsetof(ImDrawVert, col));
-		// ImGui ִ Color Ƹ 0 ~ 255 unsigned integer (byte, 8bit)̱ , shader 0 ~ 1 
-		//  ٲپ ϱ , GL_TRUE Normalization  ùٸ  ǵ Ѵ.
 
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, g_imgui_gl.ibo_ui);
+	// coherent  flush explicit map ؼ,   glFlushMappedBufferRange GPU ̰ Ѵ.
+	const GLbitfield map_flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_FLUSH_EXPLICIT_BIT;
+	glBindBuffer(GL_ARRAY_BUFFER, g_imgui_gl.vbo_ui);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, g_imgui_gl.ibo_ui);
+	if (g_imgui_gl.is_persistent)
+	{
+		glBufferStorage(GL_ARRAY_BUFFER, vbo_size, NULL, GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT);
+		glBufferStorage(GL_ELEMENT_ARRAY_BUFFER, ibo_size, NULL, GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT);
+		g_imgui_gl.vbo_mapped = (char*)glMapBufferRange(GL_ARRAY_BUFFER, 0, vbo_size, map_flags);
+		g_imgui_gl.ibo_mapped = (char*)glMapBufferRange(GL_ELEMENT_ARRAY_BUFFER, 0, ibo_size, map_flags);
+	}
+	else
+	{
+		glBufferData(GL_ARRAY_BUFFER, vbo_size, NULL, GL_STREAM_DRAW);
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, ibo_size, NULL, GL_STREAM_DRAW);
+		g_imgui_gl.vbo_mapped = NULL;
+		g_imgui_gl.ibo_mapped = NULL;
 	}
+	memory_tracker_gpu_set(GPU_MEMORY_BUFFER, g_imgui_gl.vbo_ui, (size_t)vbo_size);
+	memory_tracker_gpu_set(GPU_MEMORY_BUFFER, g_imgui_gl.ibo_ui, (size_t)ibo_size);
+
+	glEnableVertexAttribArray(0);
+	glEnableVertexAttribArray(1);
+	glEnableVertexAttribArray(2);
+	glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(ImDrawVert), (void*)offsetof(ImDrawVert, pos));
+	glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(ImDrawVert), (void*)offsetof(ImDrawVert, uv));
+	glVertexAttribPointer(2, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(ImDrawVert), (void*)offsetof(ImDrawVert, col));
+	// ImGui ִ Color Ƹ 0 ~ 255 unsigned integer (byte, 8bit)̱ , shader 0 ~ 1 
+	//  ٲپ ϱ , GL_TRUE Normalization  ùٸ  ǵ Ѵ.
+
+	glBindVertexArray(0);
 }
 
-void imgui_terminate()
+void imgui_destroy_ring()
 {
+	// persistent mapping buffer    Ǯ.
+	//  frame  а ִ ̹ GPU ۾  ڿ  Ѵ.
+	memory_tracker_gpu_release(GPU_MEMORY_BUFFER, g_imgui_gl.ibo_ui);
+	memory_tracker_gpu_release(GPU_MEMORY_BUFFER, g_imgui_gl.vbo_ui);
 	glDeleteVertexArrays(1, &(g_imgui_gl.vao_ui));
 	glDeleteBuffers(1, &(g_imgui_gl.ibo_ui));
 	glDeleteBuffers(1, &(g_imgui_gl.vbo_ui));
-	glDeleteTextures(1, &(g_imgui_gl.tex_font));
-	glDeleteProgram(g_imgui_gl.pso_imgui);
-	glDeleteShader(g_imgui_gl.shader_frag);
-	glDeleteShader(g_imgui_gl.shader_vertex);
-
-	ImGui::DestroyContext();
+	g_imgui_gl.vbo_mapped = NULL;
+	g_imgui_gl.ibo_mapped = NULL;
 }
 
 void imgui_prepare()
 {
+	// headless mode window  offscreen FBO ũ⸦ , Է   ð  Ѵ.
+	if (g_headless.is_enable)
+	{
+		ImGuiIO& io = ImGui::GetIO();
+		io.DisplaySize = ImVec2((float)g_headless.width, (float)g_headless.height);
+		io.DisplayFramebufferScale = ImVec2(1.f, 1.f);
+		io.DeltaTime = g_benchmark.is_enable ? g_benchmark.fixed_delta_time : g_headless.fixed_delta_time;
+		io.MousePos = ImVec2(-FLT_MAX, -FLT_MAX);
+		return;
+	}
+
 	int w, h;
 	int display_w, display_h;
 	glfwGetWindowSize(g_window, &w, &h);
@@ -1272,6 +2664,12 @@ void imgui_prepare()
 	io.DeltaTime = g_time > 0.0 ? (float)(current_time - g_time) : (float)(1.0f / 60.0f);
 	g_time = current_time;
 
+	// benchmark  ɸ ð   frame  ŭ ؾ    ִ.
+	if (g_benchmark.is_enable)
+	{
+		io.DeltaTime = g_benchmark.fixed_delta_time;
+	}
+
 	for (int i = 0; i < IM_ARRAYSIZE(io.MouseDown); i++)
 	{
 		// if a mouse press event came,
@@ -1314,34 +2712,24 @@ void imgui_draw()
 	ImDrawData* draw_data = ImGui::GetDrawData();
 	int fb_width = (int)(draw_data->DisplaySize.x * draw_data->FramebufferScale.x);
 	int fb_height = (int)(draw_data->DisplaySize.y * draw_data->FramebufferScale.y);
-	if (fb_width <= 0 || fb_height <= 0)
+	if (fb_width <= 0 || fb_height <= 0 || draw_data->TotalVtxCount == 0)
 		return;
 
 	// imgui draw ʿ rasterization · 
-	// ٸ ڵ rasterization õ     ֱ 
-	//   صд.
-	GLenum last_blend_src_rgb; glGetIntegerv(GL_BLEND_SRC_RGB, (GLint*)&last_blend_src_rgb);
-	GLenum last_blend_dst_rgb; glGetIntegerv(GL_BLEND_DST_RGB, (GLint*)&last_blend_dst_rgb);
-	GLenum last_blend_src_alpha; glGetIntegerv(GL_BLEND_SRC_ALPHA, (GLint*)&last_blend_src_alpha);
-	GLenum last_blend_dst_alpha; glGetIntegerv(GL_BLEND_DST_ALPHA, (GLint*)&last_blend_dst_alpha);
-	GLenum last_blend_equation_rgb; glGetIntegerv(GL_BLEND_EQUATION_RGB, (GLint*)&last_blend_equation_rgb);
-	GLenum last_blend_equation_alpha; glGetIntegerv(GL_BLEND_EQUATION_ALPHA, (GLint*)&last_blend_equation_alpha);
-	GLboolean last_enable_blend = glIsEnabled(GL_BLEND);
-	GLboolean last_enable_cull_face = glIsEnabled(GL_CULL_FACE);
-	GLboolean last_enable_depth_test = glIsEnabled(GL_DEPTH_TEST);
-	GLboolean last_enable_stencil_test = glIsEnabled(GL_STENCIL_TEST);
-	GLboolean last_enable_scissor_test = glIsEnabled(GL_SCISSOR_TEST);
-	GLint last_polygon_mode[2]; glGetIntegerv(GL_POLYGON_MODE, last_polygon_mode);
+	// ٸ ڵ rasterization õ     ֱ 
+	//   صд. driver  ʰ g_gl_state Ѵ.
+	GL_STATE_VALIDATE();
+	const GLState last_state = g_gl_state;
 
 	// ImGui ʿ rasterization state
-	glEnable(GL_BLEND);
-	glBlendEquation(GL_FUNC_ADD);
-	glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
-	glDisable(GL_CULL_FACE);
-	glDisable(GL_DEPTH_TEST);
-	glDisable(GL_STENCIL_TEST);
-	glEnable(GL_SCISSOR_TEST);
-	glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+	gl_state_set_enable(GL_BLEND, true);
+	gl_state_set_blend_equation(GL_FUNC_ADD, GL_FUNC_ADD);
+	gl_state_set_blend_func(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+	gl_state_set_enable(GL_CULL_FACE, false);
+	gl_state_set_enable(GL_DEPTH_TEST, false);
+	gl_state_set_enable(GL_STENCIL_TEST, false);
+	gl_state_set_enable(GL_SCISSOR_TEST, true);
+	gl_state_set_polygon_mode(GL_FILL);
 
 	// 2D Rendering̹Ƿ, Orthogonal Projection 
 	float L = draw_data->DisplayPos.x;
@@ -1363,9 +2751,58 @@ void imgui_draw()
 	glUniformMatrix4fv(g_imgui_gl.loc_projection, 1, GL_FALSE, &ortho_projection[0][0]);
 
 	//  غ
+	//  ڶ ring ü  ũ  . (UI Ŀ    Ͼ.)
+	if (draw_data->TotalVtxCount > g_imgui_gl.vtx_slot_capacity || draw_data->TotalIdxCount > g_imgui_gl.idx_slot_capacity)
+	{
+		int vtx_capacity = std::max(draw_data->TotalVtxCount, g_imgui_gl.vtx_slot_capacity * 2);
+		int idx_capacity = std::max(draw_data->TotalIdxCount, g_imgui_gl.idx_slot_capacity * 2);
+		imgui_destroy_ring();
+		imgui_create_ring(vtx_capacity, idx_capacity);
+	}
+
+	const int frame_slot = g_frame_sync.frame_slot;
+	const GLintptr vtx_slot_offset = (GLintptr)frame_slot * g_imgui_gl.vtx_slot_capacity * (int)sizeof(ImDrawVert);
+	const GLintptr idx_slot_offset = (GLintptr)frame_slot * g_imgui_gl.idx_slot_capacity * (int)sizeof(ImDrawIdx);
+	const GLsizeiptr vtx_size = (GLsizeiptr)draw_data->TotalVtxCount * (int)sizeof(ImDrawVert);
+	const GLsizeiptr idx_size = (GLsizeiptr)draw_data->TotalIdxCount * (int)sizeof(ImDrawIdx);
+
 	glBindVertexArray(g_imgui_gl.vao_ui);
 	glBindBuffer(GL_ARRAY_BUFFER, g_imgui_gl.vbo_ui);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, g_imgui_gl.ibo_ui);
+
+	//  command list vertex/index ̹ slot    Ѵ.
+	// persistent ƴ϶  unsynchronized map Ѵ. (fence ̹ ϴ.)
+	char* vtx_dst;
+	char* idx_dst;
+	if (g_imgui_gl.is_persistent)
+	{
+		vtx_dst = g_imgui_gl.vbo_mapped + vtx_slot_offset;
+		idx_dst = g_imgui_gl.ibo_mapped + idx_slot_offset;
+	}
+	else
+	{
+		const GLbitfield map_flags = GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_FLUSH_EXPLICIT_BIT;
+		vtx_dst = (char*)glMapBufferRange(GL_ARRAY_BUFFER, vtx_slot_offset, vtx_size, map_flags);
+		idx_dst = (char*)glMapBufferRange(GL_ELEMENT_ARRAY_BUFFER, idx_slot_offset, idx_size, map_flags);
+	}
+
+	for (int n = 0; n < draw_data->CmdListsCount; n++)
+	{
+		const ImDrawList* cmd_list = draw_data->CmdLists[n];
+		memcpy(vtx_dst, cmd_list->VtxBuffer.Data, (size_t)cmd_list->VtxBuffer.Size * sizeof(ImDrawVert));
+		memcpy(idx_dst, cmd_list->IdxBuffer.Data, (size_t)cmd_list->IdxBuffer.Size * sizeof(ImDrawIdx));
+		vtx_dst += (size_t)cmd_list->VtxBuffer.Size * sizeof(ImDrawVert);
+		idx_dst += (size_t)cmd_list->IdxBuffer.Size * sizeof(ImDrawIdx);
+	}
+
+	// flush  map   ̴. (persistent buffer ü map ߴ.)
+	glFlushMappedBufferRange(GL_ARRAY_BUFFER, g_imgui_gl.is_persistent ? vtx_slot_offset : 0, vtx_size);
+	glFlushMappedBufferRange(GL_ELEMENT_ARRAY_BUFFER, g_imgui_gl.is_persistent ? idx_slot_offset : 0, idx_size);
+	if (!g_imgui_gl.is_persistent)
+	{
+		glUnmapBuffer(GL_ARRAY_BUFFER);
+		glUnmapBuffer(GL_ELEMENT_ARRAY_BUFFER);
+	}
+
 	ImVec2 clip_off = draw_data->DisplayPos;         // (0,0) unless using multi-viewports
 	ImVec2 clip_scale = draw_data->FramebufferScale; // (1,1) unless using retina display which are often (2,2)
 
@@ -1373,18 +2810,37 @@ void imgui_draw()
 	glViewport(0, 0, fb_width, fb_height);
 
 	// Render command lists
+	//  command list ring  ڱ ġ(base vertex / index offset) ׸.
+	// texture scissor ٲ  ٽ Ѵ.
+	const GLint slot_base_vertex = frame_slot * g_imgui_gl.vtx_slot_capacity;
+	const size_t slot_base_index = (size_t)frame_slot * g_imgui_gl.idx_slot_capacity;
+	GLint list_base_vertex = 0;
+	size_t list_base_index = 0;
+	ImTextureID bound_texture = NULL;
+	ImVec4 bound_clip_rect(-1.f, -1.f, -1.f, -1.f);
 	for (int n = 0; n < draw_data->CmdListsCount; n++)
 	{
 		const ImDrawList* cmd_list = draw_data->CmdLists[n];
 
-		// Upload vertex/index buffers
-		glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)cmd_list->VtxBuffer.Size * (int)sizeof(ImDrawVert), (const GLvoid*)cmd_list->VtxBuffer.Data, GL_STREAM_DRAW);
-		glBufferData(GL_ELEMENT_ARRAY_BUFFER, (GLsizeiptr)cmd_list->IdxBuffer.Size * (int)sizeof(ImDrawIdx), (const GLvoid*)cmd_list->IdxBuffer.Data, GL_STREAM_DRAW);
-
 		for (int cmd_i = 0; cmd_i < cmd_list->CmdBuffer.Size; cmd_i++)
 		{
 			const ImDrawCmd* pcmd = &cmd_list->CmdBuffer[cmd_i];
 
+			//  texture clip rect index ̾ command   ׸.
+			unsigned elem_count = pcmd->ElemCount;
+			while (cmd_i + 1 < cmd_list->CmdBuffer.Size)
+			{
+				const ImDrawCmd* next = &cmd_list->CmdBuffer[cmd_i + 1];
+				if (next->GetTexID() != pcmd->GetTexID() || next->VtxOffset != pcmd->VtxOffset ||
+					next->IdxOffset != pcmd->IdxOffset + elem_count ||
+					memcmp(&next->ClipRect, &pcmd->ClipRect, sizeof(ImVec4)) != 0)
+				{
+					break;
+				}
+				elem_count += next->ElemCount;
+				++cmd_i;
+			}
+
 			// Project scissor/clipping rectangles into framebuffer space
 			ImVec4 clip_rect;
 			clip_rect.x = (pcmd->ClipRect.x - clip_off.x) * clip_scale.x;
@@ -1395,24 +2851,34 @@ void imgui_draw()
 			if (clip_rect.x < fb_width && clip_rect.y < fb_height && clip_rect.z >= 0.0f && clip_rect.w >= 0.0f)
 			{
 				// Apply scissor/clipping rectangle
-				glScissor((int)clip_rect.x, (int)(fb_height - clip_rect.w), (int)(clip_rect.z - clip_rect.x), (int)(clip_rect.w - clip_rect.y));
+				if (memcmp(&clip_rect, &bound_clip_rect, sizeof(ImVec4)) != 0)
+				{
+					glScissor((int)clip_rect.x, (int)(fb_height - clip_rect.w), (int)(clip_rect.z - clip_rect.x), (int)(clip_rect.w - clip_rect.y));
+					bound_clip_rect = clip_rect;
+				}
 
 				// Bind texture, Draw
-				glBindTexture(GL_TEXTURE_2D, (GLuint)(intptr_t)pcmd->GetTexID());
-				glDrawElements(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, (void*)(intptr_t)(pcmd->IdxOffset * sizeof(ImDrawIdx)));
+				if (pcmd->GetTexID() != bound_texture)
+				{
+					glBindTexture(GL_TEXTURE_2D, (GLuint)(intptr_t)pcmd->GetTexID());
+					bound_texture = pcmd->GetTexID();
+				}
+				++g_render_stats.draw_calls;
+				g_render_stats.triangles += elem_count / 3;
+				glDrawElementsBaseVertex(GL_TRIANGLES, (GLsizei)elem_count, sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT,
+					(void*)(intptr_t)((slot_base_index + list_base_index + pcmd->IdxOffset) * sizeof(ImDrawIdx)),
+					slot_base_vertex + list_base_vertex + (GLint)pcmd->VtxOffset);
 			}
 		}
+
+		list_base_vertex += cmd_list->VtxBuffer.Size;
+		list_base_index += cmd_list->IdxBuffer.Size;
 	}
+	glBindVertexArray(0);
 
-	//  rasterization state  ´.
-	glBlendEquationSeparate(last_blend_equation_rgb, last_blend_equation_alpha);
-	glBlendFuncSeparate(last_blend_src_rgb, last_blend_dst_rgb, last_blend_src_alpha, last_blend_dst_alpha);
-	if (last_enable_blend) glEnable(GL_BLEND); else glDisable(GL_BLEND);
-	if (last_enable_cull_face) glEnable(GL_CULL_FACE); else glDisable(GL_CULL_FACE);
-	if (last_enable_depth_test) glEnable(GL_DEPTH_TEST); else glDisable(GL_DEPTH_TEST);
-	if (last_enable_stencil_test) glEnable(GL_STENCIL_TEST); else glDisable(GL_STENCIL_TEST);
-	if (last_enable_scissor_test) glEnable(GL_SCISSOR_TEST); else glDisable(GL_SCISSOR_TEST);
-	glPolygonMode(GL_FRONT_AND_BACK, (GLenum)last_polygon_mode[0]);
+	//  rasterization state  ´. ٲ ͸ ǵ.
+	gl_state_restore(last_state);
+	GL_STATE_VALIDATE();
 }
 
 void imgui_glfw_scroll_callback(GLFWwindow* window, double xoffset, double yoffset)
@@ -1420,6 +2886,8 @@ void imgui_glfw_scroll_callback(GLFWwindow* window, double xoffset, double yoffs
 	ImGuiIO& io = ImGui::GetIO();
 	io.MouseWheelH += (float)xoffset;
 	io.MouseWheel += (float)yoffset;
+	ui_cache_invalidate();
+	idle_mark_dirty();
 }
 
 void imgui_glfw_key_callback(GLFWwindow* window, int key, int scancode, int action, int mods)
@@ -1432,12 +2900,16 @@ void imgui_glfw_key_callback(GLFWwindow* window, int key, int scancode, int acti
 		else if (action == GLFW_RELEASE)
 			io.KeysDown[key] = false;
 	}
+	ui_cache_invalidate();
+	idle_mark_dirty();
 }
 
 void imgui_glfw_char_callback(GLFWwindow* window, unsigned int c)
 {
 	ImGuiIO& io = ImGui::GetIO();
 	io.AddInputCharacter(c);
+	ui_cache_invalidate();
+	idle_mark_dirty();
 }
 
 const char* imgui_glfw_clipboard_get(void* user_data)
@@ -1452,29 +2924,76 @@ void imgui_glfw_clipboard_set(void* user_data, const char* text)
 
 void glfw_init()
 {
-	glfwInit();
-	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
-	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
-	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
-
-	// glfw  ش OS ´ window â ϰ, ׿ õ egl context .
-	g_window = glfwCreateWindow(INITIAL_WINDOW_WIDTH, INITIAL_WINDOW_HEIGHT, "Third Lecture", NULL, NULL);
-	if (g_window == NULL)
+	GLADloadproc gl_loader = (GLADloadproc)glfwGetProcAddress;
+#if defined(HEADLESS_EGL)
+	// display   GLFW  EGL offscreen context .
+	if (g_headless.is_enable)
 	{
-		printf("Failed to create GLFW Window\n");
-		assert(false);
+		if (!headless_egl_create_context())
+		{
+			printf("Failed to create EGL context\n");
+			assert(false);
+		}
+		gl_loader = (GLADloadproc)headless_egl_get_proc_address;
+	}
+	else
+#endif
+	{
+		glfwInit();
+		glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+		glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+		glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+		if (g_headless.is_enable)
+		{
+			// headless mode context ʿϹǷ window  ʴ´.
+			glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+		}
+
+		// glfw  ش OS ´ window â ϰ, ׿ õ egl context .
+		g_window = glfwCreateWindow(INITIAL_WINDOW_WIDTH, INITIAL_WINDOW_HEIGHT, "Third Lecture", NULL, NULL);
+		if (g_window == NULL)
+		{
+			printf("Failed to create GLFW Window\n");
+			assert(false);
+		}
+		if (!g_headless.is_enable)
+		{
+			glfwSetFramebufferSizeCallback(g_window, framebuffer_size_callback);
+			glfwSetWindowRefreshCallback(g_window, window_refresh_callback);
+		}
+		glfwMakeContextCurrent(g_window);
 	}
-	glfwSetFramebufferSizeCallback(g_window, framebuffer_size_callback);
-	glfwMakeContextCurrent(g_window);
-	if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
+
+	if (!gladLoadGLLoader(gl_loader))
 	{
 		printf("Failed to initialize GLAD");
 		assert(false);
 	}
+
+	// glad  GL 4.x Լ(compute shader, indirect draw ) ҷ´.
+	gl_extension_init(gl_loader);
+	gl_state_init();
+	program_cache_init("shader_cache");
+
+	// headless mode window  offscreen FBO ׸.
+	if (g_headless.is_enable)
+	{
+		g_window_width = g_headless.width;
+		g_window_height = g_headless.height;
+		headless_init();
+	}
 }
 
 void glfw_terminate()
 {
+	headless_terminate();
+#if defined(HEADLESS_EGL)
+	if (g_headless.is_enable)
+	{
+		headless_egl_destroy_context();
+		return;
+	}
+#endif
 	glfwTerminate();
 }
 
@@ -1483,6 +3002,20 @@ void framebuffer_size_callback(GLFWwindow* window, int width, int height)
 	g_window_width = width;
 	g_window_height = height;
 	glViewport(0, 0, width, height);
+	idle_mark_dirty();
+}
+
+// window ٰ ٽ ̴  OS ٽ ׷޶  
+void window_refresh_callback(GLFWwindow* window)
+{
+	idle_mark_dirty();
+}
+
+// UI ̴   Է ̵ ٲ ͵. (FPS profiler ڴ refresh interval Ѵ.)
+void ui_watch_values()
+{
+	ui_cache_watch(&g_camera.position, sizeof(g_camera.position));
+	ui_cache_watch(&g_camera.rotation, sizeof(g_camera.rotation));
 }
 
 void do_your_gui_code()
@@ -1494,6 +3027,32 @@ void do_your_gui_code()
 
 		ImGuiIO& io = ImGui::GetIO();
 		ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
+		ImGui::Text("Draw Calls %u / Triangles %llu", g_render_stats.draw_calls, g_render_stats.triangles);
+
+		int max_frames_in_flight = g_frame_sync.max_frames_in_flight;
+		ImGui::Text("Max Frames In Flight"); ImGui::SameLine();
+		if (ImGui::SliderInt("##MaxFramesInFlight", &max_frames_in_flight, 1, MAX_FRAMES_IN_FLIGHT))
+		{
+			frame_sync_set_max_frames_in_flight(max_frames_in_flight);
+		}
+		ImGui::Text("GPU Wait %.3f ms", g_frame_sync.wait_ms);
+		frame_pacing_draw_gui();
+		dynamic_resolution_draw_gui();
+		job_system_draw_gui();
+		frame_allocator_draw_gui();
+
+		ImGui::Text("Retained UI"); ImGui::SameLine();
+		ImGui::Checkbox("##RetainedUI", &g_ui_cache.is_enable);
+		ImGui::Text("UI Refresh Interval"); ImGui::SameLine();
+		ImGui::SliderFloat("##UIRefreshInterval", &g_ui_cache.refresh_interval, 0.f, 2.f, "%.2f s");
+		ImGui::Text("UI Rebuilds %u / %u frames", g_ui_cache.rebuild_count, g_ui_cache.frame_count);
+
+		if (g_window != NULL && !g_benchmark.is_enable)
+		{
+			ImGui::Text("Idle Rendering (On Demand)"); ImGui::SameLine();
+			ImGui::Checkbox("##IdleRendering", &g_idle.is_enable);
+			ImGui::Text("Rendered %u / Skipped %u", g_idle.rendered_count, g_idle.skipped_count);
+		}
 
 		ImGui::Separator();
 
@@ -1504,6 +3063,8 @@ void do_your_gui_code()
 		ImGui::Text("Camera Forward : %f %f %f", g_camera.forward.x, g_camera.forward.y, g_camera.forward.z);
 		ImGui::Text("Camera Mouse Sensitivity"); ImGui::SameLine();
 		ImGui::DragFloat("##CameraMouseSensitivity", &(g_camera.mouse_sensitivity), 0.0001f, 0.01f, 0.1f, "%.4f");
+		ImGui::Text("Late Latch Camera"); ImGui::SameLine();
+		ImGui::Checkbox("##LateLatchCamera", &g_is_late_latch_camera);
 		ImGui::Text("Camera Move Speed"); ImGui::SameLine();
 		ImGui::DragFloat("##CameraMoveSpeed", &(g_camera.move_speed), 0.01f, 1.f, 100.f, "%.2f");
 		if (ImGui::Button("Camera Reset"))
@@ -1513,35 +3074,53 @@ void do_your_gui_code()
 
 		ImGui::Separator();
 
+		//  ٲ  transform dirty ǥѴ.
+		Transform* model_transform = transform_get(g_model.transform);
+		bool is_model_changed = false;
 		ImGui::Text("Model Position"); ImGui::SameLine();
-		ImGui::DragFloat3("##ModelPosition", &g_model.position.x, 0.01f, FLT_MAX, -FLT_MAX, "%.2f");
+		is_model_changed |= ImGui::DragFloat3("##ModelPosition", &model_transform->position.x, 0.01f, FLT_MAX, -FLT_MAX, "%.2f");
 		ImGui::Text("Model Rotation"); ImGui::SameLine();
-		ImGui::DragFloat3("##ModelRotation", &g_model.rot_euler.x, 0.1f, FLT_MAX, -FLT_MAX, "%.1f");
+		is_model_changed |= ImGui::DragFloat3("##ModelRotation", &model_transform->rot_euler.x, 0.1f, FLT_MAX, -FLT_MAX, "%.1f");
 		ImGui::Text("Model Scale"); ImGui::SameLine();
-		ImGui::DragFloat3("##ModelScale", &g_model.scale.x, 0.001f, FLT_MAX, -FLT_MAX, "%.3f");
+		is_model_changed |= ImGui::DragFloat3("##ModelScale", &model_transform->scale.x, 0.001f, FLT_MAX, -FLT_MAX, "%.3f");
+		if (is_model_changed)
+		{
+			transform_mark_dirty(g_model.transform);
+		}
 		if (ImGui::Button("Model Reset"))
 		{
-			g_model.scale = INITIAL_MODEL_SCALE;
-			g_model.position = INITIAL_MODEL_POSITION;
-			g_model.rot_euler = INITIAL_MODEL_ROTATION;
+			transform_set(g_model.transform, INITIAL_MODEL_POSITION, INITIAL_MODEL_ROTATION, INITIAL_MODEL_SCALE);
 		}
 
 		ImGui::Separator();
 
 		ImGui::Text("Light Rotataion"); ImGui::SameLine();
-		ImGui::DragFloat3("##LightRotataion", &g_light.rot_euler.x, 0.01f, FLT_MAX, -FLT_MAX, "%.2f");
+		if (ImGui::DragFloat3("##LightRotataion", &transform_get(g_light.transform)->rot_euler.x, 0.01f, FLT_MAX, -FLT_MAX, "%.2f"))
+		{
+			transform_mark_dirty(g_light.transform);
+		}
 		ImGui::Text("Light Ambient"); ImGui::SameLine();
-		ImGui::ColorEdit3("##LightAmbient", &g_light.ambient.x);
+		if (ImGui::ColorEdit3("##LightAmbient", &g_light.ambient.x))
+		{
+			++g_light.version;
+		}
 		ImGui::Text("Light Diffuse"); ImGui::SameLine();
-		ImGui::ColorEdit3("##LightDiffuse", &g_light.diffuse.x);
+		if (ImGui::ColorEdit3("##LightDiffuse", &g_light.diffuse.x))
+		{
+			++g_light.version;
+		}
 		ImGui::Text("Light Specular"); ImGui::SameLine();
-		ImGui::ColorEdit3("##LightSpecular", &g_light.specular.x);
+		if (ImGui::ColorEdit3("##LightSpecular", &g_light.specular.x))
+		{
+			++g_light.version;
+		}
 		if (ImGui::Button("Light Reset"))
 		{
-			g_light.rot_euler = INITIAL_LIGHT_ROT_EULER;
+			transform_set(g_light.transform, glm::vec3(0.f), INITIAL_LIGHT_ROT_EULER, glm::vec3(1.f));
 			g_light.ambient = INITIAL_LIGHT_AMBIENT;
 			g_light.diffuse = INITIAL_LIGHT_DIFFUSE;
 			g_light.specular = INITIAL_LIGHT_SPECULAR;
+			++g_light.version;
 		}
 
 		ImGui::Separator();
@@ -1551,6 +3130,43 @@ void do_your_gui_code()
 
 		ImGui::Separator();
 
+		animation_draw_gui();
+
+		ImGui::Separator();
+
+		physics_draw_gui();
+
+		ImGui::Separator();
+
+		size_t mesh_cpu_bytes = 0;
+		for (const Mesh& mesh : g_model.mesh)
+		{
+			mesh_cpu_bytes += sizeof(float) * (mesh.cpu.position.capacity() + mesh.cpu.normal.capacity() + mesh.cpu.tangent.capacity() + mesh.cpu.uv.capacity()) +
+				sizeof(uint32_t) * mesh.cpu.indices.capacity();
+		}
+		ImGui::Text("Mesh Residency %s / CPU Vertex Data %.2f MB", MESH_RESIDENCY_NAMES[g_mesh_residency], (float)mesh_cpu_bytes / (1024.f * 1024.f));
+
+		ImGui::Separator();
+
+		ImGui::Text("Instance Count"); ImGui::SameLine();
+		ImGui::DragInt("##InstanceCount", &g_model.instance_count, 10.f, 1, MAX_INSTANCE_COUNT);
+		ImGui::Text("Instance Spacing"); ImGui::SameLine();
+		ImGui::DragFloat("##InstanceSpacing", &g_model.instance_spacing, 0.1f, 0.f, FLT_MAX, "%.1f");
+		if (g_gpu_culling.is_supported)
+		{
+			ImGui::Text("GPU Culling"); ImGui::SameLine();
+			ImGui::Checkbox("##GPUCulling", &g_gpu_culling.is_enable);
+			ImGui::Text("Occlusion Culling (Hi-Z)"); ImGui::SameLine();
+			ImGui::Checkbox("##OcclusionCulling", &g_gpu_culling.is_enable_occlusion);
+			ImGui::Text("Draw Count Buffer : %s", g_gpu_culling.is_use_draw_count ? "YES" : "NO");
+		}
+		else
+		{
+			ImGui::Text("GPU Culling : Not Supported");
+		}
+
+		ImGui::Separator();
+
 		if (ImGui::TreeNode("Materials"))
 		{
 			for (int i = 0; i < g_model.material.size(); ++i)
@@ -1581,6 +3197,8 @@ void do_your_gui_code()
 							ImGui::Text("Has Diffuse Map : %s", mat.gl_diffuse != g_default_texture_white ? "YES" : "NO");
 							ImGui::Text("Has Normal Map : %s", mat.has_normal_texture ? "YES" : "NO");
 							ImGui::Text("IsTransparent : %s", mat.is_transparent ? "YES" : "NO");
+							ImGui::Text("IsAlphaTest : %s (cutoff %.2f)", mat.is_alpha_test ? "YES" : "NO", mat.alpha_cutoff);
+							ImGui::Text("Shader Variant : 0x%X", mat.shader_features);
 						}
 						ImGui::Unindent();
 
@@ -1595,4 +3213,16 @@ void do_your_gui_code()
 		ImGui::Separator();
 	}
 	ImGui::End();
+
+	if (ImGui::Begin("Profiler", 0, ImGuiWindowFlags_HorizontalScrollbar))
+	{
+		gpu_profiler_draw_gui();
+	}
+	ImGui::End();
+
+	if (ImGui::Begin("Memory", 0, ImGuiWindowFlags_HorizontalScrollbar))
+	{
+		memory_tracker_draw_gui();
+	}
+	ImGui::End();
 }
\ No newline at end of file
@@ -0,0 +1,402 @@
+#include "memory_tracker.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <new>
+#include <unordered_map>
+
+#include "imgui/imgui.h"
+
+MemoryTracker g_memory_tracker;
+
+static const char* const MEMORY_STAT_NAMES[MEMORY_STAT_COUNT] =
+{
+	"general", "mesh", "animation", "physics", "assimp", "stb_image", "imgui", "frame_arena",
+	"gpu_buffer", "gpu_texture", "gpu_renderbuffer"
+};
+
+// Ҵ  տ ٴ header. 16 byte ִ ּҵ malloc   .
+struct MemoryHeader
+{
+	uint64_t size;
+	uint32_t tag;
+	uint32_t magic;
+};
+static_assert(sizeof(MemoryHeader) == 16, "MemoryHeader must keep 16 byte alignment");
+constexpr uint32_t MEMORY_HEADER_MAGIC = 0x4D454D54;	// "MEMT"
+
+//  thread operator new  tag
+static thread_local int t_memory_tag = MEMORY_TAG_GENERAL;
+
+// GPU object (type << 32 | id) -> bytes. GL thread .
+static std::unordered_map<uint64_t, size_t> s_gpu_objects;
+
+static void memory_stat_add(MemoryStat* stat, int64_t bytes)
+{
+	const int64_t current = stat->current_bytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+	int64_t peak = stat->peak_bytes.load(std::memory_order_relaxed);
+	while (current > peak && !stat->peak_bytes.compare_exchange_weak(peak, current, std::memory_order_relaxed))
+	{
+	}
+	stat->alloc_count.fetch_add(1, std::memory_order_relaxed);
+}
+
+static void memory_stat_remove(MemoryStat* stat, int64_t bytes)
+{
+	stat->current_bytes.fetch_sub(bytes, std::memory_order_relaxed);
+	stat->free_count.fetch_add(1, std::memory_order_relaxed);
+}
+
+void* memory_tracker_malloc(size_t size, int tag)
+{
+	MemoryHeader* header = (MemoryHeader*)malloc(sizeof(MemoryHeader) + size);
+	if (header == nullptr)
+	{
+		return nullptr;
+	}
+
+	header->size = size;
+	header->tag = (uint32_t)tag;
+	header->magic = MEMORY_HEADER_MAGIC;
+	memory_stat_add(&(g_memory_tracker.stats[tag]), (int64_t)size);
+	return header + 1;
+}
+
+void* memory_tracker_realloc(void* ptr, size_t size, int tag)
+{
+	if (ptr == nullptr)
+	{
+		return memory_tracker_malloc(size, tag);
+	}
+
+	MemoryHeader* header = (MemoryHeader*)ptr - 1;
+	assert(header->magic == MEMORY_HEADER_MAGIC);
+	const int64_t last_size = (int64_t)header->size;
+	const int last_tag = (int)header->tag;
+
+	MemoryHeader* new_header = (MemoryHeader*)realloc(header, sizeof(MemoryHeader) + size);
+	if (new_header == nullptr)
+	{
+		return nullptr;
+	}
+
+	memory_stat_remove(&(g_memory_tracker.stats[last_tag]), last_size);
+	new_header->size = size;
+	memory_stat_add(&(g_memory_tracker.stats[last_tag]), (int64_t)size);
+	return new_header + 1;
+}
+
+void memory_tracker_free(void* ptr)
+{
+	if (ptr == nullptr)
+	{
+		return;
+	}
+
+	MemoryHeader* header = (MemoryHeader*)ptr - 1;
+	assert(header->magic == MEMORY_HEADER_MAGIC);
+	memory_stat_remove(&(g_memory_tracker.stats[header->tag]), (int64_t)header->size);
+	header->magic = 0;
+	free(header);
+}
+
+//  ʿ new(align_val_t) ⺻  ״ . (header  Ƿ delete ⺻  ¦ ´´.)
+void* operator new(size_t size)
+{
+	void* ptr = memory_tracker_malloc(size > 0 ? size : 1, t_memory_tag);
+	if (ptr == nullptr)
+	{
+		throw std::bad_alloc();
+	}
+	return ptr;
+}
+
+void* operator new[](size_t size)
+{
+	return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+	return memory_tracker_malloc(size > 0 ? size : 1, t_memory_tag);
+}
+
+void* operator new[](size_t size, const std::nothrow_t& tag) noexcept
+{
+	return operator new(size, tag);
+}
+
+void operator delete(void* ptr) noexcept
+{
+	memory_tracker_free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+	memory_tracker_free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+	memory_tracker_free(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept
+{
+	memory_tracker_free(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept
+{
+	memory_tracker_free(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept
+{
+	memory_tracker_free(ptr);
+}
+
+static void* memory_tracker_imgui_alloc(size_t size, void* user_data)
+{
+	return memory_tracker_malloc(size, MEMORY_TAG_IMGUI);
+}
+
+static void memory_tracker_imgui_free(void* ptr, void* user_data)
+{
+	memory_tracker_free(ptr);
+}
+
+void memory_tracker_print_usage()
+{
+	printf("  --memory-budget TAG MB      warn when TAG uses more than MB (TAG : general, mesh, animation, physics,\n");
+	printf("                              assimp, stb_image, imgui, frame_arena, gpu_buffer, gpu_texture,\n");
+	printf("                              gpu_renderbuffer)\n");
+	printf("  --memory-dump PATH          write the memory report as JSON to PATH on exit\n");
+}
+
+void memory_tracker_set_defaults()
+{
+	//  main  Ҵ  Ƿ budget ɼǸ ʱȭѴ.
+	for (int i = 0; i < MEMORY_STAT_COUNT; ++i)
+	{
+		g_memory_tracker.stats[i].budget_bytes = 0;
+		g_memory_tracker.stats[i].is_over_budget = false;
+	}
+	g_memory_tracker.dump_path[0] = '\0';
+}
+
+bool memory_tracker_parse_arg(int argc, char** argv, int* index)
+{
+	const char* arg = argv[*index];
+	if (strcmp(arg, "--memory-budget") == 0)
+	{
+		if (*index + 2 >= argc)
+		{
+			return false;
+		}
+
+		const char* name = argv[*index + 1];
+		const double budget_mb = atof(argv[*index + 2]);
+		for (int i = 0; i < MEMORY_STAT_COUNT; ++i)
+		{
+			if (strcmp(name, MEMORY_STAT_NAMES[i]) == 0 && budget_mb >= 0.0)
+			{
+				g_memory_tracker.stats[i].budget_bytes = (int64_t)(budget_mb * 1024.0 * 1024.0);
+				*index += 2;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	if (*index + 1 >= argc)
+	{
+		return false;
+	}
+
+	const char* value = argv[*index + 1];
+	if (strcmp(arg, "--memory-dump") == 0)
+	{
+		snprintf(g_memory_tracker.dump_path, sizeof(g_memory_tracker.dump_path), "%s", value);
+	}
+	else
+	{
+		return false;
+	}
+
+	++(*index);
+	return true;
+}
+
+void memory_tracker_init()
+{
+	// ImGui context   ҷ Ѵ.
+	ImGui::SetAllocatorFunctions(memory_tracker_imgui_alloc, memory_tracker_imgui_free);
+}
+
+void memory_tracker_terminate()
+{
+	if (g_memory_tracker.dump_path[0] != '\0')
+	{
+		memory_tracker_dump_json(g_memory_tracker.dump_path);
+	}
+}
+
+int memory_tag_begin(int tag)
+{
+	assert(tag >= 0 && tag < MEMORY_TAG_COUNT);
+	const int last_tag = t_memory_tag;
+	t_memory_tag = tag;
+	return last_tag;
+}
+
+void memory_tag_end(int last_tag)
+{
+	t_memory_tag = last_tag;
+}
+
+uint64_t memory_tracker_alloc_count()
+{
+	uint64_t count = 0;
+	for (int i = 0; i < MEMORY_TAG_COUNT; ++i)
+	{
+		count += g_memory_tracker.stats[i].alloc_count.load(std::memory_order_relaxed);
+	}
+	return count;
+}
+
+void memory_tracker_gpu_set(int type, GLuint id, size_t bytes)
+{
+	assert(type >= 0 && type < GPU_MEMORY_TYPE_COUNT);
+	MemoryStat* stat = &(g_memory_tracker.stats[MEMORY_TAG_COUNT + type]);
+	const uint64_t key = ((uint64_t)type << 32) | id;
+
+	auto ret = s_gpu_objects.find(key);
+	if (ret != s_gpu_objects.end())
+	{
+		memory_stat_remove(stat, (int64_t)ret->second);
+		ret->second = bytes;
+	}
+	else
+	{
+		s_gpu_objects[key] = bytes;
+	}
+	memory_stat_add(stat, (int64_t)bytes);
+}
+
+void memory_tracker_gpu_release(int type, GLuint id)
+{
+	assert(type >= 0 && type < GPU_MEMORY_TYPE_COUNT);
+	const uint64_t key = ((uint64_t)type << 32) | id;
+	auto ret = s_gpu_objects.find(key);
+	if (ret == s_gpu_objects.end())
+	{
+		return;
+	}
+
+	memory_stat_remove(&(g_memory_tracker.stats[MEMORY_TAG_COUNT + type]), (int64_t)ret->second);
+	s_gpu_objects.erase(ret);
+}
+
+void memory_tracker_update()
+{
+	for (int i = 0; i < MEMORY_STAT_COUNT; ++i)
+	{
+		MemoryStat* stat = &(g_memory_tracker.stats[i]);
+		const int64_t current = stat->current_bytes.load(std::memory_order_relaxed);
+		const bool is_over_budget = stat->budget_bytes > 0 && current > stat->budget_bytes;
+		if (is_over_budget && !stat->is_over_budget)
+		{
+			printf("Memory budget exceeded : %s %.2f MB / %.2f MB\n", MEMORY_STAT_NAMES[i],
+				(double)current / (1024.0 * 1024.0), (double)stat->budget_bytes / (1024.0 * 1024.0));
+		}
+		stat->is_over_budget = is_over_budget;
+	}
+}
+
+bool memory_tracker_dump_json(const char* path)
+{
+	FILE* fp = fopen(path, "w");
+	if (!fp)
+	{
+		printf("Fail to write a memory report : %s\n", path);
+		return false;
+	}
+
+	fprintf(fp, "{\n");
+	for (int i = 0; i < MEMORY_STAT_COUNT; ++i)
+	{
+		const MemoryStat& s = g_memory_tracker.stats[i];
+		fprintf(fp, "  \"%s\": { \"current_bytes\": %lld, \"peak_bytes\": %lld, \"alloc_count\": %llu, \"free_count\": %llu, \"budget_bytes\": %lld, \"over_budget\": %s }%s\n",
+			MEMORY_STAT_NAMES[i],
+			(long long)s.current_bytes.load(), (long long)s.peak_bytes.load(),
+			(unsigned long long)s.alloc_count.load(), (unsigned long long)s.free_count.load(),
+			(long long)s.budget_bytes, s.is_over_budget ? "true" : "false",
+			i + 1 < MEMORY_STAT_COUNT ? "," : "");
+	}
+	fprintf(fp, "}\n");
+	fclose(fp);
+
+	printf("Memory report : %s\n", path);
+	return true;
+}
+
+void memory_tracker_draw_gui()
+{
+	const ImVec4 over_budget_color(1.f, 0.35f, 0.35f, 1.f);
+
+	if (ImGui::BeginTable("##MemoryTable", 6, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingFixedFit))
+	{
+		ImGui::TableSetupColumn("Subsystem");
+		ImGui::TableSetupColumn("Current (MB)");
+		ImGui::TableSetupColumn("Peak (MB)");
+		ImGui::TableSetupColumn("Allocs");
+		ImGui::TableSetupColumn("Frees");
+		ImGui::TableSetupColumn("Budget (MB)");
+		ImGui::TableHeadersRow();
+
+		for (int i = 0; i < MEMORY_STAT_COUNT; ++i)
+		{
+			MemoryStat* stat = &(g_memory_tracker.stats[i]);
+			ImGui::TableNextRow();
+
+			ImGui::TableNextColumn();
+			if (stat->is_over_budget)
+			{
+				ImGui::TextColored(over_budget_color, "%s", MEMORY_STAT_NAMES[i]);
+			}
+			else
+			{
+				ImGui::Text("%s", MEMORY_STAT_NAMES[i]);
+			}
+
+			ImGui::TableNextColumn();
+			ImGui::Text("%.2f", (double)stat->current_bytes.load() / (1024.0 * 1024.0));
+			ImGui::TableNextColumn();
+			ImGui::Text("%.2f", (double)stat->peak_bytes.load() / (1024.0 * 1024.0));
+			ImGui::TableNextColumn();
+			ImGui::Text("%llu", (unsigned long long)stat->alloc_count.load());
+			ImGui::TableNextColumn();
+			ImGui::Text("%llu", (unsigned long long)stat->free_count.load());
+
+			// 0 budget 
+			ImGui::TableNextColumn();
+			float budget_mb = (float)((double)stat->budget_bytes / (1024.0 * 1024.0));
+			ImGui::PushID(i);
+			ImGui::SetNextItemWidth(80.f);
+			if (ImGui::DragFloat("##Budget", &budget_mb, 1.f, 0.f, 65536.f, budget_mb > 0.f ? "%.1f" : "None"))
+			{
+				stat->budget_bytes = (int64_t)((double)budget_mb * 1024.0 * 1024.0);
+			}
+			ImGui::PopID();
+		}
+		ImGui::EndTable();
+	}
+
+	if (ImGui::Button("Dump JSON"))
+	{
+		memory_tracker_dump_json(g_memory_tracker.dump_path[0] != '\0' ? g_memory_tracker.dump_path : "memory_report.json");
+	}
+}
@@ -0,0 +1,108 @@
+#ifndef __MEMORY_TRACKER_H__
+#define __MEMORY_TRACKER_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+
+#include "glad/glad.h"
+
+// subsystem(tag)  memory 뷮 .
+// CPU : global operator new/delete, ImGui allocator, STBI_MALLOC/STBI_FREE, frame arena block  ⸦ .
+//       Ҵ縶 տ header(ũ, tag) ̹Ƿ    tag    ִ.
+//       operator new  thread  tag ϵǹǷ,  subsystem Ҵ ȣϴ  Ѵ.
+// GPU : buffer/texture/renderbuffer ų   object id ũ⸦ ˷ش. (GL thread)
+//  :
+//   const int last_tag = memory_tag_begin(MEMORY_TAG_MESH);
+//   mesh.position.resize(...);
+//   memory_tag_end(last_tag);
+//
+//   glBufferData(GL_ARRAY_BUFFER, size, data, GL_STATIC_DRAW);
+//   memory_tracker_gpu_set(GPU_MEMORY_BUFFER, vbo, size);
+//   glDeleteBuffers(1, &vbo);
+//   memory_tracker_gpu_release(GPU_MEMORY_BUFFER, vbo);
+//
+// command line : [--memory-budget TAG MB] [--memory-dump PATH]
+
+enum MemoryTag
+{
+	MEMORY_TAG_GENERAL = 0,
+	MEMORY_TAG_MESH,
+	MEMORY_TAG_ANIMATION,
+	MEMORY_TAG_PHYSICS,
+	MEMORY_TAG_ASSIMP,
+	MEMORY_TAG_STB_IMAGE,
+	MEMORY_TAG_IMGUI,
+	MEMORY_TAG_FRAME_ARENA,
+	MEMORY_TAG_COUNT
+};
+
+enum GPUMemoryType
+{
+	GPU_MEMORY_BUFFER = 0,
+	GPU_MEMORY_TEXTURE,
+	GPU_MEMORY_RENDERBUFFER,
+	GPU_MEMORY_TYPE_COUNT
+};
+
+// CPU tag GPU type  ٷ ְ budget ֱ  index
+constexpr int MEMORY_STAT_COUNT = MEMORY_TAG_COUNT + GPU_MEMORY_TYPE_COUNT;
+
+struct MemoryStat
+{
+	std::atomic<int64_t> current_bytes;
+	std::atomic<int64_t> peak_bytes;
+	std::atomic<uint64_t> alloc_count;
+	std::atomic<uint64_t> free_count;
+
+	// 0̶ budget 
+	int64_t budget_bytes;
+	bool is_over_budget;
+};
+
+struct MemoryTracker
+{
+	// [0, MEMORY_TAG_COUNT) CPU tag,  ڴ GPU type
+	MemoryStat stats[MEMORY_STAT_COUNT];
+
+	//   JSON  .  ִٸ  ʴ´.
+	char dump_path[260];
+};
+extern MemoryTracker g_memory_tracker;
+
+void memory_tracker_set_defaults();
+void memory_tracker_print_usage();
+
+// argv[*index] memory tracker ɼ̶  а index ű  true ش.
+bool memory_tracker_parse_arg(int argc, char** argv, int* index);
+
+// ImGui allocator ٲٹǷ imgui_init  ȣѴ.
+void memory_tracker_init();
+
+// --memory-dump ־ٸ Ѵ. GL object   ȣѴ.
+void memory_tracker_terminate();
+
+//  thread operator new  tag ٲٰ  tag ش.  memory_tag_end ǵ.
+int memory_tag_begin(int tag);
+void memory_tag_end(int last_tag);
+
+// tag ϴ malloc/realloc/free. (stb_image, ImGui, frame arena)
+void* memory_tracker_malloc(size_t size, int tag);
+void* memory_tracker_realloc(void* ptr, size_t size, int tag);
+void memory_tracker_free(void* ptr);
+
+// operator new tag  Ҵ   Ҵ Ƚ
+uint64_t memory_tracker_alloc_count();
+
+//  object ٽ θ ũ⸦ ٲ۴. (glBufferData ٽ Ҵϴ )
+void memory_tracker_gpu_set(int type, GLuint id, size_t bytes);
+void memory_tracker_gpu_release(int type, GLuint id);
+
+//  frame   main thread ȣѴ. budget    Ѵ.
+void memory_tracker_update();
+
+bool memory_tracker_dump_json(const char* path);
+
+void memory_tracker_draw_gui();
+
+#endif
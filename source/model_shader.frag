@@ -1,15 +1,22 @@
 #version 330 core
 
 in vec3 v_pos;
-in vec3 v_normal;
 in vec2 v_uv;
+#ifdef USE_NORMAL_MAP
 in mat3 tbn_mat;
+#else
+in vec3 v_normal;
+#endif
 
 layout (location = 0) out vec4 frag_color;
 
-uniform bool is_use_tangent;
-
-uniform vec3 cam_pos;
+// Same layout as CameraBlock in main.cpp. Filled once per frame; late latch rewrites only view_mat and position.
+layout(std140) uniform CameraBlock
+{
+	mat4 view_mat;
+	mat4 projection_mat;
+	vec4 cam_pos;
+};
 
 uniform vec3 sun_dir;
 uniform vec3 sun_ambient;
@@ -17,30 +24,42 @@ uniform vec3 sun_diffuse;
 uniform vec3 sun_specular;
 
 uniform sampler2D diffuse_texture;
+#ifdef USE_NORMAL_MAP
 uniform sampler2D normal_texture;
+#endif
 
 uniform vec3 mat_ambient;
 uniform vec3 mat_diffuse;
 uniform vec3 mat_specular;
 uniform float mat_shininess;
+#ifdef USE_ALPHA_TEST
+uniform float mat_alpha_cutoff;
+#endif
 
 void main()
 {
-	vec3 light_dir = normalize(sun_dir);
-	vec3 view_dir = normalize(cam_pos - v_pos);
-
 	vec4 diffuse_tex_color = texture(diffuse_texture, v_uv);
 
+#ifdef USE_ALPHA_TEST
+	if (diffuse_tex_color.a < mat_alpha_cutoff)
+	{
+		discard;
+	}
+#endif
+
+	vec3 light_dir = normalize(sun_dir);
+	vec3 view_dir = normalize(cam_pos.xyz - v_pos);
+
 	vec3 ambient_color = sun_ambient * mat_ambient * diffuse_tex_color.xyz;
 
+#ifdef USE_NORMAL_MAP
+	// Normal Mapping : get new normal, and then transform it into world space.
+	vec3 normal = texture(normal_texture, v_uv).xyz;
+	normal = normalize(normal * 2.0 - 1.0);
+	normal = tbn_mat * normal;
+#else
 	vec3 normal = v_normal;
-	if (is_use_tangent)
-	{
-		// Normal Mapping : get new normal, and then transform it into world space.
-		normal = texture(normal_texture, v_uv).xyz;
-		normal = normalize(normal * 2.0 - 1.0);
-		normal = tbn_mat * normal;
-	}
+#endif
 	normal = normalize(normal);
 
 	float diff = max(dot(normal, light_dir), 0.0);
@@ -51,7 +70,9 @@ void main()
 	vec3 specular_color = sun_specular * mat_specular * spec;
 
 	vec4 lighting_color = vec4(ambient_color + diffuse_color + specular_color, 1.0);
+#ifdef USE_TRANSPARENCY
 	lighting_color.a *= diffuse_tex_color.a;
+#endif
 
 	frag_color = lighting_color;
-}
\ No newline at end of file
+}
@@ -1,36 +1,101 @@
 #version 330 core
+// Variants (injected by the permutation system right after #version)
+// USE_NORMAL_MAP   : tangent attribute + TBN matrix for normal mapping
+// USE_ALPHA_TEST   : (fragment only)
+// USE_TRANSPARENCY : (fragment only)
+// USE_INSTANCING   : per instance world matrix attribute instead of the world_mat uniform
+// USE_SKINNING     : blend up to 4 bone matrices from the bone_palette texture buffer
 layout(location = 0) in vec4 a_pos;
 layout(location = 1) in vec3 a_normal;
+#ifdef USE_NORMAL_MAP
 layout(location = 2) in vec3 a_tangent;
+#endif
 layout(location = 3) in vec2 a_uv;
+#ifdef USE_INSTANCING
+layout(location = 4) in mat4 a_instance_world;
+#endif
+#ifdef USE_SKINNING
+layout(location = 8) in uvec4 a_joints;
+layout(location = 9) in vec4 a_weights;
+layout(location = 10) in uint a_instance_pose;	// divisor 1 : which pose of the palette this instance uses
+#endif
 
 out vec3 v_pos;
-out vec3 v_normal;
 out vec2 v_uv;
+#ifdef USE_NORMAL_MAP
 out mat3 tbn_mat;
+#else
+out vec3 v_normal;
+#endif
 
+#ifndef USE_INSTANCING
 uniform mat4 world_mat;
-uniform mat4 view_mat;
-uniform mat4 projection_mat;
+#endif
+// Same layout as CameraBlock in main.cpp. Filled once per frame; late latch rewrites only view_mat and position.
+layout(std140) uniform CameraBlock
+{
+	mat4 view_mat;
+	mat4 projection_mat;
+	vec4 cam_pos;
+};
 
-uniform bool is_use_tangent;
+#ifdef USE_SKINNING
+// Same layout as SkinMatrix in animation.h : 3 RGBA32F texels (rows of an affine matrix) per bone.
+// Bone b of this mesh for pose p is at (p * palette_stride + bone_base + b).
+uniform samplerBuffer bone_palette;
+uniform int bone_base;
+uniform int palette_stride;
+#endif
 
 void main()
 {
-	v_pos = vec3((world_mat * a_pos).xyz);
-	v_normal = mat3(world_mat) * a_normal;
-	v_uv = a_uv;
-	gl_Position = projection_mat * view_mat * vec4(v_pos, 1.0);
+#ifdef USE_INSTANCING
+	mat4 world = a_instance_world;
+#else
+	mat4 world = world_mat;
+#endif
+
+	vec4 pos = a_pos;
+	vec3 local_normal = a_normal;
+#ifdef USE_NORMAL_MAP
+	vec3 local_tangent = a_tangent;
+#endif
 
-	if (is_use_tangent)
+#ifdef USE_SKINNING
+	// Blend the rows, then transform once. Weights sum to 1 so the result stays affine.
+	int base = (int(a_instance_pose) * palette_stride + bone_base) * 3;
+	vec4 row0 = vec4(0.0);
+	vec4 row1 = vec4(0.0);
+	vec4 row2 = vec4(0.0);
+	for (int i = 0; i < 4; ++i)
 	{
-		// Gram-scmidt Process
-		vec3 T = normalize(vec3(world_mat * vec4(a_tangent, 0.0)));
-		vec3 N = normalize(v_normal);
-		T = normalize(T - dot(T, N) * N);
-		vec3 B = cross(N, T);
-		tbn_mat = mat3(T, B, N);
-
-		// and then use the normal/depth map in fragment shader with TBNmat
+		int texel = base + int(a_joints[i]) * 3;
+		row0 += a_weights[i] * texelFetch(bone_palette, texel);
+		row1 += a_weights[i] * texelFetch(bone_palette, texel + 1);
+		row2 += a_weights[i] * texelFetch(bone_palette, texel + 2);
 	}
-}
\ No newline at end of file
+	pos = vec4(dot(row0, a_pos), dot(row1, a_pos), dot(row2, a_pos), 1.0);
+	local_normal = vec3(dot(row0.xyz, a_normal), dot(row1.xyz, a_normal), dot(row2.xyz, a_normal));
+#ifdef USE_NORMAL_MAP
+	local_tangent = vec3(dot(row0.xyz, a_tangent), dot(row1.xyz, a_tangent), dot(row2.xyz, a_tangent));
+#endif
+#endif
+
+	v_pos = vec3((world * pos).xyz);
+	v_uv = a_uv;
+	gl_Position = projection_mat * view_mat * vec4(v_pos, 1.0);
+
+	vec3 normal = mat3(world) * local_normal;
+#ifdef USE_NORMAL_MAP
+	// Gram-scmidt Process
+	vec3 T = normalize(vec3(world * vec4(local_tangent, 0.0)));
+	vec3 N = normalize(normal);
+	T = normalize(T - dot(T, N) * N);
+	vec3 B = cross(N, T);
+	tbn_mat = mat3(T, B, N);
+
+	// and then use the normal/depth map in fragment shader with TBNmat
+#else
+	v_normal = normal;
+#endif
+}
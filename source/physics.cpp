@@ -0,0 +1,853 @@
+#include "physics.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include <assert.h>
+#include <chrono>
+#include <algorithm>
+
+#include "imgui/imgui.h"
+#include "job_system.h"
+#include "memory_tracker.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PHYSICS_SSE 1
+#include <emmintrin.h>
+#else
+#define PHYSICS_SSE 0
+#endif
+
+PhysicsWorld g_physics;
+
+//  index ׻  0 ~ 1 
+static float physics_hash01(uint32_t value)
+{
+	value ^= value >> 16;
+	value *= 0x7FEB352Du;
+	value ^= value >> 15;
+	value *= 0x846CA68Bu;
+	value ^= value >> 16;
+	return (float)(value & 0xFFFFFF) / (float)0xFFFFFF;
+}
+
+//   迭 capacity . þ body  ʴ bind ´.
+static void physics_resize(int capacity)
+{
+	const int last_tag = memory_tag_begin(MEMORY_TAG_PHYSICS);
+
+	std::vector<float>* zero_arrays[] =
+	{
+		&g_physics.position_x, &g_physics.position_y, &g_physics.position_z,
+		&g_physics.orientation_x, &g_physics.orientation_y, &g_physics.orientation_z,
+		&g_physics.linear_velocity_x, &g_physics.linear_velocity_y, &g_physics.linear_velocity_z,
+		&g_physics.angular_velocity_x, &g_physics.angular_velocity_y, &g_physics.angular_velocity_z,
+		&g_physics.inverse_mass, &g_physics.inverse_inertia, &g_physics.radius,
+		&g_physics.previous_position_x, &g_physics.previous_position_y, &g_physics.previous_position_z,
+		&g_physics.previous_orientation_x, &g_physics.previous_orientation_y, &g_physics.previous_orientation_z,
+	};
+	for (std::vector<float>* array : zero_arrays)
+	{
+		array->resize(capacity, 0.f);
+	}
+	g_physics.orientation_w.resize(capacity, 1.f);
+	g_physics.previous_orientation_w.resize(capacity, 1.f);
+	g_physics.capacity = capacity;
+
+	memory_tag_end(last_tag);
+}
+
+void physics_set_defaults()
+{
+	g_physics.is_enable = false;
+	g_physics.test_mode = PHYSICS_TEST_NONE;
+	g_physics.step_hz = PHYSICS_DEFAULT_STEP_HZ;
+	g_physics.gravity = glm::vec3(0.f, -9.8f, 0.f);
+	g_physics.ground_height = 0.f;
+	g_physics.restitution = 0.4f;
+	g_physics.friction = 0.5f;
+	g_physics.linear_damping = 0.05f;
+	g_physics.angular_damping = 0.2f;
+	g_physics.picked_body = -1;
+	broadphase_set_defaults();
+}
+
+void physics_print_usage()
+{
+	printf("  --physics                   drop the model instances as rigid bodies\n");
+	printf("  --physics-hz HZ             fixed physics steps per second (default %.0f)\n", PHYSICS_DEFAULT_STEP_HZ);
+	printf("  --physics-bench             run the rigid body scaling/determinism benchmark without a window and exit\n");
+	broadphase_print_usage();
+}
+
+bool physics_parse_arg(int argc, char** argv, int* index)
+{
+	const char* arg = argv[*index];
+	if (strcmp(arg, "--physics") == 0)
+	{
+		g_physics.is_enable = true;
+		return true;
+	}
+	if (strcmp(arg, "--physics-bench") == 0)
+	{
+		g_physics.test_mode = PHYSICS_TEST_BENCH;
+		return true;
+	}
+	if (strcmp(arg, "--physics-hz") == 0 && *index + 1 < argc)
+	{
+		const float step_hz = (float)atof(argv[*index + 1]);
+		if (step_hz < 1.f)
+		{
+			return false;
+		}
+		g_physics.step_hz = step_hz;
+		++(*index);
+		return true;
+	}
+	return broadphase_parse_arg(argc, argv, index);
+}
+
+void physics_clear()
+{
+	g_physics.body_count = 0;
+	physics_resize(0);
+	g_physics.accumulator = 0.f;
+	g_physics.alpha = 0.f;
+	g_physics.step_count = 0;
+	g_physics.picked_body = -1;
+	g_physics.contact_count = 0;
+	g_physics.broadphase_drift = 0.f;
+	g_physics.body_aabbs.clear();
+	g_physics.body_displacements.clear();
+	broadphase_clear(&g_broadphase);
+	++g_physics.version;
+}
+
+void physics_terminate()
+{
+	physics_clear();
+
+	std::vector<float>* arrays[] =
+	{
+		&g_physics.position_x, &g_physics.position_y, &g_physics.position_z,
+		&g_physics.orientation_x, &g_physics.orientation_y, &g_physics.orientation_z, &g_physics.orientation_w,
+		&g_physics.linear_velocity_x, &g_physics.linear_velocity_y, &g_physics.linear_velocity_z,
+		&g_physics.angular_velocity_x, &g_physics.angular_velocity_y, &g_physics.angular_velocity_z,
+		&g_physics.inverse_mass, &g_physics.inverse_inertia, &g_physics.radius,
+		&g_physics.previous_position_x, &g_physics.previous_position_y, &g_physics.previous_position_z,
+		&g_physics.previous_orientation_x, &g_physics.previous_orientation_y, &g_physics.previous_orientation_z, &g_physics.previous_orientation_w,
+	};
+	for (std::vector<float>* array : arrays)
+	{
+		array->shrink_to_fit();
+	}
+	g_physics.body_aabbs.shrink_to_fit();
+	g_physics.body_displacements.shrink_to_fit();
+}
+
+int physics_add_body(const glm::vec3& position, const glm::quat& orientation, float radius, float mass,
+	const glm::vec3& linear_velocity, const glm::vec3& angular_velocity)
+{
+	const int index = g_physics.body_count;
+	if (index >= g_physics.capacity)
+	{
+		// 迭  ٽ Ҵ ʵ  辿 ø.
+		physics_resize(std::max(4, g_physics.capacity * 2));
+	}
+	++g_physics.body_count;
+
+	g_physics.position_x[index] = g_physics.previous_position_x[index] = position.x;
+	g_physics.position_y[index] = g_physics.previous_position_y[index] = position.y;
+	g_physics.position_z[index] = g_physics.previous_position_z[index] = position.z;
+	g_physics.orientation_x[index] = g_physics.previous_orientation_x[index] = orientation.x;
+	g_physics.orientation_y[index] = g_physics.previous_orientation_y[index] = orientation.y;
+	g_physics.orientation_z[index] = g_physics.previous_orientation_z[index] = orientation.z;
+	g_physics.orientation_w[index] = g_physics.previous_orientation_w[index] = orientation.w;
+	g_physics.linear_velocity_x[index] = linear_velocity.x;
+	g_physics.linear_velocity_y[index] = linear_velocity.y;
+	g_physics.linear_velocity_z[index] = linear_velocity.z;
+	g_physics.angular_velocity_x[index] = angular_velocity.x;
+	g_physics.angular_velocity_y[index] = angular_velocity.y;
+	g_physics.angular_velocity_z[index] = angular_velocity.z;
+
+	//     Ʈ 2/5 m r^2
+	radius = std::max(radius, 1e-3f);
+	g_physics.radius[index] = radius;
+	g_physics.inverse_mass[index] = mass > 0.f ? 1.f / mass : 0.f;
+	g_physics.inverse_inertia[index] = mass > 0.f ? 1.f / (0.4f * mass * radius * radius) : 0.f;
+
+	++g_physics.version;
+	return index;
+}
+
+void physics_reset_grid(int count, float spacing, float radius)
+{
+	physics_clear();
+	physics_resize((count + 3) & ~3);
+
+	// model instance  grid  ٸ ̿ ӵ .
+	const int grid_side = (int)ceil(sqrt((double)count));
+	const float grid_half = (grid_side - 1) * 0.5f;
+	for (int i = 0; i < count; ++i)
+	{
+		const float height = radius * (1.f + 6.f * physics_hash01(i * 4 + 0));
+		const glm::vec3 position(((i % grid_side) - grid_half) * spacing, g_physics.ground_height + radius + height, ((i / grid_side) - grid_half) * spacing);
+		const glm::vec3 linear_velocity((physics_hash01(i * 4 + 1) - 0.5f) * 2.f, 0.f, (physics_hash01(i * 4 + 2) - 0.5f) * 2.f);
+		const glm::vec3 angular_velocity(0.f, (physics_hash01(i * 4 + 3) - 0.5f) * 4.f, 0.f);
+		physics_add_body(position, glm::quat(1.f, 0.f, 0.f, 0.f), radius, 1.f, linear_velocity, angular_velocity);
+	}
+}
+
+void physics_integrate_range_scalar(float dt, int begin, int end)
+{
+	PhysicsWorld* w = &g_physics;
+	const float linear_damping = 1.f / (1.f + dt * w->linear_damping);
+	const float angular_damping = 1.f / (1.f + dt * w->angular_damping);
+	const float half_dt = 0.5f * dt;
+
+	for (int i = begin; i < end; ++i)
+	{
+		w->previous_position_x[i] = w->position_x[i];
+		w->previous_position_y[i] = w->position_y[i];
+		w->previous_position_z[i] = w->position_z[i];
+		w->previous_orientation_x[i] = w->orientation_x[i];
+		w->previous_orientation_y[i] = w->orientation_y[i];
+		w->previous_orientation_z[i] = w->orientation_z[i];
+		w->previous_orientation_w[i] = w->orientation_w[i];
+
+		const float inverse_mass = w->inverse_mass[i];
+		if (inverse_mass <= 0.f)
+		{
+			continue;
+		}
+
+		// ӵ  ϰ  ӵ ġ ű.
+		float vx = (w->linear_velocity_x[i] + w->gravity.x * dt) * linear_damping;
+		float vy = (w->linear_velocity_y[i] + w->gravity.y * dt) * linear_damping;
+		float vz = (w->linear_velocity_z[i] + w->gravity.z * dt) * linear_damping;
+		float ax = w->angular_velocity_x[i] * angular_damping;
+		float ay = w->angular_velocity_y[i] * angular_damping;
+		float az = w->angular_velocity_z[i] * angular_damping;
+
+		const float px = w->position_x[i] + vx * dt;
+		float py = w->position_y[i] + vy * dt;
+		const float pz = w->position_z[i] + vz * dt;
+
+		// q += dt / 2 * (w, 0) * q
+		const float qx = w->orientation_x[i], qy = w->orientation_y[i], qz = w->orientation_z[i], qw = w->orientation_w[i];
+		float nx = qx + half_dt * (ax * qw + ay * qz - az * qy);
+		float ny = qy + half_dt * (ay * qw + az * qx - ax * qz);
+		float nz = qz + half_dt * (az * qw + ax * qy - ay * qx);
+		float nw = qw - half_dt * (ax * qx + ay * qy + az * qz);
+		const float inverse_length = 1.f / sqrtf(nx * nx + ny * ny + nz * nz + nw * nw);
+		nx *= inverse_length; ny *= inverse_length; nz *= inverse_length; nw *= inverse_length;
+
+		// ٴ .  ӵ ְ(ٸ ݹ ŭ ǵ),  ݷ ȿ ̲ ӵ  δ.
+		const float radius = w->radius[i];
+		if (py - radius < w->ground_height)
+		{
+			py = w->ground_height + radius;
+			const float bounce = vy < -PHYSICS_RESTITUTION_MIN_SPEED ? 1.f + w->restitution : 1.f;
+			const float normal_dv = vy < 0.f ? -bounce * vy : 0.f;
+			vy += normal_dv;
+
+			const float slip_x = vx + radius * az;
+			const float slip_z = vz - radius * ax;
+			const float inverse_inertia = w->inverse_inertia[i];
+			const float k = inverse_mass + inverse_inertia * radius * radius;
+			const float max_impulse = w->friction * normal_dv / inverse_mass;
+			const float impulse_x = std::max(-max_impulse, std::min(max_impulse, -slip_x / k));
+			const float impulse_z = std::max(-max_impulse, std::min(max_impulse, -slip_z / k));
+			vx += impulse_x * inverse_mass;
+			vz += impulse_z * inverse_mass;
+			ax += inverse_inertia * -radius * impulse_z;
+			az += inverse_inertia * radius * impulse_x;
+		}
+
+		w->position_x[i] = px; w->position_y[i] = py; w->position_z[i] = pz;
+		w->orientation_x[i] = nx; w->orientation_y[i] = ny; w->orientation_z[i] = nz; w->orientation_w[i] = nw;
+		w->linear_velocity_x[i] = vx; w->linear_velocity_y[i] = vy; w->linear_velocity_z[i] = vz;
+		w->angular_velocity_x[i] = ax; w->angular_velocity_y[i] = ay; w->angular_velocity_z[i] = az;
+	}
+}
+
+#if PHYSICS_SSE
+// mask ? a : b
+static __m128 physics_select(__m128 mask, __m128 a, __m128 b)
+{
+	return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+#endif
+
+void physics_integrate_range(float dt, int begin, int end)
+{
+#if PHYSICS_SSE
+	assert((begin & 3) == 0 && (end & 3) == 0);
+	PhysicsWorld* w = &g_physics;
+	const __m128 v_dt = _mm_set1_ps(dt);
+	const __m128 half_dt = _mm_set1_ps(0.5f * dt);
+	const __m128 linear_damping = _mm_set1_ps(1.f / (1.f + dt * w->linear_damping));
+	const __m128 angular_damping = _mm_set1_ps(1.f / (1.f + dt * w->angular_damping));
+	const __m128 gravity_dt_x = _mm_set1_ps(w->gravity.x * dt);
+	const __m128 gravity_dt_y = _mm_set1_ps(w->gravity.y * dt);
+	const __m128 gravity_dt_z = _mm_set1_ps(w->gravity.z * dt);
+	const __m128 ground = _mm_set1_ps(w->ground_height);
+	const __m128 restitution = _mm_set1_ps(1.f + w->restitution);
+	const __m128 restitution_min_speed = _mm_set1_ps(-PHYSICS_RESTITUTION_MIN_SPEED);
+	const __m128 friction = _mm_set1_ps(w->friction);
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.f);
+
+	for (int i = begin; i < end; i += 4)
+	{
+		const __m128 px0 = _mm_loadu_ps(&(w->position_x[i]));
+		const __m128 py0 = _mm_loadu_ps(&(w->position_y[i]));
+		const __m128 pz0 = _mm_loadu_ps(&(w->position_z[i]));
+		const __m128 qx = _mm_loadu_ps(&(w->orientation_x[i]));
+		const __m128 qy = _mm_loadu_ps(&(w->orientation_y[i]));
+		const __m128 qz = _mm_loadu_ps(&(w->orientation_z[i]));
+		const __m128 qw = _mm_loadu_ps(&(w->orientation_w[i]));
+		_mm_storeu_ps(&(w->previous_position_x[i]), px0);
+		_mm_storeu_ps(&(w->previous_position_y[i]), py0);
+		_mm_storeu_ps(&(w->previous_position_z[i]), pz0);
+		_mm_storeu_ps(&(w->previous_orientation_x[i]), qx);
+		_mm_storeu_ps(&(w->previous_orientation_y[i]), qy);
+		_mm_storeu_ps(&(w->previous_orientation_z[i]), qz);
+		_mm_storeu_ps(&(w->previous_orientation_w[i]), qw);
+
+		// inverse mass 0 body(þ ڸ ) ״ д.
+		const __m128 inverse_mass = _mm_loadu_ps(&(w->inverse_mass[i]));
+		const __m128 dynamic = _mm_cmpgt_ps(inverse_mass, zero);
+		if (_mm_movemask_ps(dynamic) == 0)
+		{
+			continue;
+		}
+
+		const __m128 vx0 = _mm_loadu_ps(&(w->linear_velocity_x[i]));
+		const __m128 vy0 = _mm_loadu_ps(&(w->linear_velocity_y[i]));
+		const __m128 vz0 = _mm_loadu_ps(&(w->linear_velocity_z[i]));
+		const __m128 ax0 = _mm_loadu_ps(&(w->angular_velocity_x[i]));
+		const __m128 ay0 = _mm_loadu_ps(&(w->angular_velocity_y[i]));
+		const __m128 az0 = _mm_loadu_ps(&(w->angular_velocity_z[i]));
+
+		__m128 vx = _mm_mul_ps(_mm_add_ps(vx0, gravity_dt_x), linear_damping);
+		__m128 vy = _mm_mul_ps(_mm_add_ps(vy0, gravity_dt_y), linear_damping);
+		__m128 vz = _mm_mul_ps(_mm_add_ps(vz0, gravity_dt_z), linear_damping);
+		__m128 ax = _mm_mul_ps(ax0, angular_damping);
+		const __m128 ay = _mm_mul_ps(ay0, angular_damping);
+		__m128 az = _mm_mul_ps(az0, angular_damping);
+
+		const __m128 px = _mm_add_ps(px0, _mm_mul_ps(vx, v_dt));
+		__m128 py = _mm_add_ps(py0, _mm_mul_ps(vy, v_dt));
+		const __m128 pz = _mm_add_ps(pz0, _mm_mul_ps(vz, v_dt));
+
+		__m128 nx = _mm_add_ps(qx, _mm_mul_ps(half_dt, _mm_sub_ps(_mm_add_ps(_mm_mul_ps(ax, qw), _mm_mul_ps(ay, qz)), _mm_mul_ps(az, qy))));
+		__m128 ny = _mm_add_ps(qy, _mm_mul_ps(half_dt, _mm_sub_ps(_mm_add_ps(_mm_mul_ps(ay, qw), _mm_mul_ps(az, qx)), _mm_mul_ps(ax, qz))));
+		__m128 nz = _mm_add_ps(qz, _mm_mul_ps(half_dt, _mm_sub_ps(_mm_add_ps(_mm_mul_ps(az, qw), _mm_mul_ps(ax, qy)), _mm_mul_ps(ay, qx))));
+		__m128 nw = _mm_sub_ps(qw, _mm_mul_ps(half_dt, _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax, qx), _mm_mul_ps(ay, qy)), _mm_mul_ps(az, qz))));
+		const __m128 length_sq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, nx), _mm_mul_ps(ny, ny)), _mm_add_ps(_mm_mul_ps(nz, nz), _mm_mul_ps(nw, nw)));
+		const __m128 inverse_length = _mm_div_ps(one, _mm_sqrt_ps(length_sq));
+		nx = _mm_mul_ps(nx, inverse_length);
+		ny = _mm_mul_ps(ny, inverse_length);
+		nz = _mm_mul_ps(nz, inverse_length);
+		nw = _mm_mul_ps(nw, inverse_length);
+
+		// ٴ  (scalar  )
+		const __m128 radius = _mm_loadu_ps(&(w->radius[i]));
+		const __m128 rest_height = _mm_add_ps(ground, radius);
+		const __m128 contact = _mm_cmplt_ps(py, rest_height);
+		if (_mm_movemask_ps(contact) != 0)
+		{
+			py = physics_select(contact, rest_height, py);
+			const __m128 approaching = _mm_and_ps(contact, _mm_cmplt_ps(vy, zero));
+			const __m128 bounce = physics_select(_mm_cmplt_ps(vy, restitution_min_speed), restitution, one);
+			const __m128 normal_dv = _mm_and_ps(approaching, _mm_mul_ps(_mm_sub_ps(zero, bounce), vy));
+			vy = _mm_add_ps(vy, normal_dv);
+
+			const __m128 inverse_inertia = _mm_loadu_ps(&(w->inverse_inertia[i]));
+			const __m128 slip_x = _mm_add_ps(vx, _mm_mul_ps(radius, az));
+			const __m128 slip_z = _mm_sub_ps(vz, _mm_mul_ps(radius, ax));
+			const __m128 k = _mm_add_ps(inverse_mass, _mm_mul_ps(inverse_inertia, _mm_mul_ps(radius, radius)));
+			const __m128 max_impulse = _mm_div_ps(_mm_mul_ps(friction, normal_dv), inverse_mass);
+			const __m128 min_impulse = _mm_sub_ps(zero, max_impulse);
+			__m128 impulse_x = _mm_max_ps(min_impulse, _mm_min_ps(max_impulse, _mm_div_ps(_mm_sub_ps(zero, slip_x), k)));
+			__m128 impulse_z = _mm_max_ps(min_impulse, _mm_min_ps(max_impulse, _mm_div_ps(_mm_sub_ps(zero, slip_z), k)));
+
+			//  body 0   mask .
+			impulse_x = _mm_and_ps(_mm_and_ps(contact, dynamic), impulse_x);
+			impulse_z = _mm_and_ps(_mm_and_ps(contact, dynamic), impulse_z);
+			vx = _mm_add_ps(vx, _mm_mul_ps(impulse_x, inverse_mass));
+			vz = _mm_add_ps(vz, _mm_mul_ps(impulse_z, inverse_mass));
+			ax = _mm_add_ps(ax, _mm_mul_ps(inverse_inertia, _mm_mul_ps(_mm_sub_ps(zero, radius), impulse_z)));
+			az = _mm_add_ps(az, _mm_mul_ps(inverse_inertia, _mm_mul_ps(radius, impulse_x)));
+		}
+
+		_mm_storeu_ps(&(w->position_x[i]), physics_select(dynamic, px, px0));
+		_mm_storeu_ps(&(w->position_y[i]), physics_select(dynamic, py, py0));
+		_mm_storeu_ps(&(w->position_z[i]), physics_select(dynamic, pz, pz0));
+		_mm_storeu_ps(&(w->orientation_x[i]), physics_select(dynamic, nx, qx));
+		_mm_storeu_ps(&(w->orientation_y[i]), physics_select(dynamic, ny, qy));
+		_mm_storeu_ps(&(w->orientation_z[i]), physics_select(dynamic, nz, qz));
+		_mm_storeu_ps(&(w->orientation_w[i]), physics_select(dynamic, nw, qw));
+		_mm_storeu_ps(&(w->linear_velocity_x[i]), physics_select(dynamic, vx, vx0));
+		_mm_storeu_ps(&(w->linear_velocity_y[i]), physics_select(dynamic, vy, vy0));
+		_mm_storeu_ps(&(w->linear_velocity_z[i]), physics_select(dynamic, vz, vz0));
+		_mm_storeu_ps(&(w->angular_velocity_x[i]), physics_select(dynamic, ax, ax0));
+		_mm_storeu_ps(&(w->angular_velocity_y[i]), physics_select(dynamic, ay, ay0));
+		_mm_storeu_ps(&(w->angular_velocity_z[i]), physics_select(dynamic, az, az0));
+	}
+#else
+	physics_integrate_range_scalar(dt, begin, end);
+#endif
+}
+
+void physics_step(float dt)
+{
+	parallel_for_range(g_physics.capacity, PHYSICS_BATCH_SIZE, [dt](int begin, int end)
+	{
+		physics_integrate_range(dt, begin, end);
+	});
+	physics_solve_contacts();
+	++g_physics.step_count;
+	++g_physics.version;
+}
+
+// body  AABB broadphase  AABB(body_aabbs)   Ÿ   ū 
+static float physics_broadphase_drift(int index)
+{
+	const PhysicsWorld* w = &g_physics;
+	const glm::vec3 position(w->position_x[index], w->position_y[index], w->position_z[index]);
+	const BroadphaseAABB& aabb = w->body_aabbs[index];
+	const glm::vec3 drift = glm::max(position + w->radius[index] - aabb.max, aabb.min - (position - w->radius[index]));
+	return std::max(std::max(drift.x, drift.y), std::max(drift.z, 0.f));
+}
+
+void physics_solve_contacts()
+{
+	PhysicsWorld* w = &g_physics;
+	const int count = w->body_count;
+	w->contact_count = 0;
+	w->broadphase_drift = 0.f;
+	if (count == 0)
+	{
+		return;
+	}
+
+	{
+		const int last_tag = memory_tag_begin(MEMORY_TAG_PHYSICS);
+		w->body_aabbs.resize(count);
+		w->body_displacements.resize(count);
+		memory_tag_end(last_tag);
+	}
+	parallel_for_range(count, PHYSICS_BATCH_SIZE, [w](int begin, int end)
+	{
+		for (int i = begin; i < end; ++i)
+		{
+			const glm::vec3 position(w->position_x[i], w->position_y[i], w->position_z[i]);
+			const glm::vec3 previous_position(w->previous_position_x[i], w->previous_position_y[i], w->previous_position_z[i]);
+			w->body_aabbs[i] = { position - glm::vec3(w->radius[i]), position + glm::vec3(w->radius[i]) };
+			w->body_displacements[i] = position - previous_position;
+		}
+	});
+	broadphase_update(&g_broadphase, w->body_aabbs.data(), w->body_displacements.data(), count);
+
+	//  thread pair  Ǭ.   ٲ ӵ ġ   д´.
+	//    fat AABB pair Ǯ sap  ޶Ƿ, body_aabbs( ) ġ pair Ǭ.
+	for (const BroadphasePair& pair : g_broadphase.pairs)
+	{
+		const int a = pair.a;
+		const int b = pair.b;
+		if (!broadphase_overlap(w->body_aabbs[a], w->body_aabbs[b]))
+		{
+			continue;
+		}
+
+		const float inverse_mass_a = w->inverse_mass[a];
+		const float inverse_mass_b = w->inverse_mass[b];
+		const float inverse_mass_sum = inverse_mass_a + inverse_mass_b;
+		if (inverse_mass_sum <= 0.f)
+		{
+			continue;
+		}
+
+		const float dx = w->position_x[b] - w->position_x[a];
+		const float dy = w->position_y[b] - w->position_y[a];
+		const float dz = w->position_z[b] - w->position_z[a];
+		const float distance_sq = dx * dx + dy * dy + dz * dz;
+		const float radius_sum = w->radius[a] + w->radius[b];
+		if (distance_sq >= radius_sum * radius_sum)
+		{
+			continue;
+		}
+		++w->contact_count;
+
+		// ߽ ٸ  о.
+		const float distance = sqrtf(distance_sq);
+		const glm::vec3 normal = distance > 1e-6f ? glm::vec3(dx, dy, dz) / distance : glm::vec3(0.f, 1.f, 0.f);
+
+		//  ӵ ְ, ٸ ݹ ŭ ǵ.
+		const float normal_speed =
+			(w->linear_velocity_x[b] - w->linear_velocity_x[a]) * normal.x +
+			(w->linear_velocity_y[b] - w->linear_velocity_y[a]) * normal.y +
+			(w->linear_velocity_z[b] - w->linear_velocity_z[a]) * normal.z;
+		if (normal_speed < 0.f)
+		{
+			const float bounce = normal_speed < -PHYSICS_RESTITUTION_MIN_SPEED ? 1.f + w->restitution : 1.f;
+			const glm::vec3 impulse = normal * (-bounce * normal_speed / inverse_mass_sum);
+			w->linear_velocity_x[a] -= impulse.x * inverse_mass_a;
+			w->linear_velocity_y[a] -= impulse.y * inverse_mass_a;
+			w->linear_velocity_z[a] -= impulse.z * inverse_mass_a;
+			w->linear_velocity_x[b] += impulse.x * inverse_mass_b;
+			w->linear_velocity_y[b] += impulse.y * inverse_mass_b;
+			w->linear_velocity_z[b] += impulse.z * inverse_mass_b;
+		}
+
+		// ģ ̸     о. ٴ Ʒδ  ʴ´.
+		const glm::vec3 correction = normal * (std::max(radius_sum - distance - PHYSICS_CONTACT_SLOP, 0.f) * PHYSICS_CONTACT_CORRECTION / inverse_mass_sum);
+		w->position_x[a] -= correction.x * inverse_mass_a;
+		w->position_y[a] = std::max(w->position_y[a] - correction.y * inverse_mass_a, w->ground_height + w->radius[a]);
+		w->position_z[a] -= correction.z * inverse_mass_a;
+		w->position_x[b] += correction.x * inverse_mass_b;
+		w->position_y[b] = std::max(w->position_y[b] + correction.y * inverse_mass_b, w->ground_height + w->radius[b]);
+		w->position_z[b] += correction.z * inverse_mass_b;
+
+		w->broadphase_drift = std::max(w->broadphase_drift, std::max(physics_broadphase_drift(a), physics_broadphase_drift(b)));
+	}
+}
+
+bool physics_update(float delta_time)
+{
+	g_physics.frame_step_count = 0;
+	if (!g_physics.is_enable || g_physics.body_count == 0)
+	{
+		return false;
+	}
+
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	const float step_time = 1.f / g_physics.step_hz;
+	g_physics.accumulator += delta_time;
+	while (g_physics.accumulator >= step_time && g_physics.frame_step_count < PHYSICS_MAX_STEPS_PER_FRAME)
+	{
+		physics_step(step_time);
+		g_physics.accumulator -= step_time;
+		++g_physics.frame_step_count;
+	}
+
+	//   ð .  ŭ ùķ̼ ʰ 帥.
+	if (g_physics.accumulator >= step_time)
+	{
+		g_physics.accumulator = fmodf(g_physics.accumulator, step_time);
+	}
+	g_physics.alpha = g_physics.accumulator / step_time;
+	++g_physics.version;
+
+	g_physics.step_ms = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+	return true;
+}
+
+glm::mat4 physics_body_matrix(int index)
+{
+	const PhysicsWorld* w = &g_physics;
+	const float alpha = w->alpha;
+	const glm::vec3 previous_position(w->previous_position_x[index], w->previous_position_y[index], w->previous_position_z[index]);
+	const glm::vec3 position(w->position_x[index], w->position_y[index], w->position_z[index]);
+	const glm::quat previous_orientation(w->previous_orientation_w[index], w->previous_orientation_x[index], w->previous_orientation_y[index], w->previous_orientation_z[index]);
+	glm::quat orientation(w->orientation_w[index], w->orientation_x[index], w->orientation_y[index], w->orientation_z[index]);
+	if (glm::dot(previous_orientation, orientation) < 0.f)
+	{
+		orientation = -orientation;
+	}
+
+	glm::mat4 world = glm::mat4_cast(glm::normalize(previous_orientation + (orientation - previous_orientation) * alpha));
+	world[3] = glm::vec4(previous_position + (position - previous_position) * alpha, 1.f);
+	return world;
+}
+
+void physics_apply_impulse(int index, const glm::vec3& impulse, const glm::vec3& point)
+{
+	PhysicsWorld* w = &g_physics;
+	const float inverse_mass = w->inverse_mass[index];
+	if (inverse_mass <= 0.f)
+	{
+		return;
+	}
+
+	const glm::vec3 arm = point - glm::vec3(w->position_x[index], w->position_y[index], w->position_z[index]);
+	const glm::vec3 angular_impulse = glm::cross(arm, impulse) * w->inverse_inertia[index];
+	w->linear_velocity_x[index] += impulse.x * inverse_mass;
+	w->linear_velocity_y[index] += impulse.y * inverse_mass;
+	w->linear_velocity_z[index] += impulse.z * inverse_mass;
+	w->angular_velocity_x[index] += angular_impulse.x;
+	w->angular_velocity_y[index] += angular_impulse.y;
+	w->angular_velocity_z[index] += angular_impulse.z;
+}
+
+int physics_raycast(const glm::vec3& origin, const glm::vec3& direction, float max_distance, float* out_distance)
+{
+	// broadphase  step body  ־ Ѵ.   Ű ŭ AABB ÷ ã´.
+	if (g_broadphase.proxy_count != g_physics.body_count || g_physics.body_count == 0)
+	{
+		*out_distance = -1.f;
+		return -1;
+	}
+
+	const glm::vec3 unit_direction = glm::normalize(direction);
+	return broadphase_raycast(&g_broadphase, origin, unit_direction, max_distance, g_physics.broadphase_drift, [&origin, &unit_direction](int body, float max_distance)
+	{
+		// |origin + t * direction - center| = radius   
+		const PhysicsWorld* w = &g_physics;
+		const glm::vec3 offset = origin - glm::vec3(w->position_x[body], w->position_y[body], w->position_z[body]);
+		const float b = glm::dot(offset, unit_direction);
+		const float c = glm::dot(offset, offset) - w->radius[body] * w->radius[body];
+		const float discriminant = b * b - c;
+		if ((c > 0.f && b > 0.f) || discriminant < 0.f)
+		{
+			return -1.f;
+		}
+		const float distance = std::max(-b - sqrtf(discriminant), 0.f);
+		return distance <= max_distance ? distance : -1.f;
+	}, out_distance);
+}
+
+void physics_query_aabb(const glm::vec3& min, const glm::vec3& max, std::vector<int>* out_bodies)
+{
+	out_bodies->clear();
+	if (g_broadphase.proxy_count != g_physics.body_count)
+	{
+		return;
+	}
+
+	// broadphase AABB    ̹Ƿ ׸ŭ ÷ ã,
+	// tree fat AABB ãǷ body  AABB    Ÿ.
+	const glm::vec3 drift(g_physics.broadphase_drift);
+	broadphase_query_aabb(&g_broadphase, { min - drift, max + drift }, out_bodies);
+	const PhysicsWorld* w = &g_physics;
+	out_bodies->erase(std::remove_if(out_bodies->begin(), out_bodies->end(), [w, &min, &max](int body)
+	{
+		const glm::vec3 position(w->position_x[body], w->position_y[body], w->position_z[body]);
+		const float radius = w->radius[body];
+		return glm::any(glm::lessThan(position + radius, min)) || glm::any(glm::greaterThan(position - radius, max));
+	}), out_bodies->end());
+}
+
+int physics_pick(const glm::vec3& origin, const glm::vec3& direction, float max_distance, float strength)
+{
+	float distance;
+	const int picked_body = physics_raycast(origin, direction, max_distance, &distance);
+	g_physics.picked_body = picked_body;
+	if (picked_body == -1)
+	{
+		return -1;
+	}
+
+	//  body   ray  о ȸ  Ѵ.
+	const glm::vec3 unit_direction = glm::normalize(direction);
+	const glm::vec3 hit_point = origin + unit_direction * distance;
+	const float inverse_mass = g_physics.inverse_mass[picked_body];
+	if (inverse_mass > 0.f)
+	{
+		physics_apply_impulse(picked_body, unit_direction * (strength / inverse_mass), hit_point);
+	}
+
+	// ֺ body   ּ ϰ ٱ  о.
+	std::vector<int> bodies;
+	physics_query_aabb(hit_point - glm::vec3(PHYSICS_PICK_RADIUS), hit_point + glm::vec3(PHYSICS_PICK_RADIUS), &bodies);
+	for (int body : bodies)
+	{
+		const PhysicsWorld* w = &g_physics;
+		if (body == picked_body || w->inverse_mass[body] <= 0.f)
+		{
+			continue;
+		}
+
+		const glm::vec3 offset = glm::vec3(w->position_x[body], w->position_y[body], w->position_z[body]) - hit_point;
+		const float falloff = 1.f - glm::length(offset) / PHYSICS_PICK_RADIUS;
+		if (falloff <= 0.f)
+		{
+			continue;
+		}
+		const glm::vec3 push = glm::normalize(offset + glm::vec3(0.f, 0.5f * PHYSICS_PICK_RADIUS, 0.f));
+		physics_apply_impulse(body, push * (strength * falloff / w->inverse_mass[body]), hit_point);
+	}
+	return picked_body;
+}
+
+uint64_t physics_state_hash()
+{
+	const std::vector<float>* arrays[] =
+	{
+		&g_physics.position_x, &g_physics.position_y, &g_physics.position_z,
+		&g_physics.orientation_x, &g_physics.orientation_y, &g_physics.orientation_z, &g_physics.orientation_w,
+		&g_physics.linear_velocity_x, &g_physics.linear_velocity_y, &g_physics.linear_velocity_z,
+		&g_physics.angular_velocity_x, &g_physics.angular_velocity_y, &g_physics.angular_velocity_z,
+	};
+
+	// FNV-1a
+	uint64_t hash = 14695981039346656037ull;
+	for (const std::vector<float>* array : arrays)
+	{
+		const uint8_t* bytes = (const uint8_t*)array->data();
+		const size_t size = sizeof(float) * g_physics.body_count;
+		for (size_t i = 0; i < size; ++i)
+		{
+			hash = (hash ^ bytes[i]) * 1099511628211ull;
+		}
+	}
+	return hash;
+}
+
+//   count step ŭ  ð(ms / step)
+template <typename Function>
+static float physics_bench_measure(int body_count, int step_count, const Function& step)
+{
+	physics_reset_grid(body_count, 2.f, 0.5f);
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (int i = 0; i < step_count; ++i)
+	{
+		step();
+	}
+	return std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count() / step_count;
+}
+
+bool physics_run_test()
+{
+	constexpr float MAX_SCALAR_ERROR = 1e-3f;
+	constexpr int BENCH_COUNT = sizeof(PHYSICS_BENCH_BODY_COUNTS) / sizeof(PHYSICS_BENCH_BODY_COUNTS[0]);
+
+	if (g_physics.test_mode == PHYSICS_TEST_BROADPHASE_BENCH)
+	{
+		return broadphase_run_bench();
+	}
+
+	// и(scalar, SSE) ˱  step job system   .
+	const float dt = 1.f / g_physics.step_hz;
+	float scalar_ms[BENCH_COUNT], sse_ms[BENCH_COUNT], step_ms[BENCH_COUNT];
+	uint64_t serial_hashes[BENCH_COUNT];
+	int contact_counts[BENCH_COUNT];
+	float max_scalar_error = 0.f;
+	for (int bench = 0; bench < BENCH_COUNT; ++bench)
+	{
+		const int body_count = PHYSICS_BENCH_BODY_COUNTS[bench];
+		scalar_ms[bench] = physics_bench_measure(body_count, PHYSICS_BENCH_STEP_COUNT, [dt]()
+		{
+			physics_integrate_range_scalar(dt, 0, g_physics.capacity);
+		});
+		const std::vector<float> scalar_y = g_physics.position_y;
+
+		sse_ms[bench] = physics_bench_measure(body_count, PHYSICS_BENCH_STEP_COUNT, [dt]()
+		{
+			physics_integrate_range(dt, 0, g_physics.capacity);
+		});
+		for (int i = 0; i < body_count; ++i)
+		{
+			max_scalar_error = std::max(max_scalar_error, fabsf(scalar_y[i] - g_physics.position_y[i]));
+		}
+
+		step_ms[bench] = physics_bench_measure(body_count, PHYSICS_BENCH_STEP_COUNT, [dt]()
+		{
+			physics_step(dt);
+		});
+		serial_hashes[bench] = physics_state_hash();
+		contact_counts[bench] = g_physics.contact_count;
+	}
+
+	job_system_init(g_job_system.requested_worker_count);
+
+	printf("Physics bench : %d steps at %.0f Hz, %d threads\n", PHYSICS_BENCH_STEP_COUNT, g_physics.step_hz, g_job_system.worker_count + 1);
+	printf("       bodies    scalar ms       sse ms      step ms  tree+jobs ms   sap+jobs ms   contacts\n");
+
+	bool is_deterministic = true;
+	const int broadphase_type = g_broadphase.type;
+	for (int bench = 0; bench < BENCH_COUNT; ++bench)
+	{
+		// job ų broadphase ٲ㵵  thread bit  ƾ Ѵ.
+		const int body_count = PHYSICS_BENCH_BODY_COUNTS[bench];
+		float jobs_ms[BROADPHASE_TYPE_COUNT];
+		for (int type = 0; type < BROADPHASE_TYPE_COUNT; ++type)
+		{
+			g_broadphase.type = type;
+			jobs_ms[type] = physics_bench_measure(body_count, PHYSICS_BENCH_STEP_COUNT, [dt]()
+			{
+				physics_step(dt);
+			});
+			is_deterministic &= physics_state_hash() == serial_hashes[bench];
+		}
+
+		printf("  %11d %12.3f %12.3f %12.3f %13.3f %13.3f %10d\n", body_count, scalar_ms[bench], sse_ms[bench], step_ms[bench],
+			jobs_ms[BROADPHASE_TREE], jobs_ms[BROADPHASE_SAP], contact_counts[bench]);
+	}
+	g_broadphase.type = broadphase_type;
+
+	// frame ð ߳ص  step   step  Ͱ ƾ Ѵ.
+	g_physics.is_enable = true;
+	physics_reset_grid(PHYSICS_BENCH_BODY_COUNTS[0], 2.f, 0.5f);
+	const float frame_times[] = { 1.f / 30.f, 1.f / 144.f, 1.f / 60.f, 1.f / 75.f, 0.05f, 1.f / 240.f };
+	for (int frame = 0; frame < 600; ++frame)
+	{
+		physics_update(frame_times[frame % (sizeof(frame_times) / sizeof(frame_times[0]))]);
+	}
+	const uint64_t variable_step_count = g_physics.step_count;
+	const uint64_t variable_hash = physics_state_hash();
+
+	physics_reset_grid(PHYSICS_BENCH_BODY_COUNTS[0], 2.f, 0.5f);
+	for (uint64_t i = 0; i < variable_step_count; ++i)
+	{
+		physics_step(dt);
+	}
+	const bool is_frame_rate_independent = physics_state_hash() == variable_hash;
+
+	//  body ٴ  ־ Ѵ.
+	float min_height = FLT_MAX;
+	for (int i = 0; i < g_physics.body_count; ++i)
+	{
+		min_height = std::min(min_height, g_physics.position_y[i] - g_physics.radius[i] - g_physics.ground_height);
+	}
+
+	job_system_terminate();
+	physics_terminate();
+
+	const bool is_success = is_deterministic && is_frame_rate_independent && max_scalar_error <= MAX_SCALAR_ERROR && min_height >= -1e-4f;
+	printf("Physics bench %s : deterministic %s, frame rate independent %s (%llu steps), max scalar error %g, min height %g\n",
+		is_success ? "passed" : "FAILED", is_deterministic ? "yes" : "no", is_frame_rate_independent ? "yes" : "no",
+		(unsigned long long)variable_step_count, max_scalar_error, min_height);
+	return is_success;
+}
+
+void physics_draw_gui()
+{
+	ImGui::Text("Physics"); ImGui::SameLine();
+	if (ImGui::Checkbox("##Physics", &g_physics.is_enable))
+	{
+		// Ѹ instance ġ ٽ ߸.
+		physics_clear();
+	}
+	if (!g_physics.is_enable)
+	{
+		return;
+	}
+
+	ImGui::Text("Physics Hz"); ImGui::SameLine();
+	ImGui::SliderFloat("##PhysicsHz", &g_physics.step_hz, 15.f, 240.f, "%.0f");
+
+	ImGui::Text("Gravity"); ImGui::SameLine();
+	ImGui::DragFloat("##Gravity", &g_physics.gravity.y, 0.1f, -50.f, 50.f, "%.1f");
+
+	ImGui::Text("Restitution"); ImGui::SameLine();
+	ImGui::SliderFloat("##Restitution", &g_physics.restitution, 0.f, 1.f, "%.2f");
+
+	ImGui::Text("Friction"); ImGui::SameLine();
+	ImGui::SliderFloat("##Friction", &g_physics.friction, 0.f, 2.f, "%.2f");
+
+	if (ImGui::Button("Physics Reset"))
+	{
+		physics_clear();
+	}
+
+	ImGui::Text("Bodies %d, %d steps %.3f ms, alpha %.2f", g_physics.body_count, g_physics.frame_step_count, g_physics.step_ms, g_physics.alpha);
+	ImGui::Text("Contacts %d, picked body %d (right click)", g_physics.contact_count, g_physics.picked_body);
+
+	broadphase_draw_gui();
+}
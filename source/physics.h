@@ -0,0 +1,169 @@
+#ifndef __PHYSICS_H__
+#define __PHYSICS_H__
+
+#include <stdint.h>
+#include <vector>
+
+#include "glm/glm.hpp"
+#include "glm/gtc/quaternion.hpp"
+
+#include "broadphase.h"
+
+// rigid body world.
+// body (sphere)̰,  ¸ и  迭(SoA) . 迭 4  ÷ΰ þ body (inverse mass 0)̴.
+// step  semi-implicit Euler ӵ  ϰ,  ӵ ġ ȸ ű  ٴ(y = ground_height)  óѴ.
+// а ٴ  SSE body 4, job system PHYSICS_BATCH_SIZE   Ѵ.
+//   broadphase(g_broadphase) ã pair   ġ  ݷ ġ  о.
+// pair ĵǾ ְ   thread   ǮǷ thread  job    . ()
+// tree fat AABB ã pair  step  AABB ġ ʴ  ǳʶٹǷ broadphase  ٲ㵵  pair Ǭ.
+// step io.DeltaTime  ׻ 1 / step_hz ̰,  ð  frame ѱ.
+// ׸    step ̸  ð (alpha) Ѵ.
+//  :
+//   physics_reset_grid(count, spacing, radius);
+//   physics_update(delta_time);				// frame . step  alpha ٲ.
+//   glm::mat4 world = physics_body_matrix(index);
+//   int body = physics_pick(origin, direction, max_distance, strength);	// ray  body ֺ о.
+// raycast AABB query  step broadphase broadphase_driftŭ ÷ ã,  ġ  ٽ ȮѴ.
+//
+// command line : [--physics] [--physics-hz HZ] [--physics-bench] (+ broadphase ɼ)
+
+constexpr int PHYSICS_BATCH_SIZE = 1024;	// 4 
+constexpr float PHYSICS_DEFAULT_STEP_HZ = 60.f;
+
+//  frame   ִ ִ step . Ѵ ð . ( frame ڿ step   ʰ)
+constexpr int PHYSICS_MAX_STEPS_PER_FRAME = 4;
+
+// ٴڿ ̺  ε Ƣ ʴ´. ( ִ body  step  ʰ)
+constexpr float PHYSICS_RESTITUTION_MIN_SPEED = 0.5f;
+
+// body ģ   slop Ѵ κ  ŭ  step о.
+constexpr float PHYSICS_CONTACT_SLOP = 0.01f;
+constexpr float PHYSICS_CONTACT_CORRECTION = 0.8f;
+
+// picking   ֺ о 
+constexpr float PHYSICS_PICK_RADIUS = 3.f;
+
+// --physics-bench body 
+constexpr int PHYSICS_BENCH_BODY_COUNTS[] = { 1000, 10000, 100000 };
+constexpr int PHYSICS_BENCH_STEP_COUNT = 60;
+
+enum PhysicsTestMode
+{
+	PHYSICS_TEST_NONE = 0,
+	PHYSICS_TEST_BENCH,
+	PHYSICS_TEST_BROADPHASE_BENCH,
+};
+
+struct PhysicsWorld
+{
+	bool is_enable;
+	int test_mode;
+
+	// 
+	float step_hz;
+	glm::vec3 gravity;
+	float ground_height;
+	float restitution;
+	float friction;
+	float linear_damping;	// ʴ ӵ پ 
+	float angular_damping;
+
+	// body  4  ø 迭 ũ
+	int body_count;
+	int capacity;
+
+	// body  (SoA)
+	std::vector<float> position_x, position_y, position_z;
+	std::vector<float> orientation_x, orientation_y, orientation_z, orientation_w;
+	std::vector<float> linear_velocity_x, linear_velocity_y, linear_velocity_z;
+	std::vector<float> angular_velocity_x, angular_velocity_y, angular_velocity_z;
+	std::vector<float> inverse_mass;
+	std::vector<float> inverse_inertia;	// ̹Ƿ   ϳ.
+	std::vector<float> radius;
+
+	//  step ġ ȸ.  .
+	std::vector<float> previous_position_x, previous_position_y, previous_position_z;
+	std::vector<float> previous_orientation_x, previous_orientation_y, previous_orientation_z, previous_orientation_w;
+
+	// broadphase Է. body AABB ̹ step ̵
+	std::vector<BroadphaseAABB> body_aabbs;
+	std::vector<glm::vec3> body_displacements;
+
+	// broadphase    AABB Ƿ,  body  AABB  ű ִ Ÿ(ึ) Ѵ.
+	// picking broadphase AABB ̸ŭ ÷ ã´.
+	float broadphase_drift;
+
+	//  step   ð   (0 ~ 1)
+	float accumulator;
+	float alpha;
+
+	// step̳ reset ö󰣴.  transform ٽ  ǴѴ.
+	unsigned version;
+	uint64_t step_count;
+
+	//  picking  body. ٸ -1
+	int picked_body;
+
+	//  (GUI)
+	int frame_step_count;
+	float step_ms;
+	int contact_count;
+};
+extern PhysicsWorld g_physics;
+
+void physics_set_defaults();
+void physics_print_usage();
+
+// argv[*index] physics ɼ̶  а index ű  true ش.
+bool physics_parse_arg(int argc, char** argv, int* index);
+
+void physics_terminate();
+
+//  body .
+void physics_clear();
+
+// capacity ڶ ø. ߰ body index
+int physics_add_body(const glm::vec3& position, const glm::quat& orientation, float radius, float mass,
+	const glm::vec3& linear_velocity, const glm::vec3& angular_velocity);
+
+// XZ  grid  body ߸. ʱ ӵ index ϹǷ ׻   ȴ.
+void physics_reset_grid(int count, float spacing, float radius);
+
+//  ð ϳŭ Ѵ.
+void physics_step(float dt);
+
+// broadphase pair  ġ  pair  о. (physics_step)
+void physics_solve_contacts();
+
+// [begin, end) body Ѵ. begin end 4  Ѵ.
+void physics_integrate_range(float dt, int begin, int end);
+void physics_integrate_range_scalar(float dt, int begin, int end);
+
+// frame ð ׾Ƽ ׸ŭ step ϰ alpha Ѵ. body ִٸ true
+bool physics_update(float delta_time);
+
+// alpha  body world matrix
+glm::mat4 physics_body_matrix(int index);
+
+// point impulse ش. ӵ ӵ ٲ.
+void physics_apply_impulse(int index, const glm::vec3& impulse, const glm::vec3& point);
+
+// ray   ´ body Ÿ. ٸ -1
+int physics_raycast(const glm::vec3& origin, const glm::vec3& direction, float max_distance, float* out_distance);
+
+// aabb ġ body
+void physics_query_aabb(const glm::vec3& min, const glm::vec3& max, std::vector<int>* out_bodies);
+
+// ray  body ray  а,   PHYSICS_PICK_RADIUS  body ٱ о.  body, ٸ -1
+int physics_pick(const glm::vec3& origin, const glm::vec3& direction, float max_distance, float strength);
+
+//  body  hash.  Ȯο .
+uint64_t physics_state_hash();
+
+// --physics-bench. â̳ GL context  body  step ð ,   ٽ    Ȯϰ .
+// --broadphase-bench broadphase_run_bench θ.
+bool physics_run_test();
+
+void physics_draw_gui();
+
+#endif
@@ -0,0 +1,183 @@
+#include "program_cache.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+#include "gl_extension.h"
+#include "utility.h"
+
+ProgramCache g_program_cache;
+
+// cache  header.  ų ٸ key  Ȯϴ  .
+struct ProgramCacheHeader
+{
+	uint32_t magic;
+	uint32_t binary_format;
+	uint32_t binary_length;
+	uint32_t reserved;
+	uint64_t key;
+};
+constexpr uint32_t PROGRAM_CACHE_MAGIC = 0x31434250; // "PBC1"
+
+// FNV-1a 64bit
+constexpr uint64_t FNV_OFFSET_BASIS = 14695981039346656037ull;
+constexpr uint64_t FNV_PRIME = 1099511628211ull;
+
+static uint64_t hash_string(uint64_t hash, const char* str)
+{
+	if (str == NULL)
+	{
+		return hash;
+	}
+
+	for (const char* c = str; *c != '\0'; ++c)
+	{
+		hash ^= (uint8_t)(*c);
+		hash *= FNV_PRIME;
+	}
+
+	// source 谡 ٲ  hash  ʵ ڸ ִ´.
+	hash ^= 0xFF;
+	hash *= FNV_PRIME;
+	return hash;
+}
+
+static void program_cache_file_path(uint64_t key, char* path, size_t path_size)
+{
+	snprintf(path, path_size, "%s/%016llx.bin", g_program_cache.folder, (unsigned long long)key);
+}
+
+void program_cache_init(const char* folder)
+{
+	memset(&g_program_cache, 0, sizeof(ProgramCache));
+	g_program_cache.is_enable = g_gl_ext.has_program_binary;
+	snprintf(g_program_cache.folder, sizeof(g_program_cache.folder), "%s", folder);
+
+	//  source ̹ ٲ binary   Ƿ ̹  key ´.
+	uint64_t hash = FNV_OFFSET_BASIS;
+	hash = hash_string(hash, (const char*)glGetString(GL_VENDOR));
+	hash = hash_string(hash, (const char*)glGetString(GL_RENDERER));
+	hash = hash_string(hash, (const char*)glGetString(GL_VERSION));
+	hash = hash_string(hash, (const char*)glGetString(GL_SHADING_LANGUAGE_VERSION));
+	g_program_cache.driver_hash = hash;
+
+	if (g_program_cache.is_enable)
+	{
+		file_make_folder(g_program_cache.folder);
+	}
+}
+
+uint64_t program_cache_key(const char* const* sources, unsigned source_count)
+{
+	uint64_t hash = g_program_cache.driver_hash;
+	for (unsigned i = 0; i < source_count; ++i)
+	{
+		hash = hash_string(hash, sources[i]);
+	}
+
+	return hash;
+}
+
+GLuint program_cache_load(uint64_t key)
+{
+	if (!g_program_cache.is_enable)
+	{
+		return 0;
+	}
+
+	char path[512];
+	program_cache_file_path(key, path, sizeof(path));
+	FILE* fp = fopen(path, "rb");
+	if (!fp)
+	{
+		++g_program_cache.miss_count;
+		return 0;
+	}
+
+	ProgramCacheHeader header;
+	std::vector<char> binary;
+	bool is_valid = fread(&header, sizeof(ProgramCacheHeader), 1, fp) == 1 &&
+		header.magic == PROGRAM_CACHE_MAGIC &&
+		header.key == key &&
+		header.binary_length > 0;
+	if (is_valid)
+	{
+		binary.resize(header.binary_length);
+		is_valid = fread(binary.data(), 1, binary.size(), fp) == binary.size();
+	}
+	fclose(fp);
+
+	if (!is_valid)
+	{
+		++g_program_cache.reject_count;
+		return 0;
+	}
+
+	// ̹ Ʈ Ǿų binary  ̻ ޾Ƶ  link Ѵ.
+	//   0 ༭ sourceκ ٽ compile ϰ ϰ,  binary    ȴ.
+	GLuint pso = glCreateProgram();
+	glProgramBinary(pso, header.binary_format, binary.data(), (GLsizei)binary.size());
+
+	GLint success;
+	glGetProgramiv(pso, GL_LINK_STATUS, &success);
+	if (!success)
+	{
+		glDeleteProgram(pso);
+		++g_program_cache.reject_count;
+		return 0;
+	}
+
+	++g_program_cache.hit_count;
+	return pso;
+}
+
+void program_cache_prepare(GLuint pso)
+{
+	if (!g_program_cache.is_enable)
+	{
+		return;
+	}
+
+	glProgramParameteri(pso, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+}
+
+void program_cache_save(GLuint pso, uint64_t key)
+{
+	if (!g_program_cache.is_enable)
+	{
+		return;
+	}
+
+	GLint binary_length = 0;
+	glGetProgramiv(pso, GL_PROGRAM_BINARY_LENGTH, &binary_length);
+	if (binary_length <= 0)
+	{
+		return;
+	}
+
+	std::vector<char> binary(binary_length);
+	GLenum binary_format = 0;
+	glGetProgramBinary(pso, binary_length, &binary_length, &binary_format, binary.data());
+
+	ProgramCacheHeader header;
+	memset(&header, 0, sizeof(ProgramCacheHeader));
+	header.magic = PROGRAM_CACHE_MAGIC;
+	header.binary_format = binary_format;
+	header.binary_length = (uint32_t)binary_length;
+	header.key = key;
+
+	char path[512];
+	program_cache_file_path(key, path, sizeof(path));
+	FILE* fp = fopen(path, "wb");
+	if (!fp)
+	{
+		// cache    ġ Ƿ  ࿡ ٽ compile ϰ д.
+		printf("Fail to write a program cache : %s\n", path);
+		return;
+	}
+
+	fwrite(&header, sizeof(ProgramCacheHeader), 1, fp);
+	fwrite(binary.data(), 1, binary_length, fp);
+	fclose(fp);
+}
@@ -0,0 +1,41 @@
+#ifndef __PROGRAM_CACHE_H__
+#define __PROGRAM_CACHE_H__
+
+#include <stdint.h>
+
+#include "glad/glad.h"
+
+// link program glGetProgramBinary ޾ ũ صΰ,
+//  ʹ glProgramBinary compile/link  ٷ Ѵ.
+// key shader source(define ) ̹(vendor/renderer/version) Ƿ
+// shader ġų ̹ ٲ ڿ  compile ȴ.
+
+struct ProgramCache
+{
+	// ̹ program binary    Լ ƹ ͵  ʴ´.
+	bool is_enable;
+	char folder[256];
+	uint64_t driver_hash;
+
+	// debug  
+	unsigned hit_count;
+	unsigned miss_count;
+	unsigned reject_count;	//  ־ ̹ ޾Ƶ  
+};
+extern ProgramCache g_program_cache;
+
+// gl_extension_init Ŀ ȣؾ Ѵ.
+void program_cache_init(const char* folder);
+
+uint64_t program_cache_key(const char* const* sources, unsigned source_count);
+
+// cache ִ binary link program  ش. ų ̹ źϸ 0.
+GLuint program_cache_load(uint64_t key);
+
+// binary   ֵ glLinkProgram  ȣؾ Ѵ.
+void program_cache_prepare(GLuint pso);
+
+// link  program binary Ѵ.
+void program_cache_save(GLuint pso, uint64_t key);
+
+#endif
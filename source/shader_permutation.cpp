@@ -0,0 +1,188 @@
+#include "shader_permutation.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <string>
+
+#include "gl_extension.h"
+#include "program_cache.h"
+#include "utility.h"
+
+void shader_permutation_system_init()
+{
+	if (g_gl_ext.has_parallel_shader_compile)
+	{
+		// 0xFFFFFFFF : ̹  ִ thread  
+		glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+	}
+}
+
+static std::string shader_define_block(const ShaderPermutation* permutation, unsigned feature_mask)
+{
+	std::string block;
+	for (unsigned i = 0; i < permutation->defines.size(); ++i)
+	{
+		if (feature_mask & (1u << i))
+		{
+			block.append("#define ");
+			block.append(permutation->defines[i]);
+			block.append("\n");
+		}
+	}
+
+	//  ޼  ȣ  ϰ µ Ѵ.
+	block.append("#line 2\n");
+	return block;
+}
+
+static void shader_compile_with_defines(GLuint so, const std::vector<char>& source, const std::string& define_block)
+{
+	// #version ݵ ù ٿ ־ ϹǷ, ù  ٷ  define  ִ´.
+	const char* text = source.data();
+	const char* body = strchr(text, '\n');
+	body = body ? body + 1 : text + strlen(text);
+
+	const char* strings[3] = { text, define_block.c_str(), body };
+	GLint lengths[3] = { (GLint)(body - text), (GLint)define_block.size(), -1 };
+	glShaderSource(so, 3, strings, lengths);
+	glCompileShader(so);
+}
+
+static void shader_variant_finish(ShaderPermutation* permutation, unsigned feature_mask)
+{
+	ShaderVariant* variant = &(permutation->variants[feature_mask]);
+	assert(variant->state == SHADER_VARIANT_COMPILING);
+
+	// parallel compile   ʾҴٸ ⼭ ٸ ȴ.
+	GLint success;
+	glGetProgramiv(variant->pso, GL_LINK_STATUS, &success);
+	if (!success)
+	{
+		char info_logs[512];
+		glGetShaderInfoLog(variant->vso, 512, NULL, info_logs);
+		printf("Fail to Compile %s (variant %u) vertex : %s\n", permutation->debug_name, feature_mask, info_logs);
+		glGetShaderInfoLog(variant->fso, 512, NULL, info_logs);
+		printf("Fail to Compile %s (variant %u) fragment : %s\n", permutation->debug_name, feature_mask, info_logs);
+		glGetProgramInfoLog(variant->pso, 512, NULL, info_logs);
+		printf("Fail to Link %s (variant %u) : %s\n", permutation->debug_name, feature_mask, info_logs);
+
+		variant->state = SHADER_VARIANT_FAILED;
+		assert(false);
+		return;
+	}
+
+	variant->state = SHADER_VARIANT_READY;
+	program_cache_save(variant->pso, variant->cache_key);
+}
+
+void shader_permutation_init(ShaderPermutation* permutation, const char* debug_name,
+							 const char* vertex_path, const char* frag_path,
+							 const char* const* defines, unsigned define_count)
+{
+	permutation->debug_name = debug_name;
+	file_open_fill_buffer(vertex_path, permutation->vertex_source);
+	file_open_fill_buffer(frag_path, permutation->frag_source);
+	permutation->defines.assign(defines, defines + define_count);
+
+	ShaderVariant empty_variant;
+	memset(&empty_variant, 0, sizeof(ShaderVariant));
+	permutation->variants.assign((size_t)1 << define_count, empty_variant);
+}
+
+void shader_permutation_terminate(ShaderPermutation* permutation)
+{
+	for (ShaderVariant& variant : permutation->variants)
+	{
+		if (variant.state == SHADER_VARIANT_NONE)
+		{
+			continue;
+		}
+
+		glDeleteProgram(variant.pso);
+		glDeleteShader(variant.fso);
+		glDeleteShader(variant.vso);
+		memset(&variant, 0, sizeof(ShaderVariant));
+	}
+}
+
+void shader_permutation_request(ShaderPermutation* permutation, unsigned feature_mask)
+{
+	assert(feature_mask < permutation->variants.size());
+
+	ShaderVariant* variant = &(permutation->variants[feature_mask]);
+	if (variant->state != SHADER_VARIANT_NONE)
+	{
+		return;
+	}
+
+	const std::string define_block = shader_define_block(permutation, feature_mask);
+
+	//  ࿡ ص binary ִٸ compile  ٷ Ѵ.
+	const char* key_sources[3] = { permutation->vertex_source.data(), define_block.c_str(), permutation->frag_source.data() };
+	variant->cache_key = program_cache_key(key_sources, 3);
+	variant->pso = program_cache_load(variant->cache_key);
+	if (variant->pso != 0)
+	{
+		variant->state = SHADER_VARIANT_READY;
+		return;
+	}
+
+	// compile  Ȯ ʰ ٷ link ûѴ.
+	// compile  link з ŸǷ shader_variant_finish Ѳ ȮѴ.
+	variant->vso = glCreateShader(GL_VERTEX_SHADER);
+	shader_compile_with_defines(variant->vso, permutation->vertex_source, define_block);
+
+	variant->fso = glCreateShader(GL_FRAGMENT_SHADER);
+	shader_compile_with_defines(variant->fso, permutation->frag_source, define_block);
+
+	variant->pso = glCreateProgram();
+	glAttachShader(variant->pso, variant->vso);
+	glAttachShader(variant->pso, variant->fso);
+	program_cache_prepare(variant->pso);
+	glLinkProgram(variant->pso);
+
+	variant->state = SHADER_VARIANT_COMPILING;
+
+	// parallel compile ٸ ٷ ޶  Ƿ ٷ Ѵ.
+	if (!g_gl_ext.has_parallel_shader_compile)
+	{
+		shader_variant_finish(permutation, feature_mask);
+	}
+}
+
+bool shader_permutation_is_ready(ShaderPermutation* permutation, unsigned feature_mask)
+{
+	assert(feature_mask < permutation->variants.size());
+
+	ShaderVariant* variant = &(permutation->variants[feature_mask]);
+	if (variant->state == SHADER_VARIANT_COMPILING)
+	{
+		GLint is_completed = GL_TRUE;
+		glGetProgramiv(variant->pso, GL_COMPLETION_STATUS_KHR, &is_completed);
+		if (is_completed)
+		{
+			shader_variant_finish(permutation, feature_mask);
+		}
+	}
+
+	return variant->state == SHADER_VARIANT_READY;
+}
+
+const ShaderVariant* shader_permutation_get(ShaderPermutation* permutation, unsigned feature_mask)
+{
+	assert(feature_mask < permutation->variants.size());
+
+	ShaderVariant* variant = &(permutation->variants[feature_mask]);
+	if (variant->state == SHADER_VARIANT_NONE)
+	{
+		shader_permutation_request(permutation, feature_mask);
+	}
+
+	if (variant->state == SHADER_VARIANT_COMPILING)
+	{
+		shader_variant_finish(permutation, feature_mask);
+	}
+
+	return variant;
+}
@@ -0,0 +1,61 @@
+#ifndef __SHADER_PERMUTATION_H__
+#define __SHADER_PERMUTATION_H__
+
+#include <vector>
+#include <stdint.h>
+
+#include "glad/glad.h"
+
+// ϳ vertex/fragment shader sourceκ #define (feature mask) ٸ program .
+// runtime uniform bool б  compile time ʿ  ڵ varying  ̴.
+// feature bit i  "#define <defines[i]>" #version ٷ  ٿ .
+
+enum ShaderVariantState
+{
+	SHADER_VARIANT_NONE = 0,	//  û 
+	SHADER_VARIANT_COMPILING,	// compile/link û߰ (parallel compile̶) ̹ ó
+	SHADER_VARIANT_READY,
+	SHADER_VARIANT_FAILED,
+};
+
+struct ShaderVariant
+{
+	ShaderVariantState state;
+	GLuint vso;
+	GLuint fso;
+	GLuint pso;
+
+	// program cache key (source + define + ̹)
+	uint64_t cache_key;
+};
+
+struct ShaderPermutation
+{
+	const char* debug_name;
+	std::vector<char> vertex_source;
+	std::vector<char> frag_source;
+	std::vector<const char*> defines;
+
+	// feature mask index Ѵ. (ũ : 1 << defines.size())
+	std::vector<ShaderVariant> variants;
+};
+
+// ̹ KHR_parallel_shader_compile ϸ compiler thread  ִ Ƶд.
+void shader_permutation_system_init();
+
+void shader_permutation_init(ShaderPermutation* permutation, const char* debug_name,
+							 const char* vertex_path, const char* frag_path,
+							 const char* const* defines, unsigned define_count);
+void shader_permutation_terminate(ShaderPermutation* permutation);
+
+// ش variant compile/link ۸ ϰ ٷ ƿ´.
+// program cache binary ְų parallel compile  ̹  Լ ȿ .
+void shader_permutation_request(ShaderPermutation* permutation, unsigned feature_mask);
+
+// ٸ ʰ variant   ȮѴ.
+bool shader_permutation_is_ready(ShaderPermutation* permutation, unsigned feature_mask);
+
+// variant program ش. û ʾҴٸ  ,  ̶   ٸ.
+const ShaderVariant* shader_permutation_get(ShaderPermutation* permutation, unsigned feature_mask);
+
+#endif
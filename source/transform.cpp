@@ -0,0 +1,92 @@
+#include "transform.h"
+
+#include "glm/gtc/matrix_transform.hpp"
+
+#include <stdio.h>
+#include <assert.h>
+
+TransformSystem g_transform_system;
+
+void transform_system_init()
+{
+	g_transform_system = TransformSystem();
+}
+
+void transform_system_terminate()
+{
+	g_transform_system.transforms.clear();
+	g_transform_system.dirty_list.clear();
+}
+
+TransformHandle transform_create(const glm::vec3& position, const glm::vec3& rot_euler, const glm::vec3& scale)
+{
+	Transform transform;
+	transform.position = position;
+	transform.rot_euler = rot_euler;
+	transform.scale = scale;
+	transform.rotation = glm::quat(1.f, 0.f, 0.f, 0.f);
+	transform.world = glm::mat4(1.f);
+	transform.version = 0;
+	transform.is_dirty = false;
+
+	TransformHandle handle = (TransformHandle)g_transform_system.transforms.size();
+	g_transform_system.transforms.push_back(transform);
+	transform_mark_dirty(handle);
+	return handle;
+}
+
+Transform* transform_get(TransformHandle handle)
+{
+	if (handle < 0 || handle >= (TransformHandle)g_transform_system.transforms.size())
+	{
+		printf("Invalid transform handle : %d\n", handle);
+		assert(false);
+		return NULL;
+	}
+
+	return &(g_transform_system.transforms[handle]);
+}
+
+void transform_set(TransformHandle handle, const glm::vec3& position, const glm::vec3& rot_euler, const glm::vec3& scale)
+{
+	Transform* transform = transform_get(handle);
+	transform->position = position;
+	transform->rot_euler = rot_euler;
+	transform->scale = scale;
+	transform_mark_dirty(handle);
+}
+
+void transform_mark_dirty(TransformHandle handle)
+{
+	Transform* transform = transform_get(handle);
+	if (transform->is_dirty)
+	{
+		return;
+	}
+
+	transform->is_dirty = true;
+	g_transform_system.dirty_list.push_back(handle);
+}
+
+void transform_system_update()
+{
+	constexpr glm::mat4 identity(1.0f);
+
+	g_transform_system.updated_count = (unsigned)g_transform_system.dirty_list.size();
+	for (TransformHandle handle : g_transform_system.dirty_list)
+	{
+		Transform& transform = g_transform_system.transforms[handle];
+
+		// Rotation Order : Y -> X -> Z
+		transform.rotation = glm::angleAxis(glm::radians(transform.rot_euler.y), glm::vec3(0.0f, 1.0f, 0.0f)) *
+			glm::angleAxis(glm::radians(transform.rot_euler.x), glm::vec3(1.0f, 0.0f, 0.0f)) *
+			glm::angleAxis(glm::radians(transform.rot_euler.z), glm::vec3(0.0f, 0.0f, 1.0f));
+		transform.world = glm::translate(identity, transform.position) *
+						  glm::mat4_cast(transform.rotation) *
+						  glm::scale(identity, transform.scale);
+
+		++transform.version;
+		transform.is_dirty = false;
+	}
+	g_transform_system.dirty_list.clear();
+}
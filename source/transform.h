@@ -0,0 +1,61 @@
+#ifndef __TRANSFORM_H__
+#define __TRANSFORM_H__
+
+#include <vector>
+
+#include "glm/glm.hpp"
+#include "glm/gtc/quaternion.hpp"
+
+// ġ/ȸ(Euler Angle)/ũ local to world matrix  transform component.
+// Է ٲ  dirty ǥϰ, transform_system_update dirty transform ٽ Ѵ.
+//   version ö󰡹Ƿ, GPU 纻   ø  version صξٰ
+// ٸ  ٽ ø ȴ.
+//  :
+//   TransformHandle handle = transform_create(position, rot_euler, scale);
+//   transform_get(handle)->position.x += 1.f; transform_mark_dirty(handle);
+//   transform_system_update();	// frame   , ׸ 
+//   transform_get(handle)->world
+
+typedef int TransformHandle;
+constexpr TransformHandle INVALID_TRANSFORM = -1;
+
+struct Transform
+{
+	// Է.  ٲٸ transform_mark_dirty ҷ Ѵ.
+	glm::vec3 position;
+	glm::vec3 rot_euler;	// degree. Unityó  xyz Euler Angle Ÿ. (Rotation Order : Y -> X -> Z)
+	glm::vec3 scale;
+
+	// transform_system_update ŵȴ.
+	glm::quat rotation;
+	glm::mat4 world;
+	unsigned version;
+
+	bool is_dirty;
+};
+
+struct TransformSystem
+{
+	std::vector<Transform> transforms;
+	std::vector<TransformHandle> dirty_list;
+
+	//  update ٽ  transform 
+	unsigned updated_count;
+};
+extern TransformSystem g_transform_system;
+
+void transform_system_init();
+void transform_system_terminate();
+
+TransformHandle transform_create(const glm::vec3& position, const glm::vec3& rot_euler, const glm::vec3& scale);
+
+// transform_create vector Ŀ   pointer ȿ ȴ. handle  ִٰ   ´.
+Transform* transform_get(TransformHandle handle);
+
+void transform_set(TransformHandle handle, const glm::vec3& position, const glm::vec3& rot_euler, const glm::vec3& scale);
+void transform_mark_dirty(TransformHandle handle);
+
+// dirty transform rotation/world ٽ Ѵ.
+void transform_system_update();
+
+#endif
@@ -0,0 +1,222 @@
+#include "ui_cache.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <vector>
+
+#include "gl_state.h"
+#include "utility.h"
+#include "memory_tracker.h"
+
+UICache g_ui_cache;
+
+// FNV-1a 64bit
+constexpr uint64_t UI_CACHE_HASH_OFFSET_BASIS = 14695981039346656037ull;
+constexpr uint64_t UI_CACHE_HASH_PRIME = 1099511628211ull;
+
+static void ui_cache_create_target(int width, int height)
+{
+	if (g_ui_cache.texture != 0)
+	{
+		memory_tracker_gpu_release(GPU_MEMORY_TEXTURE, g_ui_cache.texture);
+		glDeleteFramebuffers(1, &(g_ui_cache.fbo));
+		glDeleteTextures(1, &(g_ui_cache.texture));
+	}
+
+	glGenTextures(1, &(g_ui_cache.texture));
+	glBindTexture(GL_TEXTURE_2D, g_ui_cache.texture);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+	memory_tracker_gpu_set(GPU_MEMORY_TEXTURE, g_ui_cache.texture, (size_t)width * height * 4);
+
+	glGenFramebuffers(1, &(g_ui_cache.fbo));
+	glBindFramebuffer(GL_FRAMEBUFFER, g_ui_cache.fbo);
+	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, g_ui_cache.texture, 0);
+	if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+	{
+		printf("UI overlay framebuffer is not complete\n");
+		assert(false);
+	}
+
+	g_ui_cache.width = width;
+	g_ui_cache.height = height;
+	g_ui_cache.is_texture_valid = false;
+}
+
+void ui_cache_init()
+{
+	// ImVec2 Ƿ memset  value-initialization 0 ä.
+	g_ui_cache = UICache();
+	g_ui_cache.is_enable = true;
+	g_ui_cache.refresh_interval = UI_CACHE_DEFAULT_REFRESH_INTERVAL;
+	g_ui_cache.has_event = true;
+
+	std::vector<char> shader_source;
+
+	file_open_fill_buffer("ui_composite.vert", shader_source);
+	GLuint vso = glCreateShader(GL_VERTEX_SHADER);
+	gl_validate_shader(vso, (const char*)shader_source.data());
+
+	file_open_fill_buffer("ui_composite.frag", shader_source);
+	GLuint fso = glCreateShader(GL_FRAGMENT_SHADER);
+	gl_validate_shader(fso, (const char*)shader_source.data());
+
+	GLuint pso = glCreateProgram();
+	gl_validate_program(pso, vso, fso);
+
+	g_ui_cache.shader_vertex = vso;
+	g_ui_cache.shader_frag = fso;
+	g_ui_cache.pso = pso;
+	g_ui_cache.loc_overlay_texture = glGetUniformLocation(pso, "overlay_texture");
+
+	// ﰢ gl_VertexID  core profile VAO bind Ǿ ־ ׸  ִ.
+	glGenVertexArrays(1, &(g_ui_cache.vao));
+}
+
+void ui_cache_terminate()
+{
+	if (g_ui_cache.texture != 0)
+	{
+		memory_tracker_gpu_release(GPU_MEMORY_TEXTURE, g_ui_cache.texture);
+		glDeleteFramebuffers(1, &(g_ui_cache.fbo));
+		glDeleteTextures(1, &(g_ui_cache.texture));
+	}
+	glDeleteVertexArrays(1, &(g_ui_cache.vao));
+	glDeleteProgram(g_ui_cache.pso);
+	glDeleteShader(g_ui_cache.shader_frag);
+	glDeleteShader(g_ui_cache.shader_vertex);
+}
+
+void ui_cache_invalidate()
+{
+	g_ui_cache.has_event = true;
+}
+
+void ui_cache_watch(const void* data, size_t size)
+{
+	if (g_ui_cache.watch_hash == 0)
+	{
+		g_ui_cache.watch_hash = UI_CACHE_HASH_OFFSET_BASIS;
+	}
+
+	const uint8_t* bytes = (const uint8_t*)data;
+	for (size_t i = 0; i < size; ++i)
+	{
+		g_ui_cache.watch_hash ^= bytes[i];
+		g_ui_cache.watch_hash *= UI_CACHE_HASH_PRIME;
+	}
+}
+
+bool ui_cache_begin_frame()
+{
+	const ImGuiIO& io = ImGui::GetIO();
+	const int width = (int)(io.DisplaySize.x * io.DisplayFramebufferScale.x);
+	const int height = (int)(io.DisplaySize.y * io.DisplayFramebufferScale.y);
+	++g_ui_cache.frame_count;
+	g_ui_cache.time_since_rebuild += io.DeltaTime;
+
+	// Ѻ   frame  ϵǹǷ ⼭ ϰ .
+	const bool is_watch_changed = g_ui_cache.watch_hash != g_ui_cache.last_watch_hash;
+	g_ui_cache.last_watch_hash = g_ui_cache.watch_hash;
+	g_ui_cache.watch_hash = 0;
+
+	// 콺 ٸ hover  ٲ  ִ.
+	const bool is_mouse_moved = io.MousePos.x != g_ui_cache.last_mouse_pos.x || io.MousePos.y != g_ui_cache.last_mouse_pos.y;
+	g_ui_cache.last_mouse_pos = io.MousePos;
+
+	// ư  ִ  drag   ְ, camera_update  io.MouseDelta NewFrame ŵȴ.
+	bool is_mouse_down = false;
+	for (int i = 0; i < IM_ARRAYSIZE(io.MouseDown); ++i)
+	{
+		is_mouse_down |= io.MouseDown[i];
+	}
+
+	const bool is_input = g_ui_cache.has_event || is_mouse_moved || is_mouse_down ||
+		io.MouseWheel != 0.f || io.MouseWheelH != 0.f || io.InputQueueCharacters.Size > 0;
+	g_ui_cache.has_event = false;
+	if (is_input || is_watch_changed)
+	{
+		g_ui_cache.settle_frames = UI_CACHE_SETTLE_FRAMES;
+	}
+
+	bool is_rebuild = !g_ui_cache.is_enable ||
+		!g_ui_cache.is_texture_valid ||
+		width != g_ui_cache.width || height != g_ui_cache.height ||
+		g_ui_cache.settle_frames > 0 ||
+		ImGui::IsAnyItemActive() || io.WantTextInput ||
+		g_ui_cache.time_since_rebuild >= g_ui_cache.refresh_interval;
+
+	if (g_ui_cache.settle_frames > 0)
+	{
+		--g_ui_cache.settle_frames;
+	}
+
+	if (is_rebuild)
+	{
+		++g_ui_cache.rebuild_count;
+		g_ui_cache.time_since_rebuild = 0.f;
+	}
+
+	g_ui_cache.is_rebuild = is_rebuild;
+	return is_rebuild;
+}
+
+void ui_cache_draw(void (*draw_ui)(), GLuint target_fbo)
+{
+	if (!g_ui_cache.is_enable)
+	{
+		// ٽ    overlay  ʵ Ѵ.
+		g_ui_cache.is_texture_valid = false;
+		draw_ui();
+		return;
+	}
+
+	const ImGuiIO& io = ImGui::GetIO();
+	const int width = (int)(io.DisplaySize.x * io.DisplayFramebufferScale.x);
+	const int height = (int)(io.DisplaySize.y * io.DisplayFramebufferScale.y);
+	if (width <= 0 || height <= 0)
+	{
+		return;
+	}
+
+	if (g_ui_cache.is_rebuild)
+	{
+		if (width != g_ui_cache.width || height != g_ui_cache.height || g_ui_cache.texture == 0)
+		{
+			ui_cache_create_target(width, height);
+		}
+
+		//    ImGui blend (rgb : SRC_ALPHA, ONE_MINUS_SRC_ALPHA / alpha : ONE, ONE_MINUS_SRC_ALPHA) ׸
+		// overlay alpha   ùٸ coverage Ƿ, ռ ONE, ONE_MINUS_SRC_ALPHA ϸ ȴ.
+		glBindFramebuffer(GL_FRAMEBUFFER, g_ui_cache.fbo);
+		gl_state_set_enable(GL_SCISSOR_TEST, false);
+		glClearColor(0.f, 0.f, 0.f, 0.f);
+		glClear(GL_COLOR_BUFFER_BIT);
+		draw_ui();
+		glBindFramebuffer(GL_FRAMEBUFFER, target_fbo);
+		g_ui_cache.is_texture_valid = true;
+	}
+
+	const GLState last_state = g_gl_state;
+	gl_state_set_enable(GL_BLEND, true);
+	gl_state_set_blend_equation(GL_FUNC_ADD, GL_FUNC_ADD);
+	gl_state_set_blend_func(GL_ONE, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+	gl_state_set_enable(GL_CULL_FACE, false);
+	gl_state_set_enable(GL_DEPTH_TEST, false);
+	gl_state_set_enable(GL_STENCIL_TEST, false);
+	gl_state_set_enable(GL_SCISSOR_TEST, false);
+	gl_state_set_polygon_mode(GL_FILL);
+
+	glViewport(0, 0, width, height);
+	glUseProgram(g_ui_cache.pso);
+	glActiveTexture(GL_TEXTURE0);
+	glBindTexture(GL_TEXTURE_2D, g_ui_cache.texture);
+	glUniform1i(g_ui_cache.loc_overlay_texture, 0);
+	glBindVertexArray(g_ui_cache.vao);
+	glDrawArrays(GL_TRIANGLES, 0, 3);
+	glBindVertexArray(0);
+
+	gl_state_restore(last_state);
+}
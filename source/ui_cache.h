@@ -0,0 +1,75 @@
+#ifndef __UI_CACHE_H__
+#define __UI_CACHE_H__
+
+#include <stdint.h>
+
+#include "glad/glad.h"
+#include "imgui/imgui.h"
+
+// Retained UI mode.
+// ImGui  UI framebuffer ũ overlay texture   ׷ΰ,
+// Է ų hover/drag ̰ų Ѻ  ٲ  NewFrame/Render upload ٽ Ѵ.
+//   frame overlay texture ȭ ü ﰢ ϳ ռ Ѵ.
+//  :
+//   imgui_prepare();
+//   ui_cache_watch(&value, sizeof(value)); ...
+//   if (ui_cache_begin_frame()) { ImGui::NewFrame(); ...; ImGui::Render(); }
+//   ...
+//   ui_cache_draw(imgui_draw, target_fbo);
+
+// Է  ڿ hover/active ° ݿ   frame  ٽ .
+constexpr int UI_CACHE_SETTLE_FRAMES = 3;
+constexpr float UI_CACHE_DEFAULT_REFRESH_INTERVAL = 0.5f;
+
+struct UICache
+{
+	bool is_enable;
+
+	// Է   () ٽ . FPS/profiler   ٲ ڸ  ̴. (0 :  frame)
+	float refresh_interval;
+
+	GLuint fbo;
+	GLuint texture;
+	int width;
+	int height;
+	bool is_texture_valid;
+
+	GLuint shader_vertex;
+	GLuint shader_frag;
+	GLuint pso;
+	GLuint vao;
+	GLint loc_overlay_texture;
+
+	// ̹ frame ٽ  Ǵϱ   frame 
+	ImVec2 last_mouse_pos;
+	uint64_t watch_hash;
+	uint64_t last_watch_hash;
+	bool has_event;
+	int settle_frames;
+	float time_since_rebuild;
+
+	// ̹ frame UI ٽ 
+	bool is_rebuild;
+
+	unsigned frame_count;
+	unsigned rebuild_count;
+};
+extern UICache g_ui_cache;
+
+void ui_cache_init();
+void ui_cache_terminate();
+
+// glfw input callback  UI ٽ    ȣѴ.
+void ui_cache_invalidate();
+
+// ̹ frame UI   Ѵ.  frame ޶ UI ٽ .
+void ui_cache_watch(const void* data, size_t size);
+
+// imgui_prepare ڿ ȣѴ. true ̹ frame ImGui::NewFrame ~ ImGui::Render ؾ Ѵ.
+bool ui_cache_begin_frame();
+
+// UI ׸. ٽ  frame̶ draw_ui overlay ׸  target_fbo ռѴ.
+//  ִٸ draw_ui ״ ȣѴ.
+void ui_cache_draw(void (*draw_ui)(), GLuint target_fbo);
+
+#endif
@@ -0,0 +1,12 @@
+#version 330 core
+
+// the overlay has the same size as the framebuffer, so read it texel by texel
+// its color is already multiplied by alpha (see ui_cache.cpp)
+uniform sampler2D overlay_texture;
+
+out vec4 frag_color;
+
+void main()
+{
+	frag_color = texelFetch(overlay_texture, ivec2(gl_FragCoord.xy), 0);
+}
@@ -0,0 +1,31 @@
+#version 330 core
+
+// bilinear upscale of the scene followed by a small unsharp mask.
+// the result is clamped to the min/max of the neighbours so edges do not get halos.
+uniform sampler2D scene_texture;
+uniform vec2 uv_scale;		// the scene only covers [0, uv_scale] of the texture (render size / texture size)
+uniform vec2 output_size;
+uniform float sharpness;	// 0 : plain bilinear
+
+out vec4 frag_color;
+
+void main()
+{
+	vec2 texel = 1.0 / vec2(textureSize(scene_texture, 0));
+	vec2 uv_min = texel * 0.5;
+	vec2 uv_max = uv_scale - texel * 0.5;
+	vec2 uv = clamp(gl_FragCoord.xy / output_size * uv_scale, uv_min, uv_max);
+
+	vec3 c = texture(scene_texture, uv).rgb;
+	vec3 n = texture(scene_texture, clamp(uv + vec2(0.0, texel.y), uv_min, uv_max)).rgb;
+	vec3 s = texture(scene_texture, clamp(uv - vec2(0.0, texel.y), uv_min, uv_max)).rgb;
+	vec3 e = texture(scene_texture, clamp(uv + vec2(texel.x, 0.0), uv_min, uv_max)).rgb;
+	vec3 w = texture(scene_texture, clamp(uv - vec2(texel.x, 0.0), uv_min, uv_max)).rgb;
+
+	vec3 average = (n + s + e + w) * 0.25;
+	vec3 sharpened = c + (c - average) * sharpness * 2.0;
+
+	vec3 lo = min(c, min(min(n, s), min(e, w)));
+	vec3 hi = max(c, max(max(n, s), max(e, w)));
+	frag_color = vec4(clamp(sharpened, lo, hi), 1.0);
+}
@@ -3,7 +3,14 @@
 #include <stdio.h>
 #include <assert.h>
 
+#if defined(_WIN32) || defined(_WIN64)
+#include <direct.h>
+#else
+#include <sys/stat.h>
+#endif
+
 #include "glad/glad.h"
+#include "memory_tracker.h"
 
 bool file_read_until_total_size(FILE* fp, int total_size, void* buffer)
 {
@@ -43,6 +50,16 @@ void file_open_fill_buffer(const char* path, std::vector<char>& buffer)
     fclose(fp);
 }
 
+void file_make_folder(const char* path)
+{
+    // ̹ ִٸ  .
+#if defined(_WIN32) || defined(_WIN64)
+    _mkdir(path);
+#else
+    mkdir(path, 0755);
+#endif
+}
+
 void gl_validate_shader(unsigned so, const char* shader_source)
 {
     glShaderSource(so, 1, &shader_source, NULL);
@@ -78,6 +95,23 @@ void gl_validate_program(unsigned pso, unsigned vso, unsigned fso)
     }
 }
 
+void gl_validate_compute_program(unsigned pso, unsigned cso)
+{
+    glAttachShader(pso, cso);
+    glLinkProgram(pso);
+    {
+        GLint success;
+        glGetProgramiv(pso, GL_LINK_STATUS, &success);
+        if (!success)
+        {
+            char info_logs[512];
+            glGetProgramInfoLog(pso, 512, NULL, info_logs);
+            printf("Fail to Compile source : %s\n", info_logs);
+            assert(false);
+        }
+    }
+}
+
 unsigned gl_load_model_texture(unsigned char* data, int width, int height, int comp)
 {
     unsigned gl_id;
@@ -105,6 +139,9 @@ unsigned gl_load_model_texture(unsigned char* data, int width, int height, int c
     glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0, dataFormat, GL_UNSIGNED_BYTE, data);
     glGenerateMipmap(GL_TEXTURE_2D);
 
+    // mip chain   1/3  Ѵ.
+    memory_tracker_gpu_set(GPU_MEMORY_TEXTURE, gl_id, (size_t)width * height * comp * 4 / 3);
+
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
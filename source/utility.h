@@ -4,9 +4,11 @@
 #include <vector>
 
 void file_open_fill_buffer(const char* path, std::vector<char>& buffer);
+void file_make_folder(const char* path);
 
 void gl_validate_shader(unsigned so, const char* shader_source);
 void gl_validate_program(unsigned pso, unsigned vso, unsigned fso);
+void gl_validate_compute_program(unsigned pso, unsigned cso);
 unsigned gl_load_model_texture(unsigned char* data, int width, int height, int comp);
 void gl_check_error(const char* file, int line);
 #define GL_CHECK_ERROR() gl_check_error(__FILE__, __LINE__)